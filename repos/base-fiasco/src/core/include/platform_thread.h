@@ -179,6 +179,13 @@ class Genode::Platform_thread : Interface
 		 */
 		Trace::Execution_time execution_time() const { return { 0, 0 }; }
 
+		/**
+		 * Return hardware performance-counter readings of the thread
+		 *
+		 * Not supported on this kernel.
+		 */
+		Trace::Performance_counters performance_counters() const { return { }; }
+
 
 		/*******************************
 		 ** Fiasco-specific Accessors **
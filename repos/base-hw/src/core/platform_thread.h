@@ -211,6 +211,13 @@ class Genode::Platform_thread : Noncopyable
 				const_cast<Platform_thread *>(this)->_kobj->execution_time();
 			return { execution_time, 0, _quota, _priority }; }
 
+		/**
+		 * Return hardware performance-counter readings of the thread
+		 *
+		 * Not supported on this kernel.
+		 */
+		Trace::Performance_counters performance_counters() const { return { }; }
+
 
 		/***************
 		 ** Accessors **
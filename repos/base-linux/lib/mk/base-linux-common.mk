@@ -13,3 +13,12 @@ SRC_CC += rpc_dispatch_loop.cc
 SRC_CC += thread_env.cc
 SRC_CC += capability.cc
 SRC_CC += native_thread.cc
+
+#
+# Transfer the payload of RPCs between threads that call the same RPC object
+# repeatedly via shared-memory rings, see 'base/internal/ipc_ring.h'. Enable
+# by adding 'LX_IPC_RING = yes' to the build configuration.
+#
+ifeq ($(LX_IPC_RING),yes)
+CC_OPT_ipc += -DLX_IPC_RING
+endif
@@ -0,0 +1,30 @@
+/*
+ * \brief  Core-specific back end of the shared memory for RPC rings
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* base-internal includes */
+#include <base/internal/ipc_ring.h>
+
+using namespace Genode;
+
+
+/*
+ * Core calls RPC objects via sockets only. It still serves rings set up by
+ * its clients.
+ */
+Ipc_ring_memory Genode::alloc_ipc_ring_memory()
+{
+	throw Ipc_ring_memory::Unavailable();
+}
+
+
+void Genode::free_ipc_ring_memory(Ipc_ring_memory &) { }
@@ -24,6 +24,7 @@
 #undef size_t
 
 #include <sys/ioctl.h>
+#include <linux/perf_event.h>
 
 
 /*******************************************************
@@ -185,6 +186,86 @@ inline void lx_disable_aslr()
 }
 
 
+/***********************************************
+ ** Functions used by core's tracing support **
+ ***********************************************/
+
+/**
+ * Open hardware performance counter for the given thread
+ *
+ * \param group_fd  file descriptor of the group leader, or -1 to create
+ *                  a new group
+ */
+inline int lx_perf_event_open(perf_event_attr *attr, int tid, int group_fd)
+{
+	/* count the events of the thread on any CPU */
+	return (int)lx_syscall(SYS_perf_event_open, attr, tid, -1, group_fd, 0);
+}
+
+
+/**************************************************
+ ** Functions used by core's CPU-affinity support **
+ **************************************************/
+
+/*
+ * CPU mask as used by 'sched_setaffinity' and 'sched_getaffinity',
+ * covering up to 1024 CPUs like the C library's 'cpu_set_t'
+ */
+struct Lx_cpu_mask
+{
+	enum { BITS = 1024, BITS_PER_WORD = 8*sizeof(unsigned long) };
+
+	unsigned long words[BITS/BITS_PER_WORD] { };
+
+	void set(unsigned cpu)
+	{
+		if (cpu < BITS)
+			words[cpu/BITS_PER_WORD] |= 1UL << (cpu % BITS_PER_WORD);
+	}
+
+	bool contains(unsigned cpu) const
+	{
+		return cpu < BITS
+		    && (words[cpu/BITS_PER_WORD] & (1UL << (cpu % BITS_PER_WORD)));
+	}
+};
+
+
+inline int lx_sched_setaffinity(unsigned long tid, Lx_cpu_mask const &mask)
+{
+	return (int)lx_syscall(SYS_sched_setaffinity, tid, sizeof(mask.words),
+	                       mask.words);
+}
+
+
+/**
+ * Obtain CPU mask of the given thread, 0 refers to the calling thread
+ *
+ * \return  size of the kernel's CPU mask in bytes, or negative error
+ */
+inline int lx_sched_getaffinity(unsigned long tid, Lx_cpu_mask &mask)
+{
+	return (int)lx_syscall(SYS_sched_getaffinity, tid, sizeof(mask.words),
+	                       mask.words);
+}
+
+
+/**
+ * Return time of the monotonic clock in microseconds
+ */
+inline Genode::uint64_t lx_monotonic_time_us()
+{
+	enum { LX_CLOCK_MONOTONIC = 1 };
+
+	/* layout of the kernel's 'struct timespec' as used by 'clock_gettime' */
+	struct { long tv_sec, tv_nsec; } ts { 0, 0 };
+
+	lx_syscall(SYS_clock_gettime, LX_CLOCK_MONOTONIC, &ts);
+
+	return (Genode::uint64_t)ts.tv_sec*1000*1000 + (Genode::uint64_t)ts.tv_nsec/1000;
+}
+
+
 /***********************************
  ** Resource-limit initialization **
  ***********************************/
@@ -121,6 +121,17 @@ class Genode::Platform : public Platform_generic
 
 		} _ram_alloc { };
 
+		Affinity::Space _affinity_space { 1 };
+
+		/*
+		 * Linux CPU numbers of the CPUs available to core, indexed by the
+		 * x position within the affinity space. The CPU mask of core may
+		 * be sparse, e.g., when started via 'taskset'.
+		 */
+		enum { MAX_CPUS = 1024 };
+
+		unsigned short _linux_cpus[MAX_CPUS] { };
+
 	public:
 
 		/**
@@ -156,6 +167,21 @@ class Genode::Platform : public Platform_generic
 		 */
 		size_t max_caps() const override { return 20000; }
 
+		/*
+		 * The affinity space covers the CPUs that core may use according
+		 * to its Linux CPU mask. Threads are bound to CPUs via
+		 * 'sched_setaffinity'.
+		 */
+		Affinity::Space affinity_space() const override { return _affinity_space; }
+
+		/**
+		 * Return Linux CPU number of the CPU at x position 'xpos'
+		 */
+		unsigned linux_cpu(unsigned xpos) const
+		{
+			return _linux_cpus[xpos % _affinity_space.width()];
+		}
+
 		void wait_for_exit() override;
 };
 
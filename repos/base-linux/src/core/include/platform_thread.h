@@ -61,12 +61,67 @@ class Genode::Platform_thread : public List<Platform_thread>::Element
 		unsigned long _pid = -1;
 		char          _name[32] { };
 
+		Affinity::Location _location;
+
+		/**
+		 * Restrict thread to the CPUs covered by '_location'
+		 */
+		void _apply_affinity();
+
 		/*
 		 * Dummy pager object that is solely used for storing the
 		 * 'Signal_context_capability' for the thread's exception handler.
 		 */
 		Pager_object _pager { };
 
+		/*
+		 * Hardware performance counters of the thread
+		 *
+		 * The counters are opened via 'perf_event_open' on the first
+		 * request only because each counter occupies a file descriptor
+		 * of core and a hardware counter while the thread is scheduled.
+		 * The number of threads with open counters is limited to
+		 * 'MAX_THREADS'. Requests for further threads yield invalid
+		 * readings until counters of other threads are closed.
+		 */
+		struct Perf_counters
+		{
+			enum { CYCLES, INSTRUCTIONS, LLC_MISSES, NUM };
+
+			enum { MAX_THREADS = 256 };
+
+			int  fd[NUM] { -1, -1, -1 };
+			bool opened  { false };
+
+			void open(unsigned long tid);
+			void close();
+
+			Trace::Performance_counters read() const;
+		};
+
+		mutable Perf_counters _perf_counters { };
+
+		/*
+		 * Execution time read from '/proc/<tid>/schedstat'
+		 *
+		 * A TRACE query obtains the execution times of all subjects and
+		 * a monitor usually issues several queries per period. The value
+		 * is re-read not before 'MAX_AGE_US' passed.
+		 */
+		struct Cached_execution_time
+		{
+			enum { MAX_AGE_US = 10*1000 };
+
+			uint64_t read_us { 0 };
+			bool     valid   { false };
+
+			Trace::Execution_time time { };
+		};
+
+		mutable Cached_execution_time _execution_time { };
+
+		Trace::Execution_time _read_execution_time() const;
+
 	public:
 
 		/**
@@ -114,22 +169,30 @@ class Genode::Platform_thread : public List<Platform_thread>::Element
 		const char   *name() { return _name; }
 
 		/**
-		 * Set the executing CPU for this thread
+		 * Set the executing CPUs for this thread
 		 *
-		 * SMP is currently not directly supported on Genode/Linux
-		 * (but indirectly by the Linux kernel).
+		 * The thread is restricted to the CPUs covered by the location
+		 * whereas the Linux kernel schedules the thread among them.
 		 */
-		void affinity(Affinity::Location) { }
+		void affinity(Affinity::Location location)
+		{
+			_location = location;
+			_apply_affinity();
+		}
 
 		/**
 		 * Request the affinity of this thread
 		 */
-		Affinity::Location affinity() const { return Affinity::Location(); }
+		Affinity::Location affinity() const { return _location; }
 
 		/**
 		 * Register process ID and thread ID of thread
 		 */
-		void thread_id(int pid, int tid) { _pid = pid, _tid = tid; }
+		void thread_id(int pid, int tid)
+		{
+			_pid = pid, _tid = tid;
+			_apply_affinity();
+		}
 
 		/**
 		 * Notify Genode::Signal handler about sigchld
@@ -147,7 +210,12 @@ class Genode::Platform_thread : public List<Platform_thread>::Element
 		/**
 		 * Return execution time consumed by the thread
 		 */
-		Trace::Execution_time execution_time() const { return { 0, 0 }; }
+		Trace::Execution_time execution_time() const;
+
+		/**
+		 * Return hardware performance-counter readings of the thread
+		 */
+		Trace::Performance_counters performance_counters() const;
 
 		unsigned long pager_object_badge() const { return 0; }
 };
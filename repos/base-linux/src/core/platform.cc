@@ -107,6 +107,17 @@ Platform::Platform()
 
 	_core_mem_alloc.add_range((addr_t)_core_mem, sizeof(_core_mem));
 
+	/* the affinity space covers the CPUs available to core only */
+	Lx_cpu_mask mask { };
+	if (lx_sched_getaffinity(0, mask) > 0) {
+		unsigned width = 0;
+		for (unsigned cpu = 0; cpu < Lx_cpu_mask::BITS && width < MAX_CPUS; cpu++)
+			if (mask.contains(cpu))
+				_linux_cpus[width++] = (unsigned short)cpu;
+
+		_affinity_space = Affinity::Space(max(width, 1u));
+	}
+
 	/*
 	 * Occupy the socket handle that will be used to propagate the parent
 	 * capability new processes. Otherwise, there may be the chance that the
@@ -15,10 +15,12 @@
 #include <util/token.h>
 #include <util/misc_math.h>
 #include <base/log.h>
+#include <base/mutex.h>
 
 /* local includes */
 #include "platform_thread.h"
-#include <linux_syscalls.h>
+#include <platform.h>
+#include <core_linux_syscalls.h>
 
 using namespace Genode;
 
@@ -70,12 +72,170 @@ Platform_thread::Registry &Platform_thread::_registry()
 }
 
 
+/*************************************
+ ** Platform_thread::Perf_counters **
+ *************************************/
+
+/*
+ * Number of threads with open performance counters
+ */
+struct Perf_threads
+{
+	Mutex    mutex { };
+	unsigned count { 0 };
+};
+
+
+static Perf_threads &perf_threads()
+{
+	static Perf_threads inst { };
+	return inst;
+}
+
+
+void Platform_thread::Perf_counters::open(unsigned long tid)
+{
+	static unsigned long long const config[NUM] = {
+		PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_MISSES   /* usually last-level cache misses */
+	};
+
+	Perf_threads &threads = perf_threads();
+	Mutex::Guard guard(threads.mutex);
+
+	/* leave 'opened' unset to retry once counters of other threads closed */
+	if (threads.count >= MAX_THREADS) {
+		static bool warned = false;
+		if (!warned)
+			warning("performance counters limited to ", (unsigned)MAX_THREADS,
+			        " threads");
+		warned = true;
+		return;
+	}
+
+	opened = true;
+
+	for (unsigned i = 0; i < NUM; i++) {
+
+		perf_event_attr attr { };
+		attr.type           = PERF_TYPE_HARDWARE;
+		attr.size           = sizeof(attr);
+		attr.config         = config[i];
+		attr.read_format    = PERF_FORMAT_GROUP
+		                    | PERF_FORMAT_TOTAL_TIME_ENABLED
+		                    | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv     = 1;
+
+		/* the cycle counter leads the group so that all are read at once */
+		int const res = lx_perf_event_open(&attr, (int)tid,
+		                                   i == CYCLES ? -1 : fd[CYCLES]);
+		if (res >= 0) {
+			fd[i] = res;
+			if (i == CYCLES)
+				threads.count++;
+			continue;
+		}
+
+		if (i == CYCLES) {
+			static bool warned = false;
+			if (!warned)
+				warning("performance counters unavailable (", res, "), "
+				        "check /proc/sys/kernel/perf_event_paranoid");
+			warned = true;
+			return;
+		}
+	}
+}
+
+
+void Platform_thread::Perf_counters::close()
+{
+	if (fd[CYCLES] >= 0) {
+		Perf_threads &threads = perf_threads();
+		Mutex::Guard guard(threads.mutex);
+		threads.count--;
+	}
+
+	opened = false;
+
+	for (unsigned i = 0; i < NUM; i++) {
+		if (fd[i] >= 0)
+			lx_close(fd[i]);
+		fd[i] = -1;
+	}
+}
+
+
+Trace::Performance_counters Platform_thread::Perf_counters::read() const
+{
+	if (fd[CYCLES] < 0)
+		return { };
+
+	/*
+	 * With 'PERF_FORMAT_GROUP', the leader reports the number of values,
+	 * the times the group was enabled and actually counting, followed by
+	 * the values in the order the counters joined the group.
+	 */
+	struct {
+		uint64_t nr;
+		uint64_t time_enabled;
+		uint64_t time_running;
+		uint64_t values[NUM];
+	} group { };
+
+	int const header_size = (int)(sizeof(group) - sizeof(group.values));
+	if (lx_read(fd[CYCLES], &group, sizeof(group)) < header_size)
+		return { };
+
+	/*
+	 * If the kernel multiplexed the hardware counters with other events,
+	 * the group counted during 'time_running' only. Extrapolate the values
+	 * to 'time_enabled' without overflowing the intermediate product.
+	 */
+	uint64_t enabled = group.time_enabled, running = group.time_running;
+	bool const scale = running && running < enabled;
+	while (enabled >> 32) {
+		enabled >>= 1;
+		running >>= 1;
+	}
+
+	auto scaled = [&] (uint64_t value) -> uint64_t
+	{
+		if (!scale || !running)
+			return value;
+
+		return (value / running)*enabled + (value % running)*enabled/running;
+	};
+
+	Trace::Performance_counters result { };
+	result.valid = true;
+
+	unsigned v = 0;
+	for (unsigned i = 0; i < NUM && v < group.nr; i++) {
+		if (fd[i] < 0)
+			continue;
+
+		uint64_t const value = scaled(group.values[v++]);
+		switch (i) {
+		case CYCLES:       result.cycles       = value; break;
+		case INSTRUCTIONS: result.instructions = value; break;
+		case LLC_MISSES:   result.llc_misses   = value; break;
+		}
+	}
+	return result;
+}
+
+
 /*********************
  ** Platform_thread **
  *********************/
 
 Platform_thread::Platform_thread(size_t, const char *name, unsigned,
-                                 Affinity::Location, addr_t)
+                                 Affinity::Location location, addr_t)
+:
+	_location(location)
 {
 	copy_cstring(_name, name, min(sizeof(_name), strlen(name) + 1));
 
@@ -85,10 +245,83 @@ Platform_thread::Platform_thread(size_t, const char *name, unsigned,
 
 Platform_thread::~Platform_thread()
 {
+	_perf_counters.close();
+
 	_registry().remove(this);
 }
 
 
+void Platform_thread::_apply_affinity()
+{
+	/* the thread ID is known not before the thread announced itself */
+	if (_tid == (unsigned long)-1 || !_location.width())
+		return;
+
+	Lx_cpu_mask mask { };
+	for (unsigned i = 0; i < _location.width(); i++)
+		mask.set(platform_specific().linux_cpu(_location.xpos() + i));
+
+	if (int const res = lx_sched_setaffinity(_tid, mask))
+		warning("unable to set affinity of thread '", Cstring(_name), "' (", res, ")");
+}
+
+
+Trace::Execution_time Platform_thread::execution_time() const
+{
+	if (_tid == (unsigned long)-1)
+		return { 0, 0 };
+
+	uint64_t const now_us = lx_monotonic_time_us();
+
+	Cached_execution_time &cached = _execution_time;
+
+	if (!cached.valid || now_us - cached.read_us >= Cached_execution_time::MAX_AGE_US) {
+		cached.time    = _read_execution_time();
+		cached.read_us = now_us;
+		cached.valid   = true;
+	}
+	return cached.time;
+}
+
+
+Trace::Execution_time Platform_thread::_read_execution_time() const
+{
+	/*
+	 * The first value of the scheduler statistics is the time spent on
+	 * the CPU in nanoseconds. It is reported in microseconds like on the
+	 * other kernels.
+	 */
+	String<32> const path("/proc/", _tid, "/schedstat");
+
+	int const fd = lx_open(path.string(), O_RDONLY);
+	if (fd < 0)
+		return { 0, 0 };
+
+	char buf[64] { };
+	int const len = lx_read(fd, buf, sizeof(buf) - 1);
+	lx_close(fd);
+
+	uint64_t ns = 0;
+	for (int i = 0; i < len && buf[i] >= '0' && buf[i] <= '9'; i++)
+		ns = ns*10 + (unsigned)(buf[i] - '0');
+
+	return { ns / 1000, 0 };
+}
+
+
+Trace::Performance_counters Platform_thread::performance_counters() const
+{
+	/* the thread ID is known not before the thread announced itself */
+	if (_tid == (unsigned long)-1)
+		return { };
+
+	if (!_perf_counters.opened)
+		_perf_counters.open(_tid);
+
+	return _perf_counters.read();
+}
+
+
 void Platform_thread::pause()
 {
 	warning(__func__, "not implemented");
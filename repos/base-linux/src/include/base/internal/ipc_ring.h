@@ -0,0 +1,275 @@
+/*
+ * \brief  Shared-memory rings for transferring RPC payloads
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * When enabled via the 'LX_IPC_RING' build switch, a thread that calls the
+ * same RPC object repeatedly sets up a ring in shared memory with the
+ * entrypoint of the object. Subsequent calls without capability arguments
+ * transfer their payload through the ring instead of Unix-domain sockets.
+ *
+ * The caller waits for the reply via a futex on the ring. The entrypoint,
+ * however, must keep waiting for socket messages via epoll. Hence, it
+ * cannot block on a futex. Instead, before blocking in epoll, it flags each
+ * ring as 'server_sleeping' and the next caller rings a doorbell socket.
+ * Back-to-back calls to a busy entrypoint therefore need no system call
+ * except for the futex wait of the caller and the futex wake of the server.
+ *
+ * Capabilities are file descriptors, which can be transferred via sockets
+ * only. Calls with capability arguments always take the socket path.
+ * Replies carrying capabilities are sent via a socket pair that is
+ * established along with the ring, and flagged in the ring.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__INTERNAL__IPC_RING_H_
+#define _INCLUDE__BASE__INTERNAL__IPC_RING_H_
+
+#include <base/mutex.h>
+#include <base/native_capability.h>
+
+#include <linux_syscalls.h>
+
+namespace Genode {
+
+	class  Msgbuf_base;
+	struct Rpc_exception_code;
+
+	struct Ipc_ring;
+	struct Ipc_ring_memory;
+	class  Ipc_ring_client;
+	class  Ipc_ring_server;
+
+	/**
+	 * Allocate and locally map shared memory for one ring
+	 *
+	 * \throw Ipc_ring_memory::Unavailable
+	 */
+	Ipc_ring_memory alloc_ipc_ring_memory();
+
+	void free_ipc_ring_memory(Ipc_ring_memory &);
+}
+
+
+/**
+ * Memory layout shared by client and server
+ *
+ * Because calls are synchronous, a single request and a single reply slot
+ * suffice. A request is pending as long as 'request_seq' differs from the
+ * sequence number of the latest request taken by the server.
+ */
+struct Genode::Ipc_ring
+{
+	enum { SIZE = 8*1024, HEADER_SIZE = 64, SLOT_SIZE = (SIZE - HEADER_SIZE)/2 };
+
+	int request_seq;      /* written by the client after the request payload */
+	int reply_seq;        /* written by the server after the reply payload */
+	int client_sleeping;  /* client blocks in futex wait on 'reply_seq' */
+	int server_sleeping;  /* server waits for the doorbell */
+	int closed;           /* ring must no longer be used */
+	int reply_via_socket; /* reply carries capabilities */
+
+	long          exception_code;
+	unsigned long request_len;
+	unsigned long reply_len;
+
+	char _header_padding[HEADER_SIZE - 6*sizeof(int) - sizeof(long)
+	                     - 2*sizeof(unsigned long)];
+
+	char request[SLOT_SIZE];
+	char reply[SLOT_SIZE];
+};
+
+
+struct Genode::Ipc_ring_memory
+{
+	struct Unavailable : Exception { };
+
+	Native_capability ds { };  /* RAM dataspace backing the ring */
+	Native_capability fd { };  /* file descriptor of the dataspace */
+	Ipc_ring         *ring = nullptr;
+};
+
+
+/**
+ * Rings of a calling thread
+ */
+class Genode::Ipc_ring_client : Noncopyable
+{
+	public:
+
+		enum {
+			MAX_RINGS = 4,
+
+			/* number of socket calls to an object before setting up a ring */
+			HOT_CALLS = 16,
+		};
+
+		struct Entry
+		{
+			Native_capability dst { };
+			Ipc_ring_memory   memory { };
+
+			Lx_sd reply    { -1 };  /* replies carrying capabilities */
+			Lx_sd doorbell { -1 };  /* wakes up the sleeping server */
+
+			int           seq       = 0;
+			unsigned long last_used = 0;
+
+			bool valid() const { return memory.ring != nullptr; }
+		};
+
+		struct Candidate
+		{
+			enum { DENIED = ~0U };
+
+			Native_capability::Data const *dst = nullptr;
+			unsigned calls = 0;
+		};
+
+	private:
+
+		Entry     _entries[MAX_RINGS] { };
+		Candidate _candidates[MAX_RINGS] { };
+
+		unsigned      _next_candidate = 0;
+		unsigned long _now = 0;
+
+	public:
+
+		/*
+		 * Set while a ring is set up, which involves RPCs on its own
+		 */
+		bool in_setup = false;
+
+		~Ipc_ring_client();
+
+		/**
+		 * Return ring for 'dst', or nullptr if none is set up
+		 */
+		Entry *lookup(Native_capability const &dst);
+
+		/**
+		 * Account socket call to 'dst', return true if a ring should be set up
+		 */
+		bool hot(Native_capability const &dst);
+
+		/**
+		 * Prevent further attempts to set up a ring for 'dst'
+		 */
+		void deny(Native_capability const &dst);
+
+		/**
+		 * Return unused entry, evict the least recently used ring if needed
+		 */
+		Entry &alloc_entry();
+
+		/**
+		 * Close ring and release its resources
+		 */
+		void release(Entry &);
+};
+
+
+/**
+ * Rings of an RPC entrypoint
+ *
+ * The entrypoint thread takes requests and evicts rings. Replies may be
+ * issued by other threads, e.g., deferred replies of core's signal sources.
+ * Hence, entries are protected by a mutex.
+ */
+class Genode::Ipc_ring_server : Noncopyable
+{
+	public:
+
+		enum {
+			MAX_RINGS = 32,
+
+			/* number of ring requests between checks for socket requests */
+			MAX_BATCH = 16,
+		};
+
+		struct Entry
+		{
+			Ipc_ring_server *server = nullptr;
+			Ipc_ring        *ring   = nullptr;
+
+			unsigned long badge = 0;
+			Lx_sd         reply { -1 };
+
+			int           seq       = 0;  /* sequence number of latest request */
+			bool          serving   = false;
+			bool          discarded = false;
+			unsigned long last_used = 0;
+		};
+
+	private:
+
+		Mutex _mutex { };
+
+		Entry _entries[MAX_RINGS] { };
+
+		unsigned      _next  = 0;
+		unsigned      _batch = 0;
+		unsigned long _now   = 0;
+
+		void _release(Entry &);
+
+		bool _pending(Entry const &) const;
+
+	public:
+
+		Ipc_ring_server();
+
+		~Ipc_ring_server();
+
+		/**
+		 * Register ring of a new client
+		 *
+		 * \param memory  file descriptor of the shared memory, consumed
+		 * \param reply   socket for replies carrying capabilities
+		 *
+		 * \return false if the ring cannot be used
+		 */
+		bool setup(unsigned long badge, Lx_sd memory, Lx_sd reply);
+
+		/**
+		 * Take pending request and copy its payload into 'request_msg'
+		 *
+		 * \return entry of the taken request, or nullptr if none is pending
+		 */
+		Entry *take_request(Msgbuf_base &request_msg);
+
+		/**
+		 * Return true if socket requests must be checked for
+		 *
+		 * Without this check, a steady stream of ring requests would starve
+		 * requests arriving via sockets.
+		 */
+		bool sockets_due();
+
+		/**
+		 * Flag all rings as sleeping before blocking for socket messages
+		 *
+		 * \return false if a request became pending in the meantime
+		 */
+		bool sleep();
+
+		/**
+		 * Send reply for the request taken from 'entry'
+		 */
+		void reply(Entry &entry, Rpc_exception_code, Msgbuf_base &reply_msg);
+
+		/**
+		 * Close rings of an RPC object that is about to vanish
+		 */
+		void discard(unsigned long badge);
+};
+
+#endif /* _INCLUDE__BASE__INTERNAL__IPC_RING_H_ */
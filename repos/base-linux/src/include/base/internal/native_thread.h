@@ -19,6 +19,9 @@
 
 #include <linux_syscalls.h>
 
+/* base-internal includes */
+#include <base/internal/ipc_ring.h>
+
 namespace Genode { struct Native_thread; }
 
 
@@ -67,6 +70,12 @@ class Genode::Native_thread
 
 				Lx_epoll_sd const _epoll;
 
+				/* socket pair for waking up 'poll' by ring clients */
+				Lx_sd _doorbell_local  { -1 };
+				Lx_sd _doorbell_remote { -1 };
+
+				void _drain_doorbell();
+
 				void _add   (Lx_sd);
 				void _remove(Lx_sd);
 
@@ -89,13 +98,30 @@ class Genode::Native_thread
 
 				~Epoll();
 
+				/**
+				 * Shared-memory rings of the clients of the entrypoint
+				 */
+				Ipc_ring_server rings { };
+
 				/**
 				 * Wait for incoming RPC messages
 				 *
+				 * \param block  if false, return immediately if no message
+				 *               is pending
+				 *
 				 * \return  valid socket descriptor that matches the invoked
-				 *          RPC object
+				 *          RPC object, or an invalid socket descriptor if
+				 *          woken up via the doorbell or if no message is
+				 *          pending
+				 */
+				Lx_sd poll(bool block = true);
+
+				/**
+				 * Return socket used by ring clients to wake up 'poll'
+				 *
+				 * Must be called by the polling thread.
 				 */
-				Lx_sd poll();
+				Lx_sd doorbell();
 
 				Native_capability alloc_rpc_cap();
 
@@ -108,6 +134,61 @@ class Genode::Native_thread
 
 		} epoll { };
 
+		/**
+		 * Socket pair for receiving RPC replies
+		 *
+		 * The socket pair is created at the first RPC call of the thread and
+		 * reused for all subsequent calls, which saves the creation and
+		 * destruction of a socket pair per call.
+		 *
+		 * Calls of objects with a shared-memory ring set up take the ring
+		 * instead, see 'ipc_ring.h'.
+		 */
+		class Reply_channel
+		{
+			private:
+
+				Lx_sd _local  { -1 };
+				Lx_sd _remote { -1 };
+
+				void _construct()
+				{
+					Lx_socketpair const socketpair { };
+					_local  = socketpair.local;
+					_remote = socketpair.remote;
+				}
+
+			public:
+
+				~Reply_channel() { reset(); }
+
+				Lx_sd local()  { if (!_local.valid()) _construct(); return _local; }
+				Lx_sd remote() { if (!_local.valid()) _construct(); return _remote; }
+
+				/**
+				 * Discard socket pair
+				 *
+				 * This must be done whenever a reply may still be in flight or
+				 * the sockets may be unusable, e.g., after a call got canceled
+				 * or failed. Otherwise, a stale reply would be taken as the
+				 * reply of the next call.
+				 */
+				void reset()
+				{
+					if (_local.valid())  lx_close(_local.value);
+					if (_remote.valid()) lx_close(_remote.value);
+
+					_local  = Lx_sd::invalid();
+					_remote = Lx_sd::invalid();
+				}
+
+		} reply_channel { };
+
+		/**
+		 * Shared-memory rings used for calls by this thread
+		 */
+		Ipc_ring_client ipc_rings { };
+
 		Native_thread() { }
 };
 
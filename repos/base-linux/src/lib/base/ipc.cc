@@ -74,6 +74,12 @@ struct Protocol_header
 
 	enum { INVALID_BADGE = ~1UL };
 
+	/*
+	 * Protocol words used for setting up a shared-memory ring, see
+	 * 'ipc_ring.h'. Regular calls use a protocol word of 0.
+	 */
+	enum { RING_SETUP = 0x52494e47, RING_ACCEPT, RING_DENIED };
+
 	void *msg_start() { return &protocol_word; }
 };
 
@@ -280,6 +286,563 @@ static inline void lx_reply(Lx_sd reply_socket, Rpc_exception_code exception_cod
 }
 
 
+/*************************
+ ** Shared-memory rings **
+ *************************/
+
+static int atomic_load(int const &value)
+{
+	return __atomic_load_n(&value, __ATOMIC_SEQ_CST);
+}
+
+
+static void atomic_store(int &dst, int value)
+{
+	__atomic_store_n(&dst, value, __ATOMIC_SEQ_CST);
+}
+
+
+/*
+ * Set if the component cannot provide memory for rings, e.g., in core
+ */
+static bool ring_memory_unavailable = false;
+
+
+Ipc_ring_client::~Ipc_ring_client()
+{
+	for (Entry &entry : _entries)
+		if (entry.valid())
+			release(entry);
+}
+
+
+Ipc_ring_client::Entry *Ipc_ring_client::lookup(Native_capability const &dst)
+{
+	for (Entry &entry : _entries) {
+		if (entry.valid() && entry.dst == dst) {
+			entry.last_used = ++_now;
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+
+bool Ipc_ring_client::hot(Native_capability const &dst)
+{
+	for (Candidate &candidate : _candidates) {
+
+		if (candidate.dst != dst.data())
+			continue;
+
+		if (candidate.calls == Candidate::DENIED || ++candidate.calls < HOT_CALLS)
+			return false;
+
+		/* count anew should the ring get closed */
+		candidate.calls = 0;
+		return true;
+	}
+
+	_candidates[_next_candidate] = Candidate { dst.data(), 1 };
+	_next_candidate = (_next_candidate + 1) % MAX_RINGS;
+	return false;
+}
+
+
+void Ipc_ring_client::deny(Native_capability const &dst)
+{
+	for (Candidate &candidate : _candidates)
+		if (candidate.dst == dst.data())
+			candidate.calls = Candidate::DENIED;
+}
+
+
+Ipc_ring_client::Entry &Ipc_ring_client::alloc_entry()
+{
+	Entry *lru = &_entries[0];
+
+	for (Entry &entry : _entries) {
+		if (!entry.valid())
+			return entry;
+
+		if (entry.last_used < lru->last_used)
+			lru = &entry;
+	}
+
+	release(*lru);
+	return *lru;
+}
+
+
+void Ipc_ring_client::release(Entry &entry)
+{
+	if (entry.memory.ring)
+		atomic_store(entry.memory.ring->closed, 1);
+
+	/* freeing the memory involves RPCs, which must not take a ring */
+	bool const nested = in_setup;
+	in_setup = true;
+	free_ipc_ring_memory(entry.memory);
+	in_setup = nested;
+
+	if (entry.reply.valid())    lx_close(entry.reply.value);
+	if (entry.doorbell.valid()) lx_close(entry.doorbell.value);
+
+	entry = Entry();
+}
+
+
+Ipc_ring_server::Ipc_ring_server()
+{
+	for (Entry &entry : _entries)
+		entry.server = this;
+}
+
+
+Ipc_ring_server::~Ipc_ring_server()
+{
+	for (Entry &entry : _entries)
+		if (entry.ring)
+			_release(entry);
+}
+
+
+void Ipc_ring_server::_release(Entry &entry)
+{
+	atomic_store(entry.ring->closed, 1);
+
+	/* wake up client that waits for a reply */
+	lx_futex(&entry.ring->reply_seq, LX_FUTEX_WAKE, 1);
+
+	lx_munmap(entry.ring, Ipc_ring::SIZE);
+	lx_close(entry.reply.value);
+
+	entry = Entry();
+	entry.server = this;
+}
+
+
+bool Ipc_ring_server::_pending(Entry const &entry) const
+{
+	return entry.ring && !entry.serving
+	    && (atomic_load(entry.ring->closed)
+	     || atomic_load(entry.ring->request_seq) != entry.seq);
+}
+
+
+bool Ipc_ring_server::setup(unsigned long badge, Lx_sd memory, Lx_sd reply)
+{
+	Mutex::Guard guard(_mutex);
+
+	/* accessing memory beyond the end of a smaller file would fault */
+#ifdef __NR_fstat64
+	struct stat64 statbuf { };
+	(void)lx_syscall(SYS_fstat64, memory.value, &statbuf);
+#else
+	struct stat statbuf { };
+	(void)lx_syscall(SYS_fstat, memory.value, &statbuf);
+#endif /* __NR_fstat64 */
+
+	void *ptr = nullptr;
+	if (statbuf.st_size >= Ipc_ring::SIZE)
+		ptr = lx_mmap(0, Ipc_ring::SIZE, PROT_READ | PROT_WRITE, MAP_SHARED,
+		              memory.value, 0);
+
+	lx_close(memory.value);
+
+	if (!ptr || (((long)ptr < 0) && ((long)ptr > -4095)))
+		return false;
+
+	/* use free entry or evict least recently used idle ring */
+	Entry *entry_ptr = nullptr;
+	for (Entry &entry : _entries) {
+
+		if (!entry.ring) {
+			entry_ptr = &entry;
+			break;
+		}
+
+		if (entry.serving)
+			continue;
+
+		if (!entry_ptr || entry.last_used < entry_ptr->last_used)
+			entry_ptr = &entry;
+	}
+
+	if (!entry_ptr) {
+		lx_munmap(ptr, Ipc_ring::SIZE);
+		return false;
+	}
+
+	if (entry_ptr->ring)
+		_release(*entry_ptr);
+
+	Entry &entry = *entry_ptr;
+
+	entry.ring      = (Ipc_ring *)ptr;
+	entry.badge     = badge;
+	entry.reply     = reply;
+	entry.seq       = atomic_load(entry.ring->request_seq);
+	entry.last_used = ++_now;
+	return true;
+}
+
+
+Ipc_ring_server::Entry *Ipc_ring_server::take_request(Msgbuf_base &request_msg)
+{
+	Mutex::Guard guard(_mutex);
+
+	for (unsigned i = 0; i < MAX_RINGS; i++) {
+
+		unsigned const index = (_next + i) % MAX_RINGS;
+		Entry &entry = _entries[index];
+
+		if (!_pending(entry))
+			continue;
+
+		if (atomic_load(entry.ring->closed)) {
+			_release(entry);
+			continue;
+		}
+
+		Ipc_ring &ring = *entry.ring;
+
+		/* the payload is complete once the sequence number is updated */
+		entry.seq       = atomic_load(ring.request_seq);
+		entry.serving   = true;
+		entry.last_used = ++_now;
+
+		size_t const len = min(min((size_t)ring.request_len,
+		                           (size_t)Ipc_ring::SLOT_SIZE),
+		                       request_msg.capacity());
+
+		request_msg.reset();
+		Genode::memcpy(request_msg.data(), ring.request, len);
+
+		/* serve rings in a round-robin fashion */
+		_next = (index + 1) % MAX_RINGS;
+		_batch++;
+
+		return &entry;
+	}
+	return nullptr;
+}
+
+
+bool Ipc_ring_server::sockets_due()
+{
+	if (_batch < MAX_BATCH)
+		return false;
+
+	_batch = 0;
+	return true;
+}
+
+
+bool Ipc_ring_server::sleep()
+{
+	Mutex::Guard guard(_mutex);
+
+	_batch = 0;
+
+	for (Entry &entry : _entries)
+		if (entry.ring)
+			atomic_store(entry.ring->server_sleeping, 1);
+
+	/* a client may have posted a request before observing the flag */
+	bool pending = false;
+	for (Entry &entry : _entries)
+		pending |= _pending(entry);
+
+	if (pending)
+		for (Entry &entry : _entries)
+			if (entry.ring)
+				atomic_store(entry.ring->server_sleeping, 0);
+
+	return !pending;
+}
+
+
+void Ipc_ring_server::reply(Entry &entry, Rpc_exception_code exc,
+                            Msgbuf_base &reply_msg)
+{
+	Mutex::Guard guard(_mutex);
+
+	if (!entry.ring || !entry.serving)
+		return;
+
+	Ipc_ring &ring = *entry.ring;
+
+	/* capabilities can be transferred via sockets only */
+	bool const via_socket = reply_msg.used_caps()
+	                     || reply_msg.data_size() > Ipc_ring::SLOT_SIZE;
+
+	if (via_socket) {
+		lx_reply(entry.reply, exc, reply_msg);
+	} else {
+		Genode::memcpy(ring.reply, reply_msg.data(), reply_msg.data_size());
+		ring.reply_len = reply_msg.data_size();
+	}
+
+	ring.exception_code   = exc.value;
+	ring.reply_via_socket = via_socket;
+
+	entry.serving = false;
+
+	atomic_store(ring.reply_seq, entry.seq);
+
+	if (atomic_load(ring.client_sleeping))
+		lx_futex(&ring.reply_seq, LX_FUTEX_WAKE, 1);
+
+	if (entry.discarded)
+		_release(entry);
+}
+
+
+void Ipc_ring_server::discard(unsigned long badge)
+{
+	Mutex::Guard guard(_mutex);
+
+	for (Entry &entry : _entries) {
+
+		if (!entry.ring || entry.badge != badge)
+			continue;
+
+		/* release ring once the request in service is answered */
+		if (entry.serving)
+			entry.discarded = true;
+		else
+			_release(entry);
+	}
+}
+
+
+#ifdef LX_IPC_RING
+
+/**
+ * Set up ring for calling 'dst'
+ *
+ * \throw Blocking_canceled
+ */
+static Ipc_ring_client::Entry *setup_ring(Ipc_ring_client &rings,
+                                          Native_capability const &dst)
+{
+	Ipc_ring_client::Entry &entry = rings.alloc_entry();
+
+	/* allocating the memory involves RPCs, which must not take a ring */
+	rings.in_setup = true;
+	try { entry.memory = alloc_ipc_ring_memory(); }
+	catch (Ipc_ring_memory::Unavailable) { }
+	rings.in_setup = false;
+
+	if (!entry.memory.ring) {
+		ring_memory_unavailable = true;
+		return nullptr;
+	}
+
+	Lx_socketpair const reply { };
+
+	entry.dst   = dst;
+	entry.reply = reply.local;
+
+	/* pass reply socket and ring memory to the server */
+	int send_ret = 0;
+	{
+		Protocol_header header { };
+		header.protocol_word = Protocol_header::RING_SETUP;
+
+		Message msg(header.msg_start(), sizeof(Protocol_header));
+		msg.marshal_socket(reply.remote);
+		msg.marshal_socket(Capability_space::ipc_cap_data(entry.memory.fd).dst.socket);
+
+		send_ret = lx_sendmsg(Capability_space::ipc_cap_data(dst).dst.socket,
+		                      msg.msg(), 0);
+
+		lx_close(reply.remote.value);
+		entry.memory.fd = Native_capability();
+	}
+
+	if (send_ret < 0) {
+		rings.release(entry);
+		return nullptr;
+	}
+
+	/* receive doorbell socket from the server */
+	Protocol_header header { };
+	Message msg(header.msg_start(), sizeof(Protocol_header));
+	msg.accept_sockets(1);
+
+	int const recv_ret = lx_recvmsg(entry.reply, msg.msg(), 0);
+
+	if (recv_ret == -LX_EINTR) {
+		rings.release(entry);
+		throw Blocking_canceled();
+	}
+
+	if (recv_ret >= 0 && msg.num_sockets() == 1)
+		entry.doorbell = msg.socket_at_index(0);
+
+	if (recv_ret < 0 || header.protocol_word != Protocol_header::RING_ACCEPT
+	 || !entry.doorbell.valid()) {
+		rings.release(entry);
+		rings.deny(dst);
+		return nullptr;
+	}
+	return &entry;
+}
+
+
+static void ring_doorbell(Lx_sd doorbell)
+{
+	char byte = 0;
+
+	struct iovec iovec { };
+	iovec.iov_base = &byte;
+	iovec.iov_len  = sizeof(byte);
+
+	struct msghdr msg { };
+	msg.msg_iov    = &iovec;
+	msg.msg_iovlen = 1;
+
+	/* non-blocking, a full socket buffer wakes up the server anyway */
+	(void)lx_sendmsg(doorbell, &msg, 0x40);
+}
+
+
+/**
+ * Perform call via ring
+ *
+ * \return false if the ring got closed before the server took the request
+ * \throw  Blocking_canceled
+ */
+static bool ring_call(Ipc_ring_client &rings, Ipc_ring_client::Entry &entry,
+                      Msgbuf_base &snd_msgbuf, Msgbuf_base &rcv_msgbuf,
+                      Rpc_exception_code &exc)
+{
+	Ipc_ring &ring = *entry.memory.ring;
+
+	if (atomic_load(ring.closed)) {
+		rings.release(entry);
+		return false;
+	}
+
+	Genode::memcpy(ring.request, snd_msgbuf.data(), snd_msgbuf.data_size());
+	ring.request_len = snd_msgbuf.data_size();
+
+	int const seq = ++entry.seq;
+	atomic_store(ring.request_seq, seq);
+
+	if (__atomic_exchange_n(&ring.server_sleeping, 0, __ATOMIC_SEQ_CST))
+		ring_doorbell(entry.doorbell);
+
+	auto replied = [&] () { return atomic_load(ring.reply_seq) == seq; };
+
+	/* the server may reply right away if it runs on another CPU */
+	enum { SPIN_LOOPS = 256 };
+	for (unsigned i = 0; i < SPIN_LOOPS && !replied(); i++);
+
+	if (!replied()) {
+
+		atomic_store(ring.client_sleeping, 1);
+
+		for (;;) {
+			int const reply_seq = atomic_load(ring.reply_seq);
+			if (reply_seq == seq)
+				break;
+
+			/* the server publishes a pending reply before closing the ring */
+			if (atomic_load(ring.closed)) {
+				if (replied())
+					break;
+
+				rings.release(entry);
+				return false;
+			}
+
+			if (lx_futex(&ring.reply_seq, LX_FUTEX_WAIT, reply_seq) == -LX_EINTR) {
+				rings.release(entry);
+				throw Blocking_canceled();
+			}
+		}
+
+		atomic_store(ring.client_sleeping, 0);
+	}
+
+	rcv_msgbuf.reset();
+
+	if (!ring.reply_via_socket) {
+		size_t const len = min(min((size_t)ring.reply_len,
+		                           (size_t)Ipc_ring::SLOT_SIZE),
+		                       rcv_msgbuf.capacity());
+
+		Genode::memcpy(rcv_msgbuf.data(), ring.reply, len);
+		exc = Rpc_exception_code((int)ring.exception_code);
+		return true;
+	}
+
+	/* the reply was sent before 'reply_seq' got updated */
+	Protocol_header &rcv_header = rcv_msgbuf.header<Protocol_header>();
+	rcv_header.protocol_word = 0;
+
+	Message rcv_msg(rcv_header.msg_start(),
+	                sizeof(Protocol_header) + rcv_msgbuf.capacity());
+	rcv_msg.accept_sockets(Message::MAX_SDS_PER_MSG);
+
+	int const recv_ret = lx_recvmsg(entry.reply, rcv_msg.msg(), 0);
+
+	if (recv_ret < 0)
+		rings.release(entry);
+
+	if (recv_ret == -LX_EINTR)
+		throw Genode::Blocking_canceled();
+
+	if (recv_ret < 0) {
+		error(lx_getpid(), ":", lx_gettid(), " ipc_call failed to receive result (", recv_ret, ")");
+		sleep_forever();
+	}
+
+	extract_sds_from_message(0, rcv_msg, rcv_header, rcv_msgbuf);
+
+	exc = Rpc_exception_code((int)rcv_header.protocol_word);
+	return true;
+}
+
+
+/**
+ * Try to perform call via ring
+ *
+ * \return true if the call was performed
+ */
+static bool try_ring_call(Native_capability const &dst,
+                          Msgbuf_base &snd_msgbuf, Msgbuf_base &rcv_msgbuf,
+                          Rpc_exception_code &exc)
+{
+	/* the initial thread has no 'Thread' object */
+	Thread * const myself_ptr = Thread::myself();
+
+	if (!myself_ptr || ring_memory_unavailable)
+		return false;
+
+	Ipc_ring_client &rings = myself_ptr->native_thread().ipc_rings;
+
+	if (rings.in_setup)
+		return false;
+
+	/* capabilities can be transferred via sockets only */
+	if (snd_msgbuf.used_caps() || snd_msgbuf.data_size() > Ipc_ring::SLOT_SIZE)
+		return false;
+
+	Ipc_ring_client::Entry *entry_ptr = rings.lookup(dst);
+
+	if (!entry_ptr && rings.hot(dst))
+		entry_ptr = setup_ring(rings, dst);
+
+	return entry_ptr && ring_call(rings, *entry_ptr, snd_msgbuf, rcv_msgbuf, exc);
+}
+
+#endif /* LX_IPC_RING */
+
+
 /****************
  ** IPC client **
  ****************/
@@ -293,6 +856,14 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 		sleep_forever();
 	}
 
+#ifdef LX_IPC_RING
+	{
+		Rpc_exception_code exc { Rpc_exception_code::SUCCESS };
+		if (try_ring_call(dst, snd_msgbuf, rcv_msgbuf, exc))
+			return exc;
+	}
+#endif /* LX_IPC_RING */
+
 	Protocol_header &snd_header = snd_msgbuf.header<Protocol_header>();
 	snd_header.protocol_word = 0;
 
@@ -300,23 +871,25 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 	                sizeof(Protocol_header) + snd_msgbuf.data_size());
 
 	/*
-	 * Create reply channel
+	 * Obtain reply channel
 	 *
-	 * The reply channel will be closed when leaving the scope of 'lx_call'.
+	 * Threads reuse their reply channel for all calls. The initial thread
+	 * of the process has no 'Thread' object ('Thread::myself()' returns
+	 * nullptr, see 'Ipc_server') and uses a temporary reply channel, which is
+	 * closed when leaving the scope of 'ipc_call'.
 	 */
-	struct Reply_channel : Lx_socketpair
-	{
-		~Reply_channel()
-		{
-			if (local.value  != -1) lx_close(local.value);
-			if (remote.value != -1) lx_close(remote.value);
-		}
-	} reply_channel;
+	Native_thread::Reply_channel temporary_reply_channel { };
+
+	Thread * const myself_ptr = Thread::myself();
+
+	Native_thread::Reply_channel &reply_channel = myself_ptr
+	                                            ? myself_ptr->native_thread().reply_channel
+	                                            : temporary_reply_channel;
 
 	/* assemble message */
 
 	/* marshal reply capability */
-	snd_msg.marshal_socket(reply_channel.remote);
+	snd_msg.marshal_socket(reply_channel.remote());
 
 	/* marshal capabilities contained in 'snd_msgbuf' */
 	insert_sds_into_message(snd_msg, snd_header, snd_msgbuf);
@@ -327,6 +900,7 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 	if (send_ret < 0) {
 		error(lx_getpid(), ":", lx_gettid(), " lx_sendmsg to sd ", dst_socket,
 		    " failed with ", send_ret, " in lx_call()");
+		reply_channel.reset();
 		sleep_forever();
 	}
 
@@ -339,7 +913,15 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 	rcv_msg.accept_sockets(Message::MAX_SDS_PER_MSG);
 
 	rcv_msgbuf.reset();
-	int const recv_ret = lx_recvmsg(reply_channel.local, rcv_msg.msg(), 0);
+	int const recv_ret = lx_recvmsg(reply_channel.local(), rcv_msg.msg(), 0);
+
+	/*
+	 * After a failed receive, a reply may still be in flight or the socket
+	 * may be unusable. In both cases, the channel must not be used for the
+	 * next call.
+	 */
+	if (recv_ret < 0)
+		reply_channel.reset();
 
 	/* system call got interrupted by a signal */
 	if (recv_ret == -LX_EINTR)
@@ -360,12 +942,66 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
  ** IPC server **
  ****************/
 
+/**
+ * Send reply via the reply socket or the ring the request was taken from
+ */
+static void reply_to_caller(Native_capability const &caller,
+                            Rpc_exception_code exc, Msgbuf_base &snd_msg)
+{
+	Capability_space::Ipc_cap_data const cap_data =
+		Capability_space::ipc_cap_data(caller);
+
+	if (cap_data.dst.socket.valid()) {
+		lx_reply(cap_data.dst.socket, exc, snd_msg);
+		return;
+	}
+
+	/* reply capabilities of ring requests refer to the ring entry */
+	if (cap_data.rpc_obj_key.valid()) {
+		Ipc_ring_server::Entry &entry =
+			*(Ipc_ring_server::Entry *)cap_data.rpc_obj_key.value();
+
+		entry.server->reply(entry, exc, snd_msg);
+	}
+}
+
+
+/**
+ * Register ring requested by a client of the RPC object 'badge'
+ */
+static void accept_ring(Native_thread::Epoll &epoll, Lx_sd badge,
+                        Message const &msg)
+{
+	Lx_sd const reply  = msg.socket_at_index(0);
+	Lx_sd const memory = (msg.num_sockets() > 1) ? msg.socket_at_index(1)
+	                                             : Lx_sd::invalid();
+
+	for (unsigned i = 2; i < msg.num_sockets(); i++)
+		lx_close(msg.socket_at_index(i).value);
+
+	bool const accepted = memory.valid()
+	                   && epoll.rings.setup(badge.value, memory, reply);
+
+	Protocol_header header { };
+	header.protocol_word = accepted ? Protocol_header::RING_ACCEPT
+	                                : Protocol_header::RING_DENIED;
+
+	Message result(header.msg_start(), sizeof(Protocol_header));
+
+	if (accepted)
+		result.marshal_socket(epoll.doorbell());
+
+	(void)lx_sendmsg(reply, result.msg(), 0);
+
+	if (!accepted)
+		lx_close(reply.value);
+}
+
+
 void Genode::ipc_reply(Native_capability caller, Rpc_exception_code exc,
                        Msgbuf_base &snd_msg)
 {
-	Lx_sd const reply_socket = Capability_space::ipc_cap_data(caller).dst.socket;
-
-	try { lx_reply(reply_socket, exc, snd_msg); } catch (Ipc_error) { }
+	try { reply_to_caller(caller, exc, snd_msg); } catch (Ipc_error) { }
 }
 
 
@@ -376,7 +1012,7 @@ Rpc_request Genode::ipc_reply_wait(Reply_capability const &last_caller,
 {
 	/* when first called, there was no request yet */
 	if (last_caller.valid() && exc.value != Rpc_exception_code::INVALID_OBJECT)
-		lx_reply(Capability_space::ipc_cap_data(last_caller).dst.socket, exc, reply_msg);
+		reply_to_caller(last_caller, exc, reply_msg);
 
 	/*
 	 * Block infinitely if called from the main thread. This may happen if the
@@ -389,10 +1025,29 @@ Rpc_request Genode::ipc_reply_wait(Reply_capability const &last_caller,
 	}
 
 	Native_thread::Epoll &epoll = myself_ptr->native_thread().epoll;
+	Ipc_ring_server      &rings = epoll.rings;
 
 	for (;;) {
 
-		Lx_sd const selected_sd = epoll.poll();
+		Lx_sd selected_sd = rings.sockets_due() ? epoll.poll(false)
+		                                        : Lx_sd::invalid();
+
+		if (!selected_sd.valid()) {
+
+			if (Ipc_ring_server::Entry *entry = rings.take_request(request_msg))
+				return Rpc_request(Capability_space::import(Rpc_destination::invalid(),
+				                                            Rpc_obj_key((addr_t)entry)),
+				                   entry->badge);
+
+			if (!rings.sleep())
+				continue;
+
+			selected_sd = epoll.poll();
+		}
+
+		/* woken up by a ring client */
+		if (!selected_sd.valid())
+			continue;
 
 		Protocol_header &header = request_msg.header<Protocol_header>();
 		Message msg(header.msg_start(), sizeof(Protocol_header) + request_msg.capacity());
@@ -412,6 +1067,11 @@ Rpc_request Genode::ipc_reply_wait(Reply_capability const &last_caller,
 
 		Lx_sd const reply_socket = msg.socket_at_index(0);
 
+		if (header.protocol_word == Protocol_header::RING_SETUP) {
+			accept_ring(epoll, selected_sd, msg);
+			continue;
+		}
+
 		/* start at offset 1 to skip the reply channel */
 		extract_sds_from_message(1, msg, header, request_msg);
 
@@ -0,0 +1,79 @@
+/*
+ * \brief  Shared memory for the RPC rings of non-core components
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <pd_session/client.h>
+#include <linux_dataspace/client.h>
+#include <linux_syscalls.h>
+
+/* base-internal includes */
+#include <base/internal/globals.h>
+#include <base/internal/ipc_ring.h>
+#include <base/internal/capability_space_tpl.h>
+
+using namespace Genode;
+
+
+Ipc_ring_memory Genode::alloc_ipc_ring_memory()
+{
+	Ipc_ring_memory memory { };
+
+	/*
+	 * Rings are merely an optimization. Hence, we use a plain PD-session
+	 * client instead of 'env.pd()', which would request quota from the
+	 * parent on exhaustion.
+	 */
+	Ram_dataspace_capability ds { };
+	try {
+		Pd_session_client pd(internal_env().pd_session_cap());
+
+		pd.try_alloc(Ipc_ring::SIZE).with_result(
+			[&] (Ram_dataspace_capability cap) { ds = cap; },
+			[&] (Ram_allocator::Alloc_error) { });
+	}
+	catch (...) { }
+
+	if (!ds.valid())
+		throw Ipc_ring_memory::Unavailable();
+
+	Untyped_capability const fd = Linux_dataspace_client(ds).fd();
+
+	int const fd_value = Capability_space::ipc_cap_data(fd).dst.socket.value;
+
+	void * const ptr = lx_mmap(0, Ipc_ring::SIZE, PROT_READ | PROT_WRITE,
+	                           MAP_SHARED, fd_value, 0);
+
+	if (((long)ptr < 0) && ((long)ptr > -4095)) {
+		Pd_session_client(internal_env().pd_session_cap()).free(ds);
+		throw Ipc_ring_memory::Unavailable();
+	}
+
+	memory.ds   = ds;
+	memory.fd   = fd;
+	memory.ring = (Ipc_ring *)ptr;
+	return memory;
+}
+
+
+void Genode::free_ipc_ring_memory(Ipc_ring_memory &memory)
+{
+	if (memory.ring)
+		lx_munmap(memory.ring, Ipc_ring::SIZE);
+
+	if (memory.ds.valid())
+		Pd_session_client(internal_env().pd_session_cap())
+			.free(reinterpret_cap_cast<Ram_dataspace>(memory.ds));
+
+	memory = Ipc_ring_memory();
+}
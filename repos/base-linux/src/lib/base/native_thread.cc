@@ -38,6 +38,12 @@ Native_thread::Epoll::~Epoll()
 	lx_close(_control.local.value);
 	lx_close(_control.remote.value);
 
+	if (_doorbell_local.valid()) {
+		_remove(_doorbell_local);
+		lx_close(_doorbell_local.value);
+		lx_close(_doorbell_remote.value);
+	}
+
 	lx_close(_epoll.value);
 }
 
@@ -72,12 +78,48 @@ void Native_thread::Epoll::_remove(Lx_sd sd)
 }
 
 
-Lx_sd Native_thread::Epoll::poll()
+void Native_thread::Epoll::_drain_doorbell()
+{
+	for (;;) {
+		char byte = 0;
+
+		struct iovec iovec { };
+		iovec.iov_base = &byte;
+		iovec.iov_len  = sizeof(byte);
+
+		struct msghdr msg { };
+		msg.msg_iov    = &iovec;
+		msg.msg_iovlen = 1;
+
+		/* non-blocking */
+		if (lx_recvmsg(_doorbell_local, &msg, 0x40) < 0)
+			return;
+	}
+}
+
+
+Lx_sd Native_thread::Epoll::doorbell()
+{
+	if (!_doorbell_local.valid()) {
+		Lx_socketpair const socketpair { };
+		_add(socketpair.local);
+
+		_doorbell_local  = socketpair.local;
+		_doorbell_remote = socketpair.remote;
+	}
+	return _doorbell_remote;
+}
+
+
+Lx_sd Native_thread::Epoll::poll(bool const block)
 {
 	for (;;) {
 		epoll_event events[1] { };
 
-		int const event_count = lx_epoll_wait(_epoll, events, 1, -1);
+		int const event_count = lx_epoll_wait(_epoll, events, 1, block ? -1 : 0);
+
+		if (!block && event_count == 0)
+			return Lx_sd::invalid();
 
 		if ((event_count == 1) && (events[0].events == POLLIN)) {
 
@@ -112,6 +154,12 @@ Lx_sd Native_thread::Epoll::poll()
 				continue;
 			}
 
+			/* let the caller look for requests posted to rings */
+			if (sd.value == _doorbell_local.value) {
+				_drain_doorbell();
+				return Lx_sd::invalid();
+			}
+
 			return sd;
 		}
 
@@ -205,5 +253,8 @@ void Native_thread::Epoll::free_rpc_cap(Native_capability cap)
 {
 	int const local_socket = (int)Capability_space::ipc_cap_data(cap).rpc_obj_key.value();
 
-	_exec_control([&] () { _remove(Lx_sd{local_socket}); });
+	_exec_control([&] () {
+		_remove(Lx_sd{local_socket});
+		rings.discard((unsigned long)local_socket);
+	});
 }
@@ -219,6 +219,13 @@ namespace Genode {
 			 * Return execution time consumed by the thread
 			 */
 			Trace::Execution_time execution_time() const;
+
+			/**
+			 * Return hardware performance-counter readings of the thread
+			 *
+			 * Not supported on this kernel.
+			 */
+			Trace::Performance_counters performance_counters() const { return { }; }
 	};
 }
 
@@ -169,6 +169,7 @@ void Rpc_entrypoint::_activation_entry()
 		catch (Blocking_canceled) { }
 	};
 	ep.apply(id_pt, lambda);
+	ep._requests.add(1);
 
 	if (!rcv_window.prepare_rcv_window(*(Nova::Utcb *)ep.utcb()))
 		warning("out of capability selectors for handling server requests");
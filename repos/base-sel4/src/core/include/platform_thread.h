@@ -138,6 +138,13 @@ class Genode::Platform_thread : public List<Platform_thread>::Element
 		 */
 		Trace::Execution_time execution_time() const;
 
+		/**
+		 * Return hardware performance-counter readings of the thread
+		 *
+		 * Not supported on this kernel.
+		 */
+		Trace::Performance_counters performance_counters() const { return { }; }
+
 
 		/************************
 		 ** Accessor functions **
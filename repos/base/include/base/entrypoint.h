@@ -20,6 +20,7 @@
 #include <base/signal.h>
 #include <base/thread.h>
 #include <base/mutex.h>
+#include <trace/probe.h>
 
 namespace Genode {
 	class Startup;
@@ -49,6 +50,22 @@ class Genode::Entrypoint : Noncopyable
 			virtual void handle_io_progress() = 0;
 		};
 
+		/**
+		 * Counters of the entrypoint
+		 *
+		 * The counters are updated by the entrypoint thread without
+		 * synchronization and are meant for diagnostic purposes. The idle
+		 * time is accounted in trace-timestamp ticks while the entrypoint
+		 * is traced only.
+		 */
+		struct Stats
+		{
+			unsigned long    rpcs;            /* RPC requests except signals */
+			unsigned long    signal_wakeups;  /* signal deliveries via proxy */
+			unsigned long    signals;         /* dispatched signals          */
+			Trace::Timestamp idle;
+		};
+
 	private:
 
 		struct Signal_proxy : Interface
@@ -107,6 +124,10 @@ class Genode::Entrypoint : Noncopyable
 
 		Io_progress_handler *_io_progress_handler { nullptr };
 
+		unsigned       _signal_batch_limit { 1 };
+		Trace::Counter _signal_wakeups     { "ep signal wakeups" };
+		Trace::Counter _signals            { "ep signals" };
+
 		void _handle_io_progress()
 		{
 			if (_io_progress_handler != nullptr)
@@ -123,6 +144,7 @@ class Genode::Entrypoint : Noncopyable
 		Constructible<Genode::Signal_handler<Entrypoint> > _suspend_dispatcher { };
 
 		void _dispatch_signal(Signal &sig);
+		bool _dispatch_pending_signals();
 		void _defer_signal(Signal &sig);
 		void _process_deferred_signals();
 		void _process_incoming_signals();
@@ -238,6 +260,32 @@ class Genode::Entrypoint : Noncopyable
 			}
 			_io_progress_handler = &handler;
 		}
+
+		/**
+		 * Set the maximum number of signals dispatched per signal wakeup
+		 *
+		 * By default, the entrypoint dispatches a single signal per wakeup
+		 * to ensure fairness between RPCs and signals. Servers that are hit
+		 * by many signals, e.g., packet-stream wakeups, may trade some
+		 * fairness for fewer wakeups by dispatching all pending signals up
+		 * to the given limit at once. The I/O-progress handler is called
+		 * once per batch.
+		 */
+		void signal_batch_limit(unsigned limit)
+		{
+			_signal_batch_limit = max(1U, limit);
+		}
+
+		Stats stats() const
+		{
+			unsigned long const requests = _rpc_ep->requests();
+
+			return Stats {
+				.rpcs           = requests - min(requests, _signal_wakeups.value()),
+				.signal_wakeups = _signal_wakeups.value(),
+				.signals        = _signals.value(),
+				.idle           = _rpc_ep->idle_time() };
+		}
 };
 
 #endif /* _INCLUDE__BASE__ENTRYPOINT_H_ */
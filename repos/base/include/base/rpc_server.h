@@ -21,6 +21,7 @@
 #include <base/blockade.h>
 #include <base/log.h>
 #include <base/trace/events.h>
+#include <trace/probe.h>
 #include <pd_session/pd_session.h>
 
 namespace Genode {
@@ -309,6 +310,12 @@ class Genode::Rpc_entrypoint : Thread, public Object_pool<Rpc_object_base>
 		Msgbuf<SND_BUF_SIZE> _snd_buf { };
 		Msgbuf<RCV_BUF_SIZE> _rcv_buf { };
 
+		/*
+		 * Request statistics, updated by the entrypoint thread only
+		 */
+		Trace::Counter   _requests { "rpc requests" };
+		Trace::Timestamp _idle     { 0 };
+
 		/**
 		 * Hook to let low-level thread init code access private members
 		 *
@@ -443,6 +450,19 @@ class Genode::Rpc_entrypoint : Thread, public Object_pool<Rpc_object_base>
 		 */
 		Untyped_capability reply_dst() { return _caller; }
 
+		/**
+		 * Return number of dispatched requests
+		 */
+		unsigned long requests() const { return _requests.value(); }
+
+		/**
+		 * Return time spent waiting for requests in trace-timestamp ticks
+		 *
+		 * The idle time is accounted only while the entrypoint thread is
+		 * traced to keep the reading of the timestamp off the common path.
+		 */
+		Trace::Timestamp idle_time() const { return _idle; }
+
 		/**
 		 * Prevent reply of current request
 		 *
@@ -132,6 +132,8 @@ struct Genode::Trace::Checkpoint
 		OBJ_NEW   = 0x10,
 		OBJ_DEL   = 0x11,
 		OBJ_STATE = 0x12,
+		COUNTER   = 0x20,
+		GAUGE     = 0x21,
 		EXCEPTION = 0xfe,
 		FAILURE   = 0xff
 	};
@@ -42,6 +42,13 @@ struct Genode::Trace::Logger
 		size_t             max_event_size { 0 };
 		bool               pending_init   { false };
 
+		/*
+		 * Number of loggers of the component with tracing enabled
+		 */
+		static int volatile _num_enabled;
+
+		void _enabled(bool);
+
 		bool _evaluate_control();
 
 		/*
@@ -54,6 +61,17 @@ struct Genode::Trace::Logger
 
 		Logger();
 
+		~Logger();
+
+		/**
+		 * Return true if tracing is enabled for any thread of the component
+		 *
+		 * This check allows instrumentation probes to skip the generation of
+		 * events with a single branch while no thread is traced. Whether the
+		 * calling thread is traced is still evaluated by 'log'.
+		 */
+		static bool enabled_in_component() { return _num_enabled != 0; }
+
 		bool initialized() { return control != 0; }
 
 		bool init_pending() { return pending_init; }
@@ -41,6 +41,8 @@ namespace Genode { namespace Trace {
 	struct Subject_id;
 	struct Execution_time;
 	struct Subject_info;
+	struct Subject_delta;
+	struct Performance_counters;
 } }
 
 
@@ -100,6 +102,23 @@ struct Genode::Trace::Execution_time
 };
 
 
+/**
+ * Hardware performance-counter readings of a trace subject
+ *
+ * The counters accumulate the events caused by the thread in user mode since
+ * the counters were first requested. Counters not supported by the kernel or
+ * the CPU are reported as 0. If the kernel does not support performance
+ * counters at all, 'valid' is false.
+ */
+struct Genode::Trace::Performance_counters
+{
+	bool     valid        = false;
+	uint64_t cycles       = 0;
+	uint64_t instructions = 0;
+	uint64_t llc_misses   = 0;
+};
+
+
 /**
  * Subject information
  */
@@ -155,4 +174,26 @@ class Genode::Trace::Subject_info
 		Affinity::Location   affinity()       const { return _affinity; }
 };
 
+
+
+/**
+ * Compact record of a subject reported by the delta query of a TRACE session
+ *
+ * In contrast to 'Subject_info', the record lacks the session label and
+ * thread name, which never change during the lifetime of a subject.
+ */
+struct Genode::Trace::Subject_delta
+{
+	Subject_id          id             { };
+	Subject_info::State state          { Subject_info::INVALID };
+	Policy_id           policy_id      { };
+	Execution_time      execution_time { };
+	Affinity::Location  affinity       { };
+
+	/*
+	 * True if the subject is reported for the first time
+	 */
+	bool added = false;
+};
+
 #endif /* _INCLUDE__BASE__TRACE__TYPES_H_ */
@@ -4,6 +4,12 @@
  * \date   2021-12-01
  *
  * Convenience macros for creating user-defined trace checkpoints.
+ *
+ * The probes are meant to stay in hot paths. While no thread of the component
+ * is traced, a probe costs a single branch. Tracing is enabled per thread via
+ * the TRACE session. A thread notices the change with its next trace event,
+ * e.g., an RPC or a signal, from which point on the probes emit checkpoints
+ * through the thread's trace policy.
  */
 
 /*
@@ -20,12 +26,21 @@
 
 namespace Genode { namespace Trace {
 
+	/**
+	 * Return true if probes must generate events
+	 */
+	static inline bool probes_enabled()
+	{
+		return __builtin_expect(Logger::enabled_in_component(), false);
+	}
+
 	class Duration
 	{
 		private:
 
 			char          const *_name;
 			unsigned long const  _data;
+			bool          const  _enabled { probes_enabled() };
 
 			Duration(Duration const &) = delete;
 
@@ -35,10 +50,49 @@ namespace Genode { namespace Trace {
 
 			Duration(char const * name, unsigned long data)
 			: _name(name), _data(data)
-			{ Checkpoint(_name, _data, nullptr, Checkpoint::Type::START); }
+			{
+				if (_enabled)
+					Checkpoint(_name, _data, nullptr, Checkpoint::Type::START);
+			}
 
 			~Duration()
-			{ Checkpoint(_name, _data, nullptr, Checkpoint::Type::END); }
+			{
+				if (_enabled)
+					Checkpoint(_name, _data, nullptr, Checkpoint::Type::END);
+			}
+	};
+
+	/**
+	 * Monotonic counter
+	 *
+	 * The counter is incremented regardless of tracing. Its value is
+	 * emitted whenever it changes while tracing is enabled. The counter is
+	 * not synchronized and meant to be used by a single thread.
+	 */
+	class Counter
+	{
+		private:
+
+			char const   *_name;
+			unsigned long _value = 0;
+
+			Counter(Counter const &) = delete;
+
+			Counter & operator = (Counter const &) = delete;
+
+		public:
+
+			Counter(char const *name) : _name(name) { }
+
+			void add(unsigned long increment)
+			{
+				_value += increment;
+
+				if (probes_enabled())
+					Checkpoint(_name, _value, nullptr, Checkpoint::Type::COUNTER);
+			}
+
+			unsigned long value() const { return _value; }
 	};
 
 } }
@@ -50,7 +104,8 @@ namespace Genode { namespace Trace {
  * The argument 'data' specifies the payload as an unsigned value.
  */
 #define GENODE_TRACE_CHECKPOINT(data) \
-	Genode::Trace::Checkpoint(__PRETTY_FUNCTION__, (unsigned long)data, nullptr);
+	{ if (Genode::Trace::probes_enabled()) \
+		Genode::Trace::Checkpoint(__PRETTY_FUNCTION__, (unsigned long)data, nullptr); }
 
 
 /**
@@ -60,7 +115,8 @@ namespace Genode { namespace Trace {
  * The argument 'name' specifies the name of the checkpoint.
  */
 #define GENODE_TRACE_CHECKPOINT_NAMED(data, name) \
-	Genode::Trace::Checkpoint(name, (unsigned long)data, nullptr);
+	{ if (Genode::Trace::probes_enabled()) \
+		Genode::Trace::Checkpoint(name, (unsigned long)data, nullptr); }
 
 
 /**
@@ -82,4 +138,27 @@ namespace Genode { namespace Trace {
 	Genode::Trace::Duration duration(name, (unsigned long)data);
 
 
+/**
+ * Increment a monotonic counter and trace its new value.
+ *
+ * There is one counter per macro invocation. The argument 'name' specifies
+ * the name of the checkpoint and 'inc' the increment.
+ */
+#define GENODE_TRACE_COUNTER(name, inc) \
+	{ static Genode::Trace::Counter counter(name); counter.add((unsigned long)inc); }
+
+
+/**
+ * Trace the current value of a quantity, e.g., a queue length.
+ *
+ * The argument 'name' specifies the name of the checkpoint and 'value' the
+ * value as unsigned number. The value is evaluated only if tracing is
+ * enabled.
+ */
+#define GENODE_TRACE_GAUGE(name, value) \
+	{ if (Genode::Trace::probes_enabled()) \
+		Genode::Trace::Checkpoint(name, (unsigned long)(value), nullptr, \
+		                          Genode::Trace::Checkpoint::Type::GAUGE); }
+
+
 #endif /* _INCLUDE__TRACE__PROBE_H_ */
@@ -60,6 +60,19 @@ struct Genode::Trace::Session_client : Genode::Rpc_client<Genode::Trace::Session
 
 		Argument_buffer _argument_buffer;
 
+		/* generation of the most recent delta query */
+		unsigned long _delta_generation { 0 };
+
+		size_t _max_subject_infos() const
+		{
+			return _argument_buffer.size / (sizeof(Subject_info) + sizeof(Subject_id));
+		}
+
+		size_t _max_performance_counters() const
+		{
+			return _argument_buffer.size / (sizeof(Performance_counters) + sizeof(Subject_id));
+		}
+
 	public:
 
 		/**
@@ -92,7 +105,7 @@ struct Genode::Trace::Session_client : Genode::Rpc_client<Genode::Trace::Session
 		For_each_subject_info_result for_each_subject_info(FN const &fn)
 		{
 			size_t const num_subjects = call<Rpc_subject_infos>();
-			size_t const max_subjects = _argument_buffer.size / (sizeof(Subject_info) + sizeof(Subject_id));
+			size_t const max_subjects = _max_subject_infos();
 
 			Subject_info * const infos = reinterpret_cast<Subject_info *>(_argument_buffer.base);
 			Subject_id   * const ids   = reinterpret_cast<Subject_id *>(infos + max_subjects);
@@ -104,6 +117,71 @@ struct Genode::Trace::Session_client : Genode::Rpc_client<Genode::Trace::Session
 			return { .count = num_subjects, .limit = max_subjects };
 		}
 
+		/**
+		 * Call 'fn' for each subject added or changed since the previous call
+		 *
+		 * Only subjects whose state, policy, execution time, or affinity
+		 * changed are reported, each as compact 'Subject_delta' record.
+		 * If the result reaches the limit, further changed subjects are
+		 * reported by the next call.
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		template <typename FN>
+		For_each_subject_info_result for_each_subject_delta(FN const &fn)
+		{
+			Delta_result const result = call<Rpc_subject_deltas>(_delta_generation);
+
+			_delta_generation = result.generation;
+
+			size_t const max_deltas = _argument_buffer.size / sizeof(Subject_delta);
+
+			Subject_delta const * const deltas =
+				reinterpret_cast<Subject_delta const *>(_argument_buffer.base);
+
+			for (unsigned i = 0; i < result.count; i++)
+				fn(deltas[i]);
+
+			return { .count = result.count, .limit = max_deltas };
+		}
+
+		/**
+		 * Call 'fn' with the 'Subject_info' of each subject of the given list
+		 *
+		 * This function complements 'for_each_subject_delta' to obtain the
+		 * session label and thread name of newly added subjects. IDs of
+		 * subjects that no longer exist yield an 'INVALID' subject info.
+		 *
+		 * \return number of obtained subject infos
+		 */
+		template <typename FN>
+		size_t for_each_subject_info(Subject_id const *ids, size_t num_ids,
+		                             FN const &fn)
+		{
+			size_t const max_subjects = _max_subject_infos();
+
+			Subject_info * const infos   = reinterpret_cast<Subject_info *>(_argument_buffer.base);
+			Subject_id   * const arg_ids = reinterpret_cast<Subject_id *>(infos + max_subjects);
+
+			size_t done = 0;
+			while (done < num_ids && max_subjects) {
+
+				size_t const batch = min(num_ids - done, max_subjects);
+
+				for (size_t i = 0; i < batch; i++)
+					arg_ids[i] = ids[done + i];
+
+				size_t const count = call<Rpc_subject_infos_by_id>(batch);
+
+				for (size_t i = 0; i < count; i++)
+					fn(arg_ids[i], infos[i]);
+
+				done += batch;
+			}
+			return done;
+		}
+
 		Policy_id alloc_policy(size_t size) override {
 			return call<Rpc_alloc_policy>(size); }
 
@@ -127,6 +205,47 @@ struct Genode::Trace::Session_client : Genode::Rpc_client<Genode::Trace::Session
 
 		void free(Subject_id subject) override {
 			call<Rpc_free>(subject); }
+
+		Performance_counters performance_counters(Subject_id subject) override {
+			return call<Rpc_performance_counters>(subject); }
+
+		/**
+		 * Call 'fn' with the performance counters of each subject of the list
+		 *
+		 * In contrast to 'performance_counters', the counters of many
+		 * subjects are obtained with one RPC. IDs of subjects that no longer
+		 * exist yield invalid counters.
+		 *
+		 * \return number of obtained readings
+		 */
+		template <typename FN>
+		size_t for_each_performance_counters(Subject_id const *ids, size_t num_ids,
+		                                     FN const &fn)
+		{
+			size_t const max_subjects = _max_performance_counters();
+
+			Performance_counters * const counters =
+				reinterpret_cast<Performance_counters *>(_argument_buffer.base);
+			Subject_id * const arg_ids =
+				reinterpret_cast<Subject_id *>(counters + max_subjects);
+
+			size_t done = 0;
+			while (done < num_ids && max_subjects) {
+
+				size_t const batch = min(num_ids - done, max_subjects);
+
+				for (size_t i = 0; i < batch; i++)
+					arg_ids[i] = ids[done + i];
+
+				size_t const count = call<Rpc_performance_counters_by_id>(batch);
+
+				for (size_t i = 0; i < count; i++)
+					fn(arg_ids[i], counters[i]);
+
+				done += batch;
+			}
+			return done;
+		}
 };
 
 #endif /* _INCLUDE__TRACE_SESSION__CLIENT_H_ */
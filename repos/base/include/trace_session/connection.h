@@ -68,6 +68,20 @@ struct Genode::Trace::Connection : Genode::Connection<Genode::Trace::Session>,
 		return _retry([&] () {
 			return Session_client::for_each_subject_info(fn); });
 	}
+
+	template <typename FN>
+	For_each_subject_info_result for_each_subject_delta(FN const &fn)
+	{
+		return _retry([&] () {
+			return Session_client::for_each_subject_delta(fn); });
+	}
+
+	template <typename FN>
+	size_t for_each_subject_info(Subject_id const *ids, size_t num_ids,
+	                             FN const &fn)
+	{
+		return Session_client::for_each_subject_info(ids, num_ids, fn);
+	}
 };
 
 #endif /* _INCLUDE__TRACE_SESSION__CONNECTION_H_ */
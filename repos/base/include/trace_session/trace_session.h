@@ -31,6 +31,15 @@ struct Genode::Trace::Session : Genode::Session
 
 	enum { CAP_QUOTA = 6 };
 
+	/**
+	 * Result of the query of subjects changed since the previous query
+	 */
+	struct Delta_result
+	{
+		unsigned long generation;
+		size_t        count;
+	};
+
 	/**
 	 * Allocate policy-module backing store
 	 *
@@ -96,6 +105,15 @@ struct Genode::Trace::Session : Genode::Session
 	 */
 	virtual void free(Subject_id) = 0;
 
+	/**
+	 * Obtain hardware performance-counter readings of a subject
+	 *
+	 * The counters are enabled by the first request for the subject.
+	 *
+	 * \throw Nonexistent_subject
+	 */
+	virtual Performance_counters performance_counters(Subject_id) = 0;
+
 	virtual ~Session() { }
 
 
@@ -127,16 +145,27 @@ struct Genode::Trace::Session : Genode::Session
 	                 GENODE_TYPE_LIST(Out_of_ram, Out_of_caps));
 	GENODE_RPC_THROW(Rpc_subject_infos, size_t, subject_infos,
 	                 GENODE_TYPE_LIST(Out_of_ram, Out_of_caps));
+	GENODE_RPC_THROW(Rpc_subject_deltas, Delta_result, subject_deltas,
+	                 GENODE_TYPE_LIST(Out_of_ram, Out_of_caps),
+	                 unsigned long);
+	GENODE_RPC(Rpc_subject_infos_by_id, size_t, subject_infos_by_id, size_t);
 	GENODE_RPC_THROW(Rpc_buffer, Dataspace_capability, buffer,
 	                 GENODE_TYPE_LIST(Nonexistent_subject, Subject_not_traced),
 	                 Subject_id);
 	GENODE_RPC_THROW(Rpc_free, void, free,
 	                 GENODE_TYPE_LIST(Nonexistent_subject), Subject_id);
+	GENODE_RPC_THROW(Rpc_performance_counters, Performance_counters,
+	                 performance_counters,
+	                 GENODE_TYPE_LIST(Nonexistent_subject), Subject_id);
+	GENODE_RPC(Rpc_performance_counters_by_id, size_t,
+	           performance_counters_by_id, size_t);
 
 	GENODE_RPC_INTERFACE(Rpc_dataspace, Rpc_alloc_policy, Rpc_policy,
 	                     Rpc_unload_policy, Rpc_trace, Rpc_pause,
 	                     Rpc_resume, Rpc_subjects, Rpc_buffer,
-	                     Rpc_free, Rpc_subject_infos);
+	                     Rpc_free, Rpc_subject_infos, Rpc_subject_deltas,
+	                     Rpc_subject_infos_by_id, Rpc_performance_counters,
+	                     Rpc_performance_counters_by_id);
 };
 
 #endif /* _INCLUDE__TRACE_SESSION__TRACE_SESSION_H_ */
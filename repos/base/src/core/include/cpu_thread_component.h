@@ -195,6 +195,11 @@ class Genode::Cpu_thread_component : public  Rpc_object<Cpu_thread>,
 			         _platform_thread.affinity() };
 		}
 
+		Trace::Performance_counters trace_performance_counters() const override
+		{
+			return _platform_thread.performance_counters();
+		}
+
 
 		/************************
 		 ** Accessor functions **
@@ -73,6 +73,9 @@ class Genode::Trace::Session_component
 		Dataspace_capability dataspace();
 		size_t subjects();
 		size_t subject_infos();
+		Delta_result subject_deltas(unsigned long);
+		size_t subject_infos_by_id(size_t);
+		size_t performance_counters_by_id(size_t);
 
 		Policy_id alloc_policy(size_t) override;
 		Dataspace_capability policy(Policy_id) override;
@@ -82,6 +85,7 @@ class Genode::Trace::Session_component
 		void resume(Subject_id) override;
 		Dataspace_capability buffer(Subject_id) override;
 		void free(Subject_id) override;
+		Performance_counters performance_counters(Subject_id) override;
 };
 
 #endif /* _CORE__INCLUDE__TRACE__SESSION_COMPONENT_H_ */
@@ -64,6 +64,15 @@ class Genode::Trace::Source
 		struct Info_accessor : Interface
 		{
 			virtual Info trace_source_info() const = 0;
+
+			/**
+			 * Return hardware performance-counter readings
+			 *
+			 * Sources without support for performance counters keep the
+			 * default implementation.
+			 */
+			virtual Performance_counters trace_performance_counters() const {
+				return Performance_counters { }; }
 		};
 
 	private:
@@ -102,6 +111,9 @@ class Genode::Trace::Source
 
 		Info const info() const { return _info.trace_source_info(); }
 
+		Performance_counters performance_counters() const {
+			return _info.trace_performance_counters(); }
+
 		void trace(Dataspace_capability policy, Dataspace_capability buffer)
 		{
 			_buffer = buffer;
@@ -27,6 +27,7 @@
 #include <base/env.h>
 #include <base/weak_ptr.h>
 #include <dataspace/client.h>
+#include <trace_session/trace_session.h>
 
 /* core includes */
 #include <trace/source_registry.h>
@@ -148,6 +149,47 @@ class Genode::Trace::Subject
 		Policy_id           _policy_id { };
 		size_t              _allocated_memory { 0 };
 
+		/*
+		 * State reported by the most recent delta query, used to detect
+		 * changes
+		 */
+		struct Reported
+		{
+			bool                valid { false };
+			Subject_info::State state { Subject_info::INVALID };
+			Policy_id           policy_id { };
+			Execution_time      execution_time { };
+			Affinity::Location  affinity { };
+
+			bool differs(Subject_delta const &d) const
+			{
+				Execution_time     const &t = d.execution_time;
+				Affinity::Location const &a = d.affinity;
+
+				return !valid
+				    || state                         != d.state
+				    || !(policy_id                   == d.policy_id)
+				    || execution_time.thread_context != t.thread_context
+				    || execution_time.scheduling_context != t.scheduling_context
+				    || execution_time.quantum        != t.quantum
+				    || execution_time.priority       != t.priority
+				    || affinity.xpos()   != a.xpos()  || affinity.ypos()   != a.ypos()
+				    || affinity.width()  != a.width() || affinity.height() != a.height();
+			}
+		} _reported { };
+
+		void _source_info(Execution_time &execution_time,
+		                  Affinity::Location &affinity)
+		{
+			Locked_ptr<Source> source(_source);
+
+			if (source.valid()) {
+				Trace::Source::Info const info = source->info();
+				execution_time = info.execution_time;
+				affinity       = info.affinity;
+			}
+		}
+
 		Subject_info::State _state()
 		{
 			Locked_ptr<Source> source(_source);
@@ -280,25 +322,61 @@ class Genode::Trace::Subject
 			source->enable();
 		}
 
+		Performance_counters performance_counters()
+		{
+			Locked_ptr<Source> source(_source);
+
+			if (!source.valid())
+				return Performance_counters { };
+
+			return source->performance_counters();
+		}
+
 		Subject_info info()
 		{
 			Execution_time execution_time;
 			Affinity::Location affinity;
 
-			{
-				Locked_ptr<Source> source(_source);
-
-				if (source.valid()) {
-					Trace::Source::Info const info = source->info();
-					execution_time = info.execution_time;
-					affinity       = info.affinity;
-				}
-			}
+			_source_info(execution_time, affinity);
 
 			return Subject_info(_label, _name, _state(), _policy_id,
 			                    execution_time, affinity);
 		}
 
+		/**
+		 * Determine compact info if changed since the last reported delta
+		 *
+		 * \return  true if 'delta' was filled in, which marks the current
+		 *          state as reported
+		 */
+		bool delta(Subject_delta &delta)
+		{
+			Subject_delta current { };
+
+			current.id        = _id;
+			current.state     = _state();
+			current.policy_id = _policy_id;
+			current.added     = !_reported.valid;
+
+			_source_info(current.execution_time, current.affinity);
+
+			if (!_reported.differs(current))
+				return false;
+
+			delta     = current;
+			_reported = Reported { .valid          = true,
+			                       .state          = current.state,
+			                       .policy_id      = current.policy_id,
+			                       .execution_time = current.execution_time,
+			                       .affinity       = current.affinity };
+			return true;
+		}
+
+		/**
+		 * Forget reported state, the subject is reported as added again
+		 */
+		void reset_reported() { _reported = Reported { }; }
+
 		Dataspace_capability buffer() const { return _buffer.dataspace(); }
 
 		size_t release()
@@ -332,6 +410,13 @@ class Genode::Trace::Subject_registry
 		Mutex            _mutex   { };
 		Subjects         _entries { };
 
+		/* number of delta queries */
+		unsigned long    _delta_generation { 0 };
+
+		/* last subject reported by a delta query that filled the buffer */
+		Subject_id       _delta_resume    { };
+		bool             _delta_truncated { false };
+
 		/**
 		 * Functor for testing the existance of subjects for a given source
 		 *
@@ -403,6 +488,37 @@ class Genode::Trace::Subject_registry
 			throw Nonexistent_subject();
 		}
 
+		/**
+		 * Call 'fn' with the index and subject (or nullptr) of each ID
+		 */
+		template <typename FN>
+		void _unsynchronized_for_each_id(Subject_id const * const ids,
+		                                 size_t const len, FN const &fn)
+		{
+			/*
+			 * The IDs are usually requested in the order reported by
+			 * 'deltas', so the search continues at the previous match.
+			 */
+			Subject *s = _entries.first();
+
+			for (size_t i = 0; i < len; i++) {
+
+				Subject *match = nullptr;
+				for (Subject *t = s; t && !match; t = t->next())
+					if (t->id() == ids[i])
+						match = t;
+
+				for (Subject *t = _entries.first(); t != s && !match; t = t->next())
+					if (t->id() == ids[i])
+						match = t;
+
+				fn(i, match);
+
+				if (match)
+					s = match;
+			}
+		}
+
 	public:
 
 		/**
@@ -469,6 +585,83 @@ class Genode::Trace::Subject_registry
 			return i;
 		}
 
+		/**
+		 * Retrieve compact infos of subjects changed since the last query
+		 *
+		 * \param generation  generation returned by the previous query,
+		 *                    a mismatch indicates that the caller lost track
+		 *                    and needs a report of all subjects
+		 */
+		Session::Delta_result deltas(unsigned long generation,
+		                             Subject_delta * const dst, size_t const len)
+		{
+			Mutex::Guard guard(_mutex);
+
+			if (generation != _delta_generation)
+				for (Subject *s = _entries.first(); s; s = s->next())
+					s->reset_reported();
+
+			/*
+			 * Subjects that do not fit into 'dst' stay unreported and are
+			 * picked up by the next query, which resumes after the last
+			 * reported subject. Otherwise, frequently changing subjects at
+			 * the front of the list would starve the others.
+			 */
+			Subject *start = _entries.first();
+			if (_delta_truncated)
+				for (Subject *s = _entries.first(); s; s = s->next())
+					if (s->id() == _delta_resume) {
+						start = s->next() ? s->next() : _entries.first();
+						break;
+					}
+
+			size_t i = 0;
+			for (Subject *s = start; s && i < len; ) {
+
+				if (s->delta(dst[i])) {
+					_delta_resume = s->id();
+					i++;
+				}
+
+				s = s->next() ? s->next() : _entries.first();
+				if (s == start)
+					break;
+			}
+
+			_delta_truncated = (i == len);
+
+			return { .generation = ++_delta_generation, .count = i };
+		}
+
+		/**
+		 * Retrieve Subject_infos of the specified subjects
+		 */
+		size_t subjects(Subject_id const * const ids, Subject_info * const dst,
+		                size_t const len)
+		{
+			Mutex::Guard guard(_mutex);
+
+			_unsynchronized_for_each_id(ids, len, [&] (size_t i, Subject *s) {
+				dst[i] = s ? s->info() : Subject_info(); });
+
+			return len;
+		}
+
+		/**
+		 * Retrieve performance counters of the specified subjects
+		 */
+		size_t performance_counters(Subject_id const * const ids,
+		                            Performance_counters * const dst,
+		                            size_t const len)
+		{
+			Mutex::Guard guard(_mutex);
+
+			_unsynchronized_for_each_id(ids, len, [&] (size_t i, Subject *s) {
+				dst[i] = s ? s->performance_counters() : Performance_counters(); });
+
+			return len;
+		}
+
 		/**
 		 * Remove subject and release resources
 		 *
@@ -48,6 +48,38 @@ size_t Session_component::subject_infos()
 }
 
 
+Trace::Session::Delta_result Session_component::subject_deltas(unsigned long generation)
+{
+	_subjects.import_new_sources(_sources);
+
+	return _subjects.deltas(generation,
+	                        _argument_buffer.local_addr<Subject_delta>(),
+	                        _argument_buffer.size()/sizeof(Subject_delta));
+}
+
+
+size_t Session_component::subject_infos_by_id(size_t num_ids)
+{
+	size_t const count  = _argument_buffer.size() / (sizeof(Subject_info) + sizeof(Subject_id));
+	Subject_info *infos = _argument_buffer.local_addr<Subject_info>();
+	Subject_id   *ids   = reinterpret_cast<Subject_id *>(infos + count);
+
+	return _subjects.subjects(ids, infos, min(num_ids, count));
+}
+
+
+size_t Session_component::performance_counters_by_id(size_t num_ids)
+{
+	size_t const count = _argument_buffer.size()
+	                   / (sizeof(Performance_counters) + sizeof(Subject_id));
+
+	Performance_counters *counters = _argument_buffer.local_addr<Performance_counters>();
+	Subject_id           *ids      = reinterpret_cast<Subject_id *>(counters + count);
+
+	return _subjects.performance_counters(ids, counters, min(num_ids, count));
+}
+
+
 Policy_id Session_component::alloc_policy(size_t size)
 {
 	if (size > _argument_buffer.size())
@@ -153,6 +185,12 @@ void Session_component::free(Subject_id subject_id)
 }
 
 
+Performance_counters Session_component::performance_counters(Subject_id subject_id)
+{
+	return _subjects.lookup_by_id(subject_id).performance_counters();
+}
+
+
 Session_component::Session_component(Rpc_entrypoint  &ep,
                                      Resources const &resources,
                                      Label     const &label,
@@ -48,18 +48,37 @@ void Entrypoint::Signal_proxy_component::signal()
 
 	ep._process_deferred_signals();
 
-	bool io_progress = false;
+	if (ep._dispatch_pending_signals())
+		ep._handle_io_progress();
+}
+
+
+bool Entrypoint::_dispatch_pending_signals()
+{
+	bool     io_progress = false;
+	unsigned count       = 0;
 
 	/*
-	 * Try to dispatch one pending signal picked-up by the signal-proxy thread.
-	 * Note, we handle only one signal here to ensure fairness between RPCs and
-	 * signals.
+	 * Dispatch pending signals picked-up by the signal-proxy thread. By
+	 * default, we handle only one signal here to ensure fairness between RPCs
+	 * and signals. With a signal-batch limit set, all pending signals up to
+	 * the limit are dispatched within one wakeup.
+	 *
+	 * Repeated submissions to one context are coalesced by the signal
+	 * receiver, which keeps each context pending at most once and merely
+	 * counts the submissions. Note that each signal is dispatched before the
+	 * next one is fetched. Holding a signal while dispatching another one
+	 * would block the dissolution of its context by the handler.
 	 */
+	while (count < _signal_batch_limit) {
 
-	Signal sig = ep._sig_rec->pending_signal();
+		Signal sig = _sig_rec->pending_signal();
 
-	if (sig.valid()) {
-		ep._dispatch_signal(sig);
+		if (!sig.valid())
+			break;
+
+		_dispatch_signal(sig);
+		count++;
 
 		if (sig.context()->level() == Signal_context::Level::Io) {
 			/* trigger the progress handler */
@@ -67,8 +86,13 @@ void Entrypoint::Signal_proxy_component::signal()
 		}
 	}
 
-	if (io_progress)
-		ep._handle_io_progress();
+	_signal_wakeups.add(1);
+	if (count)
+		_signals.add(count);
+
+	GENODE_TRACE_GAUGE("ep signals per wakeup", count);
+
+	return io_progress;
 }
 
 
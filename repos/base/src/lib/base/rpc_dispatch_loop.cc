@@ -54,9 +54,19 @@ void Rpc_entrypoint::entry()
 
 	while (!_exit_handler.exit) {
 
+		bool             const traced = Trace::probes_enabled();
+		Trace::Timestamp const start  = traced ? Trace::timestamp() : 0;
+
 		Rpc_request const request = ipc_reply_wait(_caller, exc, _snd_buf, _rcv_buf);
 		_caller = request.caller;
 
+		if (traced) {
+			Trace::Timestamp const idle = Trace::timestamp() - start;
+			_idle += idle;
+			GENODE_TRACE_GAUGE("rpc idle", idle);
+		}
+		_requests.add(1);
+
 		Ipc_unmarshaller unmarshaller(_rcv_buf);
 		Rpc_opcode opcode(0);
 		unmarshaller.extract(opcode);
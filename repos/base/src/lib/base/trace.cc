@@ -18,6 +18,7 @@
 #include <dataspace/client.h>
 #include <util/construct_at.h>
 #include <cpu_thread/client.h>
+#include <cpu/atomic.h>
 
 /* local includes */
 #include <base/internal/trace_control.h>
@@ -45,6 +46,25 @@ static Env &_env()
  ** Trace::Logger **
  *******************/
 
+int volatile Trace::Logger::_num_enabled = 0;
+
+
+void Trace::Logger::_enabled(bool value)
+{
+	if (value == enabled)
+		return;
+
+	enabled = value;
+
+	int const inc = value ? 1 : -1;
+	for (;;) {
+		int const old = _num_enabled;
+		if (cmpxchg(&_num_enabled, old, old + inc))
+			return;
+	}
+}
+
+
 bool Trace::Logger::_evaluate_control()
 {
 	/* check process-global and thread-specific tracing condition */
@@ -71,13 +91,13 @@ bool Trace::Logger::_evaluate_control()
 			}
 
 			/* inhibit generation of trace events */
-			enabled = false;
+			_enabled(false);
 			control->acknowledge_disabled();
 		}
 
 		else if (control->to_be_enabled()) {
 			control->acknowledge_enabled();
-			enabled = true;
+			_enabled(true);
 		}
 	}
 
@@ -93,7 +113,7 @@ bool Trace::Logger::_evaluate_control()
 		if (!policy_ds.valid()) {
 			warning("could not obtain trace policy");
 			control->error();
-			enabled = false;
+			_enabled(false);
 			return false;
 		}
 
@@ -125,7 +145,7 @@ bool Trace::Logger::_evaluate_control()
 		if (!buffer_ds.valid()) {
 			warning("could not obtain trace buffer");
 			control->error();
-			enabled = false;
+			_enabled(false);
 			return false;
 		}
 
@@ -187,6 +207,9 @@ void Trace::Logger::init(Thread_capability thread, Cpu_session *cpu_session,
 Trace::Logger::Logger() { }
 
 
+Trace::Logger::~Logger() { _enabled(false); }
+
+
 /************
  ** Thread **
  ************/
@@ -70,21 +70,26 @@ Trace::Simple_buffer &Trace::Partitioned_buffer::_switch_producer()
 	/* stops consumer from reading after switching */
 	_consumer_lock = SPINLOCK_LOCKED;
 
-	bool switched = false;
-	while (!switched) {
-		int const old_state = _state;
-
-		if (State::Producer::get(old_state) == State::Consumer::get(old_state))
-			switched = cmpxchg(&_state, old_state, State::toggle_producer(old_state));
-		else {
-			/**
-			 * consumer may still switch partitions at this point but not continue
-			 * reading until we set the new head entry
-			 */
-			_lost_entries += _producer()._num_entries;
-			switched = true;
-		}
-	}
+	/*
+	 * The producer attempts the switch only once so that it never spins on
+	 * the state word. If the attempt fails, the consumer has just switched
+	 * away from the producer's partition. In this case, the producer wraps
+	 * within its current partition, which is what a retry would have done.
+	 * The consumer does not read from its new partition before the consumer
+	 * lock is released.
+	 */
+	int const old_state = _state;
+
+	bool const switched =
+		State::Producer::get(old_state) == State::Consumer::get(old_state) &&
+		cmpxchg(&_state, old_state, State::toggle_producer(old_state));
+
+	/**
+	 * consumer may still switch partitions at this point but not continue
+	 * reading until we set the new head entry
+	 */
+	if (!switched)
+		_lost_entries += _producer()._num_entries;
 
 	Trace::Simple_buffer &current = _producer();
 
@@ -28,6 +28,7 @@ Linker::Dependency::Dependency(Env &env, Allocator &md_alloc,
 	_root(root),
 	_md_alloc(&md_alloc)
 {
+	invalidate_symbol_memo();
 	deps.enqueue(*this);
 	load_needed(env, *_md_alloc, deps, keep);
 }
@@ -35,6 +36,8 @@ Linker::Dependency::Dependency(Env &env, Allocator &md_alloc,
 
 Linker::Dependency::~Dependency()
 {
+	invalidate_symbol_memo();
+
 	if (!_unload_on_destruct)
 		return;
 
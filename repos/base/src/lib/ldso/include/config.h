@@ -49,6 +49,7 @@ class Linker::Config : Noncopyable
 
 		bool const _verbose     = _config.attribute_value("ld_verbose",     false);
 		bool const _check_ctors = _config.attribute_value("ld_check_ctors", true);
+		bool const _symbol_memo = _config.attribute_value("ld_symbol_memo", true);
 
 	public:
 
@@ -57,6 +58,7 @@ class Linker::Config : Noncopyable
 		Bind bind()        const { return _bind; }
 		bool verbose()     const { return _verbose; }
 		bool check_ctors() const { return _check_ctors; }
+		bool symbol_memo() const { return _symbol_memo; }
 
 		typedef String<100> Rom_name;
 
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2015-2019 Genode Labs GmbH
+ * Copyright (C) 2015-2026 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -20,6 +20,8 @@
 
 namespace Linker {
 	struct Hash_table;
+	struct Gnu_hash_table;
+	struct Symbol_hash;
 	struct Dynamic;
 }
 
@@ -53,6 +55,94 @@ struct Linker::Hash_table
 };
 
 
+/**
+ * GNU-style hash table (DT_GNU_HASH)
+ *
+ * In contrast to the System V table, the GNU table is preceded by a Bloom
+ * filter, which rejects most lookups of symbols not defined by the object
+ * without touching the hash chains. The chains store the hash values of the
+ * symbols, which spares the string comparison for all but the matching
+ * symbol. The lowest bit of a chain value marks the end of the chain.
+ */
+struct Linker::Gnu_hash_table
+{
+	enum { BLOOM_BITS = sizeof(Elf::Addr)*8 };
+
+	uint32_t nbuckets()    const { return ((uint32_t const *)this)[0]; }
+	uint32_t symoffset()   const { return ((uint32_t const *)this)[1]; }
+	uint32_t bloom_size()  const { return ((uint32_t const *)this)[2]; }
+	uint32_t bloom_shift() const { return ((uint32_t const *)this)[3]; }
+
+	Elf::Addr const *bloom() const {
+		return (Elf::Addr const *)((uint32_t const *)this + 4); }
+
+	uint32_t const *buckets() const {
+		return (uint32_t const *)(bloom() + bloom_size()); }
+
+	uint32_t const *chains() const { return buckets() + nbuckets(); }
+
+	/**
+	 * GNU hash function (Bernstein)
+	 */
+	static uint32_t hash(char const *name)
+	{
+		uint32_t h = 5381;
+		for (unsigned char const *p = (unsigned char const *)name; *p; p++)
+			h = (h << 5) + h + *p;
+		return h;
+	}
+
+	/**
+	 * Return false if the Bloom filter rules out a symbol with hash 'h'
+	 */
+	bool may_contain(uint32_t h) const
+	{
+		if (!bloom_size())
+			return true;
+
+		Elf::Addr const word = bloom()[(h / BLOOM_BITS) & (bloom_size() - 1)];
+		Elf::Addr const mask = ((Elf::Addr)1 << (h % BLOOM_BITS))
+		                     | ((Elf::Addr)1 << ((h >> bloom_shift()) % BLOOM_BITS));
+
+		return (word & mask) == mask;
+	}
+
+	/**
+	 * Return number of entries of the dynamic symbol table
+	 *
+	 * The GNU table does not state the size of the symbol table. It is
+	 * determined by the end of the last chain.
+	 */
+	unsigned long num_symbols() const
+	{
+		uint32_t last = 0;
+		for (uint32_t i = 0; i < nbuckets(); i++)
+			last = max(last, buckets()[i]);
+
+		if (last < symoffset())
+			return symoffset();
+
+		while (!(chains()[last - symoffset()] & 1))
+			last++;
+
+		return last + 1;
+	}
+};
+
+
+/**
+ * Hash values of a symbol name, computed once per lookup
+ */
+struct Linker::Symbol_hash
+{
+	unsigned long const elf;
+	uint32_t      const gnu;
+
+	Symbol_hash(char const *name)
+	: elf(Hash_table::hash(name)), gnu(Gnu_hash_table::hash(name)) { }
+};
+
+
 /**
  * .dynamic section entries
  */
@@ -94,6 +184,10 @@ class Linker::Dynamic
 		Allocator           *_md_alloc      = nullptr;
 
 		Hash_table          *_hash_table    = nullptr;
+		Gnu_hash_table      *_gnu_hash_table = nullptr;
+
+		/* number of symbols, determined on first use */
+		mutable unsigned long _num_symbols  = 0;
 
 		Elf::Rela           *_reloca        = nullptr;
 		unsigned long        _reloca_size   = 0;
@@ -158,6 +252,7 @@ class Linker::Dynamic
 				case DT_PLTRELSZ: _pltrel_size = d->un.val;                             break;
 				case DT_PLTGOT  : _section<typeof(_pltgot)>(&_pltgot, d);               break;
 				case DT_HASH    : _section<typeof(_hash_table)>(&_hash_table, d);       break;
+				case DT_GNU_HASH: _section<typeof(_gnu_hash_table)>(&_gnu_hash_table, d); break;
 				case DT_RELA    : _section<typeof(_reloca)>(&_reloca, d);               break;
 				case DT_RELASZ  : _reloca_size = d->un.val;                             break;
 				case DT_SYMTAB  : _section<typeof(_symtab)>(&_symtab, d);               break;
@@ -214,9 +309,21 @@ class Linker::Dynamic
 			_init_function();
 		}
 
+		/**
+		 * Return number of entries of the dynamic symbol table
+		 */
+		unsigned long num_symbols() const
+		{
+			if (!_num_symbols)
+				_num_symbols = _hash_table     ? _hash_table->nchains()
+				             : _gnu_hash_table ? _gnu_hash_table->num_symbols()
+				             : 0;
+			return _num_symbols;
+		}
+
 		Elf::Sym const *symbol(unsigned sym_index) const
 		{
-			if (sym_index > _hash_table->nchains())
+			if (sym_index >= num_symbols())
 				return nullptr;
 
 			return _symtab + sym_index;
@@ -234,46 +341,105 @@ class Linker::Dynamic
 		Dependency const &dep() const { return *_dep; }
 
 		/*
-		 * Use DT_HASH table address for linker, assuming that it will always be at
+		 * Use hash-table address for linker, assuming that it will always be at
 		 * the beginning of the file
 		 */
-		Elf::Addr link_map_addr() const { return trunc_page((Elf::Addr)_hash_table); }
+		Elf::Addr link_map_addr() const
+		{
+			return trunc_page(_hash_table ? (Elf::Addr)_hash_table
+			                              : (Elf::Addr)_gnu_hash_table);
+		}
+
+	private:
 
 		/**
-		 * Lookup symbol name in this ELF
+		 * Return symbol if it is a definition of 'name'
 		 */
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *_match(unsigned sym_index, char const *name) const
+		{
+			Elf::Sym const *sym = symbol(sym_index);
+
+			/* bad object */
+			if (!sym)
+				return nullptr;
+
+			/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
+			if (sym->type() > STT_FUNC)
+				return nullptr;
+
+			if (sym->st_value == 0)
+				return nullptr;
+
+			/* check for symbol name */
+			char const *sym_name = symbol_name(*sym);
+			if (name[0] != sym_name[0] || strcmp(name, sym_name))
+				return nullptr;
+
+			return sym;
+		}
+
+		Elf::Sym const *_lookup_gnu(char const *name, uint32_t hash) const
+		{
+			Gnu_hash_table const &h = *_gnu_hash_table;
+
+			if (!h.nbuckets() || !h.may_contain(hash))
+				return nullptr;
+
+			uint32_t sym_index = h.buckets()[hash % h.nbuckets()];
+			if (sym_index < h.symoffset())
+				return nullptr;
+
+			/* traverse hash chain, comparing names of equally hashed symbols only */
+			for (;; sym_index++) {
+
+				uint32_t const chain_hash = h.chains()[sym_index - h.symoffset()];
+
+				if ((chain_hash | 1) == (hash | 1))
+					if (Elf::Sym const *sym = _match(sym_index, name))
+						return sym;
+
+				if (chain_hash & 1)
+					return nullptr;
+			}
+		}
+
+		Elf::Sym const *_lookup_sysv(char const *name, unsigned long hash) const
 		{
 			Hash_table *h = _hash_table;
 
-			if (!h->buckets())
+			if (!h->nbuckets())
 				return nullptr;
 
 			unsigned sym_index = h->buckets()[hash % h->nbuckets()];
 
 			/* traverse hash chain */
-			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
-			{
+			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index]) {
+
 				/* bad object */
-				if (sym_index > h->nchains())
+				if (sym_index >= h->nchains())
 					return nullptr;
 
-				Elf::Sym const *sym      = symbol(sym_index);
-				char const     *sym_name = symbol_name(*sym);
+				if (Elf::Sym const *sym = _match(sym_index, name))
+					return sym;
+			}
 
-				/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
-				if (sym->type() > STT_FUNC)
-					continue;
+			return nullptr;
+		}
 
-				if (sym->st_value == 0)
-					continue;
+	public:
 
-				/* check for symbol name */
-				if (name[0] != sym_name[0] || strcmp(name, sym_name))
-					continue;
+		/**
+		 * Lookup symbol name in this ELF
+		 *
+		 * The GNU hash table is preferred if present.
+		 */
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash) const
+		{
+			if (_gnu_hash_table)
+				return _lookup_gnu(name, hash.gnu);
 
-				return sym;
-			}
+			if (_hash_table)
+				return _lookup_sysv(name, hash.elf);
 
 			return nullptr;
 		}
@@ -285,7 +451,7 @@ class Linker::Dynamic
 		{
 			addr_t const reloc_base = _obj.reloc_base();
 
-			for (unsigned i = 0; i < _hash_table->nchains(); i++)
+			for (unsigned i = 0; i < num_symbols(); i++)
 			{
 				Elf::Sym const *sym = symbol(i);
 				if (!sym)
@@ -101,6 +101,14 @@ namespace Linker {
 	Elf::Sym const *lookup_symbol(char const *name, Dependency const &dep, Elf::Addr *base,
 	                              bool undef = false, bool other = false);
 
+	/**
+	 * Invalidate memoized symbol-lookup results
+	 *
+	 * Must be called whenever the set of loaded objects or the dependency
+	 * lists change.
+	 */
+	void invalidate_symbol_memo();
+
 	/**
 	 * Load an ELF (setup segments and map program header)
 	 *
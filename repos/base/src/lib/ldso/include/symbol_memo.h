@@ -0,0 +1,115 @@
+/*
+ * \brief  Memoization of resolved symbols
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * Each relocation referring to a global symbol triggers a lookup through all
+ * objects of the dependency list. The same symbols are referenced by many
+ * objects (e.g., the C++ runtime or libc functions), hence the result of each
+ * successful lookup is remembered per dependency list. The memo is organized
+ * as a direct-mapped table indexed by the symbol's hash value. Whenever the
+ * set of loaded objects changes, all entries are invalidated at once by
+ * advancing the generation counter.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__SYMBOL_MEMO_H_
+#define _INCLUDE__SYMBOL_MEMO_H_
+
+/* local includes */
+#include <dynamic.h>
+
+namespace Linker { class Symbol_memo; }
+
+
+class Linker::Symbol_memo : Noncopyable
+{
+	private:
+
+		enum { NUM_ENTRIES = 2048 };
+
+		struct Entry
+		{
+			unsigned long     generation;
+			Dependency const *first;
+			uint32_t          hash;
+			char       const *name;
+			Elf::Sym   const *sym;
+			Elf::Addr         base;
+		};
+
+		Mutex _mutex { };
+
+		/* generation 0 denotes an unused entry */
+		unsigned long _generation = 1;
+
+		Entry _entries[NUM_ENTRIES] { };
+
+		unsigned long _hits = 0, _misses = 0;
+
+		Entry &_entry(uint32_t hash) { return _entries[hash % NUM_ENTRIES]; }
+
+	public:
+
+		/**
+		 * Look up memoized symbol
+		 *
+		 * \param first  first element of the dependency list searched
+		 * \return       true if the symbol was found in the memo
+		 */
+		bool lookup(Dependency const &first, char const *name,
+		            Symbol_hash const &hash, Elf::Sym const **sym,
+		            Elf::Addr *base)
+		{
+			Mutex::Guard guard(_mutex);
+
+			Entry const &e = _entry(hash.gnu);
+
+			if (e.generation != _generation || e.first != &first
+			 || e.hash != hash.gnu || (e.name != name && strcmp(e.name, name))) {
+				_misses++;
+				return false;
+			}
+
+			_hits++;
+			*sym  = e.sym;
+			*base = e.base;
+			return true;
+		}
+
+		void insert(Dependency const &first, char const *name,
+		            Symbol_hash const &hash, Elf::Sym const *sym,
+		            Elf::Addr base)
+		{
+			Mutex::Guard guard(_mutex);
+
+			_entry(hash.gnu) = Entry { .generation = _generation,
+			                           .first      = &first,
+			                           .hash       = hash.gnu,
+			                           .name       = name,
+			                           .sym        = sym,
+			                           .base       = base };
+		}
+
+		/**
+		 * Invalidate all entries
+		 *
+		 * Called whenever an object or dependency is added or removed.
+		 */
+		void invalidate()
+		{
+			Mutex::Guard guard(_mutex);
+			_generation++;
+		}
+
+		unsigned long hits()   const { return _hits; }
+		unsigned long misses() const { return _misses; }
+};
+
+#endif /* _INCLUDE__SYMBOL_MEMO_H_ */
@@ -30,6 +30,7 @@
 #include <init.h>
 #include <region_map.h>
 #include <config.h>
+#include <symbol_memo.h>
 
 using namespace Linker;
 
@@ -189,7 +190,7 @@ class Linker::Elf_object : public Object, private Fifo<Elf_object>::Element
 			return _dyn.symbol_name(sym);
 		}
 
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash) const
 		{
 			return _dyn.lookup_symbol(name, hash);
 		}
@@ -516,7 +517,7 @@ void genode_exit(int status)
 
 Elf::Addr Linker::Object::_symbol_address(char const *name)
 {
-	unsigned long   hash = Hash_table::hash(name);
+	Symbol_hash     hash(name);
 	Elf::Sym const *sym  = dynamic().lookup_symbol(name, hash);
 
 	if (sym)
@@ -582,11 +583,33 @@ Elf::Sym const *Linker::lookup_symbol(unsigned sym_index, Dependency const &dep,
 }
 
 
-Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
-                                      Elf::Addr *base, bool undef, bool other)
+/*
+ * The memo is used not before the linker relocated itself and loads the
+ * binary.
+ */
+static bool symbol_memo_enabled = false;
+
+
+static Symbol_memo &symbol_memo()
+{
+	return *unmanaged_singleton<Symbol_memo>();
+}
+
+
+void Linker::invalidate_symbol_memo()
+{
+	if (symbol_memo_enabled)
+		symbol_memo().invalidate();
+}
+
+
+static Elf::Sym const *lookup_symbol_uncached(char const *name,
+                                              Symbol_hash const &hash,
+                                              Dependency const &dep,
+                                              Elf::Addr *base, bool undef,
+                                              bool other)
 {
 	Dependency const *curr        = &dep.first();
-	unsigned long     hash        = Hash_table::hash(name);
 	Elf::Sym   const *weak_symbol = 0;
 	Elf::Addr        weak_base    = 0;
 	Elf::Sym   const *symbol      = 0;
@@ -624,7 +647,8 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 	/* try searching binary's dependencies */
 	if (!weak_symbol && dep.root()) {
 		if (binary_ptr && &dep != binary_ptr->first_dep()) {
-			return lookup_symbol(name, *binary_ptr->first_dep(), base, undef, other);
+			return lookup_symbol_uncached(name, hash, *binary_ptr->first_dep(),
+			                              base, undef, other);
 		} else {
 			throw Not_found(name);
 		}
@@ -641,6 +665,31 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 }
 
 
+Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
+                                      Elf::Addr *base, bool undef, bool other)
+{
+	Symbol_hash const hash(name);
+
+	/*
+	 * Only the common lookups of defined symbols in all objects are
+	 * memoized. Lookups that fail are not memoized because they raise an
+	 * exception anyway.
+	 */
+	bool const memoize = symbol_memo_enabled && !undef && !other;
+
+	Elf::Sym const *symbol = nullptr;
+	if (memoize && symbol_memo().lookup(dep.first(), name, hash, &symbol, base))
+		return symbol;
+
+	symbol = lookup_symbol_uncached(name, hash, dep, base, undef, other);
+
+	if (memoize)
+		symbol_memo().insert(dep.first(), name, hash, symbol, *base);
+
+	return symbol;
+}
+
+
 /********************
  ** Initialization **
  ********************/
@@ -807,6 +856,8 @@ void Component::construct(Genode::Env &env)
 
 	parent_ptr = &env.parent();
 
+	symbol_memo_enabled = config.symbol_memo();
+
 	/* load binary and all dependencies */
 	try {
 		binary_ptr = unmanaged_singleton<Binary>(env, *heap(), config, binary_name());
@@ -821,6 +872,10 @@ void Component::construct(Genode::Env &env)
 	/* print loaded object information */
 	try {
 		if (verbose) {
+			if (symbol_memo_enabled)
+				log("LD: symbol memo: ", symbol_memo().hits(), " hits, ",
+				    symbol_memo().misses(), " misses");
+
 			using namespace Genode;
 			log("  ",   Hex(Thread::stack_area_virtual_base()),
 			    " .. ", Hex(Thread::stack_area_virtual_base() +
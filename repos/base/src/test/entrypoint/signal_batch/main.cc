@@ -0,0 +1,159 @@
+/*
+ * \brief  Benchmark of the signal batching of entrypoints
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * A producer thread submits one signal to each of a number of signal
+ * contexts, calls an RPC function of the same entrypoint, and waits until
+ * all signals are handled. The benchmark runs once with the default of one
+ * signal per wakeup and once with signal batching, and reports the duration
+ * along with the counters of the entrypoint.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/rpc_client.h>
+#include <base/rpc_server.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+namespace Test {
+
+	struct Pong;
+	struct Pong_component;
+	struct Producer;
+	struct Main;
+}
+
+
+struct Test::Pong : Interface
+{
+	GENODE_RPC(Rpc_ping, unsigned, ping, unsigned);
+	GENODE_RPC_INTERFACE(Rpc_ping);
+};
+
+
+struct Test::Pong_component : Rpc_object<Pong, Pong_component>
+{
+	unsigned ping(unsigned value) { return value + 1; }
+};
+
+
+struct Test::Producer : Thread
+{
+	enum { STACK_SIZE = 2*1024*sizeof(long), MAX_CONTEXTS = 64 };
+
+	Entrypoint &_ep;
+
+	unsigned const _contexts;
+	unsigned const _rounds;
+
+	Pong_component   _pong     { };
+	Capability<Pong> _pong_cap { _ep.manage(_pong) };
+
+	Constructible<Signal_handler<Producer>> _handlers[MAX_CONTEXTS] { };
+
+	unsigned _handled    { 0 };  /* accessed by the entrypoint only */
+	Blockade _round_done { };
+
+	void _handle_signal()
+	{
+		if (++_handled < _contexts)
+			return;
+
+		_handled = 0;
+		_round_done.wakeup();
+	}
+
+	void entry() override
+	{
+		for (unsigned round = 0; round < _rounds; round++) {
+
+			for (unsigned i = 0; i < _contexts; i++)
+				Signal_transmitter(*_handlers[i]).submit();
+
+			if (_pong_cap.call<Pong::Rpc_ping>(round) != round + 1)
+				error("unexpected ping result");
+
+			_round_done.block();
+		}
+	}
+
+	Producer(Env &env, Entrypoint &ep, unsigned contexts, unsigned rounds)
+	:
+		Thread(env, "producer", STACK_SIZE),
+		_ep(ep), _contexts(max(1U, min(contexts, (unsigned)MAX_CONTEXTS))),
+		_rounds(rounds)
+	{
+		for (unsigned i = 0; i < _contexts; i++)
+			_handlers[i].construct(_ep, *this, &Producer::_handle_signal);
+	}
+
+	~Producer() { _ep.dissolve(_pong); }
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	unsigned const _contexts    = _config.xml().attribute_value("contexts", 16u);
+	unsigned const _rounds      = _config.xml().attribute_value("rounds",   10000u);
+	unsigned const _batch_limit = _config.xml().attribute_value("batch",    32u);
+
+	enum { STACK_SIZE = 8*1024*sizeof(long) };
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	void _measure(unsigned const batch_limit)
+	{
+		Entrypoint ep { _env, STACK_SIZE, "bench_ep", Affinity::Location() };
+
+		ep.signal_batch_limit(batch_limit);
+
+		Producer producer { _env, ep, _contexts, _rounds };
+
+		uint64_t const start = _now_us();
+
+		producer.start();
+		producer.join();
+
+		uint64_t const duration_us = max(_now_us() - start, (uint64_t)1);
+
+		Entrypoint::Stats const stats   = ep.stats();
+		unsigned long     const signals = (unsigned long)_contexts*_rounds;
+
+		log("batch limit ", batch_limit, ": ", signals, " signals in ",
+		    duration_us, " us, ", ((uint64_t)signals*1000*1000)/duration_us,
+		    " signals/s, wakeups=", stats.signal_wakeups,
+		    " dispatched=", stats.signals, " rpcs=", stats.rpcs,
+		    " signals/wakeup=", stats.signals/max(stats.signal_wakeups, 1UL));
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- entrypoint signal-batch benchmark ---");
+
+		_measure(1);
+		_measure(_batch_limit);
+
+		log("--- entrypoint signal-batch benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Env &env) { static Test::Main main(env); }
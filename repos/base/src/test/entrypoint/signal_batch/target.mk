@@ -0,0 +1,3 @@
+TARGET = test-entrypoint_signal_batch
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,131 @@
+/*
+ * \brief  Benchmark of the dynamic linker's load and lookup performance
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * Each library listed in the configuration is repeatedly loaded with all
+ * symbols bound immediately and unloaded again. This resembles the startup of
+ * a dynamically linked component, which is dominated by symbol resolution for
+ * large libraries. Afterwards, the symbols specified for the library are
+ * looked up repeatedly.
+ *
+ * Configuration:
+ *
+ * ! <config rounds="20" lookups="10000">
+ * !   <library rom="vfs.lib.so">
+ * !     <symbol name="_ZN3Vfs26Global_file_system_factory6createERNS_3EnvEN6Genode8Xml_nodeE"/>
+ * !   </library>
+ * ! </config>
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/shared_object.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	using Rom_name    = String<64>;
+	using Symbol_name = String<128>;
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	void _measure_load(Rom_name const &rom, unsigned rounds)
+	{
+		uint64_t min_us = ~0ULL, total_us = 0;
+
+		for (unsigned i = 0; i < rounds; i++) {
+
+			uint64_t const start = _now_us();
+
+			Shared_object obj(_env, _heap, rom.string(),
+			                  Shared_object::BIND_NOW, Shared_object::DONT_KEEP);
+
+			uint64_t const duration_us = _now_us() - start;
+
+			min_us    = min(min_us, duration_us);
+			total_us += duration_us;
+		}
+
+		log(rom, ": load and bind min ", min_us, " us, "
+		    "avg ", total_us/max(rounds, 1u), " us");
+	}
+
+	void _measure_lookup(Rom_name const &rom, Symbol_name const &symbol,
+	                     unsigned lookups)
+	{
+		Shared_object obj(_env, _heap, rom.string(),
+		                  Shared_object::BIND_LAZY, Shared_object::DONT_KEEP);
+
+		uint64_t const start = _now_us();
+
+		try {
+			for (unsigned i = 0; i < lookups; i++)
+				obj.lookup(symbol.string());
+		}
+		catch (Shared_object::Invalid_symbol) {
+			error(rom, ": symbol '", symbol, "' not found");
+			return;
+		}
+
+		uint64_t const duration_us = max(_now_us() - start, (uint64_t)1);
+
+		log(rom, ": lookup of '", symbol, "' ",
+		    (duration_us*1000)/max(lookups, 1u), " ns");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		Xml_node const config = _config.xml();
+
+		unsigned const rounds  = config.attribute_value("rounds",  20u);
+		unsigned const lookups = config.attribute_value("lookups", 10000u);
+
+		log("--- dynamic-linker startup benchmark ---");
+
+		config.for_each_sub_node("library", [&] (Xml_node const &library) {
+
+			Rom_name const rom = library.attribute_value("rom", Rom_name());
+
+			try {
+				_measure_load(rom, rounds);
+
+				library.for_each_sub_node("symbol", [&] (Xml_node const &symbol) {
+					_measure_lookup(rom, symbol.attribute_value("name", Symbol_name()),
+					                lookups); });
+			}
+			catch (Shared_object::Invalid_rom_module) {
+				error(rom, ": could not load library"); }
+		});
+
+		log("--- dynamic-linker startup benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,115 @@
+/*
+ * \brief  RPC round-trip benchmark
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The component calls an RPC object served by a second entrypoint in a
+ * tight loop and reports the average round-trip latency and the number of
+ * calls per second, once with a plain argument and once with a payload
+ * buffer.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/rpc_client.h>
+#include <base/rpc_server.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+namespace Test {
+
+	struct Pong;
+	struct Pong_component;
+	struct Main;
+
+	using Payload = Rpc_in_buffer<1024>;
+}
+
+
+struct Test::Pong : Interface
+{
+	GENODE_RPC(Rpc_ping, unsigned, ping, unsigned);
+	GENODE_RPC(Rpc_ping_payload, size_t, ping_payload, Payload const &);
+	GENODE_RPC_INTERFACE(Rpc_ping, Rpc_ping_payload);
+};
+
+
+struct Test::Pong_component : Rpc_object<Pong, Pong_component>
+{
+	unsigned ping(unsigned value) { return value + 1; }
+
+	size_t ping_payload(Payload const &payload) { return payload.size(); }
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	unsigned const _calls = _config.xml().attribute_value("calls", 100000u);
+
+	enum { STACK_SIZE = 8*1024*sizeof(long) };
+
+	Entrypoint     _pong_ep   { _env, STACK_SIZE, "pong_ep", Affinity::Location() };
+	Pong_component _pong      { };
+	Capability<Pong> _pong_cap { _pong_ep.manage(_pong) };
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	template <typename FN>
+	void _measure(char const *name, FN const &fn)
+	{
+		/* warm up */
+		for (unsigned i = 0; i < 100; i++)
+			fn(i);
+
+		uint64_t const start = _now_us();
+
+		for (unsigned i = 0; i < _calls; i++)
+			fn(i);
+
+		uint64_t const duration_us = max(_now_us() - start, (uint64_t)1);
+
+		log(name, ": ", _calls, " calls in ", duration_us, " us, "
+		    "round trip ", (duration_us*1000)/_calls, " ns, ",
+		    ((uint64_t)_calls*1000*1000)/duration_us, " calls/s");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RPC ping-pong benchmark ---");
+
+		_measure("ping", [&] (unsigned i) {
+			if (_pong_cap.call<Pong::Rpc_ping>(i) != i + 1)
+				error("unexpected ping result"); });
+
+		char buffer[1024];
+		memset(buffer, 'x', sizeof(buffer));
+		Payload const payload(buffer, sizeof(buffer));
+
+		_measure("ping with 1 KiB payload", [&] (unsigned) {
+			if (_pong_cap.call<Pong::Rpc_ping_payload>(payload) != sizeof(buffer))
+				error("unexpected payload size"); });
+
+		_pong_ep.dissolve(_pong);
+
+		log("--- RPC ping-pong benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Env &env) { static Test::Main main(env); }
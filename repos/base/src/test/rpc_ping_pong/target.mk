@@ -0,0 +1,3 @@
+TARGET = test-rpc_ping_pong
+SRC_CC = main.cc
+LIBS   = base
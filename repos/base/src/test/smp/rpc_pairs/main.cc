@@ -0,0 +1,160 @@
+/*
+ * \brief  RPC throughput of client/server pairs spread over CPUs
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * Each pair consists of a client thread that calls an RPC object of a server
+ * entrypoint in a tight loop. Initially, client and server of each pair are
+ * placed on different CPUs. The test reports the number of calls per second
+ * for a number of rounds, which allows for observing the effect of thread
+ * migrations, e.g., by the cpu_balancer.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/rpc_client.h>
+#include <base/rpc_server.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+namespace Test {
+
+	struct Pong;
+	struct Pong_component;
+	struct Pair;
+	struct Main;
+}
+
+
+struct Test::Pong : Interface
+{
+	GENODE_RPC(Rpc_ping, unsigned, ping, unsigned);
+	GENODE_RPC_INTERFACE(Rpc_ping);
+};
+
+
+struct Test::Pong_component : Rpc_object<Pong, Pong_component>
+{
+	unsigned ping(unsigned value) { return value + 1; }
+};
+
+
+struct Test::Pair : Thread
+{
+	enum { STACK_SIZE = 2*1024*sizeof(long) };
+
+	Rpc_entrypoint   _server;
+	Pong_component   _pong     { };
+	Capability<Pong> _pong_cap { _server.manage(&_pong) };
+
+	uint64_t volatile calls { 0 };
+	bool     volatile stop  { false };
+
+	void entry() override
+	{
+		for (unsigned i = 0; !stop; i++) {
+			if (_pong_cap.call<Pong::Rpc_ping>(i) != i + 1)
+				error("unexpected ping result");
+			calls = calls + 1;
+		}
+	}
+
+	Pair(Env &env, unsigned id, Affinity::Location client,
+	     Affinity::Location server)
+	:
+		Thread(env, Name("client_", id), STACK_SIZE, client, Weight(),
+		       env.cpu()),
+		_server(&env.pd(), STACK_SIZE, Name("server_", id).string(), server)
+	{ }
+
+	~Pair() { _server.dissolve(&_pong); }
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	unsigned const _num_pairs = _config.xml().attribute_value("pairs",    2u);
+	unsigned const _rounds    = _config.xml().attribute_value("rounds",   10u);
+	uint64_t const _round_ms  = _config.xml().attribute_value("round_ms", 1000ULL);
+
+	Affinity::Space const _cpus = _env.cpu().affinity_space();
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- SMP RPC pairs test started ---");
+		log("Detected ", _cpus.width(), "x", _cpus.height(), " CPU",
+		    _cpus.total() > 1 ? "s." : ".");
+
+		Pair ** const pairs = new (_heap) Pair*[_num_pairs];
+
+		/* place client and server of each pair on neighbouring CPUs */
+		for (unsigned i = 0; i < _num_pairs; i++) {
+			Affinity::Location const client = _cpus.location_of_index(2*i);
+			Affinity::Location const server = _cpus.location_of_index(2*i + 1);
+
+			pairs[i] = new (_heap) Pair(env, i, client, server);
+
+			log("pair ", i, ": client at ", client.xpos(), "x", client.ypos(),
+			    ", server at ", server.xpos(), "x", server.ypos());
+		}
+
+		for (unsigned i = 0; i < _num_pairs; i++)
+			pairs[i]->start();
+
+		uint64_t last_calls = 0;
+		uint64_t last_us    = _now_us();
+
+		for (unsigned round = 0; round < _rounds; round++) {
+
+			_timer.msleep(_round_ms);
+
+			uint64_t calls = 0;
+			for (unsigned i = 0; i < _num_pairs; i++)
+				calls += pairs[i]->calls;
+
+			uint64_t const now_us      = _now_us();
+			uint64_t const duration_us = max(now_us - last_us, (uint64_t)1);
+
+			log("round ", round, ": ",
+			    ((calls - last_calls)*1000*1000)/duration_us, " calls/s");
+
+			last_calls = calls;
+			last_us    = now_us;
+		}
+
+		for (unsigned i = 0; i < _num_pairs; i++)
+			pairs[i]->stop = true;
+
+		for (unsigned i = 0; i < _num_pairs; i++) {
+			pairs[i]->join();
+			destroy(_heap, pairs[i]);
+		}
+		destroy(_heap, pairs);
+
+		log("--- SMP RPC pairs test finished ---");
+	}
+};
+
+
+void Component::construct(Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-smp_rpc_pairs
+SRC_CC = main.cc
+LIBS   = base
@@ -25,15 +25,6 @@ class Chunky_texture : Genode::Attached_ram_dataspace, public Genode::Texture<PT
 
 		typedef Genode::Surface_base::Area Area;
 
-		/**
-		 * Calculate memory needed to store the texture
-		 */
-		static Genode::size_t _num_bytes(Area size)
-		{
-			/* account for pixel size + 1 byte per alpha value */
-			return size.count()*(sizeof(PT) + 1);
-		}
-
 		/**
 		 * Return base of pixel buffer
 		 */
@@ -53,10 +44,21 @@ class Chunky_texture : Genode::Attached_ram_dataspace, public Genode::Texture<PT
 
 	public:
 
+		/**
+		 * Calculate memory needed to store the texture
+		 *
+		 * The pixel buffer is immediately followed by the alpha buffer.
+		 */
+		static Genode::size_t num_bytes(Area size)
+		{
+			/* account for pixel size + 1 byte per alpha value */
+			return size.count()*(sizeof(PT) + 1);
+		}
+
 		Chunky_texture(Genode::Ram_allocator &ram, Genode::Region_map &rm,
 		               Genode::Surface_base::Area size)
 		:
-			Genode::Attached_ram_dataspace(ram, rm, _num_bytes(size)),
+			Genode::Attached_ram_dataspace(ram, rm, num_bytes(size)),
 			Genode::Texture<PT>(_pixel(), _alpha(size), size)
 		{ }
 };
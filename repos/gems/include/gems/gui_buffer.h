@@ -123,11 +123,23 @@ struct Gui_buffer
 				fn(pixel, alpha); }); });
 	}
 
-	void reset_surface()
+	/**
+	 * Reset the part of the surface within 'rect'
+	 */
+	void reset_surface(Rect rect)
 	{
+		rect = Rect::intersect(rect, Rect(Point(0, 0), size()));
+		if (!rect.valid())
+			return;
+
+		size_t const line = size().w();
+		size_t const skip = line*rect.y1() + rect.x1();
+
 		if (use_alpha)
 			with_alpha_surface([&] (Alpha_surface &alpha) {
-				Genode::memset(alpha.addr(), 0, alpha_surface_num_bytes()); });
+				Pixel_alpha8 *dst = alpha.addr() + skip;
+				for (unsigned y = rect.h(); y--; dst += line)
+					Genode::memset(dst, 0, rect.w()); });
 
 		with_pixel_surface([&] (Pixel_surface &pixel) {
 
@@ -137,14 +149,17 @@ struct Gui_buffer
 			 * We do not use black to limit the bleeding of black into antialiased
 			 * drawing operations applied onto an initially transparent background.
 			 */
-			Pixel_rgb888 *dst = pixel.addr();
+			Pixel_rgb888 *dst = pixel.addr() + skip;
 			Pixel_rgb888 const color = reset_color;
 
-			for (size_t n = size().count(); n; n--)
-				*dst++ = color;
+			for (unsigned y = rect.h(); y--; dst += line)
+				for (unsigned x = 0; x < rect.w(); x++)
+					dst[x] = color;
 		});
 	}
 
+	void reset_surface() { reset_surface(Rect(Point(0, 0), size())); }
+
 	template <typename DST_PT, typename SRC_PT>
 	void _convert_back_to_front(DST_PT                        *front_base,
 	                            Genode::Texture<SRC_PT> const &texture,
@@ -157,20 +172,23 @@ struct Gui_buffer
 		Blit_painter::paint(surface, texture, Point());
 	}
 
-	void _update_input_mask()
+	void _update_input_mask(Rect const rect)
 	{
 		if (!use_alpha)
 			return;
 
 		size_t const num_pixels = size().count();
+		size_t const line       = size().w();
 
 		unsigned char * const alpha_base = fb_ds.local_addr<unsigned char>()
 		                                 + mode.bytes_per_pixel()*num_pixels;
 
 		unsigned char * const input_base = alpha_base + num_pixels;
 
-		unsigned char const *src = alpha_base;
-		unsigned char       *dst = input_base;
+		size_t const skip = line*rect.y1() + rect.x1();
+
+		unsigned char const *src = alpha_base + skip;
+		unsigned char       *dst = input_base + skip;
 
 		/*
 		 * Set input mask for all pixels where the alpha value is above a
@@ -179,14 +197,19 @@ struct Gui_buffer
 		 */
 		unsigned char const threshold = 100;
 
-		for (unsigned i = 0; i < num_pixels; i++)
-			*dst++ = (*src++) > threshold;
+		for (unsigned y = rect.h(); y--; src += line, dst += line)
+			for (unsigned x = 0; x < rect.w(); x++)
+				dst[x] = src[x] > threshold;
 	}
 
-	void flush_surface()
+	/**
+	 * Copy the part of the back buffer within 'rect' to the GUI buffer
+	 */
+	void flush_surface(Rect rect)
 	{
-		// XXX track dirty rectangles
-		Rect const clip_rect(Genode::Surface_base::Point(0, 0), size());
+		rect = Rect::intersect(rect, Rect(Point(0, 0), size()));
+		if (!rect.valid())
+			return;
 
 		{
 			/* represent back buffer as texture */
@@ -195,7 +218,7 @@ struct Gui_buffer
 				              nullptr, size());
 			Pixel_rgb888 *pixel_base = fb_ds.local_addr<Pixel_rgb888>();
 
-			_convert_back_to_front(pixel_base, pixel_texture, clip_rect);
+			_convert_back_to_front(pixel_base, pixel_texture, rect);
 		}
 
 		if (use_alpha) {
@@ -206,11 +229,13 @@ struct Gui_buffer
 			Pixel_alpha8 *alpha_base = fb_ds.local_addr<Pixel_alpha8>()
 			                         + mode.bytes_per_pixel()*size().count();
 
-			_convert_back_to_front(alpha_base, alpha_texture, clip_rect);
+			_convert_back_to_front(alpha_base, alpha_texture, rect);
 
-			_update_input_mask();
+			_update_input_mask(rect);
 		}
 	}
+
+	void flush_surface() { flush_surface(Rect(Point(0, 0), size())); }
 };
 
 #endif /* _INCLUDE__GEMS__GUI_BUFFER_H_ */
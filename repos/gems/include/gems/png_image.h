@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <os/texture.h>
+#include <os/pixel_rgb888.h>
 
 /* libpng include */
 #pragma GCC diagnostic push
@@ -130,6 +131,10 @@ class Png_image
 
 					if (bit_depth <   8) png_set_packing(png_ptr);
 					if (bit_depth == 16) png_set_strip_16(png_ptr);
+
+					/* produce four bytes per pixel for images without alpha channel */
+					if (!(color_type & PNG_COLOR_MASK_ALPHA))
+						png_set_filler(png_ptr, 0xff, PNG_FILLER_AFTER);
 				}
 
 				~Info()
@@ -168,6 +173,48 @@ class Png_image
 				}
 		} _row { _alloc, _read_struct.png_ptr, _info.info_ptr };
 
+		/**
+		 * Decode rows directly into the pixel buffer of an RGB888 texture
+		 *
+		 * With the color components in BGR order, a decoded row corresponds
+		 * to a row of little-endian RGB888 pixels with the alpha value stored
+		 * in the otherwise unused most significant byte. The alpha value is
+		 * moved to the alpha buffer of the texture.
+		 */
+		bool _decode_direct(Genode::Texture<Genode::Pixel_rgb888> &dst, unsigned alpha)
+		{
+			if (!dst.alpha())
+				return false;
+
+			png_structp const png_ptr = _read_struct.png_ptr;
+
+			png_set_bgr(png_ptr);
+
+			unsigned const w = size().w(), h = size().h();
+
+			for (unsigned y = 0; y < h; y++) {
+
+				Genode::Pixel_rgb888 * const pixel = dst.pixel() + y*w;
+				unsigned char        * const a     = dst.alpha() + y*w;
+
+				png_read_row(png_ptr, (png_bytep)pixel, NULL);
+
+				for (unsigned x = 0; x < w; x++) {
+					unsigned const v = pixel[x].pixel;
+
+					a[x] = (unsigned char)(((v >> 24) * alpha) >> 8);
+					pixel[x].pixel = v & 0xffffff;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * Fallback for pixel formats without direct decoding
+		 */
+		template <typename PT>
+		bool _decode_direct(Genode::Texture<PT> &, unsigned) { return false; }
+
 	public:
 
 		/**
@@ -190,6 +237,68 @@ class Png_image
 			return Genode::Surface_base::Area(_info.img_w, _info.img_h);
 		}
 
+		/**
+		 * Decode PNG image into texture
+		 *
+		 * The image is decoded row by row. Each row is scaled to the size of
+		 * 'dst' by the means of nearest-neighbour sampling and written to
+		 * 'dst' right away. The alpha values are multiplied by 'alpha'/256.
+		 * If no scaling is needed for an RGB888 texture, libpng writes the
+		 * pixels directly into the texture.
+		 *
+		 * The image can be decoded only once.
+		 */
+		template <typename PT>
+		void decode(Genode::Texture<PT> &dst, unsigned alpha = 256)
+		{
+			/* sanity check to prevent division by zero */
+			if (dst.size().count() == 0 || size().count() == 0)
+				return;
+
+			png_structp const png_ptr = _read_struct.png_ptr;
+
+			if (dst.size() == size() && _decode_direct(dst, alpha))
+				return;
+
+			unsigned const w = dst.size().w(), h = dst.size().h();
+
+			/* steps through the source image in 16.16 fixpoint format */
+			unsigned const mx = (size().w() << 16) / w;
+			unsigned const my = (size().h() << 16) / h;
+
+			Genode::size_t const row_num_bytes = w*4;
+			unsigned char *row = (unsigned char *)_alloc.alloc(row_num_bytes);
+
+			/* number of source rows read so far */
+			unsigned num_src_rows = 0;
+
+			for (unsigned y = 0, src_y = 0; y < h; y++, src_y += my) {
+
+				/* advance to the source row of the destination row */
+				while (num_src_rows <= (src_y >> 16)) {
+					png_read_row(png_ptr, _row.row_ptr, NULL);
+					num_src_rows++;
+				}
+
+				unsigned char const * const src = _row.row_ptr;
+
+				unsigned char *d = row;
+				for (unsigned x = 0, src_x = 0; x < w; x++, src_x += mx) {
+
+					unsigned char const * const s = src + (src_x >> 16)*4;
+
+					*d++ = s[0];
+					*d++ = s[1];
+					*d++ = s[2];
+					*d++ = (unsigned char)((s[3] * alpha) >> 8);
+				}
+
+				dst.rgba(row, w, y);
+			}
+
+			_alloc.free(row, row_num_bytes);
+		}
+
 		/**
 		 * Obtain PNG image as texture
 		 */
@@ -200,10 +309,7 @@ class Png_image
 				Chunky_texture<PT>(_ram, _rm, size());
 
 			/* fill texture with PNG image data */
-			for (unsigned i = 0; i < size().h(); i++) {
-				png_read_row(_read_struct.png_ptr, _row.row_ptr, NULL);
-				texture->rgba((unsigned char *)_row.row_ptr, size().w()*4, i);
-			}
+			decode(*texture);
 
 			return texture;
 		}
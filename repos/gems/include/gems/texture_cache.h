@@ -0,0 +1,260 @@
+/*
+ * \brief  Cache of decoded textures
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * Textures are looked up by the hash of the encoded image data, the size of
+ * the texture, and the alpha value applied to the texture. The cache keeps
+ * the textures in RAM dataspaces up to a limit and evicts the least recently
+ * used textures when exceeding the limit. An optional backing store keeps the
+ * textures beyond the lifetime of the cache, e.g., across restarts of the
+ * component.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__GEMS__TEXTURE_CACHE_H_
+#define _INCLUDE__GEMS__TEXTURE_CACHE_H_
+
+/* Genode includes */
+#include <util/list.h>
+#include <util/string.h>
+#include <base/allocator.h>
+
+/* gems includes */
+#include <gems/chunky_texture.h>
+
+template <typename PT>
+class Texture_cache
+{
+	public:
+
+		typedef Genode::size_t             size_t;
+		typedef Genode::uint64_t           uint64_t;
+		typedef Genode::Surface_base::Area Area;
+
+		struct Key
+		{
+			uint64_t hash;   /* hash of the encoded image data */
+			Area     size;
+			unsigned alpha;
+
+			/**
+			 * Return FNV-1a hash of 'num_bytes' at 'data'
+			 */
+			static uint64_t hash_of(void const *data, size_t num_bytes)
+			{
+				unsigned char const *p = (unsigned char const *)data;
+
+				uint64_t h = 0xcbf29ce484222325ULL;
+				for (size_t i = 0; i < num_bytes; i++)
+					h = (h ^ p[i])*0x100000001b3ULL;
+
+				return h;
+			}
+
+			bool operator == (Key const &other) const
+			{
+				return hash == other.hash && size == other.size
+				    && alpha == other.alpha;
+			}
+
+			typedef Genode::String<64> Name;
+
+			/**
+			 * Return name of the texture within the backing store
+			 */
+			Name name() const
+			{
+				using Genode::Hex;
+				return Name(Hex(hash, Hex::OMIT_PREFIX, Hex::PAD), "-", size, "-", alpha);
+			}
+		};
+
+		/**
+		 * Interface for keeping textures beyond the lifetime of the cache
+		 *
+		 * The content of a texture consists of the pixel buffer followed by
+		 * the alpha buffer as laid out by 'Chunky_texture'.
+		 */
+		struct Backing_store : Genode::Interface
+		{
+			/**
+			 * Read content of the texture of 'key' to 'dst'
+			 *
+			 * \return  false if the backing store lacks the texture
+			 */
+			virtual bool load(Key const &key, void *dst, size_t num_bytes) = 0;
+
+			virtual void store(Key const &key, void const *src, size_t num_bytes) = 0;
+		};
+
+		struct Stats
+		{
+			unsigned hits;      /* textures found in the cache */
+			unsigned loads;     /* textures obtained from the backing store */
+			unsigned decodes;   /* textures produced by the decode function */
+		};
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Texture_cache(Texture_cache const &);
+		Texture_cache & operator = (Texture_cache const &);
+
+		Genode::Ram_allocator &_ram;
+		Genode::Region_map    &_rm;
+		Genode::Allocator     &_alloc;
+		Backing_store * const  _backing_store;
+
+		size_t _max_bytes;
+		size_t _used_bytes = 0;
+
+		Stats _stats { 0, 0, 0 };
+
+		struct Entry : Genode::List<Entry>::Element
+		{
+			Key const key;
+
+			Chunky_texture<PT> texture;
+
+			Entry(Genode::Ram_allocator &ram, Genode::Region_map &rm, Key const &key)
+			:
+				key(key), texture(ram, rm, key.size)
+			{ }
+		};
+
+		/* entries ordered from the most to the least recently used one */
+		Genode::List<Entry> _entries { };
+
+		void _destroy(Entry &entry)
+		{
+			_entries.remove(&entry);
+			_used_bytes -= Chunky_texture<PT>::num_bytes(entry.key.size);
+			Genode::destroy(_alloc, &entry);
+		}
+
+		/**
+		 * Evict least recently used entries until 'num_bytes' fit in the cache
+		 */
+		void _evict(size_t num_bytes)
+		{
+			while (_entries.first() && _used_bytes + num_bytes > _max_bytes) {
+
+				Entry *last = _entries.first();
+				while (last->next())
+					last = last->next();
+
+				_destroy(*last);
+			}
+		}
+
+		template <typename DECODE_FN>
+		void _fill(Key const &key, Chunky_texture<PT> &texture, DECODE_FN const &decode_fn)
+		{
+			size_t const num_bytes = Chunky_texture<PT>::num_bytes(key.size);
+
+			/* the alpha buffer follows the pixel buffer */
+			void * const content = texture.pixel();
+
+			if (_backing_store && _backing_store->load(key, content, num_bytes)) {
+				_stats.loads++;
+				return;
+			}
+
+			decode_fn(texture);
+			_stats.decodes++;
+
+			if (_backing_store)
+				_backing_store->store(key, content, num_bytes);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param max_bytes      limit of the RAM used for cached textures
+		 * \param backing_store  optional backing store
+		 */
+		Texture_cache(Genode::Ram_allocator &ram, Genode::Region_map &rm,
+		              Genode::Allocator &alloc, size_t max_bytes,
+		              Backing_store *backing_store = nullptr)
+		:
+			_ram(ram), _rm(rm), _alloc(alloc), _backing_store(backing_store),
+			_max_bytes(max_bytes)
+		{ }
+
+		~Texture_cache()
+		{
+			while (_entries.first())
+				_destroy(*_entries.first());
+		}
+
+		/**
+		 * Call 'fn' with the texture of 'key'
+		 *
+		 * If the texture is neither cached nor present in the backing store,
+		 * 'decode_fn' is called to produce the content of the texture. The
+		 * texture passed to 'fn' is valid during the call of 'fn' only.
+		 * Textures exceeding the limit of the cache are not cached.
+		 */
+		template <typename DECODE_FN, typename FN>
+		void with_texture(Key const &key, DECODE_FN const &decode_fn, FN const &fn)
+		{
+			for (Entry *e = _entries.first(); e; e = e->next()) {
+				if (!(e->key == key))
+					continue;
+
+				/* mark entry as most recently used */
+				_entries.remove(e);
+				_entries.insert(e);
+
+				_stats.hits++;
+				fn(e->texture);
+				return;
+			}
+
+			size_t const num_bytes = Chunky_texture<PT>::num_bytes(key.size);
+
+			if (num_bytes > _max_bytes) {
+				Chunky_texture<PT> texture(_ram, _rm, key.size);
+				_fill(key, texture, decode_fn);
+				fn(texture);
+				return;
+			}
+
+			_evict(num_bytes);
+
+			Entry &entry = *new (_alloc) Entry(_ram, _rm, key);
+			_entries.insert(&entry);
+			_used_bytes += num_bytes;
+
+			try { _fill(key, entry.texture, decode_fn); }
+			catch (...) { _destroy(entry); throw; }
+
+			fn(entry.texture);
+		}
+
+		/**
+		 * Change limit of the RAM used for cached textures
+		 */
+		void max_bytes(size_t max_bytes)
+		{
+			_max_bytes = max_bytes;
+			_evict(0);
+		}
+
+		size_t used_bytes() const { return _used_bytes; }
+
+		Stats stats() const { return _stats; }
+};
+
+#endif /* _INCLUDE__GEMS__TEXTURE_CACHE_H_ */
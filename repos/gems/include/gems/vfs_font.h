@@ -68,6 +68,166 @@ class Genode::Vfs_font : public Text_painter::Font
 
 		} __attribute__((packed));
 
+		/**
+		 * Pre-rendered glyphs of a contiguous range of codepoints
+		 *
+		 * The atlas is produced once by the font provider and read by the
+		 * font users as a whole, which spares the reading of each glyph
+		 * individually. It starts with a 'Header', followed by the offsets
+		 * of the glyphs relative to the start of the atlas. Each glyph
+		 * consists of a 'Glyph_header' followed by the opacity values.
+		 */
+		class Atlas
+		{
+			public:
+
+				struct Header
+				{
+					uint32_t magic;
+					uint32_t first;  /* first codepoint */
+					uint32_t count;  /* number of codepoints */
+					uint32_t size;   /* size of the atlas in bytes */
+				};
+
+				static constexpr uint32_t MAGIC = 0x676c7966;
+
+			private:
+
+				char const *_base = nullptr;
+				size_t      _size = 0;
+
+				Header const &_header() const { return *(Header const *)_base; }
+
+				uint32_t const *_offsets() const
+				{
+					return (uint32_t const *)(_base + sizeof(Header));
+				}
+
+				static size_t _aligned(size_t n) { return (n + 3) & ~(size_t)3; }
+
+				static size_t _glyph_bytes(Glyph const &glyph)
+				{
+					return _aligned(sizeof(Glyph_header)
+					                + Glyph_header(glyph).glyph().num_values());
+				}
+
+				template <typename FN>
+				static void _for_each_glyph(Text_painter::Font const &font,
+				                            uint32_t first, uint32_t count,
+				                            FN const &fn)
+				{
+					for (uint32_t i = 0; i < count; i++)
+						font.apply_glyph(Codepoint { first + i }, [&] (Glyph const &glyph) {
+							fn(i, glyph); });
+				}
+
+			public:
+
+				Atlas() { }
+
+				/**
+				 * Constructor
+				 *
+				 * An atlas with an invalid header is treated as empty.
+				 */
+				Atlas(char const *base, size_t size)
+				{
+					if (size < sizeof(Header))
+						return;
+
+					Header const &header = *(Header const *)base;
+					if (header.magic != MAGIC || header.size != size
+					 || sizeof(Header) + header.count*sizeof(uint32_t) > size)
+						return;
+
+					_base = base;
+					_size = size;
+				}
+
+				/**
+				 * Return size of the atlas for 'count' codepoints from 'first'
+				 */
+				static size_t num_bytes(Text_painter::Font const &font,
+				                        uint32_t first, uint32_t count)
+				{
+					size_t result = sizeof(Header) + count*sizeof(uint32_t);
+					_for_each_glyph(font, first, count, [&] (uint32_t, Glyph const &glyph) {
+						result += _glyph_bytes(glyph); });
+					return result;
+				}
+
+				/**
+				 * Render glyphs of 'font' into the atlas buffer 'dst'
+				 *
+				 * The buffer must have a size of 'num_bytes'.
+				 */
+				static void generate(Text_painter::Font const &font,
+				                     uint32_t first, uint32_t count,
+				                     char *dst, size_t size)
+				{
+					memset(dst, 0, size);
+
+					*(Header *)dst = Header { .magic = MAGIC,
+					                          .first = first,
+					                          .count = count,
+					                          .size  = (uint32_t)size };
+
+					uint32_t * const offsets = (uint32_t *)(dst + sizeof(Header));
+
+					size_t offset = sizeof(Header) + count*sizeof(uint32_t);
+
+					_for_each_glyph(font, first, count, [&] (uint32_t i, Glyph const &glyph) {
+
+						size_t const glyph_bytes = _glyph_bytes(glyph);
+						if (offset + glyph_bytes > size)
+							return;
+
+						Glyph_header const header(glyph);
+						size_t const num_values = min(header.glyph().num_values(),
+						                              glyph.num_values());
+
+						memcpy(dst + offset, &header, sizeof(header));
+						memcpy(dst + offset + sizeof(header), glyph.values, num_values);
+
+						offsets[i] = (uint32_t)offset;
+						offset += glyph_bytes;
+					});
+				}
+
+				bool valid() const { return _base != nullptr; }
+
+				size_t size() const { return _size; }
+
+				/**
+				 * Call 'fn' with the glyph of codepoint 'c' if contained
+				 *
+				 * \return  false if the atlas lacks the glyph
+				 */
+				template <typename FN>
+				bool with_glyph(Codepoint c, FN const &fn) const
+				{
+					if (!valid() || c.value < _header().first)
+						return false;
+
+					uint32_t const index = c.value - _header().first;
+					if (index >= _header().count)
+						return false;
+
+					uint32_t const offset = _offsets()[index];
+					if (!offset || offset + sizeof(Glyph_header) > _size)
+						return false;
+
+					Glyph_header const &header = *(Glyph_header const *)(_base + offset);
+					Glyph const glyph = header.glyph();
+
+					if (offset + sizeof(Glyph_header) + glyph.num_values() > _size)
+						return false;
+
+					fn(glyph);
+					return true;
+				}
+		};
+
 	private:
 
 		typedef Text_painter::Codepoint Codepoint;
@@ -102,6 +262,35 @@ class Genode::Vfs_font : public Text_painter::Font
 
 		Readonly_file _glyphs_file;
 
+		/*
+		 * Glyphs pre-rendered by the font provider, if available
+		 */
+		static constexpr size_t MAX_ATLAS_BYTES = 4*1024*1024;
+
+		Constructible<File_content> _atlas_content { };
+
+		Atlas _atlas { };
+
+		void _init_atlas(Allocator &alloc)
+		{
+			if (!_font_dir.file_exists("atlas"))
+				return;
+
+			try {
+				_atlas_content.construct(alloc, _font_dir, "atlas",
+				                         File_content::Limit { MAX_ATLAS_BYTES });
+			}
+			catch (File_content::Nonexistent_file)      { return; }
+			catch (File_content::Truncated_during_read) { return; }
+
+			_atlas_content->bytes([&] (char const *ptr, size_t size) {
+				_atlas = Atlas(ptr, size); });
+
+			/* release memory of empty or invalid atlas */
+			if (!_atlas.valid())
+				_atlas_content.destruct();
+		}
+
 		template <typename T, unsigned MAX_LEN = 128>
 		static T _value_from_file(Directory const &dir, Path const &path,
 		                          T const &default_value)
@@ -145,10 +334,20 @@ class Genode::Vfs_font : public Text_painter::Font
 			_height(_value_from_file(_font_dir, "height", 0U)),
 			_buffer(alloc, _bounding_box),
 			_glyphs_file(_font_dir, "glyphs")
-		{ }
+		{
+			_init_atlas(alloc);
+		}
+
+		/**
+		 * Return number of bytes occupied by pre-rendered glyphs
+		 */
+		size_t atlas_bytes() const { return _atlas.size(); }
 
 		void _apply_glyph(Codepoint c, Apply_fn const &fn) const override
 		{
+			if (_atlas.with_glyph(c, [&] (Glyph const &glyph) { fn.apply(glyph); }))
+				return;
+
 			_glyphs_file.read(_file_pos(c), _buffer.ptr(), _buffer.num_bytes);
 
 			fn.apply(_buffer.header.glyph());
@@ -156,11 +355,18 @@ class Genode::Vfs_font : public Text_painter::Font
 
 		Advance_info advance_info(Codepoint c) const override
 		{
-			_glyphs_file.read(_file_pos(c), _buffer.ptr(), sizeof(Glyph_header));
+			unsigned                      width = 0;
+			Text_painter::Fixpoint_number advance { 0 };
 
-			Glyph const glyph = _buffer.header.glyph();
+			auto with_glyph = [&] (Glyph const &glyph) {
+				width = glyph.width, advance = glyph.advance; };
+
+			if (!_atlas.with_glyph(c, with_glyph)) {
+				_glyphs_file.read(_file_pos(c), _buffer.ptr(), sizeof(Glyph_header));
+				with_glyph(_buffer.header.glyph());
+			}
 
-			return Advance_info { .width = glyph.width, .advance = glyph.advance };
+			return Advance_info { .width = width, .advance = advance };
 		}
 
 		unsigned baseline() const override { return _baseline; }
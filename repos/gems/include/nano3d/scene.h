@@ -7,6 +7,10 @@
  * view with a triple-buffer for rendering tearing-free animations.
  * A derrived class implements the to-be-displayed content in the virtual
  * 'render' method.
+ *
+ * Before rendering, only the bounding box of the content drawn into the
+ * buffer the last time is cleared. Hence, 'render' must report all changed
+ * areas of the pixel surface via 'flush_pixels' as done by the painters.
  */
 
 /*
@@ -21,6 +25,7 @@
 
 /* Genode includes */
 #include <base/entrypoint.h>
+#include <base/log.h>
 #include <timer_session/connection.h>
 #include <gui_session/connection.h>
 #include <os/surface.h>
@@ -149,31 +154,71 @@ class Nano3d::Scene
 		typedef Genode::Surface<PT>                   Pixel_surface;
 		typedef Genode::Surface<Genode::Pixel_alpha8> Alpha_surface;
 
-		struct Surface
+		typedef Genode::Surface_base::Rect  Rect;
+		typedef Genode::Surface_base::Point Point;
+
+		struct Surface : Genode::Surface_base::Flusher
 		{
 			Pixel_surface pixel;
 			Alpha_surface alpha;
 
+			/*
+			 * Bounding box of the content drawn since the last 'clear',
+			 * the initial content of the buffer is unknown
+			 */
+			Rect drawn { Point(0, 0), pixel.size() };
+
 			Surface(PT *pixel_base, Genode::Pixel_alpha8 *alpha_base,
 			        Genode::Surface_base::Area size)
 			:
 				pixel(pixel_base, size), alpha(alpha_base, size)
-			{ }
+			{
+				pixel.flusher(this);
+			}
+
+			~Surface() { pixel.flusher(nullptr); }
 
 			Genode::Surface_base::Area size() const { return pixel.size(); }
 
+			/**
+			 * Surface_base::Flusher interface
+			 */
+			void flush_pixels(Rect rect) override
+			{
+				drawn = drawn.valid() ? Rect::compound(drawn, rect) : rect;
+			}
+
 			template <typename T>
-			void _clear(Genode::Surface<T> &surface)
+			void _clear(Genode::Surface<T> &surface, Rect rect)
 			{
-				Genode::size_t n = surface.size().count();
-				for (T *dst = surface.addr(); n--; dst++)
-					*dst = { };
+				unsigned const w = surface.size().w();
+
+				T *line = surface.addr() + rect.y1()*w + rect.x1();
+				for (unsigned y = 0; y < rect.h(); y++, line += w) {
+					T *dst = line;
+					for (unsigned n = rect.w(); n--; dst++)
+						*dst = { };
+				}
 			}
 
-			void clear()
+			/**
+			 * Clear bounding box of the drawn content
+			 *
+			 * \return  number of cleared pixels
+			 */
+			Genode::size_t clear()
 			{
-				_clear(pixel);
-				_clear(alpha);
+				Rect const rect = Rect::intersect(drawn, Rect(Point(0, 0), size()));
+
+				drawn = Rect();
+
+				if (!rect.valid())
+					return 0;
+
+				_clear(pixel, rect);
+				_clear(alpha, rect);
+
+				return rect.area().count();
 			}
 		};
 
@@ -227,15 +272,68 @@ class Nano3d::Scene
 			_surface_front    = tmp;
 		}
 
+		/*
+		 * Statistics of the render times, logged every 'log_frames' frames
+		 */
+		struct Frame_stats
+		{
+			unsigned         frames;
+			Genode::uint64_t start_us, total_us, max_us, cleared, drawn;
+
+			void record(Genode::uint64_t us, Genode::size_t cleared_pixels,
+			            Genode::size_t drawn_pixels)
+			{
+				frames++;
+				total_us += us;
+				cleared  += cleared_pixels;
+				drawn    += drawn_pixels;
+				max_us    = Genode::max(max_us, us);
+			}
+		};
+
+		unsigned _log_frames = 0;
+
+		Frame_stats _stats { };
+
+		void _log_stats(Genode::uint64_t now_us)
+		{
+			Genode::uint64_t const period_us =
+				Genode::max(now_us - _stats.start_us, (Genode::uint64_t)1);
+
+			Genode::log("scene: ", _stats.frames, " frames, "
+			            "avg ", _stats.total_us/_stats.frames, " us, "
+			            "max ", _stats.max_us, " us, ",
+			            (_stats.frames*1000000ULL)/period_us, " fps, ",
+			            _stats.cleared/_stats.frames, " pixels cleared/frame, ",
+			            "bounding box ", _stats.drawn/_stats.frames, " pixels/frame");
+
+			_stats = Frame_stats { };
+			_stats.start_us = now_us;
+		}
+
 		void _handle_period()
 		{
 			if (_do_sync)
 				return;
 
-			_surface_back->clear();
+			Genode::uint64_t const start_us = _log_frames ? _timer.elapsed_us() : 0;
+
+			Genode::size_t const cleared = _surface_back->clear();
 
 			render(_surface_back->pixel, _surface_back->alpha);
 
+			if (_log_frames) {
+				Rect const drawn = _surface_back->drawn;
+
+				Genode::uint64_t const now_us = _timer.elapsed_us();
+
+				_stats.record(now_us - start_us, cleared,
+				              drawn.valid() ? drawn.area().count() : 0);
+
+				if (_stats.frames >= _log_frames)
+					_log_stats(now_us);
+			}
+
 			_swap_back_and_front_surfaces();
 
 			/* swap front and back buffers on next sync */
@@ -298,6 +396,19 @@ class Nano3d::Scene
 
 		Genode::uint64_t elapsed_ms() const { return _timer.elapsed_ms(); }
 
+		/**
+		 * Log render times every 'frames' frames, 0 disables the log
+		 *
+		 * The statistics are restarted with each call, e.g., when the
+		 * scene is reconfigured.
+		 */
+		void log_frames(unsigned frames)
+		{
+			_log_frames     = frames;
+			_stats          = Frame_stats { };
+			_stats.start_us = _timer.elapsed_us();
+		}
+
 		void input_handler(Input_handler *input_handler)
 		{
 			_framebuffer.input_mask(input_handler ? true : false);
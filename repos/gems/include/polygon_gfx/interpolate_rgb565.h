@@ -17,6 +17,7 @@
 /* Genode includes */
 #include <util/dither_matrix.h>
 #include <os/pixel_rgb565.h>
+#include <polygon_gfx/span_vector.h>
 #include <polygon_gfx/interpolate_rgba.h>
 
 namespace Polygon {
@@ -52,6 +53,70 @@ inline void Polygon::interpolate_rgba(Color start, Color end, Pixel_rgb565 *dst,
 	    b = start.b<<16,
 	    a = start.a<<16;
 
+	/*
+	 * The dither value may push the alpha value beyond 255. At 264, the
+	 * destination pixel does not contribute to the mixed pixel anymore.
+	 */
+	int const max_alpha = 264;
+
+#ifdef GENODE_PIXEL_SPAN_VECTOR
+
+	using namespace Span_vector;
+
+	Genode::Dither_matrix::Row const row = Genode::Dither_matrix::row(y);
+
+	/* color components of four subsequent pixels */
+	Vec_i32x4 r_v = ramp(r, r_ascent),
+	          g_v = ramp(g, g_ascent),
+	          b_v = ramp(b, b_ascent),
+	          a_v = ramp(a, a_ascent);
+
+	/*
+	 * Equivalent of 'Pixel_rgb565::blend' for alpha values up to 264
+	 *
+	 * The channels are multiplied separately such that all intermediate
+	 * values fit in 16 bit.
+	 */
+	auto blend = [] (Vec_u16x4 p, Vec_u16x4 alpha) {
+		Vec_u16x4 const a3 = alpha >> 3;
+		return (Vec_u16x4)(((((p >> 11)*a3) >> 5) << 11)
+		                 | ((((p >> 6) & 0x1f)*alpha >> 2) & 0x07c0)
+		                 |  (((p & 0x1f)*a3) >> 5)); };
+
+	for ( ; num_values >= 4; num_values -= 4, dst += 4, dst_alpha += 4, x += 4) {
+
+		Vec_i32x4 const dither = { row.value(x)     << 12, row.value(x + 1) << 12,
+		                           row.value(x + 2) << 12, row.value(x + 3) << 12 };
+
+		Vec_i32x4 const src = ((((r_v + dither) >> 16) << 8) & 0xf800)
+		                    | ((((g_v + dither) >> 16) << 3) & 0x07e0)
+		                    | ((((b_v + dither) >> 16) >> 3) & 0x001f);
+
+		Vec_i32x4 const alpha = (a_v + dither) >> 16;
+		Vec_i32x4 const above = alpha > max_alpha;
+
+		Vec_u16x4 const s = __builtin_convertvector(src,   Vec_u16x4),
+		                a = __builtin_convertvector((alpha & ~above) | (max_alpha & above),
+		                                            Vec_u16x4);
+
+		_store(dst, blend(_load<Vec_u16x4>(dst), max_alpha - a) + blend(s, a));
+
+		accumulate_alpha(dst_alpha, (Vec_u32x4)(a_v + dither), 16 + 8);
+
+		r_v += r_ascent*4;
+		g_v += g_ascent*4;
+		b_v += b_ascent*4;
+		a_v += a_ascent*4;
+	}
+
+	/* continue with the remaining pixels */
+	r = r_v[0];
+	g = g_v[0];
+	b = b_v[0];
+	a = a_v[0];
+
+#endif /* GENODE_PIXEL_SPAN_VECTOR */
+
 	for ( ; num_values--; dst++, dst_alpha++, x++) {
 
 		int const dither_value = Genode::Dither_matrix::value(x, y) << 12;
@@ -61,7 +126,7 @@ inline void Polygon::interpolate_rgba(Color start, Color end, Pixel_rgb565 *dst,
 		                         Pixel_rgb565((r + dither_value) >> 16,
 		                                      (g + dither_value) >> 16,
 		                                      (b + dither_value) >> 16),
-		                         (a + dither_value) >> 16);
+		                         Genode::min((a + dither_value) >> 16, max_alpha));
 
 		*dst_alpha += ((255 - *dst_alpha)*(a + dither_value)) >> (16 + 8);
 
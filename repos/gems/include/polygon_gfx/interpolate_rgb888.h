@@ -0,0 +1,94 @@
+/*
+ * \brief  Color interpolation for RGB888 pixels
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The span is processed four pixels at a time using the vector extension
+ * of the compiler. The results are identical to those of the generic
+ * version. Without vector support, the generic version is used.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__POLYGON_GFX__INTERPOLATE_RGB888_H_
+#define _INCLUDE__POLYGON_GFX__INTERPOLATE_RGB888_H_
+
+/* Genode includes */
+#include <polygon_gfx/span_vector.h>
+#include <polygon_gfx/interpolate_rgba.h>
+
+#ifdef GENODE_PIXEL_SPAN_VECTOR
+
+namespace Polygon {
+
+	using Genode::Pixel_rgb888;
+
+	template <>
+	inline void interpolate_rgba(Color, Color, Pixel_rgb888 *,
+	                             unsigned char *, unsigned, int, int);
+}
+
+
+/**
+ * Specialization that processes four pixels at a time
+ */
+template <>
+inline void Polygon::interpolate_rgba(Color start, Color end, Pixel_rgb888 *dst,
+                                      unsigned char *dst_alpha,
+                                      unsigned num_values, int, int)
+{
+	using namespace Span_vector;
+
+	/* sanity check */
+	if (num_values == 0) return;
+
+	/* use 16.16 fixpoint values for the calculation */
+	int const r_ascent = ((end.r - start.r)<<16) / (int)num_values,
+	          g_ascent = ((end.g - start.g)<<16) / (int)num_values,
+	          b_ascent = ((end.b - start.b)<<16) / (int)num_values,
+	          a_ascent = ((end.a - start.a)<<16) / (int)num_values;
+
+	/* color components of four subsequent pixels */
+	Vec_i32x4 r = ramp(start.r<<16, r_ascent),
+	          g = ramp(start.g<<16, g_ascent),
+	          b = ramp(start.b<<16, b_ascent),
+	          a = ramp(start.a<<16, a_ascent);
+
+	for ( ; num_values >= 4; num_values -= 4, dst += 4, dst_alpha += 4) {
+
+		Vec_u32x4 const src = (Vec_u32x4)((((r >> 16) << 16) & 0xff0000)
+		                                | (((g >> 16) <<  8) & 0x00ff00)
+		                                |  ((b >> 16)        & 0x0000ff));
+
+		/* multipliers as used by 'Pixel_rgb888::mix' */
+		Vec_u8x16 const s = rgb_bytes(a >> 16);
+		Vec_u16x8 const s_lo = _lo(s), s_hi = _hi(s);
+
+		_mix_4(dst, &src, (256 - s_lo) & RGB_MASK, s_lo, (256 - s_hi) & RGB_MASK, s_hi);
+
+		accumulate_alpha(dst_alpha, (Vec_u32x4)a, 16 + 8);
+
+		/* increment color-component values by ascent */
+		r += r_ascent*4;
+		g += g_ascent*4;
+		b += b_ascent*4;
+		a += a_ascent*4;
+	}
+
+	/* remaining pixels */
+	for (unsigned i = 0; i < num_values; i++, dst++, dst_alpha++) {
+
+		*dst        = Pixel_rgb888::mix(*dst, Pixel_rgb888(r[i]>>16, g[i]>>16, b[i]>>16),
+		                                a[i]>>16);
+		*dst_alpha += (unsigned char)(((255 - *dst_alpha)*a[i]) >> (16 + 8));
+	}
+}
+
+#endif /* GENODE_PIXEL_SPAN_VECTOR */
+
+#endif /* _INCLUDE__POLYGON_GFX__INTERPOLATE_RGB888_H_ */
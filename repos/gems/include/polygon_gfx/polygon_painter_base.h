@@ -29,17 +29,20 @@ class Polygon::Painter_base
 
 		/**
 		 * Interpolate linearly between start value and end value
+		 *
+		 * \param frac_bits  number of fractional bits of the resulting values
 		 */
 		static inline void _interpolate(int start, int end, int *dst,
-		                                unsigned num_values)
+		                                unsigned num_values, unsigned frac_bits)
 		{
 			/* sanity check */
 			if (num_values == 0) return;
 
 			int const ascent = ((end - start)<<16)/(int)num_values;
+			int const shift  = 16 - (int)frac_bits;
 
 			for (int curr = start<<16; num_values--; curr += ascent)
-				*dst++ = curr>>16;
+				*dst++ = curr>>shift;
 		}
 
 		/**
@@ -94,6 +97,63 @@ class Polygon::Painter_base
 		typedef Genode::Rect<> Rect;
 		typedef Genode::Area<> Area;
 
+		/**
+		 * Fractional bits of the x coordinates stored in the edge buffers
+		 *
+		 * The x coordinate is the edge attribute 0 of each polygon point.
+		 * The fraction is used to compute the coverage of the pixels at
+		 * the polygon edges.
+		 */
+		enum { X_FRAC_BITS = 8, X_FRAC_ONE = 1 << X_FRAC_BITS };
+
+		/**
+		 * Horizontal span of a scanline
+		 *
+		 * The pixels 'x1' to 'x2 - 1' are fully covered by the polygon.
+		 * With anti-aliasing enabled, the pixel left of 'x1' and the pixel
+		 * at 'x2' are partially covered as denoted by 'l_coverage' and
+		 * 'r_coverage' (0...256). Without anti-aliasing, the span covers
+		 * the same pixels as the integer edge coordinates.
+		 */
+		struct Span
+		{
+			int x1 = 0, x2 = 0;
+
+			int l_coverage = 0, r_coverage = 0;
+
+			/**
+			 * Constructor
+			 *
+			 * \param x_l, x_r  edge coordinates with 'X_FRAC_BITS' fraction
+			 */
+			Span(int x_l, int x_r, bool antialias)
+			{
+				int const l = x_l >> X_FRAC_BITS, l_frac = x_l & (X_FRAC_ONE - 1);
+				int const r = x_r >> X_FRAC_BITS, r_frac = x_r & (X_FRAC_ONE - 1);
+
+				if (!antialias || x_l >= x_r) {
+					x1 = l; x2 = r;
+					return;
+				}
+
+				x1 = l_frac ? l + 1 : l;
+				x2 = r;
+
+				/* span within a single pixel */
+				if (l_frac && l == r) {
+					l_coverage = x_r - x_l;
+					return;
+				}
+
+				l_coverage = l_frac ? X_FRAC_ONE - l_frac : 0;
+				r_coverage = r_frac;
+			}
+
+			bool valid() const { return x1 < x2; }
+
+			unsigned w() const { return valid() ? x2 - x1 : 0; }
+		};
+
 		/**
 		 * Buffers used for storing interpolated attribute values along a left
 		 * or right polygon edges.
@@ -227,6 +287,9 @@ class Polygon::Painter_base
 		 * Calculate edge buffers for a polygon
 		 *
 		 * \param N  number of edge attributes
+		 *
+		 * The x coordinates are stored with 'X_FRAC_BITS' fractional bits,
+		 * all other attributes as integers.
 		 */
 		template <unsigned N, typename POINT>
 		void fill_edge_buffers(Edge_buffers<N> &edges,
@@ -238,6 +301,8 @@ class Polygon::Painter_base
 				int * const l_edge = edges.left(i);
 				int * const r_edge = edges.right(i);
 
+				unsigned const frac_bits = (i == 0) ? X_FRAC_BITS : 0;
+
 				for (unsigned j = 0; j < num_points; j++) {
 
 					POINT const p1 = points[j];
@@ -252,11 +317,13 @@ class Polygon::Painter_base
 
 					/* right edge */
 					else if (p1.y() < p2.y())
-						_interpolate(p1_attr, p2_attr, r_edge + p1.y(), p2.y() - p1.y());
+						_interpolate(p1_attr, p2_attr, r_edge + p1.y(), p2.y() - p1.y(),
+						             frac_bits);
 
 					/* left edge */
 					else
-						_interpolate(p2_attr, p1_attr, l_edge + p2.y(), p1.y() - p2.y());
+						_interpolate(p2_attr, p1_attr, l_edge + p2.y(), p1.y() - p2.y(),
+						             frac_bits);
 				}
 			}
 		}
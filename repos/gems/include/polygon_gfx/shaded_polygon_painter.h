@@ -16,7 +16,7 @@
 
 #include <os/surface.h>
 #include <polygon_gfx/polygon_painter_base.h>
-#include <polygon_gfx/interpolate_rgba.h>
+#include <polygon_gfx/interpolate_rgb888.h>
 
 namespace Polygon { class Shaded_painter; }
 
@@ -32,6 +32,16 @@ class Polygon::Shaded_painter : public Polygon::Painter_base
 
 		Edge_buffers<NUM_ATTR> _edges;
 
+		bool _antialias = false;
+
+		/**
+		 * Return color with the alpha value scaled by the pixel coverage
+		 */
+		static Color _covered(Color color, int coverage)
+		{
+			return Color(color.r, color.g, color.b, (color.a*coverage) >> 8);
+		}
+
 	public:
 
 		/**
@@ -82,6 +92,11 @@ class Polygon::Shaded_painter : public Polygon::Painter_base
 			_edges(alloc, max_height)
 		{ }
 
+		/**
+		 * Enable or disable the anti-aliasing of the left and right edges
+		 */
+		void antialias(bool enabled) { _antialias = enabled; }
+
 		/**
 		 * Draw polygon with linearly interpolated color
 		 *
@@ -126,13 +141,23 @@ class Polygon::Shaded_painter : public Polygon::Painter_base
 				Color l_color = Color(r_l_edge[y], g_l_edge[y], b_l_edge[y], a_l_edge[y]);
 				Color r_color = Color(r_r_edge[y], g_r_edge[y], b_r_edge[y], a_r_edge[y]);
 
-				int const x_l = x_l_edge[y];
-				int const x_r = x_r_edge[y];
+				Span const span(x_l_edge[y], x_r_edge[y], _antialias);
+
+				if (span.valid())
+					interpolate_rgba(l_color, r_color, dst_pixel + span.x1,
+					                 (unsigned char *)dst_alpha + span.x1,
+					                 span.w(), span.x1, y);
+
+				/* partially covered pixels at the edges */
+				auto paint_edge_pixel = [&] (int x, Color color, int coverage) {
+					if (coverage)
+						interpolate_rgba(_covered(color, coverage),
+						                 _covered(color, coverage),
+						                 dst_pixel + x, (unsigned char *)dst_alpha + x,
+						                 1, x, y); };
 
-				if (x_l < x_r)
-					interpolate_rgba(l_color, r_color, dst_pixel + x_l,
-					                 (unsigned char *)dst_alpha + x_l,
-					                 x_r - x_l, x_l, y);
+				paint_edge_pixel(span.x1 - 1, l_color, span.l_coverage);
+				paint_edge_pixel(span.x2,     r_color, span.r_coverage);
 
 				dst_pixel += dst_w;
 				dst_alpha += dst_w;
@@ -0,0 +1,94 @@
+/*
+ * \brief  Vector helpers for the span fillers of the polygon painters
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The span fillers process four pixels at a time. Each attribute of the
+ * four pixels is held in a vector of 32-bit integers.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__POLYGON_GFX__SPAN_VECTOR_H_
+#define _INCLUDE__POLYGON_GFX__SPAN_VECTOR_H_
+
+/* Genode includes */
+#include <os/pixel_span.h>
+
+#ifdef GENODE_PIXEL_SPAN_VECTOR
+
+namespace Polygon { namespace Span_vector {
+
+	using namespace Genode::Pixel_span;
+
+	typedef int Vec_i32x4 __attribute__((vector_size(16)));
+
+	/**
+	 * Return values 'start', 'start + ascent', ... of four pixels
+	 */
+	static inline Vec_i32x4 ramp(int start, int ascent)
+	{
+		return start + Vec_i32x4 { 0, 1, 2, 3 }*ascent;
+	}
+
+	/**
+	 * Zero-extend the alpha values of four pixels to 32 bit
+	 */
+	static inline Vec_u32x4 load_alpha(unsigned char const *alpha)
+	{
+		Vec_u8x16 const v = (Vec_u8x16)Vec_u32x4 { _load<Genode::uint32_t>(alpha), 0, 0, 0 };
+
+		return (Vec_u32x4)_lo((Vec_u8x16)_lo(v));
+	}
+
+	/**
+	 * Truncate the values of four pixels to alpha bytes
+	 */
+	static inline void store_alpha(unsigned char *alpha, Vec_u32x4 v)
+	{
+		Vec_u8x16 const b = _pack((Vec_u16x8)_pack((Vec_u16x8)v, Vec_u16x8 { }),
+		                          Vec_u16x8 { });
+
+		_store(alpha, ((Vec_u32x4)b)[0]);
+	}
+
+	/**
+	 * Replicate the values of four pixels to the color bytes of RGB888
+	 * pixels as expected by '_mix_4'
+	 *
+	 * The values must be in the range of 0...255. The fourth byte of each
+	 * pixel is 0.
+	 */
+	static inline Vec_u8x16 rgb_bytes(Vec_i32x4 v)
+	{
+		return (Vec_u8x16)(v | (v << 8) | (v << 16));
+	}
+
+	/**
+	 * Mask for clearing the multipliers of the fourth byte of each pixel
+	 */
+	static Vec_u16x8 const RGB_MASK = { 0xffff, 0xffff, 0xffff, 0,
+	                                    0xffff, 0xffff, 0xffff, 0 };
+
+	/**
+	 * Accumulate alpha values of four pixels like '*dst += ((255 - *dst)*a) >> shift'
+	 *
+	 * The computation is performed with unsigned arithmetic, which yields
+	 * the same lower 8 bits as the 'int' arithmetic of the scalar code.
+	 */
+	static inline void accumulate_alpha(unsigned char *dst, Vec_u32x4 a, unsigned shift)
+	{
+		Vec_u32x4 const d = load_alpha(dst);
+
+		store_alpha(dst, d + (((255 - d)*a) >> shift));
+	}
+} }
+
+#endif /* GENODE_PIXEL_SPAN_VECTOR */
+
+#endif /* _INCLUDE__POLYGON_GFX__SPAN_VECTOR_H_ */
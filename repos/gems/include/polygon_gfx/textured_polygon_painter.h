@@ -17,7 +17,7 @@
 #include <os/surface.h>
 #include <os/texture.h>
 #include <polygon_gfx/polygon_painter_base.h>
-#include <polygon_gfx/texturize_rgba.h>
+#include <polygon_gfx/texturize_rgb888.h>
 
 namespace Polygon { class Textured_painter; }
 
@@ -33,6 +33,8 @@ class Polygon::Textured_painter : public Polygon::Painter_base
 
 		Edge_buffers<NUM_ATTR> _edges;
 
+		bool _antialias = false;
+
 	public:
 
 		/**
@@ -79,6 +81,11 @@ class Polygon::Textured_painter : public Polygon::Painter_base
 			_edges(alloc, max_height)
 		{ }
 
+		/**
+		 * Enable or disable the anti-aliasing of the left and right edges
+		 */
+		void antialias(bool enabled) { _antialias = enabled; }
+
 		/**
 		 * Draw textured polygon
 		 *
@@ -110,6 +117,7 @@ class Polygon::Textured_painter : public Polygon::Painter_base
 			int * const v_r_edge = _edges.right(ATTR_V);
 
 			unsigned      const  src_w     = texture.size().w();
+			unsigned      const  src_h     = texture.size().h();
 			PT            const *src_pixel = texture.pixel();
 			unsigned char const *src_alpha = texture.alpha();
 
@@ -127,13 +135,27 @@ class Polygon::Textured_painter : public Polygon::Painter_base
 				Genode::Point<> const l_texpos(u_l_edge[y], v_l_edge[y]);
 				Genode::Point<> const r_texpos(u_r_edge[y], v_r_edge[y]);
 
-				int const x_l = x_l_edge[y];
-				int const x_r = x_r_edge[y];
+				Span const span(x_l_edge[y], x_r_edge[y], _antialias);
 
-				if (x_l < x_r)
+				if (span.valid())
 					texturize_rgba(l_texpos, r_texpos,
-					               dst_pixel + x_l, (unsigned char *)dst_alpha + x_l,
-					               x_r - x_l, src_pixel, src_alpha, src_w);
+					               dst_pixel + span.x1, (unsigned char *)dst_alpha + span.x1,
+					               span.w(), src_pixel, src_alpha, src_w);
+
+				/*
+				 * Partially covered pixels at the edges, the texture
+				 * coordinates of the edges may refer to the texel just
+				 * beyond the texture.
+				 */
+				auto paint_edge_pixel = [&] (int x, Genode::Point<> texpos, int coverage) {
+					if (coverage)
+						texturize_rgba_pixel(Genode::Point<>(Genode::min(texpos.x(), (int)src_w - 1),
+						                                     Genode::min(texpos.y(), (int)src_h - 1)),
+						                     dst_pixel + x, (unsigned char *)dst_alpha + x,
+						                     coverage, src_pixel, src_alpha, src_w); };
+
+				paint_edge_pixel(span.x1 - 1, l_texpos, span.l_coverage);
+				paint_edge_pixel(span.x2,     r_texpos, span.r_coverage);
 
 				dst_pixel += dst_w;
 				dst_alpha += dst_w;
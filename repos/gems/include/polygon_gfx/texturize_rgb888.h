@@ -0,0 +1,97 @@
+/*
+ * \brief  Texturing of RGB888 scanlines
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The texel offsets and the alpha values of four subsequent pixels are
+ * computed at once using the vector extension of the compiler. The results
+ * are identical to those of the generic version. Without vector support,
+ * the generic version is used.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__POLYGON_GFX__TEXTURIZE_RGB888_H_
+#define _INCLUDE__POLYGON_GFX__TEXTURIZE_RGB888_H_
+
+/* Genode includes */
+#include <polygon_gfx/span_vector.h>
+#include <polygon_gfx/texturize_rgba.h>
+
+#ifdef GENODE_PIXEL_SPAN_VECTOR
+
+namespace Polygon {
+
+	using Genode::Pixel_rgb888;
+
+	template <>
+	inline void texturize_rgba(Genode::Point<>, Genode::Point<>, Pixel_rgb888 *,
+	                           unsigned char *, unsigned, Pixel_rgb888 const *,
+	                           unsigned char const *, unsigned);
+}
+
+
+/**
+ * Specialization that processes four pixels at a time
+ */
+template <>
+inline void Polygon::texturize_rgba(Genode::Point<> start, Genode::Point<> end,
+                                    Pixel_rgb888 *dst, unsigned char *dst_alpha,
+                                    unsigned num_values,
+                                    Pixel_rgb888 const *texture_base,
+                                    unsigned char const *alpha_base,
+                                    unsigned texture_width)
+{
+	using namespace Span_vector;
+
+	/* sanity check */
+	if (num_values == 0) return;
+
+	/* use 16.16 fixpoint values for the calculation */
+	int const tx_ascent = ((end.x() - start.x())<<16)/(int)num_values,
+	          ty_ascent = ((end.y() - start.y())<<16)/(int)num_values;
+
+	/* texture positions of four subsequent pixels */
+	Vec_i32x4 tx = ramp(start.x()<<16, tx_ascent),
+	          ty = ramp(start.y()<<16, ty_ascent);
+
+	for ( ; num_values >= 4; num_values -= 4, dst += 4, dst_alpha += 4) {
+
+		Vec_i32x4 const offset = (ty>>16)*(int)texture_width + (tx>>16);
+
+		Vec_u32x4 const pixel = { texture_base[offset[0]].pixel,
+		                          texture_base[offset[1]].pixel,
+		                          texture_base[offset[2]].pixel,
+		                          texture_base[offset[3]].pixel };
+		_store(dst, pixel);
+
+		Vec_u32x4 const a = { alpha_base[offset[0]], alpha_base[offset[1]],
+		                      alpha_base[offset[2]], alpha_base[offset[3]] };
+
+		accumulate_alpha(dst_alpha, a, 8);
+
+		/* walk through texture */
+		tx += tx_ascent*4;
+		ty += ty_ascent*4;
+	}
+
+	/* remaining pixels */
+	for (unsigned i = 0; i < num_values; i++, dst++, dst_alpha++) {
+
+		unsigned long const src_offset = (ty[i]>>16)*texture_width + (tx[i]>>16);
+
+		int const a = alpha_base[src_offset];
+
+		*dst        = texture_base[src_offset];
+		*dst_alpha += (unsigned char)(((255 - *dst_alpha)*a) >> 8);
+	}
+}
+
+#endif /* GENODE_PIXEL_SPAN_VECTOR */
+
+#endif /* _INCLUDE__POLYGON_GFX__TEXTURIZE_RGB888_H_ */
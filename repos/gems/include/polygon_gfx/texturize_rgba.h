@@ -25,6 +25,11 @@ namespace Polygon {
 	static inline void texturize_rgba(Genode::Point<>, Genode::Point<>, PT *,
 	                                  unsigned char *, unsigned, PT const *,
 	                                  unsigned char const *, unsigned);
+
+	template <typename PT>
+	static inline void texturize_rgba_pixel(Genode::Point<>, PT *,
+	                                        unsigned char *, int, PT const *,
+	                                        unsigned char const *, unsigned);
 }
 
 
@@ -66,4 +71,26 @@ static inline void Polygon::texturize_rgba(Genode::Point<> start, Genode::Point<
 	}
 }
 
+
+/**
+ * Texturize partially covered pixel at a polygon edge
+ *
+ * \param coverage  covered fraction of the pixel (0...256)
+ */
+template <typename PT>
+static inline void Polygon::texturize_rgba_pixel(Genode::Point<> texpos,
+                                                 PT *dst, unsigned char *dst_alpha,
+                                                 int coverage,
+                                                 PT const *texture_base,
+                                                 unsigned char const *alpha_base,
+                                                 unsigned texture_width)
+{
+	unsigned long const src_offset = texpos.y()*texture_width + texpos.x();
+
+	int const a = (alpha_base[src_offset]*coverage) >> 8;
+
+	*dst        = PT::mix(*dst, texture_base[src_offset], coverage);
+	*dst_alpha += (unsigned char)(((255 - *dst_alpha)*a) >> 8);
+}
+
 #endif /* _INCLUDE__POLYGON_GFX__TEXTURIZE_RGBA_H_ */
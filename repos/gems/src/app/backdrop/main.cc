@@ -22,15 +22,19 @@
 #include <base/attached_dataspace.h>
 #include <util/reconstructible.h>
 #include <os/texture_rgb888.h>
+#include <timer_session/connection.h>
 
 /* gems includes */
 #include <gems/png_image.h>
 #include <gems/file.h>
 #include <gems/xml_anchor.h>
-#include <gems/texture_utils.h>
+#include <gems/texture_cache.h>
 
 /* libc includes */
 #include <libc/component.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdio.h>
 
 using namespace Genode;
 
@@ -110,6 +114,90 @@ struct Backdrop::Main
 
 	Constructible<Buffer> _buffer { };
 
+	typedef Texture_cache<Pixel_rgb888> Cache;
+
+	/**
+	 * Backing store of the texture cache located in a directory of the VFS
+	 *
+	 * When hosted by a file-system server, the decoded textures survive
+	 * restarts of the backdrop and can be shared by several instances.
+	 */
+	struct Cache_directory : Cache::Backing_store
+	{
+		typedef String<256> Path;
+
+		Path const path;
+
+		Path _file_path(Cache::Key const &key, char const *suffix) const
+		{
+			return Path(path, "/", key.name(), suffix);
+		}
+
+		Cache_directory(Path const &path) : path(path) { }
+
+		bool load(Cache::Key const &key, void *dst, size_t num_bytes) override
+		{
+			int const fd = ::open(_file_path(key, ".tex").string(), O_RDONLY);
+			if (fd < 0)
+				return false;
+
+			size_t  remain = num_bytes;
+			char   *data   = (char *)dst;
+			while (remain > 0) {
+				ssize_t const ret = ::read(fd, data, remain);
+				if (ret <= 0)
+					break;
+
+				remain -= ret;
+				data   += ret;
+			}
+			::close(fd);
+
+			return remain == 0;
+		}
+
+		void store(Cache::Key const &key, void const *src, size_t num_bytes) override
+		{
+			/* write to a temporary file to never expose an incomplete texture */
+			Path const tmp_path  = _file_path(key, ".tmp");
+			Path const file_path = _file_path(key, ".tex");
+
+			int const fd = ::open(tmp_path.string(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+			if (fd < 0) {
+				warning("unable to create ", tmp_path);
+				return;
+			}
+
+			size_t      remain = num_bytes;
+			char const *data   = (char const *)src;
+			while (remain > 0) {
+				ssize_t const ret = ::write(fd, data, remain);
+				if (ret <= 0)
+					break;
+
+				remain -= ret;
+				data   += ret;
+			}
+			::close(fd);
+
+			if (remain == 0 && ::rename(tmp_path.string(), file_path.string()) == 0)
+				return;
+
+			::unlink(tmp_path.string());
+			warning("unable to store ", file_path);
+		}
+	};
+
+	Constructible<Cache_directory> _cache_directory { };
+	Constructible<Cache>           _cache           { };
+
+	void _apply_cache_config(Xml_node);
+
+	/* used for measuring the duration of composing the backdrop */
+	Constructible<Timer::Connection> _timer { };
+
+	unsigned _num_images = 0;
+
 	Gui::Session::View_handle _view_handle = _gui.create_view();
 
 	void _update_view()
@@ -269,28 +357,33 @@ void Backdrop::Main::_apply_image(Xml_node operation)
 
 	unsigned alpha = operation.attribute_value("alpha", 256U);
 
-	/* obtain texture containing the pixels of the PNG image */
-	Texture<Pixel_rgb888> *png_texture = png_image.texture<Pixel_rgb888>();
-
-	/* create texture with the scaled image */
-	Chunky_texture<Pixel_rgb888> scaled_texture(_env.ram(), _env.rm(), scaled_size);
-	scale(*png_texture, scaled_texture, _heap);
-
-	png_image.release_texture(png_texture);
-
 	/*
 	 * Code specific for the screen mode's pixel format
 	 */
-
-	/* create texture with down-sampled scaled image */
 	typedef Pixel_rgb888 PT;
-	Chunky_texture<PT> texture(_env.ram(), _env.rm(), scaled_size);
-	convert_pixel_format(scaled_texture, texture, alpha, _heap);
+
+	/* decode PNG image into texture of the scaled size with alpha applied */
+	auto decode = [&] (Texture<PT> &texture) {
+		png_image.decode(texture, alpha); };
 
 	/* paint texture onto surface */
-	_buffer->apply_to_surface<PT>([&] (Surface<PT> &surface) {
-		_paint_texture(surface, texture, pos, tiled);
-	});
+	auto paint = [&] (Texture<PT> const &texture) {
+		_buffer->apply_to_surface<PT>([&] (Surface<PT> &surface) {
+			_paint_texture(surface, texture, pos, tiled);
+		});
+	};
+
+	if (_cache.constructed()) {
+		Cache::Key const key { Cache::Key::hash_of(file.data<void>(), file.size()),
+		                       scaled_size, alpha };
+		_cache->with_texture(key, decode, paint);
+	} else {
+		Chunky_texture<PT> texture(_env.ram(), _env.rm(), scaled_size);
+		decode(texture);
+		paint(texture);
+	}
+
+	_num_images++;
 }
 
 
@@ -312,10 +405,57 @@ void Backdrop::Main::_apply_fill(Xml_node operation)
 }
 
 
+void Backdrop::Main::_apply_cache_config(Xml_node config)
+{
+	if (!config.has_sub_node("cache")) {
+		_cache.destruct();
+		_cache_directory.destruct();
+		return;
+	}
+
+	Xml_node const node = config.sub_node("cache");
+
+	size_t const max_bytes =
+		node.attribute_value("size", Number_of_bytes(16*1024*1024));
+
+	Cache_directory::Path const path =
+		node.attribute_value("path", Cache_directory::Path());
+
+	bool const path_changed = _cache_directory.constructed()
+	                        ? (_cache_directory->path != path) : path.valid();
+
+	/* keep cached textures if only the limit changed */
+	if (_cache.constructed() && !path_changed) {
+		_cache->max_bytes(max_bytes);
+		return;
+	}
+
+	_cache.destruct();
+	_cache_directory.conditional(path.valid(), path);
+	_cache.construct(_env.ram(), _env.rm(), _heap, max_bytes,
+	                 _cache_directory.constructed() ? &*_cache_directory : nullptr);
+}
+
+
 void Backdrop::Main::_handle_config()
 {
 	_config.update();
 
+	if (_config.xml().attribute_value("log_duration", false)) {
+		if (!_timer.constructed())
+			_timer.construct(_env);
+	} else {
+		_timer.destruct();
+	}
+
+	uint64_t const start_us = _timer.constructed() ? _timer->elapsed_us() : 0;
+
+	_apply_cache_config(_config.xml());
+
+	Cache::Stats const start_stats = _cache.constructed()
+	                               ? _cache->stats() : Cache::Stats { 0, 0, 0 };
+	_num_images = 0;
+
 	Framebuffer::Mode const phys_mode = _gui.mode();
 	Framebuffer::Mode const
 		mode { .area = { _config.xml().attribute_value("width",  phys_mode.area.w()),
@@ -343,6 +483,20 @@ void Backdrop::Main::_handle_config()
 		}
 	});
 
+	if (_timer.constructed()) {
+
+		/* without cache, each image is decoded */
+		Cache::Stats const stats = _cache.constructed()
+		                         ? _cache->stats() : Cache::Stats { 0, 0, _num_images };
+
+		log("backdrop: ", mode.area, " composed in ",
+		    _timer->elapsed_us() - start_us, " us (",
+		    _num_images, " images, ",
+		    stats.hits    - start_stats.hits,    " cached, ",
+		    stats.loads   - start_stats.loads,   " loaded, ",
+		    stats.decodes - start_stats.decodes, " decoded)");
+	}
+
 	/* schedule buffer refresh */
 	_gui.framebuffer()->sync_sigh(_sync_handler);
 }
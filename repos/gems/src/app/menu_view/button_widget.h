@@ -194,6 +194,9 @@ struct Menu_view::Button_widget : Widget, Animator::Item
 	}
 
 
+	bool _animating() const override { return Animator::Item::animated(); }
+
+
 	/******************************
 	 ** Animator::Item interface **
 	 ******************************/
@@ -92,6 +92,12 @@ class Menu_view::Cursor : List_model<Cursor>::Element
 			_move_to(_position_from_xml_node(node), Steps{0});
 		}
 
+		bool animated() const { return _position.animated(); }
+
+		/**
+		 * Number of pixels drawn left of the cursor position
+		 */
+		unsigned overdraw() const { return _texture ? _texture->size().w()/2 : 0; }
 
 		void draw(Surface<Pixel_rgb888> &pixel_surface,
 		          Surface<Pixel_alpha8> &alpha_surface,
@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <base/registry.h>
+#include <util/dictionary.h>
 
 /* gems includes */
 #include <polygon_gfx/line_painter.h>
@@ -36,12 +37,60 @@ struct Menu_view::Depgraph_widget : Widget
 
 	} _depth_direction { Depth_direction::EAST };
 
+	struct Node;
+
+	/**
+	 * Entry for the lookup of a node by its name
+	 */
+	struct Node_name : Dictionary<Node_name, Name>::Element
+	{
+		Node &node;
+
+		Node_name(Dictionary<Node_name, Name> &dictionary, Name const &name, Node &node)
+		:
+			Dictionary<Node_name, Name>::Element(dictionary, name), node(node)
+		{ }
+	};
+
+	typedef Dictionary<Node_name, Name> Node_dictionary;
+
 	struct Node
 	{
 		Allocator &_alloc;
 		Widget    &_widget;
 		Animator  &_animator;
 
+		/*
+		 * Values memoized during the layout computation
+		 *
+		 * The values are valid as long as '_memo_generation' equals the
+		 * generation of the depgraph, which is incremented whenever the
+		 * layout must be computed anew.
+		 */
+		unsigned const &_generation;
+
+		struct Memo
+		{
+			unsigned generation = ~0U;
+			unsigned value      = 0;
+
+			template <typename FN>
+			unsigned apply(unsigned curr_generation, FN const &fn)
+			{
+				if (generation != curr_generation) {
+					value      = fn();
+					generation = curr_generation;
+				}
+				return value;
+			}
+		};
+
+		Memo mutable _depth_pos_memo    { };
+		Memo mutable _breadth_size_memo { };
+		Memo mutable _breadth_pos_memo  { };
+
+		Node_name _name;
+
 		struct Anchor
 		{
 			Node &_remote;
@@ -216,8 +265,12 @@ struct Menu_view::Depgraph_widget : Widget
 		 */
 		unsigned layout_breadth_offset = 0;
 
-		Node(Allocator &alloc, Widget &widget, Animator &animator)
-		: _alloc(alloc), _widget(widget), _animator(animator) { }
+		Node(Node_dictionary &dictionary, Allocator &alloc, Widget &widget,
+		     Animator &animator, unsigned const &generation)
+		:
+			_alloc(alloc), _widget(widget), _animator(animator),
+			_generation(generation), _name(dictionary, widget.name(), *this)
+		{ }
 
 		template <typename FN>
 		void for_each_dependent_node(FN const &fn)
@@ -227,6 +280,14 @@ struct Menu_view::Depgraph_widget : Widget
 
 		virtual ~Node() { cut_dependencies(); }
 
+		bool deps_animated() const
+		{
+			bool result = false;
+			_deps.for_each([&] (Dependency const &dep) {
+				if (dep.animated()) result = true; });
+			return result;
+		}
+
 		bool has_deps() const
 		{
 			bool result = false;
@@ -262,12 +323,15 @@ struct Menu_view::Depgraph_widget : Widget
 		 */
 		unsigned breadth_size(Depth_direction dir) const
 		{
-			unsigned const widget_size =
-				dir.horizontal() ? _widget.min_size().h() : _widget.min_size().w();
+			return _breadth_size_memo.apply(_generation, [&] {
+
+				unsigned const widget_size =
+					dir.horizontal() ? _widget.min_size().h() : _widget.min_size().w();
 
-			unsigned const breadth_padding = 10;
+				unsigned const breadth_padding = 10;
 
-			return max(widget_size + breadth_padding, _breadth_clients_size(dir));
+				return max(widget_size + breadth_padding, _breadth_clients_size(dir));
+			});
 		}
 
 		/**
@@ -275,13 +339,16 @@ struct Menu_view::Depgraph_widget : Widget
 		 */
 		unsigned depth_pos(Depth_direction dir) const
 		{
-			/* maximum depth position of all nodes we depend on */
-			unsigned max_deps_depth = 0;
-			_deps.for_each([&] (Dependency const &dep) {
-				max_deps_depth = max(max_deps_depth, dep.server_depth_pos(dir)); });
+			return _depth_pos_memo.apply(_generation, [&] {
+
+				/* maximum depth position of all nodes we depend on */
+				unsigned max_deps_depth = 0;
+				_deps.for_each([&] (Dependency const &dep) {
+					max_deps_depth = max(max_deps_depth, dep.server_depth_pos(dir)); });
 
-			unsigned depth_padding = 10;
-			return max_deps_depth + depth_padding;
+				unsigned depth_padding = 10;
+				return max_deps_depth + depth_padding;
+			});
 		}
 
 		/**
@@ -306,7 +373,8 @@ struct Menu_view::Depgraph_widget : Widget
 		 */
 		unsigned breadth_pos(Depth_direction dir) const
 		{
-			return _primary_dep_breadth_pos(dir) + layout_breadth_offset;
+			return _breadth_pos_memo.apply(_generation, [&] {
+				return _primary_dep_breadth_pos(dir) + layout_breadth_offset; });
 		}
 
 		void mark_deps_as_out_of_date()
@@ -425,7 +493,53 @@ struct Menu_view::Depgraph_widget : Widget
 
 	Node_registry _nodes { };
 
-	Registered_node _root_node { _nodes, _factory.alloc, *this, _factory.animator };
+	/* lookup of nodes by name */
+	Node_dictionary _node_dictionary { };
+
+	/* generation of the memoized layout values of the nodes */
+	unsigned _layout_generation = 0;
+
+	/* hash of the topology and node sizes of the last layout */
+	unsigned long _topology_hash = 0;
+
+	/*
+	 * Set whenever a node is created or destroyed, which invalidates the
+	 * hash because the new node lacks layout values.
+	 */
+	bool _nodes_changed = true;
+
+	Registered_node _root_node { _nodes, _node_dictionary, _factory.alloc, *this,
+	                             _factory.animator, _layout_generation };
+
+	template <typename FN>
+	void _with_node(Name const &name, FN const &fn)
+	{
+		_node_dictionary.with_element(name,
+			[&] (Node_name &entry) { fn(entry.node); },
+			[&] { });
+	}
+
+	/**
+	 * Call 'fn' for the node of each child widget, in the order of children
+	 */
+	template <typename FN>
+	void _for_each_child_node(FN const &fn)
+	{
+		_children.for_each([&] (Widget &w) {
+
+			Node *found = nullptr;
+			_with_node(w.name(), [&] (Node &node) {
+				if (node.belongs_to(w)) found = &node; });
+
+			/* fall back to searching all nodes if the name is ambiguous */
+			if (!found)
+				_nodes.for_each([&] (Registered_node &node) {
+					if (node.belongs_to(w)) found = &node; });
+
+			if (found)
+				fn(w, *found);
+		});
+	}
 
 	/*
 	 * Defined by 'update', used by '_layout'
@@ -452,13 +566,19 @@ struct Menu_view::Depgraph_widget : Widget
 		Allocator                   &_alloc;
 		Animator                    &_animator;
 		Node_registry               &_nodes;
+		Node_dictionary             &_node_dictionary;
+		unsigned const              &_layout_generation;
+		bool                        &_nodes_changed;
 
 		Model_update_policy(Widget::Model_update_policy &policy,
 		                    Allocator &alloc, Animator &animator,
-		                    Node_registry &nodes)
+		                    Node_registry &nodes, Node_dictionary &node_dictionary,
+		                    unsigned const &layout_generation, bool &nodes_changed)
 		:
 			_generic_model_update_policy(policy),
-			_alloc(alloc), _animator(animator), _nodes(nodes)
+			_alloc(alloc), _animator(animator), _nodes(nodes),
+			_node_dictionary(node_dictionary), _layout_generation(layout_generation),
+			_nodes_changed(nodes_changed)
 		{ }
 
 		void _destroy_node(Registered_node &node)
@@ -474,6 +594,8 @@ struct Menu_view::Depgraph_widget : Widget
 			Widget &w = node._widget;
 			destroy(_alloc, &node);
 			_generic_model_update_policy.destroy_element(w);
+
+			_nodes_changed = true;
 		}
 
 		void destroy_element(Widget &w)
@@ -489,7 +611,9 @@ struct Menu_view::Depgraph_widget : Widget
 		Widget &create_element(Xml_node elem_node)
 		{
 			Widget &w = _generic_model_update_policy.create_element(elem_node);
-			new (_alloc) Registered_node(_nodes, _alloc, w, _animator);
+			new (_alloc) Registered_node(_nodes, _node_dictionary, _alloc, w,
+			                             _animator, _layout_generation);
+			_nodes_changed = true;
 			return w;
 		}
 
@@ -504,7 +628,8 @@ struct Menu_view::Depgraph_widget : Widget
 		}
 
 	} _model_update_policy { Widget::_model_update_policy,
-	                         _factory.alloc, _factory.animator, _nodes };
+	                         _factory.alloc, _factory.animator, _nodes,
+	                         _node_dictionary, _layout_generation, _nodes_changed };
 
 	Depgraph_widget(Widget_factory &factory, Xml_node node, Unique_id unique_id)
 	:
@@ -531,6 +656,8 @@ struct Menu_view::Depgraph_widget : Widget
 
 		_children.update_from_xml(_model_update_policy, node);
 
+		_layout_valid = false;
+
 		/*
 		 * Import dependencies
 		 */
@@ -558,10 +685,8 @@ struct Menu_view::Depgraph_widget : Widget
 				return;
 
 			Node *client = nullptr, *server = nullptr;
-			_nodes.for_each([&] (Node &node) {
-				if (node.has_name(client_name)) client = &node;
-				if (node.has_name(server_name)) server = &node;
-			});
+			_with_node(client_name, [&] (Node &node) { client = &node; });
+			_with_node(server_name, [&] (Node &node) { server = &node; });
 
 			if (client && server && client != server)
 				client->depends_on(*server,
@@ -580,6 +705,41 @@ struct Menu_view::Depgraph_widget : Widget
 		_nodes.for_each([&] (Node &node) {
 			node.destroy_stale_deps(); });
 
+		/*
+		 * Skip the layout computation if neither the set of nodes, the
+		 * topology, nor the size of any node changed, e.g., when merely the
+		 * text of a label changed
+		 */
+		{
+			unsigned long hash = 5381 + _depth_direction.value;
+			auto add = [&] (unsigned long value) { hash = hash*33 + value; };
+
+			auto add_name = [&] (Widget const &w) {
+				for (char const *s = w.name().string(); *s; s++)
+					add((unsigned char)*s); };
+
+			_for_each_child_node([&] (Widget &w, Node &node) {
+				add_name(w);
+				add(w.min_size().w());
+				add(w.min_size().h());
+				node._deps.for_each([&] (Node::Dependency const &dep) {
+					dep.apply_to_server([&] (Node const &server) {
+						add_name(server._widget);
+						add(dep.primary()); }); });
+			});
+
+			bool const unchanged = !_nodes_changed && (hash == _topology_hash);
+
+			_topology_hash = hash;
+			_nodes_changed = false;
+
+			if (unchanged)
+				return;
+		}
+
+		/* invalidate the memoized layout values of all nodes */
+		_layout_generation++;
+
 		_nodes.for_each([&] (Node &node) {
 			node.layout_breadth_child_offset = 0; });
 
@@ -588,19 +748,15 @@ struct Menu_view::Depgraph_widget : Widget
 		 *
 		 * The computation depends on the order of '_children'.
 		 */
-		_children.for_each([&] (Widget &w) {
-			_nodes.for_each([&] (Registered_node &node) {
-				if (!node.belongs_to(w))
-					return;
+		_for_each_child_node([&] (Widget &, Node &node) {
 
-				apply_to_primary_dependency(node, [&] (Node &parent) {
+			apply_to_primary_dependency(node, [&] (Node &parent) {
 
-					node.layout_breadth_offset = parent.layout_breadth_child_offset;
+				node.layout_breadth_offset = parent.layout_breadth_child_offset;
 
-					/* advance breadth offset at parent by size of current node */
-					parent.layout_breadth_child_offset +=
-						node.breadth_size(_depth_direction);
-				});
+				/* advance breadth offset at parent by size of current node */
+				parent.layout_breadth_child_offset +=
+					node.breadth_size(_depth_direction);
 			});
 		});
 
@@ -616,28 +772,24 @@ struct Menu_view::Depgraph_widget : Widget
 		 * phase.
 		 */
 		_bounding_box = Rect(Point(0, 0), Area(0, 0));
-		_children.for_each([&] (Widget &w) {
-			_nodes.for_each([&] (Registered_node &node) {
-				if (!node.belongs_to(w))
-					return;
+		_for_each_child_node([&] (Widget &w, Node &node) {
 
-				int const depth_pos    = node.depth_pos(_depth_direction),
-				          breadth_pos  = node.breadth_pos(_depth_direction),
-				          depth_size   = node.depth_size(_depth_direction),
-				          breadth_size = node.breadth_size(_depth_direction);
+			int const depth_pos    = node.depth_pos(_depth_direction),
+			          breadth_pos  = node.breadth_pos(_depth_direction),
+			          depth_size   = node.depth_size(_depth_direction),
+			          breadth_size = node.breadth_size(_depth_direction);
 
-				Rect const node_rect = _depth_direction.horizontal()
-				                     ? Rect(Point(depth_pos, breadth_pos),
-				                            Area(depth_size, breadth_size))
-				                     : Rect(Point(breadth_pos, depth_pos),
-				                            Area(breadth_size, depth_size));
+			Rect const node_rect = _depth_direction.horizontal()
+			                     ? Rect(Point(depth_pos, breadth_pos),
+			                            Area(depth_size, breadth_size))
+			                     : Rect(Point(breadth_pos, depth_pos),
+			                            Area(breadth_size, depth_size));
 
-				Rect geometry(node_rect.center(w.min_size()), w.min_size());
+			Rect geometry(node_rect.center(w.min_size()), w.min_size());
 
-				node.widget_geometry(geometry);
+			node.widget_geometry(geometry);
 
-				_bounding_box = Rect::compound(_bounding_box, geometry);
-			});
+			_bounding_box = Rect::compound(_bounding_box, geometry);
 		});
 	}
 
@@ -713,6 +865,25 @@ struct Menu_view::Depgraph_widget : Widget
 		});
 	}
 
+	/*
+	 * The connections between the nodes are drawn by the depgraph widget.
+	 * Hence, it is redrawn as a whole whenever a node or dependency changes.
+	 */
+	bool _content_includes_sub_nodes() const override { return true; }
+
+	bool _damaged_by_children() const override { return true; }
+
+	bool _animating() const override
+	{
+		bool result = false;
+		_nodes.for_each([&] (Registered_node const &node) {
+			if (node.deps_animated()) result = true; });
+		return result;
+	}
+
+	/* the shadows of the connections are drawn one pixel below */
+	unsigned _overdraw() const override { return 2; }
+
 	void draw(Surface<Pixel_rgb888> &pixel_surface,
 	          Surface<Pixel_alpha8> &alpha_surface,
 	          Point at) const override
@@ -35,6 +35,8 @@ struct Menu_view::Label_widget : Widget, Cursor::Glyph_position
 	int _min_width  = 0;
 	int _min_height = 0;
 
+	int _text_width = 0;  /* value cached from 'update' */
+
 	Cursor::Model_update_policy         _cursor_update_policy;
 	Text_selection::Model_update_policy _selection_update_policy;
 
@@ -61,6 +63,7 @@ struct Menu_view::Label_widget : Widget, Cursor::Glyph_position
 		_text       = Text("");
 		_min_width  = 0;
 		_min_height = 0;
+		_text_width = 0;
 
 		_factory.styles.with_label_style(node, [&] (Label_style style) {
 			_color.fade_to(style.color, Animated_color::Steps{80}); });
@@ -69,11 +72,12 @@ struct Menu_view::Label_widget : Widget, Cursor::Glyph_position
 			_text       = node.attribute_value("text", _text);
 			_text       = Xml_unquoted(_text);
 			_min_height = _font->height();
+			_text_width = _factory.styles.string_width(*_font, _text.string()).decimal();
 		}
 
 		unsigned const min_ex = node.attribute_value("min_ex", 0U);
 		if (min_ex) {
-			Glyph_painter::Fixpoint_number min_w_px = _font->string_width("x");
+			Glyph_painter::Fixpoint_number min_w_px = _factory.styles.string_width(*_font, "x");
 			min_w_px.value *= min_ex;
 			_min_width = min_w_px.decimal();
 		}
@@ -87,8 +91,7 @@ struct Menu_view::Label_widget : Widget, Cursor::Glyph_position
 		if (!_font)
 			return Area(0, 0);
 
-		return Area(max(_font->string_width(_text.string()).decimal(), _min_width),
-		            _min_height);
+		return Area(max(_text_width, _min_width), _min_height);
 	}
 
 	void draw(Surface<Pixel_rgb888> &pixel_surface,
@@ -124,6 +127,25 @@ struct Menu_view::Label_widget : Widget, Cursor::Glyph_position
 			cursor.draw(pixel_surface, alpha_surface, at, text_size.h()); });
 	}
 
+	/* cursors and selections are defined by sub nodes */
+	bool _content_includes_sub_nodes() const override { return true; }
+
+	bool _animating() const override
+	{
+		bool result = _color.animated();
+		_cursors.for_each([&] (Cursor const &cursor) {
+			if (cursor.animated()) result = true; });
+		return result;
+	}
+
+	unsigned _overdraw() const override
+	{
+		unsigned result = 0;
+		_cursors.for_each([&] (Cursor const &cursor) {
+			result = max(result, cursor.overdraw()); });
+		return result;
+	}
+
 	/**
 	 * Cursor::Glyph_position interface
 	 */
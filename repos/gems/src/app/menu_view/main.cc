@@ -26,6 +26,7 @@
 #include <os/reporter.h>
 #include <timer_session/connection.h>
 #include <os/vfs.h>
+#include <util/dirty_rect.h>
 
 /* gems includes */
 #include <gems/gui_buffer.h>
@@ -33,7 +34,7 @@
 namespace Menu_view { struct Main; }
 
 
-struct Menu_view::Main
+struct Menu_view::Main : Widget_factory::Damage
 {
 	Env &_env;
 
@@ -120,7 +121,24 @@ struct Menu_view::Main
 
 	Animator _animator { };
 
-	Widget_factory _widget_factory { _heap, _styles, _animator };
+	/*
+	 * Screen areas to be redrawn, reported by the widgets
+	 */
+	Dirty_rect<Rect, 4> _dirty_rect { };
+
+	/* redraw the whole dialog, e.g., after a change of the config or styles */
+	bool _redraw_all = true;
+
+	/**
+	 * Widget_factory::Damage interface
+	 */
+	void mark_as_damaged(Rect rect) override
+	{
+		if (rect.valid())
+			_dirty_rect.mark_as_dirty(rect);
+	}
+
+	Widget_factory _widget_factory { _heap, _styles, _animator, *this };
 
 	Root_widget _root_widget { _widget_factory, Xml_node("<dialog/>"), Widget::Unique_id() };
 
@@ -192,6 +210,13 @@ struct Menu_view::Main
 
 	void _update_hover_report();
 
+	/*
+	 * Debug report of the costs of the last dialog update
+	 */
+	Genode::Reporter _layout_reporter = { _env, "layout" };
+
+	void _update_layout_report(uint64_t update_us, uint64_t layout_us);
+
 	bool _schedule_redraw = false;
 
 	/**
@@ -211,6 +236,29 @@ struct Menu_view::Main
 	 */
 	unsigned _frame_cnt = 0;
 
+	/*
+	 * Statistics of the redraws, logged every 'log_redraws' redraws
+	 */
+	struct Redraw_stats
+	{
+		unsigned frames;
+		uint64_t total_us, max_us, pixels;
+
+		void record(uint64_t us, uint64_t frame_pixels)
+		{
+			frames++;
+			total_us += us;
+			pixels   += frame_pixels;
+			max_us    = max(max_us, us);
+		}
+	};
+
+	Redraw_stats _redraw_stats { };
+
+	unsigned _log_redraws = 0;
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
 	Main(Env &env, Vfs::File_system &libc_vfs)
 	:
 		_env(env), _vfs_env(_env, _heap, libc_vfs)
@@ -255,8 +303,31 @@ void Menu_view::Main::_update_hover_report()
 }
 
 
+void Menu_view::Main::_update_layout_report(uint64_t update_us, uint64_t layout_us)
+{
+	Widget_factory::Layout_stats const layout = _widget_factory.layout_stats;
+	Text_width_cache::Stats      const text   = _styles.text_width_stats();
+
+	Genode::Reporter::Xml_generator xml(_layout_reporter, [&] () {
+		xml.attribute("update_us",       update_us);
+		xml.attribute("layout_us",       layout_us);
+		xml.attribute("updates",         layout.updates);
+		xml.attribute("skipped_updates", layout.skipped_updates);
+		xml.attribute("layouts",         layout.layouts);
+		xml.attribute("skipped_layouts", layout.skipped_layouts);
+		xml.attribute("text_cache_hits",   text.hits);
+		xml.attribute("text_cache_misses", text.misses);
+	});
+
+	_widget_factory.layout_stats = { };
+}
+
+
 void Menu_view::Main::_handle_dialog_update()
 {
+	if (_styles.out_of_date())
+		_redraw_all = true;
+
 	_styles.flush_outdated_styles();
 
 	Xml_node const config = _config.xml();
@@ -271,9 +342,19 @@ void Menu_view::Main::_handle_dialog_update()
 	if (dialog.has_type("empty"))
 		return;
 
+	bool const measure = _layout_reporter.enabled();
+
+	uint64_t const start_us = measure ? _now_us() : 0;
+
 	_root_widget.update(dialog);
+
+	uint64_t const updated_us = measure ? _now_us() : 0;
+
 	_root_widget.size(_root_widget_size());
 
+	if (measure)
+		_update_layout_report(updated_us - start_us, _now_us() - updated_us);
+
 	_update_hover_report();
 
 	_schedule_redraw = true;
@@ -309,10 +390,21 @@ void Menu_view::Main::_handle_config()
 		_hover_reporter.enabled(false);
 	}
 
+	try {
+		_layout_reporter.enabled(config.sub_node("report")
+		                               .attribute_value("layout", false));
+	} catch (...) {
+		_layout_reporter.enabled(false);
+	}
+
 	_opaque = config.attribute_value("opaque", false);
 
 	_background_color = config.attribute_value("background", Color(127, 127, 127, 255));
 
+	_log_redraws = config.attribute_value("log_redraws", 0u);
+
+	_redraw_all = true;
+
 	config.with_optional_sub_node("vfs", [&] (Xml_node const &vfs_node) {
 		_vfs_env.root_dir().apply_config(vfs_node); });
 
@@ -389,6 +481,8 @@ void Menu_view::Main::_handle_frame_timer()
 
 		_frame_cnt = 0;
 
+		uint64_t const start_us = _log_redraws ? _now_us() : 0;
+
 		Area const size = _root_widget_size();
 
 		unsigned const buffer_w = _buffer.constructed() ? _buffer->size().w() : 0,
@@ -407,23 +501,58 @@ void Menu_view::Main::_handle_frame_timer()
 			                         _background_color.g,
 			                         _background_color.b,
 			                         _background_color.a };
-		} else {
-			_buffer->reset_surface();
+			_redraw_all = true;
 		}
 
 		_root_widget.position(Point(0, 0));
 
-		// XXX restrict redraw to dirty regions
-		//     don't perform a full dialog update
-		_buffer->apply_to_surface([&] (Surface<Pixel_rgb888> &pixel,
-		                               Surface<Pixel_alpha8> &alpha) {
-			_root_widget.draw(pixel, alpha, Point(0, 0));
+		Rect const buffer_rect(Point(0, 0), _buffer->size());
+
+		_root_widget.collect_damage(Point(0, 0), [&] (Rect const &rect) {
+			mark_as_damaged(rect); });
+
+		if (_redraw_all)
+			mark_as_damaged(buffer_rect);
+
+		_redraw_all = false;
+
+		/* redraw and refresh the damaged areas only */
+		uint64_t pixels = 0;
+		_dirty_rect.flush([&] (Rect const &dirty) {
+
+			Rect const rect = Rect::intersect(dirty, buffer_rect);
+			if (!rect.valid())
+				return;
+
+			_buffer->reset_surface(rect);
+
+			_buffer->apply_to_surface([&] (Surface<Pixel_rgb888> &pixel,
+			                               Surface<Pixel_alpha8> &alpha) {
+				pixel.clip(rect);
+				alpha.clip(rect);
+				_root_widget.draw(pixel, alpha, Point(0, 0));
+			});
+
+			_buffer->flush_surface(rect);
+			_gui.framebuffer()->refresh(rect.x1(), rect.y1(), rect.w(), rect.h());
+
+			pixels += rect.area().count();
 		});
 
-		_buffer->flush_surface();
-		_gui.framebuffer()->refresh(0, 0, _buffer->size().w(), _buffer->size().h());
 		_update_view(Rect(_position, size));
 
+		if (_log_redraws) {
+			_redraw_stats.record(_now_us() - start_us, pixels);
+
+			if (_redraw_stats.frames >= _log_redraws) {
+				log("redraw: ", _redraw_stats.frames, " frames, "
+				    "avg ", _redraw_stats.total_us/_redraw_stats.frames, " us, "
+				    "max ", _redraw_stats.max_us, " us, ",
+				    _redraw_stats.pixels/_redraw_stats.frames, " pixels/frame");
+				_redraw_stats = Redraw_stats { };
+			}
+		}
+
 		_schedule_redraw = false;
 	}
 
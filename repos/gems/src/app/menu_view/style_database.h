@@ -22,6 +22,7 @@
 
 /* local includes */
 #include "types.h"
+#include "text_width_cache.h"
 
 namespace Menu_view {
 
@@ -177,6 +178,14 @@ class Menu_view::Style_database
 		List<Font_entry>        mutable _fonts        { };
 		List<Label_style_entry> mutable _label_styles { };
 
+		Text_width_cache mutable _text_widths { };
+
+		/*
+		 * Incremented whenever outdated styles are flushed. Widgets that
+		 * depend on the styles must be updated if the generation changed.
+		 */
+		unsigned _generation = 0;
+
 		template <typename T>
 		T const *_lookup(List<T> &list, char const *path) const
 		{
@@ -293,6 +302,21 @@ class Menu_view::Style_database
 			fn(_label_style(node));
 		}
 
+		/**
+		 * Return width of 'text' when rendered with 'font'
+		 */
+		Text_painter::Fixpoint_number string_width(Text_painter::Font const &font,
+		                                           char const *text) const
+		{
+			return _text_widths.string_width(font, text);
+		}
+
+		Text_width_cache::Stats text_width_stats() const { return _text_widths.stats(); }
+
+		unsigned generation() const { return _generation; }
+
+		bool out_of_date() const { return _out_of_date; }
+
 		void flush_outdated_styles()
 		{
 			if (!_out_of_date)
@@ -308,6 +332,11 @@ class Menu_view::Style_database
 				}
 				font = next;
 			}
+
+			/* the cached text widths may refer to flushed fonts */
+			_text_widths.flush();
+
+			_generation++;
 			_out_of_date = false;
 		}
 };
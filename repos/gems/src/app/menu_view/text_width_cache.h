@@ -0,0 +1,102 @@
+/*
+ * \brief  Cache of text widths
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * Measuring a text requires the lookup of each glyph. Since the layout of a
+ * dialog asks for the size of the same labels over and over again, the
+ * measured widths are remembered per font and text.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _TEXT_WIDTH_CACHE_H_
+#define _TEXT_WIDTH_CACHE_H_
+
+/* local includes */
+#include "types.h"
+
+namespace Menu_view { class Text_width_cache; }
+
+
+class Menu_view::Text_width_cache
+{
+	public:
+
+		typedef Text_painter::Font            Font;
+		typedef Text_painter::Fixpoint_number Fixpoint_number;
+
+		enum { NUM_ENTRIES = 128, TEXT_MAX_LEN = 200 };
+
+		typedef String<TEXT_MAX_LEN> Text;
+
+		struct Stats
+		{
+			unsigned long hits, misses;
+		};
+
+	private:
+
+		/*
+		 * The cache is direct mapped. An entry is replaced by any other
+		 * text with the same index.
+		 */
+		struct Entry
+		{
+			Font const     *font = nullptr;
+			Text            text  { };
+			Fixpoint_number width { (int)0 };
+		};
+
+		Entry _entries[NUM_ENTRIES] { };
+
+		Stats _stats { };
+
+		static unsigned _index(Font const &font, char const *s)
+		{
+			unsigned long h = (unsigned long)&font;
+			for (; *s; s++)
+				h = h*33 + (unsigned char)*s;
+			return (unsigned)(h % NUM_ENTRIES);
+		}
+
+	public:
+
+		Fixpoint_number string_width(Font const &font, char const *s)
+		{
+			/* texts exceeding the entry size are not cached */
+			if (strlen(s) >= TEXT_MAX_LEN) {
+				_stats.misses++;
+				return font.string_width(s);
+			}
+
+			Entry &entry = _entries[_index(font, s)];
+
+			if (entry.font == &font && entry.text == s) {
+				_stats.hits++;
+				return entry.width;
+			}
+
+			_stats.misses++;
+			entry = Entry { .font = &font, .text = s, .width = font.string_width(s) };
+			return entry.width;
+		}
+
+		/**
+		 * Forget all entries, e.g., when fonts are destructed
+		 */
+		void flush()
+		{
+			for (Entry &entry : _entries)
+				entry = Entry { };
+		}
+
+		Stats stats() const { return _stats; }
+};
+
+#endif /* _TEXT_WIDTH_CACHE_H_ */
@@ -127,7 +127,14 @@ class Menu_view::Widget : List_model<Widget>::Element
 
 			Model_update_policy(Widget_factory &factory) : _factory(factory) { }
 
-			void destroy_element(Widget &w) { _factory.destroy(&w); }
+			void destroy_element(Widget &w)
+			{
+				/* the area covered by the widget must be redrawn */
+				if (w._drawn.valid())
+					_factory.damage.mark_as_damaged(w._drawn);
+
+				_factory.destroy(&w);
+			}
 
 			Widget &create_element(Xml_node elem_node)
 			{
@@ -137,7 +144,18 @@ class Menu_view::Widget : List_model<Widget>::Element
 				throw Unknown_element_type();
 			}
 
-			void update_element(Widget &w, Xml_node node) { w.update(node); }
+			void update_element(Widget &w, Xml_node node)
+			{
+				/* skip unchanged subtrees */
+				if (!w._subtree_changed(node)) {
+					_factory.layout_stats.skipped_updates++;
+					return;
+				}
+
+				w._update_content_hash(node);
+				w.update(node);
+				_factory.layout_stats.updates++;
+			}
 
 			static bool element_matches_xml_node(Widget const &w, Xml_node node)
 			{
@@ -151,14 +169,135 @@ class Menu_view::Widget : List_model<Widget>::Element
 		inline void _update_children(Xml_node node)
 		{
 			_children.update_from_xml(_model_update_policy, node);
+			_layout_valid = false;
 		}
 
 		void _draw_children(Surface<Pixel_rgb888> &pixel_surface,
 		                    Surface<Pixel_alpha8> &alpha_surface,
 		                    Point at) const
 		{
+			Rect const clip = pixel_surface.clip();
+
 			_children.for_each([&] (Widget const &w) {
-				w.draw(pixel_surface, alpha_surface, at + w._animated_geometry.p1()); });
+
+				Point const child_at = at + w._animated_geometry.p1();
+
+				/* skip children outside the area to redraw */
+				if (!Rect::intersect(w._covered(child_at), clip).valid())
+					return;
+
+				w.draw(pixel_surface, alpha_surface, child_at); });
+		}
+
+		/*
+		 * Damage tracking
+		 *
+		 * A widget is damaged if its XML attributes changed, if it moved or
+		 * changed its size, or if its appearance is animated. The area
+		 * covered at the last collection of damage must be redrawn along
+		 * with the new area.
+		 */
+		Rect          _drawn { };
+		unsigned long _content_hash    = 0;
+		bool          _content_changed = true;
+
+		/**
+		 * Return true if the widget's content depends on the XML sub nodes
+		 *
+		 * By default, sub nodes are child widgets, which track their
+		 * content on their own.
+		 */
+		virtual bool _content_includes_sub_nodes() const { return false; }
+
+		/**
+		 * Return true if the appearance changes without a model update
+		 */
+		virtual bool _animating() const { return false; }
+
+		/**
+		 * Return true if the widget must be redrawn whenever a child changes,
+		 * e.g., because it draws connections between its children
+		 */
+		virtual bool _damaged_by_children() const { return false; }
+
+		/**
+		 * Number of pixels drawn beyond the widget boundaries
+		 */
+		virtual unsigned _overdraw() const { return 0; }
+
+		/**
+		 * Return absolute area covered by the widget drawn at 'at'
+		 */
+		Rect _covered(Point at) const
+		{
+			int  const d = (int)_overdraw();
+			Area const a = _animated_geometry.area();
+			return Rect(at - Point(d, d),
+			            Area(max(a.w(), _geometry.w()) + 2*d,
+			                 max(a.h(), _geometry.h()) + 2*d));
+		}
+
+		static unsigned long _hash(char const *s, size_t n)
+		{
+			unsigned long h = 5381;
+			for (; n--; s++)
+				h = h*33 + (unsigned char)*s;
+			return h;
+		}
+
+		/**
+		 * Return length of the start tag, skipping quoted attribute values
+		 */
+		static size_t _start_tag_len(char const *s, size_t n)
+		{
+			bool quoted = false;
+			for (size_t i = 0; i < n; i++) {
+				if (s[i] == '"') quoted = !quoted;
+				if (s[i] == '>' && !quoted) return i + 1;
+			}
+			return n;
+		}
+
+		/*
+		 * Layout memoization
+		 *
+		 * The update of a widget is skipped if neither its XML subtree nor
+		 * the styles changed since the last update. The layout is skipped
+		 * if the size of the widget stayed the same and none of its children
+		 * was updated.
+		 */
+		unsigned long _subtree_hash     = 0;
+		unsigned      _style_generation = ~0U;
+		bool          _layout_valid     = false;
+
+		bool _subtree_changed(Xml_node const &node)
+		{
+			unsigned long hash = 0;
+			node.with_raw_node([&] (char const *start, size_t len) {
+				hash = _hash(start, len); });
+
+			unsigned const generation = _factory.styles.generation();
+
+			if (hash == _subtree_hash && generation == _style_generation)
+				return false;
+
+			_subtree_hash     = hash;
+			_style_generation = generation;
+			return true;
+		}
+
+		void _update_content_hash(Xml_node const &node)
+		{
+			unsigned long hash = 0;
+			node.with_raw_node([&] (char const *start, size_t len) {
+				hash = _hash(start, _content_includes_sub_nodes()
+				                    ? len : _start_tag_len(start, len)); });
+
+			if (hash == _content_hash)
+				return;
+
+			_content_hash    = hash;
+			_content_changed = true;
 		}
 
 		virtual void _layout() { }
@@ -229,6 +368,42 @@ class Menu_view::Widget : List_model<Widget>::Element
 
 		bool has_name(Name const &name) const { return name == _name; }
 
+		Name const &name() const { return _name; }
+
+		/**
+		 * Report areas to be redrawn since the last call via 'fn'
+		 *
+		 * \param at  absolute position of the widget
+		 * \return    true if any widget of the subtree is damaged
+		 */
+		template <typename FN>
+		bool collect_damage(Point at, FN const &fn)
+		{
+			Rect const covered = _covered(at);
+
+			bool damaged = _content_changed || _animating()
+			            || covered.p1()   != _drawn.p1()
+			            || covered.area() != _drawn.area();
+
+			bool children_damaged = false;
+			_children.for_each([&] (Widget &w) {
+				if (w.collect_damage(at + w._animated_geometry.p1(), fn))
+					children_damaged = true; });
+
+			if (children_damaged && _damaged_by_children())
+				damaged = true;
+
+			if (damaged) {
+				if (_drawn.valid()) fn(_drawn);
+				if (covered.valid()) fn(covered);
+			}
+
+			_drawn           = covered;
+			_content_changed = false;
+
+			return damaged || children_damaged;
+		}
+
 		virtual void update(Xml_node node) = 0;
 
 		virtual Area min_size() const = 0;
@@ -242,10 +417,16 @@ class Menu_view::Widget : List_model<Widget>::Element
 		 */
 		void size(Area size)
 		{
-			_geometry = Rect(_geometry.p1(), size);
-
-			_layout();
+			if (_layout_valid && size == _geometry.area()) {
+				_factory.layout_stats.skipped_layouts++;
+			} else {
+				_geometry = Rect(_geometry.p1(), size);
+				_layout();
+				_layout_valid = true;
+				_factory.layout_stats.layouts++;
+			}
 
+			/* the position may have changed nevertheless */
 			_trigger_geometry_animation();
 		}
 
@@ -35,13 +35,33 @@ class Menu_view::Widget_factory
 
 	public:
 
+		/**
+		 * Interface for reporting screen areas to be redrawn
+		 */
+		struct Damage : Interface
+		{
+			virtual void mark_as_damaged(Rect) = 0;
+		};
+
+		/**
+		 * Counters of the widget updates and layouts performed or skipped
+		 */
+		struct Layout_stats
+		{
+			unsigned long updates, skipped_updates, layouts, skipped_layouts;
+		};
+
 		Allocator      &alloc;
 		Style_database &styles;
 		Animator       &animator;
+		Damage         &damage;
+
+		Layout_stats layout_stats { };
 
-		Widget_factory(Allocator &alloc, Style_database &styles, Animator &animator)
+		Widget_factory(Allocator &alloc, Style_database &styles, Animator &animator,
+		               Damage &damage)
 		:
-			alloc(alloc), styles(styles), animator(animator)
+			alloc(alloc), styles(styles), animator(animator), damage(damage)
 		{ }
 
 		Widget *create(Xml_node node);
@@ -97,6 +97,12 @@ class Scene : public Nano3d::Scene<PT>
 				if (_config.xml().attribute("painter").has_value("shaded"))
 					_painter = PAINTER_SHADED;
 			} catch (...) { }
+
+			bool const antialias = _config.xml().attribute_value("antialias", false);
+			_shaded_painter  .antialias(antialias);
+			_textured_painter.antialias(antialias);
+
+			this->log_frames(_config.xml().attribute_value("log_frames", 0u));
 		}
 
 		Genode::Signal_handler<Scene> _config_handler;
@@ -39,14 +39,18 @@ namespace Ctf {
 class Ctf::Writer : public Trace_recorder::Writer_base
 {
 	private:
-		Buffer                     &_packet_buffer;
+		/*
+		 * Each writer owns its packet buffer because the monitor interleaves
+		 * the events of all subjects in the order of their timestamps. The
+		 * destination file stays open across periods.
+		 */
+		Buffer                      _packet_buffer { };
 		Constructible<Append_file>  _dst_file      { };
 		Directory::Path             _file_path     { };
 
 	public:
-		Writer(Genode::Registry<Writer_base> &registry, Buffer &packet_buffer)
-		: Writer_base(registry),
-		  _packet_buffer(packet_buffer)
+		Writer(Genode::Registry<Writer_base> &registry)
+		: Writer_base(registry)
 		{ }
 
 		virtual void start_iteration(Directory &,
@@ -66,8 +70,6 @@ class Ctf::Backend : Trace_recorder::Backend_base
 		Attached_rom_dataspace      _metadata_rom;
 		Metadata                    _metadata;
 
-		Buffer                      _packet_buf      { };
-
 	public:
 
 		Backend(Env &env, Timestamp_calibrator const &ts_calibrator, Backends &backends)
@@ -88,7 +90,7 @@ class Ctf::Backend : Trace_recorder::Backend_base
 				_metadata.write_file(metadata_file);
 			}
 
-			return *new (alloc) Writer(registry, _packet_buf);
+			return *new (alloc) Writer(registry);
 		}
 };
 
@@ -14,6 +14,10 @@
 /* local includes */
 #include "monitor.h"
 
+/* Genode includes */
+#include <trace_recorder_policy/ctf.h>
+#include <trace_recorder_policy/pcapng.h>
+
 using namespace Genode;
 
 Directory::Path Trace_recorder::Monitor::Trace_directory::subject_path(::Subject_info const &info)
@@ -27,29 +31,101 @@ Directory::Path Trace_recorder::Monitor::Trace_directory::subject_path(::Subject
 }
 
 
-void Trace_recorder::Monitor::Attached_buffer::process_events(Trace_directory &trace_directory)
+static Trace::Timestamp timestamp(Trace_recorder::Trace_event_base const &event)
+{
+	using namespace Trace_recorder;
+
+	switch (event.type()) {
+	case Event_type::CTF:
+		return (Trace::Timestamp)event.event<Ctf_event>().timestamp();
+	case Event_type::PCAPNG:
+		return event.event<Pcapng_event>().timestamp();
+	}
+	return 0;
+}
+
+
+void Trace_recorder::Monitor::Attached_buffer::_process(Trace::Buffer::Entry &entry)
+{
+	/* pass entry to every writer */
+	_writers.for_each([&] (Writer_base &writer) {
+		writer.process_event(entry.object<Trace_event_base>(), entry.length());
+	});
+}
+
+
+void Trace_recorder::Monitor::Attached_buffer::start_iteration(Trace_directory &trace_directory)
 {
-	/* start iteration for every writer */
 	_writers.for_each([&] (Writer_base &writer) {
 		writer.start_iteration(trace_directory.root(),
 		                       trace_directory.subject_path(info()),
 		                       info());
 	});
+}
+
+
+void Trace_recorder::Monitor::Attached_buffer::end_iteration()
+{
+	_writers.for_each([&] (Writer_base &writer) { writer.end_iteration(); });
+}
+
+
+void Trace_recorder::Monitor::Attached_buffer::process_events(Trace_directory &trace_directory)
+{
+	start_iteration(trace_directory);
 
-	/* iterate entries and pass each entry to every writer */
 	_buffer.for_each_new_entry([&] (Trace::Buffer::Entry &entry) {
 		if (entry.length() == 0)
 			return true;
 
-		_writers.for_each([&] (Writer_base &writer) {
-			writer.process_event(entry.object<Trace_event_base>(), entry.length());
-		});
+		_process(entry);
+		return true;
+	});
+
+	end_iteration();
+}
+
+
+bool Trace_recorder::Monitor::Attached_buffer::next_timestamp(Trace::Timestamp &ts)
+{
+	bool pending = false;
+
+	/* stop at the first non-empty entry without consuming it */
+	_buffer.for_each_new_entry([&] (Trace::Buffer::Entry &entry) {
+		if (entry.length() == 0)
+			return true;
 
+		ts      = timestamp(entry.object<Trace_event_base>());
+		pending = true;
+		return false;
+	});
+
+	return pending;
+}
+
+
+bool Trace_recorder::Monitor::Attached_buffer::process_next_event(Trace::Timestamp &ts)
+{
+	bool processed = false;
+	bool pending   = false;
+
+	_buffer.for_each_new_entry([&] (Trace::Buffer::Entry &entry) {
+		if (entry.length() == 0)
+			return true;
+
+		/* peek at the entry following the processed one */
+		if (processed) {
+			ts      = timestamp(entry.object<Trace_event_base>());
+			pending = true;
+			return false;
+		}
+
+		_process(entry);
+		processed = true;
 		return true;
 	});
 
-	/* end iteration for every writer */
-	_writers.for_each([&] (Writer_base &writer) { writer.end_iteration(); });
+	return pending;
 }
 
 
@@ -70,11 +146,72 @@ Session_policy Trace_recorder::Monitor::_session_policy(Trace::Subject_info cons
 }
 
 
+void Trace_recorder::Monitor::_sift_down(Pending *heap, unsigned num, unsigned i)
+{
+	for (;;) {
+		unsigned const left  = 2*i + 1;
+		unsigned const right = left + 1;
+		unsigned       min   = i;
+
+		if (left < num && heap[left].timestamp < heap[min].timestamp)
+			min = left;
+
+		if (right < num && heap[right].timestamp < heap[min].timestamp)
+			min = right;
+
+		if (min == i)
+			return;
+
+		Pending const tmp = heap[i];
+		heap[i]   = heap[min];
+		heap[min] = tmp;
+		i = min;
+	}
+}
+
+
 void Trace_recorder::Monitor::_handle_timeout()
 {
+	/*
+	 * All buffers are drained in a single pass that passes the events to the
+	 * writers in the order of their timestamps (k-way merge). Events produced
+	 * after the pass started are left for the next period so that busy
+	 * producers cannot stall the monitor.
+	 */
+	Trace::Timestamp const end = Trace::timestamp();
+
+	unsigned num_buffers = 0;
+	_trace_buffers.for_each([&] (Attached_buffer &) { num_buffers++; });
+
+	if (!num_buffers)
+		return;
+
+	Pending * const heap = (Pending *)_alloc.alloc(sizeof(Pending)*num_buffers);
+
+	unsigned num = 0;
 	_trace_buffers.for_each([&] (Attached_buffer &buf) {
-		buf.process_events(*_trace_directory);
+		buf.start_iteration(*_trace_directory);
+
+		Trace::Timestamp ts = 0;
+		if (buf.next_timestamp(ts) && ts <= end)
+			heap[num++] = Pending { &buf, ts };
 	});
+
+	for (unsigned i = num/2; i-- > 0; )
+		_sift_down(heap, num, i);
+
+	while (num) {
+		Pending &first = heap[0];
+
+		if (!first.buffer->process_next_event(first.timestamp) || first.timestamp > end)
+			first = heap[--num];
+
+		_sift_down(heap, num, 0);
+	}
+
+	_alloc.free(heap, sizeof(Pending)*num_buffers);
+
+	_trace_buffers.for_each([&] (Attached_buffer &buf) { buf.end_iteration(); });
 }
 
 
@@ -76,6 +76,8 @@ class Trace_recorder::Monitor
 				Trace::Subject_id                  _subject_id;
 				Registry<Writer_base>              _writers { };
 
+				void _process(Trace::Buffer::Entry &);
+
 			public:
 
 				Attached_buffer(Registry<Attached_buffer>    &registry,
@@ -95,14 +97,46 @@ class Trace_recorder::Monitor
 					_env.rm().detach(_buffer.address());
 				}
 
+				void start_iteration(Trace_directory &);
+				void end_iteration();
+
+				/**
+				 * Process all pending events
+				 */
 				void process_events(Trace_directory &);
 
+				/**
+				 * Determine timestamp of the next pending event
+				 *
+				 * \return  false if no event is pending
+				 */
+				bool next_timestamp(Trace::Timestamp &);
+
+				/**
+				 * Process next pending event and determine the timestamp of
+				 * the following one
+				 *
+				 * \return  false if no further event is pending
+				 */
+				bool process_next_event(Trace::Timestamp &);
+
 				Registry<Writer_base>   &writers()            { return _writers; }
 
 				Subject_info      const &info()         const { return _info;   }
 				Trace::Subject_id const  subject_id()   const { return _subject_id; }
 		};
 
+		/**
+		 * Element of the heap used for merging the events of all buffers
+		 */
+		struct Pending
+		{
+			Attached_buffer  *buffer;
+			Trace::Timestamp  timestamp;
+		};
+
+		static void _sift_down(Pending *, unsigned num, unsigned index);
+
 		Env                           &_env;
 		Allocator                     &_alloc;
 		Registry<Attached_buffer>      _trace_buffers    { };
@@ -125,7 +159,7 @@ class Trace_recorder::Monitor
 
 		/* built-in backends */
 		Ctf::Backend                   _ctf_backend      { _env,   _ts_calibrator, _backends };
-		Pcapng::Backend                _pcapng_backend   { _alloc, _ts_calibrator, _backends };
+		Pcapng::Backend                _pcapng_backend   { _ts_calibrator, _backends };
 
 		/* methods */
 		Session_policy _session_policy(Trace::Subject_info const &info, Xml_node config);
@@ -27,23 +27,22 @@ void Writer::start_iteration(Directory             &root,
                              Directory::Path const &path,
                              ::Subject_info  const &)
 {
-	/* write to '${path}.pcapng */
-	Path<Directory::MAX_PATH_LEN> pcap_file { path };
-	pcap_file.append(".pcapng");
+	/* append to '${path}.pcapng, the file is kept open across periods */
+	if (!_dst_file.constructed()) {
+		Path<Directory::MAX_PATH_LEN> pcap_file { path };
+		pcap_file.append(".pcapng");
 
-	_file_path = Directory::Path(pcap_file.string());
+		_file_path = Directory::Path(pcap_file.string());
 
-	/* append to file */
-	try {
-		_dst_file.construct(root, _file_path);
-
-		_interface_registry.clear();
-		_buffer.clear();
-		_buffer.append<Section_header_block>();
-		_empty_section = true;
+		try { _dst_file.construct(root, _file_path); }
+		catch (Append_file::Create_failed)  {
+			error("Could not create file."); return; }
 	}
-	catch (Append_file::Create_failed)  {
-		error("Could not create file."); }
+
+	_interface_registry.clear();
+	_buffer.clear();
+	_buffer.append<Section_header_block>();
+	_empty_section = true;
 }
 
 
@@ -118,12 +117,13 @@ void Writer::process_event(Trace_recorder::Trace_event_base const &trace_event,
 
 void Writer::end_iteration()
 {
+	if (!_dst_file.constructed()) return;
+
 	/* write buffer to file */
 	if (!_empty_section)
 		_buffer.write_to_file(*_dst_file, _file_path);
 
 	_buffer.clear();
-	_dst_file.destruct();
 }
 
 
@@ -132,5 +132,5 @@ Trace_recorder::Writer_base &Backend::create_writer(Genode::Allocator
                                                     Directory                     &,
                                                     Directory::Path      const    &)
 {
-	return *new (alloc) Writer(registry, _interface_registry, _buffer, _ts_calibrator);
+	return *new (alloc) Writer(registry, alloc, _ts_calibrator);
 }
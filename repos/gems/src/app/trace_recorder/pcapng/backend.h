@@ -39,18 +39,22 @@ namespace Pcapng {
 class Pcapng::Writer : public Trace_recorder::Writer_base
 {
 	private:
-		Interface_registry         &_interface_registry;
-		Buffer                     &_buffer;
+		/*
+		 * Each writer owns its buffer and interface registry because the
+		 * monitor interleaves the events of all subjects in the order of
+		 * their timestamps. The destination file stays open across periods.
+		 */
+		Interface_registry          _interface_registry;
+		Buffer                      _buffer        { };
 		Timestamp_calibrator const &_ts_calibrator;
 		Constructible<Append_file>  _dst_file      { };
 		Directory::Path             _file_path     { };
 		bool                        _empty_section { false };
 
 	public:
-		Writer(Genode::Registry<Writer_base> &registry, Interface_registry &interface_registry, Buffer &buffer, Timestamp_calibrator const &ts_calibrator)
+		Writer(Genode::Registry<Writer_base> &registry, Allocator &alloc, Timestamp_calibrator const &ts_calibrator)
 		: Writer_base(registry),
-		  _interface_registry(interface_registry),
-		  _buffer(buffer),
+		  _interface_registry(alloc),
 		  _ts_calibrator(ts_calibrator)
 		{ }
 
@@ -68,15 +72,12 @@ class Pcapng::Backend : Trace_recorder::Backend_base
 {
 	private:
 
-		Interface_registry          _interface_registry;
-		Buffer                      _buffer { };
 		Timestamp_calibrator const &_ts_calibrator;
 
 	public:
 
-		Backend(Allocator &alloc, Timestamp_calibrator const &ts_calibrator, Backends &backends)
+		Backend(Timestamp_calibrator const &ts_calibrator, Backends &backends)
 		: Backend_base(backends, "pcapng"),
-		  _interface_registry(alloc),
 		  _ts_calibrator(ts_calibrator)
 		{ }
 
@@ -0,0 +1,202 @@
+/*
+ * \brief  File system providing the glyph atlas of a font
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _ATLAS_FILE_SYSTEM_H_
+#define _ATLAS_FILE_SYSTEM_H_
+
+/* Genode includes */
+#include <vfs/single_file_system.h>
+
+/* gems includes */
+#include <gems/vfs_font.h>
+
+namespace Vfs {
+
+	class Atlas_buffer;
+	class Atlas_file_system;
+}
+
+
+/**
+ * Memory holding the pre-rendered glyphs of a font
+ */
+class Vfs::Atlas_buffer
+{
+	private:
+
+		Allocator &_alloc;
+
+		size_t const _size;
+
+		char * const _ptr = _size ? (char *)_alloc.alloc(_size) : nullptr;
+
+		/*
+		 * Noncopyable
+		 */
+		Atlas_buffer(Atlas_buffer const &);
+		Atlas_buffer &operator = (Atlas_buffer const &);
+
+	public:
+
+		struct Range { uint32_t first, count; };
+
+		/**
+		 * Constructor
+		 *
+		 * An empty range results in an empty buffer.
+		 */
+		Atlas_buffer(Allocator &alloc, Text_painter::Font const &font, Range range)
+		:
+			_alloc(alloc),
+			_size(range.count ? Vfs_font::Atlas::num_bytes(font, range.first, range.count) : 0)
+		{
+			if (_ptr)
+				Vfs_font::Atlas::generate(font, range.first, range.count, _ptr, _size);
+		}
+
+		~Atlas_buffer() { if (_ptr) _alloc.free(_ptr, _size); }
+
+		size_t size() const { return _size; }
+
+		char const *ptr() const { return _ptr; }
+};
+
+
+class Vfs::Atlas_file_system : public Vfs::Single_file_system
+{
+	private:
+
+		Atlas_buffer const &_buffer;
+
+		struct Vfs_handle : Single_vfs_handle
+		{
+			Atlas_buffer const &_buffer;
+
+			Vfs_handle(Directory_service &ds,
+			           File_io_service   &fs,
+			           Allocator         &alloc,
+			           Atlas_buffer const &buffer)
+			:
+				Single_vfs_handle(ds, fs, alloc, 0), _buffer(buffer)
+			{ }
+
+			Read_result read(char *dst, file_size count,
+			                 file_size &out_count) override
+			{
+				out_count = 0;
+
+				if (seek() > _buffer.size())
+					return READ_ERR_INVALID;
+
+				size_t const offset = (size_t)seek();
+				size_t const len    = min(_buffer.size() - offset, (size_t)count);
+
+				memcpy(dst, _buffer.ptr() + offset, len);
+				out_count = len;
+
+				return READ_OK;
+			}
+
+			Write_result write(char const *, file_size, file_size &) override
+			{
+				return WRITE_ERR_IO;
+			}
+
+			bool read_ready() override { return true; }
+		};
+
+		typedef Registered<Vfs_watch_handle>      Registered_watch_handle;
+		typedef Registry<Registered_watch_handle> Watch_handle_registry;
+
+		Watch_handle_registry _handle_registry { };
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param buffer  atlas buffer, which may be reconstructed at the
+		 *                same location when the font changes
+		 */
+		Atlas_file_system(Atlas_buffer const &buffer)
+		:
+			Single_file_system(Node_type::TRANSACTIONAL_FILE, type(),
+			                   Node_rwx::ro(), Xml_node("<atlas/>")),
+			_buffer(buffer)
+		{ }
+
+		static char const *type_name() { return "atlas"; }
+
+		char const *type() override { return type_name(); }
+
+		/**
+		 * Propagate font change to watch handlers
+		 */
+		void trigger_watch_response()
+		{
+			_handle_registry.for_each([] (Registered_watch_handle &handle) {
+				handle.watch_response(); });
+		}
+
+		/*********************************
+		 ** Directory-service interface **
+		 *********************************/
+
+		Open_result open(char const  *path, unsigned,
+		                 Vfs::Vfs_handle **out_handle,
+		                 Allocator   &alloc) override
+		{
+			if (!_single_file(path))
+				return OPEN_ERR_UNACCESSIBLE;
+
+			try {
+				*out_handle = new (alloc)
+					Vfs_handle(*this, *this, alloc, _buffer);
+				return OPEN_OK;
+			}
+			catch (Out_of_ram)  { return OPEN_ERR_OUT_OF_RAM; }
+			catch (Out_of_caps) { return OPEN_ERR_OUT_OF_CAPS; }
+		}
+
+		Stat_result stat(char const *path, Stat &out) override
+		{
+			Stat_result result = Single_file_system::stat(path, out);
+			out.size = _buffer.size();
+			return result;
+		}
+
+		Watch_result watch(char const        *path,
+		                   Vfs_watch_handle **handle,
+		                   Allocator         &alloc) override
+		{
+			if (!_single_file(path))
+				return WATCH_ERR_UNACCESSIBLE;
+
+			try {
+				*handle = new (alloc)
+					Registered_watch_handle(_handle_registry, *this, alloc);
+
+				return WATCH_OK;
+			}
+			catch (Out_of_ram)  { return WATCH_ERR_OUT_OF_RAM;  }
+			catch (Out_of_caps) { return WATCH_ERR_OUT_OF_CAPS; }
+		}
+
+		void close(Vfs_watch_handle *handle) override
+		{
+			destroy(handle->alloc(),
+			        static_cast<Registered_watch_handle *>(handle));
+		}
+};
+
+#endif /* _ATLAS_FILE_SYSTEM_H_ */
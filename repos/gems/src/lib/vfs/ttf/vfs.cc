@@ -22,12 +22,14 @@
 
 /* local includes */
 #include <glyphs_file_system.h>
+#include <atlas_file_system.h>
 
 namespace Vfs_ttf {
 
 	using namespace Vfs;
 	using namespace Genode;
 
+	class Ttf_files;
 	class Font_from_file;
 	class Local_factory;
 	class File_system;
@@ -36,12 +38,87 @@ namespace Vfs_ttf {
 }
 
 
+/**
+ * TTF files shared by all fonts of the plugin
+ *
+ * Fonts of different sizes often originate from the same TTF file. Its
+ * content is read only once and kept as long as it is used by any font.
+ */
+class Vfs_ttf::Ttf_files : Noncopyable
+{
+	public:
+
+		typedef Directory::Path Path;
+
+		struct File : Registry<File>::Element
+		{
+			Path         const path;
+			File_content const content;
+
+			unsigned users = 0;
+
+			/* file was modified, not to be handed out to new users */
+			bool outdated = false;
+
+			File(Registry<File> &registry, Allocator &alloc,
+			     Directory const &dir, Path const &path)
+			:
+				Registry<File>::Element(registry, *this), path(path),
+				content(alloc, dir, path, File_content::Limit{10*1024*1024})
+			{ }
+		};
+
+	private:
+
+		Registry<File> _files { };
+
+	public:
+
+		/**
+		 * Obtain content of TTF file at 'path'
+		 *
+		 * \throw File_content::Nonexistent_file
+		 * \throw File_content::Truncated_during_read
+		 */
+		File &acquire(Allocator &alloc, Directory const &dir, Path const &path)
+		{
+			File *result = nullptr;
+			_files.for_each([&] (File &file) {
+				if (!result && !file.outdated && file.path == path)
+					result = &file; });
+
+			if (!result)
+				result = new (alloc) File(_files, alloc, dir, path);
+
+			result->users++;
+			return *result;
+		}
+
+		void release(Allocator &alloc, File &file)
+		{
+			if (--file.users == 0)
+				destroy(alloc, &file);
+		}
+
+		/**
+		 * Prevent the sharing of the current content of a modified file
+		 */
+		void mark_outdated(Path const &path)
+		{
+			_files.for_each([&] (File &file) {
+				if (file.path == path)
+					file.outdated = true; });
+		}
+};
+
+
 struct Vfs_ttf::Font_from_file
 {
 	typedef Directory::Path Path;
 
-	Directory    const _dir;
-	File_content const _content;
+	Allocator       &_alloc;
+	Ttf_files       &_files;
+	Ttf_files::File &_file;
 
 	Constructible<Ttf_font const> _font { };
 
@@ -51,16 +128,38 @@ struct Vfs_ttf::Font_from_file
 	 */
 	static constexpr float MAX_SIZE_PX = 100.0;
 
-	Font_from_file(Vfs::Env &vfs_env, Path const &file_path, float px)
+	Font_from_file(Vfs::Env &vfs_env, Ttf_files &files,
+	               Path const &file_path, float px)
 	:
-		_dir(vfs_env),
-		_content(vfs_env.alloc(), _dir, file_path, File_content::Limit{10*1024*1024})
+		_alloc(vfs_env.alloc()), _files(files),
+		_file(files.acquire(vfs_env.alloc(), Directory(vfs_env), file_path))
 	{
-		_content.bytes([&] (char const *ptr, size_t) {
-			_font.construct(vfs_env.alloc(), ptr, min(px, MAX_SIZE_PX)); });
+		try {
+			_file.content.bytes([&] (char const *ptr, size_t) {
+				_font.construct(vfs_env.alloc(), ptr, min(px, MAX_SIZE_PX)); });
+		}
+		catch (...) {
+			_files.release(_alloc, _file);
+			throw;
+		}
+	}
+
+	~Font_from_file()
+	{
+		/* the font refers to the file content */
+		_font.destruct();
+		_files.release(_alloc, _file);
 	}
 
 	Font const &font() const { return *_font; }
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Font_from_file(Font_from_file const &);
+		Font_from_file &operator = (Font_from_file const &);
 };
 
 
@@ -68,31 +167,54 @@ struct Vfs_ttf::Local_factory : File_system_factory, Watch_response_handler
 {
 	Vfs::Env &_env;
 
+	Ttf_files &_ttf_files;
+
 	struct Font_config
 	{
 		Directory::Path    path;
 		float              size;
 		Cached_font::Limit cache_limit;
 
+		/*
+		 * Range of codepoints pre-rendered into the atlas
+		 */
+		bool     atlas;
+		unsigned atlas_first;
+		unsigned atlas_last;
+
 		Font_config(Xml_node const &config)
 		:
 			path(config.attribute_value("path", Directory::Path())),
 			size((float)config.attribute_value("size_px", 16.0d)),
-			cache_limit({config.attribute_value("cache", Number_of_bytes())})
+			cache_limit({config.attribute_value("cache", Number_of_bytes())}),
+			atlas(config.attribute_value("atlas", false)),
+			atlas_first(config.attribute_value("atlas_first", 0x20u)),
+			atlas_last(config.attribute_value("atlas_last", 0xffu))
 		{ }
+
+		Atlas_buffer::Range atlas_range() const
+		{
+			if (!atlas || atlas_last < atlas_first)
+				return { .first = 0, .count = 0 };
+
+			return { .first = atlas_first, .count = atlas_last - atlas_first + 1 };
+		}
 	} _font_config;
 
 	struct Font
 	{
 		Font_from_file     font;
+		Atlas_buffer       atlas;
 		Cached_font::Limit cache_limit;
 		Cached_font        cached_font;
 
-		Font(Vfs::Env &env, Font_config &config)
+		Font(Vfs::Env &env, Ttf_files &ttf_files, Font_config &config)
 		:
 			font(env,
+			     ttf_files,
 			     config.path,
 			     config.size),
+			atlas(env.alloc(), font.font(), config.atlas_range()),
 			cache_limit(config.cache_limit),
 			cached_font(env.alloc(), font.font(), cache_limit)
 		{ }
@@ -101,6 +223,7 @@ struct Vfs_ttf::Local_factory : File_system_factory, Watch_response_handler
 	Reconstructible<Font> _font;
 
 	Glyphs_file_system _glyphs_fs { _font->cached_font };
+	Atlas_file_system  _atlas_fs  { _font->atlas };
 
 	Readonly_value_file_system<unsigned> _baseline_fs   { "baseline",   0 };
 	Readonly_value_file_system<unsigned> _height_fs     { "height",     0 };
@@ -117,11 +240,12 @@ struct Vfs_ttf::Local_factory : File_system_factory, Watch_response_handler
 		_max_height_fs.value(_font->font.font().bounding_box().h());
 	}
 
-	Local_factory(Vfs::Env &env, Xml_node config)
+	Local_factory(Vfs::Env &env, Ttf_files &ttf_files, Xml_node config)
 	:
 		_env(env),
+		_ttf_files(ttf_files),
 		_font_config(config),
-		_font(env, _font_config),
+		_font(env, _ttf_files, _font_config),
 		_watcher(env, _font_config.path, *this)
 	{
 		_update_attributes();
@@ -132,6 +256,9 @@ struct Vfs_ttf::Local_factory : File_system_factory, Watch_response_handler
 		if (node.has_type(Glyphs_file_system::type_name()))
 			return &_glyphs_fs;
 
+		if (node.has_type(Atlas_file_system::type_name()))
+			return &_atlas_fs;
+
 		if (node.has_type(Readonly_value_file_system<unsigned>::type_name()))
 			return _baseline_fs.matches(node)   ? &_baseline_fs
 			     : _height_fs.matches(node)     ? &_height_fs
@@ -145,16 +272,21 @@ struct Vfs_ttf::Local_factory : File_system_factory, Watch_response_handler
 	void apply_config(Xml_node const &config)
 	{
 		_font_config = Font_config(config);
-		_font.construct(_env, _font_config);
+		_font.construct(_env, _ttf_files, _font_config);
 		_update_attributes();
 		_glyphs_fs.trigger_watch_response();
+		_atlas_fs.trigger_watch_response();
 	}
 
 	void watch_response() override
 	{
-		_font.construct(_env, _font_config);
+		/* re-read the modified file instead of sharing the old content */
+		_ttf_files.mark_outdated(_font_config.path);
+
+		_font.construct(_env, _ttf_files, _font_config);
 		_update_attributes();
 		_glyphs_fs.trigger_watch_response();
+		_atlas_fs.trigger_watch_response();
 	}
 };
 
@@ -164,7 +296,7 @@ class Vfs_ttf::File_system : private Local_factory,
 {
 	private:
 
-		typedef String<200> Config;
+		typedef String<256> Config;
 		static Config _config(Xml_node node)
 		{
 			char buf[Config::capacity()] { };
@@ -173,6 +305,7 @@ class Vfs_ttf::File_system : private Local_factory,
 				typedef String<64> Name;
 				xml.attribute("name", node.attribute_value("name", Name()));
 				xml.node("glyphs", [&] () { });
+				xml.node("atlas",  [&] () { });
 				xml.node("readonly_value", [&] () { xml.attribute("name", "baseline");   });
 				xml.node("readonly_value", [&] () { xml.attribute("name", "height");     });
 				xml.node("readonly_value", [&] () { xml.attribute("name", "max_width");  });
@@ -183,9 +316,10 @@ class Vfs_ttf::File_system : private Local_factory,
 
 	public:
 
-		File_system(Vfs::Env &vfs_env, Genode::Xml_node node)
+		File_system(Vfs::Env &vfs_env, Vfs_ttf::Ttf_files &ttf_files,
+		            Genode::Xml_node node)
 		:
-			Local_factory(vfs_env, node),
+			Local_factory(vfs_env, ttf_files, node),
 			Vfs::Dir_file_system(vfs_env,
 			                     Xml_node(_config(node).string()),
 			                     *this)
@@ -208,11 +342,13 @@ extern "C" Vfs::File_system_factory *vfs_file_system_factory(void)
 {
 	struct Factory : Vfs::File_system_factory
 	{
+		Vfs_ttf::Ttf_files _ttf_files { };
+
 		Vfs::File_system *create(Vfs::Env &vfs_env,
 		                         Genode::Xml_node node) override
 		{
 			try { return new (vfs_env.alloc())
-				Vfs_ttf::File_system(vfs_env, node); }
+				Vfs_ttf::File_system(vfs_env, _ttf_files, node); }
 			catch (...) { }
 			return nullptr;
 		}
@@ -14,6 +14,8 @@
 /* Genode includes */
 #include <base/env.h>
 #include "cpu_session_component.h"
+#include <pd_session/client.h>
+#include <region_map/client.h>
 #include <util/arg_string.h>
 #include <util/list.h>
 
@@ -28,6 +30,10 @@ Cpu_sampler::Cpu_session_component::create_thread(Pd_session_capability  pd,
                                                   Weight                 weight,
                                                   addr_t                 utcb)
 {
+	/* all threads of a session share the stack area of the same PD */
+	if (!_pd.valid())
+		_pd = pd;
+
 	Cpu_thread_component *cpu_thread = new (_md_alloc)
 		Cpu_thread_component(*this, _env,
 	                         _md_alloc,
@@ -136,6 +142,40 @@ Cpu_sampler::Cpu_session_component::~Cpu_session_component()
 }
 
 
+bool Cpu_sampler::Cpu_session_component::read_stack_word(addr_t addr,
+                                                        addr_t &value)
+{
+	addr_t const base = Thread::stack_area_virtual_base();
+	size_t const size = Thread::stack_area_virtual_size();
+
+	if (addr < base || addr - base > size - sizeof(addr_t)
+	 || (addr & (sizeof(addr_t) - 1)))
+		return false;
+
+	if (!_stack_area.constructed() && !_stack_area_failed) {
+
+		try {
+			Region_map_client stack_area(Pd_session_client(_pd).stack_area());
+			_stack_area.construct(_env.rm(), stack_area.dataspace());
+		}
+		catch (Region_map::Invalid_dataspace) { _stack_area_failed = true; }
+		catch (Region_map::Region_conflict)   { _stack_area_failed = true; }
+		catch (Out_of_ram)                    { _stack_area_failed = true; }
+		catch (Out_of_caps)                   { _stack_area_failed = true; }
+
+		if (_stack_area_failed)
+			warning("unable to access stack area of '", _session_label,
+			        "', sampling instruction pointers only");
+	}
+
+	if (!_stack_area.constructed())
+		return false;
+
+	value = _stack_area->local_addr<addr_t const>()[(addr - base) / sizeof(addr_t)];
+	return true;
+}
+
+
 int Cpu_sampler::Cpu_session_component::ref_account(Cpu_session_capability cap)
 {
 	return _parent_cpu_session.ref_account(cap);
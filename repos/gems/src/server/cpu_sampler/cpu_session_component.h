@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <base/allocator.h>
+#include <base/attached_dataspace.h>
 #include <base/rpc_server.h>
 #include <cpu_session/client.h>
 #include <os/session_policy.h>
@@ -69,12 +70,28 @@ class Cpu_sampler::Cpu_session_component : public Rpc_object<Cpu_session>
 		Capability<Cpu_session::Native_cpu>      _setup_native_cpu();
 		void _cleanup_native_cpu();
 
+		/* client's stack area, attached on demand for unwinding call stacks */
+		Pd_session_capability                    _pd { };
+		Constructible<Attached_dataspace>        _stack_area { };
+		bool                                     _stack_area_failed = false;
+
 	public:
 
 		Session_label &session_label() { return _session_label; }
 		Cpu_session_client &parent_cpu_session() { return _parent_cpu_session; }
 		Rpc_entrypoint &thread_ep() { return _thread_ep; }
 
+		/**
+		 * Read machine word from the client's stack area
+		 *
+		 * The caller must make sure that the address refers to memory that
+		 * is backed by the client, i.e., the used part of a thread's stack.
+		 *
+		 * \return  false if the address lies outside the stack area or if the
+		 *          stack area cannot be accessed
+		 */
+		bool read_stack_word(addr_t addr, addr_t &value);
+
 		/**
 		 * Constructor
 		 */
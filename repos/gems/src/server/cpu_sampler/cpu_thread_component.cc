@@ -66,6 +66,68 @@ Cpu_sampler::Cpu_thread_component::~Cpu_thread_component()
 }
 
 
+/**
+ * Return frame pointer of the interrupted code
+ *
+ * On x86 and ARMv8, the frame pointer refers to the saved frame pointer of
+ * the caller, followed by the return address. The frame records of 32-bit ARM
+ * differ between compilers and instruction sets, hence only the instruction
+ * pointer is sampled there.
+ */
+static Genode::addr_t frame_pointer(Genode::Thread_state const &state)
+{
+#if defined(__x86_64__)
+	return state.rbp;
+#elif defined(__i386__)
+	return state.ebp;
+#elif defined(__aarch64__)
+	return state.r[29];
+#else
+	(void)state;
+	return 0;
+#endif
+}
+
+
+unsigned Cpu_sampler::Cpu_thread_component::_unwind(Thread_state const &state,
+                                                    addr_t *frames)
+{
+	unsigned depth = 0;
+
+	frames[depth++] = state.ip;
+
+	/*
+	 * Follow the chain of frame records only within the used part of the
+	 * thread's stack. This part is backed by memory, so a bogus frame pointer
+	 * of code compiled without frame pointers cannot cause a page fault in
+	 * the sampler.
+	 */
+	addr_t const word = sizeof(addr_t);
+	addr_t       fp   = frame_pointer(state);
+
+	if (state.sp >= _stack_top)
+		return depth;
+
+	while (depth < _stack_depth && fp >= state.sp && fp < _stack_top - 2*word) {
+
+		addr_t next_fp = 0, ret = 0;
+		if (!_cpu_session_component.read_stack_word(fp, next_fp)
+		 || !_cpu_session_component.read_stack_word(fp + word, ret)
+		 || !ret)
+			break;
+
+		frames[depth++] = ret;
+
+		/* stack grows downwards, callers' frames are located above */
+		if (next_fp <= fp)
+			break;
+
+		fp = next_fp;
+	}
+	return depth;
+}
+
+
 void Cpu_sampler::Cpu_thread_component::take_sample()
 {
 	if (verbose_take_sample)
@@ -77,6 +139,9 @@ void Cpu_sampler::Cpu_thread_component::take_sample()
 		return;
 	}
 
+	addr_t   frames[Stack_profile::MAX_DEPTH];
+	unsigned depth = 0;
+
 	enum { MAX_LOOP_CNT = 100 };
 	unsigned loop_cnt = 0;
 	for (; loop_cnt < MAX_LOOP_CNT; loop_cnt++) {
@@ -87,7 +152,11 @@ void Cpu_sampler::Cpu_thread_component::take_sample()
 
 			Thread_state thread_state = _parent_cpu_thread.state();
 
-			_sample_buf[_sample_buf_index++] = thread_state.ip;
+			/* the stack must be walked while the thread is paused */
+			if (_profile.constructed())
+				depth = _unwind(thread_state, frames);
+			else
+				_sample_buf[_sample_buf_index++] = thread_state.ip;
 
 		} catch (State_access_failed) {
 			continue;
@@ -95,6 +164,9 @@ void Cpu_sampler::Cpu_thread_component::take_sample()
 
 		_parent_cpu_thread.resume();
 
+		if (_profile.constructed())
+			_profile->record(frames, depth);
+
 		if (_sample_buf_index == SAMPLE_BUF_SIZE)
 			flush();
 
@@ -109,11 +181,111 @@ void Cpu_sampler::Cpu_thread_component::take_sample()
 void Cpu_sampler::Cpu_thread_component::reset()
 {
 	_sample_buf_index = 0;
+
+	if (_profile.constructed())
+		_profile->reset();
+}
+
+
+void Cpu_sampler::Cpu_thread_component::configure(Folded_output const &folded,
+                                                  Symbols       const &symbols)
+{
+	_symbols     = symbols;
+	_stack_depth = max(1u, min(folded.stack_depth,
+	                           (unsigned)Stack_profile::MAX_DEPTH));
+
+	if (!folded.enabled) {
+		_profile.destruct();
+		return;
+	}
+
+	if (!_profile.constructed())
+		_profile.construct(_md_alloc, folded.max_stacks);
+}
+
+
+void Cpu_sampler::Cpu_thread_component::_flush_folded()
+{
+	if (_profile->empty())
+		return;
+
+	if (!_log.constructed())
+		_log.construct(_env, _log_session_label);
+
+	enum { LINE_LEN = Log_session::MAX_STRING_LEN, NAME_LEN = 96 };
+
+	typedef String<NAME_LEN> Name;
+
+	/*
+	 * Return addresses point behind the call instruction, which may be the
+	 * first instruction of the next function. Hence, they are symbolized
+	 * by the address of the call.
+	 */
+	auto frame_name = [&] (Stack_profile::Stack const &stack, unsigned i) {
+
+		addr_t const addr = i ? stack.frames[i] - 1 : stack.frames[i];
+
+		Name name { Hex(stack.frames[i]) };
+		_symbols.with_function(addr, [&] (char const *function) {
+			name = Name(function); });
+		return name;
+	};
+
+	_profile->for_each_stack([&] (Stack_profile::Stack const &stack) {
+
+		String<16> const count(" ", stack.count, "\n");
+
+		/*
+		 * Determine the outermost frame that fits into one line, frames
+		 * beyond are elided
+		 */
+		size_t   len   = count.length();
+		unsigned outer = 0;
+		for (; outer < stack.depth; outer++) {
+			size_t const frame_len = frame_name(stack, outer).length();
+			if (len + frame_len + 1 + sizeof("[...];") > LINE_LEN)
+				break;
+			len += frame_len + 1;
+		}
+
+		char line[LINE_LEN];
+		size_t pos = 0;
+
+		auto append = [&] (char const *s) {
+			for (; *s && pos + 1 < sizeof(line); s++)
+				line[pos++] = *s;
+			line[pos] = 0;
+		};
+
+		line[0] = 0;
+		if (outer < stack.depth)
+			append("[...];");
+
+		for (unsigned i = outer; i > 0; i--) {
+			append(frame_name(stack, i - 1).string());
+			if (i > 1)
+				append(";");
+		}
+		append(count.string());
+
+		_log->write(line);
+	});
+
+	if (_profile->dropped())
+		warning(_label, ": ", _profile->dropped(), " samples dropped, "
+		        "increase 'max_stacks'");
+
+	_profile->reset();
 }
 
 
 void Cpu_sampler::Cpu_thread_component::flush()
 {
+	if (_profile.constructed()) {
+		_flush_folded();
+		return;
+	}
+
 	if (_sample_buf_index == 0)
 		return;
 
@@ -152,7 +324,8 @@ Cpu_sampler::Cpu_thread_component::utcb()
 void Cpu_sampler::Cpu_thread_component::start(addr_t ip, addr_t sp)
 {
 	_parent_cpu_thread.start(ip, sp);
-	_started = true;
+	_stack_top = sp;
+	_started   = true;
 }
 
 
@@ -21,6 +21,8 @@
 
 /* local includes */
 #include "cpu_session_component.h"
+#include "stack_profile.h"
+#include "symbol_table.h"
 
 namespace Cpu_sampler {
 	using namespace Genode;
@@ -51,8 +53,32 @@ class Cpu_sampler::Cpu_thread_component : public Rpc_object<Cpu_thread>
 
 		Constructible<Log_connection> _log;
 
+		/* initial stack pointer, upper bound for unwinding */
+		addr_t                 _stack_top = 0;
+
+		unsigned               _stack_depth = 1;
+
+		Symbols                _symbols { };
+
+		/* aggregated call stacks, constructed for folded output only */
+		Constructible<Stack_profile> _profile { };
+
+		unsigned _unwind(Thread_state const &, addr_t *frames);
+
+		void _flush_folded();
+
 	public:
 
+		/**
+		 * Output of aggregated call stacks in the folded format
+		 */
+		struct Folded_output
+		{
+			bool     enabled;
+			unsigned stack_depth;
+			unsigned max_stacks;
+		};
+
 		Cpu_thread_component(Cpu_session_component   &cpu_session_component,
 		                     Env                     &env,
 		                     Allocator               &md_alloc,
@@ -75,6 +101,11 @@ class Cpu_sampler::Cpu_thread_component : public Rpc_object<Cpu_thread>
 		void reset();
 		void flush();
 
+		/**
+		 * Apply sampling parameters of the thread's policy
+		 */
+		void configure(Folded_output const &, Symbols const &);
+
 		/**************************
 		 ** CPU thread interface **
 		 *************************/
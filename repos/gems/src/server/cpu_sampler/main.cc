@@ -15,6 +15,7 @@
 #include <base/attached_rom_dataspace.h>
 #include <base/component.h>
 #include <base/heap.h>
+#include <base/registry.h>
 #include <cpu_session/cpu_session.h>
 #include <base/attached_dataspace.h>
 #include <os/session_policy.h>
@@ -26,6 +27,7 @@
 #include "cpu_root.h"
 #include "cpu_session_component.h"
 #include "cpu_thread_component.h"
+#include "symbol_table.h"
 #include "thread_list_change_handler.h"
 
 namespace Cpu_sampler { struct Main; }
@@ -52,6 +54,51 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 	unsigned int            max_sample_index;
 	Genode::uint64_t        timeout_us;
 
+	typedef Cpu_thread_component::Folded_output Folded_output;
+
+	Folded_output           folded_output { };
+
+	Registry<Registered<Symbol_table>> symbol_tables { };
+
+	Symbol_table const &symbol_table(Symbol_table::Rom_name const &rom,
+	                                 addr_t base)
+	{
+		Symbol_table const *table = nullptr;
+
+		symbol_tables.for_each([&] (Symbol_table const &t) {
+			if (!table && t.matches(rom, base))
+				table = &t; });
+
+		if (table)
+			return *table;
+
+		return *new (alloc)
+			Registered<Symbol_table>(symbol_tables, env, alloc, rom, base);
+	}
+
+	Symbols symbols_of_policy(Xml_node policy)
+	{
+		Symbols symbols { };
+
+		policy.for_each_sub_node("symbols", [&] (Xml_node node) {
+
+			Symbol_table::Rom_name const rom =
+				node.attribute_value("rom", Symbol_table::Rom_name());
+
+			addr_t const base = node.attribute_value("base", (addr_t)0);
+
+			try {
+				if (!symbols.add(symbol_table(rom, base)))
+					warning("symbols: ignoring ROM '", rom, "', "
+					        "too many symbol tables");
+			}
+			catch (Service_denied) {
+				warning("symbols: ROM '", rom, "' not available"); }
+		});
+
+		return symbols;
+	}
+
 
 	void handle_timeout()
 	{
@@ -97,6 +144,18 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 
 		timeout_us = sample_interval_ms * 1000;
 
+		folded_output = Folded_output {
+			.enabled     = (config.xml().attribute_value("output", String<16>()) == "folded"),
+			.stack_depth = config.xml().attribute_value("stack_depth", 16u),
+			.max_stacks  = config.xml().attribute_value("max_stacks", 256u) };
+
+		/* drop references to the symbol tables of the previous config */
+		for_each_thread(thread_list, [&] (Thread_element *cpu_thread_element) {
+			cpu_thread_element->object()->configure(Folded_output { }, Symbols()); });
+
+		symbol_tables.for_each([&] (Registered<Symbol_table> &table) {
+			destroy(alloc, &table); });
+
 		thread_list_changed();
 
 		if (verbose_sample_duration)
@@ -140,6 +199,7 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 			try {
 
 				Session_policy policy(cpu_thread->label(), config.xml());
+				cpu_thread->configure(folded_output, symbols_of_policy(policy));
 				cpu_thread->reset();
 				selected_thread_list.insert(new (&alloc)
 				                            Thread_element(cpu_thread));
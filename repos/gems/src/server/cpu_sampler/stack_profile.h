@@ -0,0 +1,150 @@
+/*
+ * \brief  Aggregation of sampled call stacks
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * Instead of storing each sample, identical call stacks are accumulated in a
+ * hash table with a sample count per stack. The table has a fixed capacity.
+ * Samples of new stacks that do not fit are counted as dropped.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _STACK_PROFILE_H_
+#define _STACK_PROFILE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <util/construct_at.h>
+
+namespace Cpu_sampler {
+	using namespace Genode;
+	class Stack_profile;
+}
+
+
+class Cpu_sampler::Stack_profile : Noncopyable
+{
+	public:
+
+		enum { MAX_DEPTH = 32 };
+
+		struct Stack
+		{
+			unsigned count;   /* 0 denotes an unused entry */
+			unsigned depth;
+
+			/* innermost frame first */
+			addr_t frames[MAX_DEPTH];
+
+			bool equals(addr_t const *f, unsigned d) const
+			{
+				if (d != depth)
+					return false;
+
+				for (unsigned i = 0; i < d; i++)
+					if (frames[i] != f[i])
+						return false;
+
+				return true;
+			}
+		};
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Stack_profile(Stack_profile const &);
+		Stack_profile &operator = (Stack_profile const &);
+
+		Allocator     &_alloc;
+		unsigned const _capacity;
+		Stack * const  _stacks;
+
+		unsigned      _used    = 0;
+		unsigned long _dropped = 0;
+
+		static unsigned _hash(addr_t const *frames, unsigned depth)
+		{
+			/* FNV-1a over the frame addresses */
+			unsigned h = 2166136261u;
+			for (unsigned i = 0; i < depth; i++) {
+				h ^= (unsigned)(frames[i] ^ (frames[i] >> 16));
+				h *= 16777619u;
+			}
+			return h;
+		}
+
+	public:
+
+		Stack_profile(Allocator &alloc, unsigned capacity)
+		:
+			_alloc(alloc), _capacity(max(capacity, 4u)),
+			_stacks((Stack *)alloc.alloc(sizeof(Stack)*_capacity))
+		{
+			reset();
+		}
+
+		~Stack_profile() { _alloc.free(_stacks, sizeof(Stack)*_capacity); }
+
+		void record(addr_t const *frames, unsigned depth)
+		{
+			depth = min(depth, (unsigned)MAX_DEPTH);
+
+			unsigned i = _hash(frames, depth) % _capacity;
+			for (unsigned probe = 0; probe < _capacity; probe++) {
+
+				Stack &s = _stacks[i];
+
+				if (s.count && s.equals(frames, depth)) {
+					s.count++;
+					return;
+				}
+
+				if (!s.count) {
+
+					/* keep the load factor below 3/4 for short probe chains */
+					if (4*(_used + 1) > 3*_capacity)
+						break;
+
+					s.count = 1;
+					s.depth = depth;
+					for (unsigned j = 0; j < depth; j++)
+						s.frames[j] = frames[j];
+					_used++;
+					return;
+				}
+
+				i = (i + 1) % _capacity;
+			}
+			_dropped++;
+		}
+
+		template <typename FN>
+		void for_each_stack(FN const &fn) const
+		{
+			for (unsigned i = 0; i < _capacity; i++)
+				if (_stacks[i].count)
+					fn(_stacks[i]);
+		}
+
+		bool          empty()   const { return !_used && !_dropped; }
+		unsigned long dropped() const { return _dropped; }
+
+		void reset()
+		{
+			for (unsigned i = 0; i < _capacity; i++)
+				construct_at<Stack>(&_stacks[i]);
+
+			_used    = 0;
+			_dropped = 0;
+		}
+};
+
+#endif /* _STACK_PROFILE_H_ */
@@ -0,0 +1,315 @@
+/*
+ * \brief  Function symbols of an ELF object
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The symbols are taken from the ELF image of a sampled component or shared
+ * library, which is obtained as ROM module. Only function symbols are kept.
+ * They are sorted by address so that the function containing a sampled
+ * address can be found by binary search.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SYMBOL_TABLE_H_
+#define _SYMBOL_TABLE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/log.h>
+#include <util/interface.h>
+#include <util/string.h>
+
+namespace Cpu_sampler {
+	using namespace Genode;
+	class Symbol_table;
+	class Symbols;
+}
+
+
+class Cpu_sampler::Symbol_table : Interface, Noncopyable
+{
+	public:
+
+		typedef String<64> Rom_name;
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Symbol_table(Symbol_table const &);
+		Symbol_table &operator = (Symbol_table const &);
+
+		/*
+		 * ELF structures of the native word width
+		 *
+		 * The section and symbol headers are not covered by the base-internal
+		 * ELF definitions, which are tailored to loading programs.
+		 */
+
+		struct Ehdr
+		{
+			unsigned char ident[16];
+			uint16_t      type, machine;
+			uint32_t      version;
+			addr_t        entry, phoff, shoff;
+			uint32_t      flags;
+			uint16_t      ehsize, phentsize, phnum, shentsize, shnum, shstrndx;
+		};
+
+		struct Shdr
+		{
+			uint32_t name, type;
+			addr_t   flags, addr, offset, size;
+			uint32_t link, info;
+			addr_t   addralign, entsize;
+		};
+
+#ifdef __LP64__
+		struct Sym
+		{
+			uint32_t      name;
+			unsigned char info, other;
+			uint16_t      shndx;
+			addr_t        value;
+			size_t        size;
+		};
+#else
+		struct Sym
+		{
+			uint32_t      name;
+			addr_t        value;
+			size_t        size;
+			unsigned char info, other;
+			uint16_t      shndx;
+		};
+#endif
+
+		enum { SHT_SYMTAB = 2, SHT_DYNSYM = 11, STT_FUNC = 2 };
+
+		struct Entry
+		{
+			addr_t   addr;
+			size_t   size;
+			uint32_t name;
+		};
+
+		Allocator &_alloc;
+
+		Rom_name const _rom_name;
+		addr_t   const _base;
+
+		Attached_rom_dataspace _rom;
+
+		char const *_strtab      = nullptr;
+		size_t      _strtab_size = 0;
+
+		Entry   *_entries     = nullptr;
+		unsigned _num_entries = 0;
+
+		template <typename T>
+		T const *_at(addr_t offset, size_t count = 1) const
+		{
+			size_t const size = _rom.size();
+			if (offset > size || count > (size - offset) / sizeof(T))
+				return nullptr;
+
+			return (T const *)(_rom.local_addr<char const>() + offset);
+		}
+
+		/**
+		 * Return symbol section, preferring the full symbol table over the
+		 * dynamic symbols
+		 */
+		Shdr const *_symbol_section(Shdr const *sections, unsigned num) const
+		{
+			Shdr const *dynsym = nullptr;
+
+			for (unsigned i = 0; i < num; i++) {
+				if (sections[i].type == SHT_SYMTAB && sections[i].link < num)
+					return &sections[i];
+
+				if (sections[i].type == SHT_DYNSYM && sections[i].link < num)
+					dynsym = &sections[i];
+			}
+			return dynsym;
+		}
+
+		static bool _function(Sym const &sym)
+		{
+			return ((sym.info & 0xf) == STT_FUNC) && sym.value;
+		}
+
+		void _sort()
+		{
+			/* shell sort, the tables are sorted only once */
+			static unsigned const gaps[] = { 701, 301, 132, 57, 23, 10, 4, 1 };
+
+			for (unsigned gap : gaps)
+				for (unsigned i = gap; i < _num_entries; i++) {
+					Entry const e = _entries[i];
+					unsigned j = i;
+					for (; j >= gap && _entries[j - gap].addr > e.addr; j -= gap)
+						_entries[j] = _entries[j - gap];
+					_entries[j] = e;
+				}
+		}
+
+		void _import()
+		{
+			Ehdr const *ehdr = _at<Ehdr>(0);
+
+			if (!ehdr || memcmp(ehdr->ident, "\177ELF", 4)
+			 || ehdr->ident[4] != (sizeof(addr_t) == 8 ? 2 : 1)
+			 || ehdr->shentsize != sizeof(Shdr)) {
+				warning("symbols: ROM '", _rom_name, "' is not a suitable ELF image");
+				return;
+			}
+
+			Shdr const *sections = _at<Shdr>(ehdr->shoff, ehdr->shnum);
+			Shdr const *symtab   = sections
+			                     ? _symbol_section(sections, ehdr->shnum)
+			                     : nullptr;
+			if (!symtab) {
+				warning("symbols: ROM '", _rom_name, "' lacks a symbol table");
+				return;
+			}
+
+			Shdr const &strtab = sections[symtab->link];
+
+			size_t const num_syms = symtab->size / sizeof(Sym);
+			Sym  const  *syms     = _at<Sym>(symtab->offset, num_syms);
+			_strtab               = _at<char>(strtab.offset, strtab.size);
+
+			if (!syms || !_strtab || !strtab.size || _strtab[strtab.size - 1]) {
+				warning("symbols: ROM '", _rom_name, "' has a malformed symbol table");
+				_strtab = nullptr;
+				return;
+			}
+			_strtab_size = strtab.size;
+
+			for (size_t i = 0; i < num_syms; i++)
+				if (_function(syms[i]) && syms[i].name < _strtab_size)
+					_num_entries++;
+
+			if (!_num_entries)
+				return;
+
+			_entries = (Entry *)_alloc.alloc(sizeof(Entry)*_num_entries);
+
+			unsigned n = 0;
+			for (size_t i = 0; i < num_syms; i++)
+				if (_function(syms[i]) && syms[i].name < _strtab_size)
+					_entries[n++] = Entry { .addr = _base + syms[i].value,
+					                        .size = syms[i].size,
+					                        .name = syms[i].name };
+			_sort();
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param base  load address of a shared object, 0 for programs
+		 */
+		Symbol_table(Env &env, Allocator &alloc, Rom_name const &rom_name,
+		             addr_t base)
+		:
+			_alloc(alloc), _rom_name(rom_name), _base(base),
+			_rom(env, rom_name.string())
+		{
+			_import();
+		}
+
+		~Symbol_table()
+		{
+			if (_entries)
+				_alloc.free(_entries, sizeof(Entry)*_num_entries);
+		}
+
+		bool matches(Rom_name const &rom_name, addr_t base) const
+		{
+			return rom_name == _rom_name && base == _base;
+		}
+
+		/**
+		 * Call 'fn' with the name of the function containing 'addr'
+		 *
+		 * \return  false if no function symbol covers the address
+		 */
+		template <typename FN>
+		bool with_function(addr_t addr, FN const &fn) const
+		{
+			if (!_num_entries || addr < _entries[0].addr)
+				return false;
+
+			/* find the last entry starting at or below 'addr' */
+			unsigned lo = 0, hi = _num_entries - 1;
+			while (lo < hi) {
+				unsigned const mid = lo + (hi - lo + 1) / 2;
+				if (_entries[mid].addr <= addr)
+					lo = mid;
+				else
+					hi = mid - 1;
+			}
+
+			Entry const &e = _entries[lo];
+			if (e.size && addr - e.addr >= e.size)
+				return false;
+
+			fn(_strtab + e.name);
+			return true;
+		}
+};
+
+
+/**
+ * Symbol tables consulted for the threads of one policy
+ */
+class Cpu_sampler::Symbols
+{
+	public:
+
+		enum { MAX_TABLES = 8 };
+
+	private:
+
+		Symbol_table const *_tables[MAX_TABLES] { };
+		unsigned            _num_tables = 0;
+
+	public:
+
+		/**
+		 * Add symbol table
+		 *
+		 * \return  false if the maximum number of tables is reached
+		 */
+		bool add(Symbol_table const &table)
+		{
+			if (_num_tables == MAX_TABLES)
+				return false;
+
+			_tables[_num_tables++] = &table;
+			return true;
+		}
+
+		template <typename FN>
+		bool with_function(addr_t addr, FN const &fn) const
+		{
+			for (unsigned i = 0; i < _num_tables; i++)
+				if (_tables[i]->with_function(addr, fn))
+					return true;
+
+			return false;
+		}
+};
+
+#endif /* _SYMBOL_TABLE_H_ */
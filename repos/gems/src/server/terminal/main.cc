@@ -134,14 +134,61 @@ struct Terminal::Main : Character_consumer
 	 */
 	Genode::uint64_t const _flush_delay = 5;
 
+	/*
+	 * Minimum time in milliseconds between two updates of the pixels. While
+	 * a client produces output continuously, the terminal content is
+	 * rendered at most once per period.
+	 */
+	Genode::uint64_t _frame_period = 20;
+
+	Genode::uint64_t _last_flush_ms = 0;
+
 	bool _flush_scheduled = false;
 
 	Framebuffer::Mode _flushed_fb_mode { };
 
+	/*
+	 * Statistics of the flush times, logged every 'log_flushes' flushes
+	 */
+	struct Flush_stats
+	{
+		unsigned flushes;
+		uint64_t total_us, max_us;
+
+		void record(uint64_t us)
+		{
+			flushes++;
+			total_us += us;
+			max_us    = max(max_us, us);
+		}
+	};
+
+	Flush_stats _flush_stats { };
+
+	unsigned _log_flushes = 0;
+
+	void _log_flush_stats()
+	{
+		Text_screen_surface<PT>::Stats const lines = _text_screen_surface->stats();
+
+		log("flush: ", _flush_stats.flushes, " flushes, "
+		    "avg ", _flush_stats.total_us/_flush_stats.flushes, " us, "
+		    "max ", _flush_stats.max_us, " us, ",
+		    lines.painted_lines, " lines painted, ",
+		    lines.moved_lines,   " lines moved");
+
+		_flush_stats = Flush_stats { };
+		_text_screen_surface->reset_stats();
+	}
+
 	void _handle_flush()
 	{
 		_flush_scheduled = false;
 
+		uint64_t const start_us = _timer.elapsed_us();
+
+		_last_flush_ms = start_us/1000;
+
 		if (_text_screen_surface.constructed() && _fb_ds.constructed()) {
 
 			Surface<PT> surface(_fb_ds->local_addr<PT>(), _fb_mode.area);
@@ -149,6 +196,13 @@ struct Terminal::Main : Character_consumer
 			Rect const dirty = _text_screen_surface->redraw(surface);
 
 			_gui.framebuffer()->refresh(dirty.x1(), dirty.y1(), dirty.w(), dirty.h());
+
+			if (_log_flushes) {
+				_flush_stats.record(_timer.elapsed_us() - start_us);
+
+				if (_flush_stats.flushes >= _log_flushes)
+					_log_flush_stats();
+			}
 		}
 
 		/* update view geometry after mode change */
@@ -168,10 +222,17 @@ struct Terminal::Main : Character_consumer
 
 	void _schedule_flush()
 	{
-		if (!_flush_scheduled) {
-			_timer.trigger_once((Genode::uint64_t)1000*_flush_delay);
-			_flush_scheduled = true;
-		}
+		if (_flush_scheduled)
+			return;
+
+		/* defer the flush until the end of the current frame period */
+		uint64_t const now_ms  = _timer.elapsed_ms();
+		uint64_t const next_ms = _last_flush_ms + _frame_period;
+
+		uint64_t const delay_ms = max(_flush_delay, (next_ms > now_ms) ? next_ms - now_ms : 0);
+
+		_timer.trigger_once(1000*delay_ms);
+		_flush_scheduled = true;
 	}
 
 	/**
@@ -232,6 +293,9 @@ void Terminal::Main::_handle_config()
 
 	_color_palette.apply_config(config);
 
+	_frame_period = config.attribute_value("frame_period_ms", 20UL);
+	_log_flushes  = config.attribute_value("log_flushes", 0U);
+
 	_font.destruct();
 
 	_root_dir.apply_config(config.sub_node("vfs"));
@@ -141,6 +141,14 @@ class Terminal::Text_screen_surface
 				}
 		};
 
+		/**
+		 * Number of lines painted and moved by 'redraw'
+		 */
+		struct Stats
+		{
+			unsigned long painted_lines, moved_lines;
+		};
+
 	private:
 
 		Font          const &_font;
@@ -175,6 +183,70 @@ class Terminal::Text_screen_surface
 
 		Position _pointer { -1, -1 };
 
+		Stats _stats { };
+
+		/**
+		 * Present scrolled lines by moving their pixels
+		 *
+		 * Of the lines displaced by scrolling, those moved by the same
+		 * distance as the first one are presented at once and marked as
+		 * clean. The other lines within the moved area must be repainted.
+		 * The pointer highlight is painted at a screen position and must not
+		 * move with the text. Hence, the pointer line and the line scrolled
+		 * away from the pointer position are repainted instead of moved.
+		 *
+		 * \return  moved area in pixels
+		 */
+		Rect _move_scrolled_lines(Surface<PT> &surface)
+		{
+			int const num_lines = (int)_cell_array.num_lines();
+
+			auto displacement = [&] (int line)
+			{
+				int const origin = _cell_array.line_origin(line);
+
+				if (line == _pointer.y || origin == _pointer.y)
+					return 0;
+
+				return (_cell_array.line_dirty(line) && origin >= 0) ? origin - line : 0;
+			};
+
+			int distance = 0;
+			for (int line = 0; line < num_lines && !distance; line++)
+				distance = displacement(line);
+
+			if (!distance)
+				return Rect();
+
+			int first = num_lines, last = -1;
+			for (int line = 0; line < num_lines; line++) {
+				if (displacement(line) == distance) {
+					first = min(first, line);
+					last  = max(last,  line);
+				}
+			}
+
+			for (int line = first; line <= last; line++) {
+				if (displacement(line) == distance) {
+					_cell_array.mark_line_as_clean(line);
+					_stats.moved_lines++;
+				} else {
+					_cell_array.mark_line_as_dirty(line);
+				}
+			}
+
+			unsigned const w = _geometry.fb_size.w();
+			unsigned const h = (last - first + 1)*_geometry.char_height;
+			int      const y = _geometry.start().y() + first*_geometry.char_height;
+
+			PT * const dst = surface.addr() + (long)y*w;
+			PT * const src = dst + (long)distance*_geometry.char_height*w;
+
+			memmove(dst, src, (size_t)h*w*sizeof(PT));
+
+			return Rect(Point(0, y), Area(w, h));
+		}
+
 	public:
 
 		/**
@@ -224,6 +296,8 @@ class Terminal::Text_screen_surface
 					Box_painter::paint(surface, r[i], bg_color);
 			}
 
+			Rect const moved = _move_scrolled_lines(surface);
+
 			int const clip_top  = 0, clip_bottom = _geometry.fb_size.h(),
 			          clip_left = 0, clip_right  = _geometry.fb_size.w();
 
@@ -232,6 +306,8 @@ class Terminal::Text_screen_surface
 
 				if (_cell_array.line_dirty(line)) {
 
+					_stats.painted_lines++;
+
 					Fixpoint_number x { (int)_geometry.start().x() };
 					for (unsigned column = 0; column < _cell_array.num_cols(); column++) {
 
@@ -326,12 +402,18 @@ class Terminal::Text_screen_surface
 				unsigned const h = num_dirty_lines*_geometry.char_height
 				                 + _geometry.unused_pixels().h();
 
-				return Rect(Point(0, y), Area(_geometry.fb_size.w(),h));
+				Rect const painted(Point(0, y), Area(_geometry.fb_size.w(),h));
+
+				return moved.valid() ? Rect::compound(moved, painted) : painted;
 			}
 
-			return Rect();
+			return moved;
 		}
 
+		Stats stats() const { return _stats; }
+
+		void reset_stats() { _stats = Stats { }; }
+
 		void apply_character(Character c)
 		{
 			clear_selection();
@@ -2,4 +2,7 @@ TARGET = test-cpu_sampler
 SRC_CC = main.cc
 LIBS   = base
 
+# keep frame records for unwinding call stacks by the cpu_sampler
+CC_OPT += -fno-omit-frame-pointer
+
 CC_CXX_WARN_STRICT =
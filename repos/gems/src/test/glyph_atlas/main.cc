@@ -0,0 +1,114 @@
+/*
+ * \brief  Costs of fonts obtained from the VFS with and without glyph atlas
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * For each configured font directory, the test measures the time needed to
+ * open the font, the time of painting a text for the first time and for a
+ * second time, and the memory consumed by the font.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <nitpicker_gfx/text_painter.h>
+#include <os/pixel_rgb888.h>
+#include <os/surface.h>
+#include <os/vfs.h>
+#include <timer_session/connection.h>
+
+/* gems includes */
+#include <gems/vfs_font.h>
+
+using namespace Genode;
+
+
+namespace Test { struct Main; }
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Root_directory _root { _env, _heap, _config.xml().sub_node("vfs") };
+
+	typedef Pixel_rgb888 PT;
+
+	Surface_base::Area const _size { 640, 480 };
+
+	PT * const _pixels = new (_heap) PT[_size.count()];
+
+	Surface<PT> _surface { _pixels, _size };
+
+	/*
+	 * Noncopyable
+	 */
+	Main(Main const &);
+	Main &operator = (Main const &);
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	/**
+	 * Paint all printable ASCII characters, return duration in microseconds
+	 */
+	uint64_t _paint(Text_painter::Font const &font)
+	{
+		char text[0x7f - 0x20 + 1] { };
+		for (unsigned i = 0; i < sizeof(text) - 1; i++)
+			text[i] = (char)(0x20 + i);
+
+		uint64_t const start_us = _now_us();
+
+		Text_painter::paint(_surface, Text_painter::Position(0, 0), font,
+		                    Color(255, 255, 255), text);
+
+		return _now_us() - start_us;
+	}
+
+	void _measure(Directory::Path const &path)
+	{
+		size_t   const heap_before_bytes = _heap.consumed();
+		uint64_t const start_us          = _now_us();
+
+		Vfs_font font { _heap, _root, path };
+
+		uint64_t const open_us    = _now_us() - start_us;
+		size_t   const heap_bytes = _heap.consumed() - heap_before_bytes;
+
+		uint64_t const first_us  = _paint(font);
+		uint64_t const second_us = _paint(font);
+
+		log(path, ": open ", open_us, " us, "
+		    "first paint ", first_us, " us, "
+		    "second paint ", second_us, " us, "
+		    "atlas ", font.atlas_bytes(), " bytes, "
+		    "heap ", heap_bytes, " bytes");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_surface.clip(Surface_base::Rect(Surface_base::Point(0, 0), _size));
+
+		_config.xml().for_each_sub_node("font", [&] (Xml_node const &node) {
+			_measure(node.attribute_value("path", Directory::Path())); });
+
+		log("--- glyph atlas test finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
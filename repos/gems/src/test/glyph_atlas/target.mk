@@ -0,0 +1,3 @@
+TARGET = test-glyph_atlas
+SRC_CC = main.cc
+LIBS   = base vfs
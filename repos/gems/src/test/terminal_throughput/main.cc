@@ -0,0 +1,92 @@
+/*
+ * \brief  Throughput of a terminal for log-like output
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The test writes lines of text to the terminal in chunks, which resembles
+ * the output of a component that logs heavily. Since the terminal processes
+ * the written characters synchronously and renders its content in between,
+ * the measured throughput reflects the costs of both.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/log.h>
+#include <terminal_session/connection.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+namespace Test { struct Main; }
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Terminal::Connection _terminal { _env };
+
+	Timer::Connection _timer { _env };
+
+	size_t const _total_bytes =
+		_config.xml().attribute_value("size", Number_of_bytes(4*1024*1024));
+
+	size_t const _chunk_bytes =
+		max(_config.xml().attribute_value("chunk", Number_of_bytes(1024)), Number_of_bytes(1));
+
+	/*
+	 * Buffer with one chunk of text
+	 */
+	char _chunk[4096] { };
+
+	void _init_chunk()
+	{
+		size_t const len = min(_chunk_bytes, sizeof(_chunk));
+
+		unsigned line = 0;
+		for (size_t i = 0; i < len; ) {
+
+			String<80> const text("[init -> test] line ", line++,
+			                      ": The quick brown fox jumps over the lazy dog\r\n");
+
+			for (size_t j = 0; j < text.length() - 1 && i < len; j++, i++)
+				_chunk[i] = text.string()[j];
+		}
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_init_chunk();
+
+		size_t const chunk_bytes = min(_chunk_bytes, sizeof(_chunk));
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		size_t written_bytes = 0;
+		while (written_bytes < _total_bytes) {
+			size_t const n = min(chunk_bytes, _total_bytes - written_bytes);
+			written_bytes += _terminal.write(_chunk, n);
+		}
+
+		uint64_t const duration_us = max(_timer.elapsed_us() - start_us, (uint64_t)1);
+
+		log("wrote ", Number_of_bytes(written_bytes), " in ", duration_us/1000, " ms, ",
+		    ((uint64_t)written_bytes*1000*1000/1024)/duration_us, " KiB/s");
+
+		log("--- terminal throughput test finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -31,4 +31,33 @@
 extern "C" void blit(void const *src, unsigned src_w,
                      void *dst, unsigned dst_w, int w, int h);
 
+
+/**
+ * Clockwise rotation applied by 'blit_rotated'
+ */
+enum Blit_rotation { BLIT_ROTATE_0, BLIT_ROTATE_90, BLIT_ROTATE_180,
+                     BLIT_ROTATE_270 };
+
+
+/**
+ * Blit 32bit pixels from source buffer to destination buffer with rotation
+ *
+ * \param src       address of source buffer
+ * \param src_w     line length of source buffer in bytes
+ * \param dst       address of destination buffer
+ * \param dst_w     line length of destination buffer in bytes
+ * \param w         number of pixels per source line to copy
+ * \param h         number of source lines to copy
+ * \param rotation  rotation of the source pixels
+ * \param flip      mirror the source pixels horizontally prior rotation
+ *
+ * The destination area has a size of 'w' x 'h' pixels when rotating by 0
+ * or 180 degrees, and 'h' x 'w' pixels otherwise. Both buffers must be
+ * 32bit aligned. If the source and destination overlap, the result of the
+ * copy operation is not defined.
+ */
+extern "C" void blit_rotated(void const *src, unsigned src_w,
+                             void *dst, unsigned dst_w, int w, int h,
+                             Blit_rotation rotation, bool flip);
+
 #endif /* _INCLUDE__BLIT__BLIT_H_ */
@@ -86,6 +86,14 @@ struct Block::Connection : Genode::Connection<Session>, Session_client
 				 */
 				Payload _payload { };
 
+				/*
+				 * True if the payload was supplied by the application
+				 *
+				 * Such a payload is neither allocated nor released by the
+				 * connection and the data is not copied via the policy.
+				 */
+				bool const _external_payload = false;
+
 				bool _completed = false;
 
 				/*
@@ -118,12 +126,30 @@ struct Block::Connection : Genode::Connection<Session>, Session_client
 						                            _operation.count - _position) };
 				}
 
+				/**
+				 * Return payload of the current packet
+				 */
+				Payload _curr_payload() const
+				{
+					if (!_external_payload)
+						return _payload;
+
+					size_t const block_size = _connection._info.block_size;
+					size_t const skip       = _position * block_size;
+
+					return { .offset = _payload.offset + (off_t)skip,
+					         .bytes  = _payload.bytes - skip };
+				}
+
 				template <typename FN>
 				static void _with_offset_and_length(Job &job, FN const &fn)
 				{
 					if (!Operation::has_payload(job._operation.type))
 						return;
 
+					if (job._external_payload)
+						return;
+
 					Operation const operation  = job._curr_operation();
 					size_t    const block_size = job._connection._info.block_size;
 
@@ -139,7 +165,7 @@ struct Block::Connection : Genode::Connection<Session>, Session_client
 
 					Request::Tag const tag { _tag->id().value };
 
-					Packet_descriptor const p(_curr_operation(), _payload, tag);
+					Packet_descriptor const p(_curr_operation(), _curr_payload(), tag);
 
 					if (_operation.type == Operation::Type::WRITE)
 						_with_offset_and_length(job, [&] (off_t offset, size_t length) {
@@ -158,6 +184,27 @@ struct Block::Connection : Genode::Connection<Session>, Session_client
 					_connection._pending.enqueue(_pending_elem);
 				}
 
+				/**
+				 * Constructor for operating directly on a given payload
+				 *
+				 * \param payload  location of the data within the packet-stream
+				 *                 buffer, which must not be managed by the
+				 *                 connection's packet allocator
+				 *
+				 * This constructor allows for passing data through without
+				 * copying, e.g., if the payload was placed into the buffer by
+				 * another party. The 'produce_write_content' and
+				 * 'consume_read_result' policy hooks are not called for such
+				 * a job.
+				 */
+				Job(Connection &connection, Operation operation, Payload payload)
+				:
+					_connection(connection), _operation(operation),
+					_payload(payload), _external_payload(true)
+				{
+					_connection._pending.enqueue(_pending_elem);
+				}
+
 				~Job()
 				{
 					if (pending()) {
@@ -384,6 +431,10 @@ bool Block::Connection<JOB>::_try_process_ack(POLICY &policy, Tx::Source &tx)
 				Operation::has_payload(type) &&
 				(job_base._position + p.block_count() < job_base._operation.count);
 
+			/* externally supplied payload is not owned by the packet allocator */
+			if (job_base._external_payload)
+				release_packet = false;
+
 			if (partial_read_or_write) {
 
 				/*
@@ -442,6 +493,11 @@ bool Block::Connection<JOB>::_try_submit_pending_job(POLICY &policy, Tx::Source
 			if (!Operation::has_payload(job._operation.type))
 				return;
 
+			if (job._external_payload) {
+				payload = job._payload;
+				return;
+			}
+
 			size_t const bytes = _info.block_size * job._curr_operation().count;
 
 			payload = { .offset = tx.alloc_packet(bytes, (unsigned)_info.align_log2).offset(),
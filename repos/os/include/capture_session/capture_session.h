@@ -19,6 +19,7 @@
 #include <os/surface.h>
 #include <os/pixel_rgb888.h>
 #include <dataspace/capability.h>
+#include <capture_session/tile_stream.h>
 
 namespace Capture {
 
@@ -115,6 +116,85 @@ struct Capture::Session : Genode::Session
 	 */
 	virtual Affected_rects capture_at(Point) = 0;
 
+	/**
+	 * Parameters of the change detection per tile
+	 */
+	struct Tiling
+	{
+		unsigned tile_size;  /* width and height of a tile, 0 disables tiling */
+		bool     encode;     /* provide run-length encoded tile content */
+
+		bool enabled() const { return tile_size > 0; }
+
+		/*
+		 * The number of tiles is computed without overflow for any
+		 * 'tile_size' provided by a client.
+		 */
+		unsigned columns(Area size) const { return _count(size.w()); }
+		unsigned rows   (Area size) const { return _count(size.h()); }
+
+		unsigned _count(unsigned len) const
+		{
+			return len/tile_size + (len % tile_size ? 1 : 0);
+		}
+	};
+
+	/**
+	 * Return number of bytes of the tile stream for the given buffer size
+	 *
+	 * The encoded tile content is limited to half of the pixel buffer. Tiles
+	 * exceeding this limit are reported as 'RAW' tiles.
+	 */
+	static size_t tile_stream_bytes(Area size, Tiling tiling)
+	{
+		if (!tiling.enabled())
+			return 0;
+
+		size_t const num_tiles = (size_t)tiling.columns(size)*tiling.rows(size);
+
+		return sizeof(Tile_stream::Header) + num_tiles*sizeof(Tile_stream::Tile)
+		     + (tiling.encode ? buffer_bytes(size)/2 : 0);
+	}
+
+	/**
+	 * Return number of bytes needed by the server for the tiling
+	 *
+	 * Besides the tile stream, the server keeps a hash value per tile.
+	 */
+	static size_t tiling_bytes(Area size, Tiling tiling)
+	{
+		if (!tiling.enabled())
+			return 0;
+
+		size_t const num_tiles = (size_t)tiling.columns(size)*tiling.rows(size);
+
+		return tile_stream_bytes(size, tiling) + num_tiles*2*sizeof(uint64_t);
+	}
+
+	/**
+	 * Enable the change detection per tile for the current pixel buffer
+	 *
+	 * When enabled, 'capture_at' compares the content of each tile within
+	 * the drawn area with the content at the previous call. Only tiles
+	 * with changed content are reported via the tile stream, and the
+	 * returned 'Affected_rects' cover the changed tiles only. A call of
+	 * 'buffer' disables the tiling. The server may adjust the tile size
+	 * to a sensible range, which never increases the number of tiles.
+	 *
+	 * \throw Out_of_ram   session quota does not suffice for the tiling
+	 *                     of the current buffer, see 'tiling_bytes'
+	 * \throw Out_of_caps
+	 */
+	virtual void tiling(Tiling) = 0;
+
+	/**
+	 * Request dataspace of the tile stream, see 'Tile_stream'
+	 *
+	 * The dataspace is invalid if the tiling is disabled or not supported
+	 * by the server.
+	 */
+	virtual Dataspace_capability tile_stream() = 0;
+
 
 	/*********************
 	 ** RPC declaration **
@@ -126,9 +206,13 @@ struct Capture::Session : Genode::Session
 	                 GENODE_TYPE_LIST(Out_of_ram, Out_of_caps), Area);
 	GENODE_RPC(Rpc_dataspace, Dataspace_capability, dataspace);
 	GENODE_RPC(Rpc_capture_at, Affected_rects, capture_at, Point);
+	GENODE_RPC_THROW(Rpc_tiling, void, tiling,
+	                 GENODE_TYPE_LIST(Out_of_ram, Out_of_caps), Tiling);
+	GENODE_RPC(Rpc_tile_stream, Dataspace_capability, tile_stream);
 
 	GENODE_RPC_INTERFACE(Rpc_screen_size, Rpc_screen_size_sigh, Rpc_buffer,
-	                     Rpc_dataspace, Rpc_capture_at);
+	                     Rpc_dataspace, Rpc_capture_at, Rpc_tiling,
+	                     Rpc_tile_stream);
 };
 
 #endif /* _INCLUDE__CAPTURE_SESSION__CAPTURE_SESSION_H_ */
@@ -42,6 +42,10 @@ struct Capture::Session_client : public Genode::Rpc_client<Session>
 	{
 		return call<Rpc_capture_at>(pos);
 	}
+
+	void tiling(Tiling tiling) override { call<Rpc_tiling>(tiling); }
+
+	Dataspace_capability tile_stream() override { return call<Rpc_tile_stream>(); }
 };
 
 #endif /* _INCLUDE__CAPTURE_SESSION__CLIENT_H_ */
@@ -34,6 +34,19 @@ class Capture::Connection : public Genode::Connection<Session>,
 
 		size_t _session_quota = 0;
 
+		Area _buffer_size { };
+
+		void _upgrade_ram(size_t needed)
+		{
+			size_t const upgrade = needed > _session_quota
+			                     ? needed - _session_quota
+			                     : 0;
+			if (upgrade > 0) {
+				this->upgrade_ram(upgrade);
+				_session_quota += upgrade;
+			}
+		}
+
 	public:
 
 		/**
@@ -50,16 +63,23 @@ class Capture::Connection : public Genode::Connection<Session>,
 
 		void buffer(Area size) override
 		{
-			size_t const needed  = buffer_bytes(size);
-			size_t const upgrade = needed > _session_quota
-			                     ? needed - _session_quota
-			                     : 0;
-			if (upgrade > 0) {
-				this->upgrade_ram(upgrade);
-				_session_quota += upgrade;
-			}
+			_upgrade_ram(buffer_bytes(size));
 
 			Session_client::buffer(size);
+
+			_buffer_size = size;
+		}
+
+		void tiling(Tiling tiling) override
+		{
+			/* account for the page granularity of the two dataspaces */
+			size_t const needed = buffer_bytes(_buffer_size)
+			                    + tiling_bytes(_buffer_size, tiling)
+			                    + (tiling.enabled() ? 2*4096 : 0);
+			_upgrade_ram(needed);
+
+			retry_with_upgrade(Ram_quota{4096}, Cap_quota{2}, [&] () {
+				Session_client::tiling(tiling); });
 		}
 
 		struct Screen;
@@ -0,0 +1,185 @@
+/*
+ * \brief  Stream of changed tiles provided by a capture session
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The stream starts with a 'Header' followed by one 'Tile' record per
+ * changed tile. The content of a 'RAW' tile is taken from the pixel buffer.
+ * A record of an 'RLE' tile is followed by the run-length encoded pixels of
+ * the tile. The encoding consists of 32-bit words. A control word with the
+ * most significant bit set denotes a run of 'count' equal pixels, followed
+ * by the pixel value. Otherwise, the control word is followed by 'count'
+ * literal pixels. The pixels of a tile are encoded line by line.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__CAPTURE_SESSION__TILE_STREAM_H_
+#define _INCLUDE__CAPTURE_SESSION__TILE_STREAM_H_
+
+#include <os/surface.h>
+#include <os/pixel_rgb888.h>
+
+namespace Capture { struct Tile_stream; }
+
+
+struct Capture::Tile_stream
+{
+	typedef Genode::uint32_t            uint32_t;
+	typedef Genode::size_t              size_t;
+	typedef Genode::Pixel_rgb888        Pixel;
+	typedef Genode::Surface_base::Area  Area;
+	typedef Genode::Surface_base::Point Point;
+	typedef Genode::Surface_base::Rect  Rect;
+
+	struct Header
+	{
+		uint32_t num_tiles;
+		uint32_t bytes;      /* used size of the stream including the header */
+	};
+
+	enum Encoding : uint32_t { RAW = 0, RLE = 1 };
+
+	struct Tile
+	{
+		uint32_t x, y, w, h;   /* position and size within the pixel buffer */
+		uint32_t encoding;
+		uint32_t bytes;        /* size of the encoded content */
+
+		Rect rect() const { return Rect(Point((int)x, (int)y), Area(w, h)); }
+	};
+
+	static constexpr uint32_t RUN = 1U << 31;
+
+	/**
+	 * Run-length encode the pixels of 'area' at 'src'
+	 *
+	 * \param stride  number of pixels per line of the source buffer
+	 *
+	 * \return  number of bytes written to 'dst', or 0 if the encoded
+	 *          pixels exceed 'capacity'
+	 */
+	static size_t encode_rle(Pixel const *src, unsigned stride, Area area,
+	                         char *dst, size_t capacity)
+	{
+		uint32_t * const out     = (uint32_t *)dst;
+		size_t     const max_len = capacity/sizeof(uint32_t);
+		size_t           len     = 0;
+
+		for (unsigned y = 0; y < area.h(); y++) {
+
+			uint32_t const * const line = (uint32_t const *)(src + (size_t)y*stride);
+
+			/* index of the control word of a pending literal, or -1 */
+			long literal = -1;
+
+			for (unsigned x = 0; x < area.w(); ) {
+
+				unsigned n = 1;
+				while (x + n < area.w() && line[x + n] == line[x])
+					n++;
+
+				if (n > 1) {
+					if (len + 2 > max_len)
+						return 0;
+
+					out[len++] = RUN | n;
+					out[len++] = line[x];
+					literal    = -1;
+					x += n;
+					continue;
+				}
+
+				if (literal < 0) {
+					if (len + 1 > max_len)
+						return 0;
+
+					literal = (long)len;
+					out[len++] = 0;
+				}
+
+				if (len + 1 > max_len)
+					return 0;
+
+				out[literal]++;
+				out[len++] = line[x++];
+			}
+		}
+		return len*sizeof(uint32_t);
+	}
+
+	/**
+	 * Decode run-length encoded pixels into 'area' at 'dst'
+	 *
+	 * \return  false if the encoded pixels do not match the area
+	 */
+	static bool decode_rle(char const *src, size_t bytes,
+	                       Pixel *dst, unsigned stride, Area area)
+	{
+		uint32_t const * const in  = (uint32_t const *)src;
+		size_t           const len = bytes/sizeof(uint32_t);
+
+		size_t i = 0;
+		for (unsigned y = 0; y < area.h(); y++) {
+
+			Pixel * const line = dst + (size_t)y*stride;
+
+			for (unsigned x = 0; x < area.w(); ) {
+
+				if (i >= len)
+					return false;
+
+				uint32_t const control = in[i++];
+				uint32_t const count   = control & ~RUN;
+				bool     const run     = control & RUN;
+
+				/* runs and literals do not span multiple lines */
+				if (count == 0 || x + count > area.w() || i + (run ? 1 : count) > len)
+					return false;
+
+				for (uint32_t j = 0; j < count; j++)
+					line[x++].pixel = run ? in[i] : in[i + j];
+
+				i += run ? 1 : count;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Call 'fn' with each tile record and its encoded content
+	 */
+	template <typename FN>
+	static void for_each_tile(char const *stream, size_t capacity, FN const &fn)
+	{
+		if (capacity < sizeof(Header))
+			return;
+
+		Header const &header = *(Header const *)stream;
+
+		size_t const bytes = Genode::min((size_t)header.bytes, capacity);
+
+		size_t offset = sizeof(Header);
+		for (uint32_t i = 0; i < header.num_tiles; i++) {
+
+			if (offset + sizeof(Tile) > bytes)
+				return;
+
+			Tile const &tile = *(Tile const *)(stream + offset);
+			offset += sizeof(Tile);
+
+			if (offset + tile.bytes > bytes)
+				return;
+
+			fn(tile, stream + offset);
+			offset += tile.bytes;
+		}
+	}
+};
+
+#endif /* _INCLUDE__CAPTURE_SESSION__TILE_STREAM_H_ */
@@ -18,6 +18,7 @@
 #include <util/dither_matrix.h>
 #include <os/surface.h>
 #include <os/texture.h>
+#include <os/pixel_span.h>
 
 
 struct Dither_painter
@@ -53,6 +54,7 @@ struct Dither_painter
 
 		unsigned const x_max = min((unsigned)clipped.x2(), dst_x + texture.size().w() - 1);
 		unsigned const y_max = min((unsigned)clipped.y2(), dst_y + texture.size().h() - 1);
+		unsigned const w     = x_max >= dst_x ? x_max - dst_x + 1 : 0;
 
 		for (unsigned y = dst_y; y <= y_max; y++) {
 
@@ -76,18 +78,7 @@ struct Dither_painter
 					*dst++ = DST_PT(max(0, r), max(0, g), max(0, b), max(0, a));
 				}
 			} else {
-				for (unsigned x = dst_x; x <= x_max; x++) {
-
-					int const v = Genode::Dither_matrix::value(x, y) >> 4;
-
-					SRC_PT const pixel = *src_pixel++;
-
-					int const r = pixel.r() - v;
-					int const g = pixel.g() - v;
-					int const b = pixel.b() - v;
-
-					*dst++ = DST_PT(max(0, r), max(0, g), max(0, b));
-				}
+				Genode::Pixel_span::dither(dst, src_pixel, w, dst_x, y);
 			}
 
 			src_pixel_line += src_line_len;
@@ -0,0 +1,250 @@
+/*
+ * \brief  Operations on horizontal spans of pixels
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The functions are the inner loops of the painters. The generic versions
+ * apply the per-pixel operations of the pixel type. For the RGB888 format,
+ * the spans are processed four pixels at a time using the vector extension
+ * of the compiler, which maps to SSE2 on x86_64 and to NEON on arm_64. The
+ * results are identical to those of the per-pixel operations.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__OS__PIXEL_SPAN_H_
+#define _INCLUDE__OS__PIXEL_SPAN_H_
+
+#include <util/dither_matrix.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+#define GENODE_PIXEL_SPAN_VECTOR 1
+#endif
+
+namespace Genode { namespace Pixel_span {
+
+	/**
+	 * Fill span with pixel
+	 */
+	template <typename PT>
+	static inline void fill(PT *dst, unsigned n, PT pixel)
+	{
+		for (; n--; dst++)
+			*dst = pixel;
+	}
+
+	/**
+	 * Mix span with pixel at the ratio 'alpha' (0...256)
+	 */
+	template <typename PT>
+	static inline void mix(PT *dst, unsigned n, PT pixel, int alpha)
+	{
+		for (; n--; dst++)
+			*dst = PT::mix(*dst, pixel, alpha);
+	}
+
+	/**
+	 * Mix span with texture pixels according to their alpha values
+	 *
+	 * Pixels with an alpha value of zero are left untouched.
+	 */
+	template <typename PT>
+	static inline void mix_alpha(PT *dst, PT const *src,
+	                             unsigned char const *alpha, unsigned n)
+	{
+		for (; n--; dst++, src++, alpha++)
+			if (__builtin_expect(*alpha != 0, true))
+				*dst = PT::mix(*dst, *src, *alpha + 1);
+	}
+
+	/**
+	 * Convert span to another pixel format by applying dithering
+	 *
+	 * \param x, y  position of the first pixel, selects the dither values
+	 */
+	template <typename DST_PT, typename SRC_PT>
+	static inline void dither(DST_PT *dst, SRC_PT const *src, unsigned n,
+	                          unsigned x, unsigned y)
+	{
+		Dither_matrix::Row const row = Dither_matrix::row(y);
+
+		for (; n--; dst++, src++, x++) {
+			int const v = row.value(x) >> 4;
+			*dst = DST_PT(max(0, src->r() - v), max(0, src->g() - v),
+			              max(0, src->b() - v));
+		}
+	}
+
+#ifdef GENODE_PIXEL_SPAN_VECTOR
+
+	typedef uint8_t  Vec_u8x16  __attribute__((vector_size(16)));
+	typedef uint16_t Vec_u16x4  __attribute__((vector_size(8)));
+	typedef uint16_t Vec_u16x8  __attribute__((vector_size(16)));
+	typedef uint32_t Vec_u32x4  __attribute__((vector_size(16)));
+
+	template <typename V>
+	static inline V _load(void const *ptr)
+	{
+		V v;
+		__builtin_memcpy(&v, ptr, sizeof(v));
+		return v;
+	}
+
+	template <typename V>
+	static inline void _store(void *ptr, V v) { __builtin_memcpy(ptr, &v, sizeof(v)); }
+
+	/**
+	 * Zero-extend the lower and upper eight bytes to 16 bit
+	 */
+	static inline Vec_u16x8 _lo(Vec_u8x16 v)
+	{
+		return (Vec_u16x8)__builtin_shuffle(v, Vec_u8x16 { },
+			Vec_u8x16 { 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23 });
+	}
+
+	static inline Vec_u16x8 _hi(Vec_u8x16 v)
+	{
+		return (Vec_u16x8)__builtin_shuffle(v, Vec_u8x16 { },
+			Vec_u8x16 { 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31 });
+	}
+
+	/**
+	 * Truncate the 16-bit values of two vectors to bytes
+	 */
+	static inline Vec_u8x16 _pack(Vec_u16x8 lo, Vec_u16x8 hi)
+	{
+		return __builtin_shuffle((Vec_u8x16)lo, (Vec_u8x16)hi,
+			Vec_u8x16 { 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30 });
+	}
+
+	/**
+	 * Compute '(d*a_d >> 8) + (s*a_s >> 8)' for each byte of four pixels
+	 *
+	 * The multipliers are given for the lower and upper two pixels.
+	 */
+	static inline void _mix_4(void *dst, void const *src,
+	                          Vec_u16x8 a_d_lo, Vec_u16x8 a_s_lo,
+	                          Vec_u16x8 a_d_hi, Vec_u16x8 a_s_hi)
+	{
+		Vec_u8x16 const d = _load<Vec_u8x16>(dst);
+		Vec_u8x16 const s = _load<Vec_u8x16>(src);
+
+		_store(dst, _pack(((_lo(d)*a_d_lo) >> 8) + ((_lo(s)*a_s_lo) >> 8),
+		                  ((_hi(d)*a_d_hi) >> 8) + ((_hi(s)*a_s_hi) >> 8)));
+	}
+
+	static inline void fill(Pixel_rgb888 *dst, unsigned n, Pixel_rgb888 pixel)
+	{
+		uint32_t const p = pixel.pixel;
+
+		Vec_u32x4 const v = { p, p, p, p };
+
+		for (; n >= 4; n -= 4, dst += 4)
+			_store(dst, v);
+
+		for (; n--; dst++)
+			*dst = pixel;
+	}
+
+	static inline void mix(Pixel_rgb888 *dst, unsigned n, Pixel_rgb888 pixel, int alpha)
+	{
+		/* the unused fourth byte of each pixel is cleared like by 'mix' */
+		uint16_t const a = (uint16_t)alpha, b = (uint16_t)(256 - alpha);
+
+		Vec_u16x8 const a_d = { b, b, b, 0, b, b, b, 0 };
+		Vec_u16x8 const a_s = { a, a, a, 0, a, a, a, 0 };
+
+		Pixel_rgb888 const src[4] = { pixel, pixel, pixel, pixel };
+
+		for (; n >= 4; n -= 4, dst += 4)
+			_mix_4(dst, src, a_d, a_s, a_d, a_s);
+
+		for (; n--; dst++)
+			*dst = Pixel_rgb888::mix(*dst, pixel, alpha);
+	}
+
+	static inline void mix_alpha(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+	                             unsigned char const *alpha, unsigned n)
+	{
+		for (; n >= 4; n -= 4, dst += 4, src += 4, alpha += 4) {
+
+			uint32_t const a = _load<uint32_t>(alpha);
+
+			/* fully transparent */
+			if (a == 0)
+				continue;
+
+			/* fully opaque */
+			if (a == ~0U) {
+				Vec_u32x4 const mask = { 0xffffff, 0xffffff, 0xffffff, 0xffffff };
+				_store(dst, _load<Vec_u32x4>(src) & mask);
+				continue;
+			}
+
+			/* alpha value of each pixel replicated to its color bytes */
+			Vec_u32x4 const t32 = Vec_u32x4 { alpha[0], alpha[1], alpha[2], alpha[3] };
+			Vec_u8x16 const t8  = (Vec_u8x16)(t32*0x010101);
+
+			/* pixels with an alpha value of zero */
+			Vec_u8x16 const h8  = (Vec_u8x16)(t32 == 0);
+
+			/*
+			 * A pixel with an alpha value of zero keeps all its bytes.
+			 * Otherwise, the unused fourth byte is cleared like by 'mix'.
+			 */
+			auto a_d = [] (Vec_u16x8 t, Vec_u16x8 h) {
+				return (Vec_u16x8)(((255 - t) & (Vec_u16x8)(t != 0)) | ((Vec_u16x8)(h != 0) & 256)); };
+
+			auto a_s = [] (Vec_u16x8 t) {
+				return (Vec_u16x8)((t + 1) & (Vec_u16x8)(t != 0)); };
+
+			Vec_u16x8 const t_lo = _lo(t8), t_hi = _hi(t8);
+			Vec_u16x8 const h_lo = _lo(h8), h_hi = _hi(h8);
+
+			_mix_4(dst, src, a_d(t_lo, h_lo), a_s(t_lo), a_d(t_hi, h_hi), a_s(t_hi));
+		}
+
+		for (; n--; dst++, src++, alpha++)
+			if (*alpha)
+				*dst = Pixel_rgb888::mix(*dst, *src, *alpha + 1);
+	}
+
+	static inline void dither(Pixel_rgb565 *dst, Pixel_rgb888 const *src,
+	                          unsigned n, unsigned x, unsigned y)
+	{
+		Dither_matrix::Row const row = Dither_matrix::row(y);
+
+		auto v = [&] (unsigned i) { return (uint32_t)(row.value(x + i) >> 4)*0x01010101U; };
+
+		for (; n >= 4; n -= 4, dst += 4, src += 4, x += 4) {
+
+			/* subtract the dither values from all channels, saturated at 0 */
+			Vec_u8x16 const p   = _load<Vec_u8x16>(src);
+			Vec_u8x16 const sub = (Vec_u8x16)Vec_u32x4 { v(0), v(1), v(2), v(3) };
+			Vec_u8x16 const ge  = (Vec_u8x16)(p >= sub);
+			Vec_u32x4 const q   = (Vec_u32x4)((p - sub) & ge);
+
+			Vec_u32x4 const rgb565 = ((q >> 8) & 0xf800) | ((q >> 5) & 0x07e0)
+			                       | ((q >> 3) & 0x001f);
+
+			_store(dst, __builtin_convertvector(rgb565, Vec_u16x4));
+		}
+
+		for (; n--; dst++, src++, x++) {
+			int const v = row.value(x) >> 4;
+			*dst = Pixel_rgb565(max(0, src->r() - v), max(0, src->g() - v),
+			                    max(0, src->b() - v));
+		}
+	}
+
+#endif /* GENODE_PIXEL_SPAN_VECTOR */
+} }
+
+#endif /* _INCLUDE__OS__PIXEL_SPAN_H_ */
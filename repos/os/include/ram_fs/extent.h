@@ -0,0 +1,372 @@
+/*
+ * \brief  Compact data structure for storing files in RAM
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * In contrast to the hierarchic 'Chunk' structure, which pre-dimensions the
+ * fan-out of each level, the 'Extent_storage' keeps tiny files inline and
+ * represents larger files as a sorted array of contiguous extents. A file
+ * written sequentially thereby occupies only a few allocations whereas sparse
+ * files are still supported by gaps between extents, which read as zeros.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__RAM_FS__EXTENT_H_
+#define _INCLUDE__RAM_FS__EXTENT_H_
+
+/* Genode includes */
+#include <util/noncopyable.h>
+#include <base/allocator.h>
+#include <util/string.h>
+#include <file_system_session/file_system_session.h>
+
+namespace File_system {
+
+	using namespace Genode;
+
+	class Extent_storage;
+}
+
+
+class File_system::Extent_storage : Noncopyable
+{
+	public:
+
+		enum {
+			INLINE_SIZE         = 48,
+			MIN_EXTENT_CAPACITY = 256,
+			MAX_EXTENT_SIZE     = 1024*1024,
+			MIN_EXTENTS         = 4,
+		};
+
+		/*
+		 * Maximum file size, which is merely limited by the seek-offset type
+		 */
+		static constexpr file_size_t SIZE = ~(file_size_t)0 >> 1;
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Extent_storage(Extent_storage const &);
+		Extent_storage &operator = (Extent_storage const &);
+
+		struct Extent
+		{
+			seek_off_t offset;
+			size_t     size;
+			size_t     capacity;
+			char      *data;
+
+			seek_off_t end() const { return offset + size; }
+		};
+
+		Allocator &_alloc;
+
+		/*
+		 * As long as '_extents' is nullptr, the file content is stored in
+		 * '_inline'. The extent array is kept sorted by offset and extents
+		 * never overlap.
+		 */
+		Extent   *_extents     = nullptr;
+		unsigned  _num_extents = 0;
+		unsigned  _max_extents = 0;
+
+		size_t _inline_used = 0;
+		char   _inline[INLINE_SIZE] { };
+
+		bool _inline_mode() const { return _extents == nullptr; }
+
+		/**
+		 * Return index of first extent that ends after 'offset'
+		 */
+		unsigned _index(seek_off_t offset) const
+		{
+			unsigned lo = 0, hi = _num_extents;
+			while (lo < hi) {
+				unsigned const mid = (lo + hi) / 2;
+				if (_extents[mid].end() > offset)
+					hi = mid;
+				else
+					lo = mid + 1;
+			}
+			return lo;
+		}
+
+		void _free_extents()
+		{
+			for (unsigned i = 0; i < _num_extents; i++)
+				_alloc.free(_extents[i].data, _extents[i].capacity);
+
+			if (_extents)
+				_alloc.free(_extents, _max_extents*sizeof(Extent));
+
+			_extents     = nullptr;
+			_num_extents = 0;
+			_max_extents = 0;
+		}
+
+		/**
+		 * Enlarge capacity of extent to hold at least 'size' bytes
+		 */
+		void _reserve(Extent &e, size_t size)
+		{
+			if (size <= e.capacity)
+				return;
+
+			size_t const capacity =
+				min((size_t)MAX_EXTENT_SIZE,
+				    max(size, max(2*e.capacity, (size_t)MIN_EXTENT_CAPACITY)));
+
+			char * const data = (char *)_alloc.alloc(capacity);
+			memcpy(data, e.data, e.size);
+			_alloc.free(e.data, e.capacity);
+
+			e.data     = data;
+			e.capacity = capacity;
+		}
+
+		/**
+		 * Insert empty extent at position 'i' of the extent array
+		 */
+		Extent &_insert(unsigned i, seek_off_t offset, size_t size)
+		{
+			if (_num_extents == _max_extents) {
+				unsigned const max_extents = max(2*_max_extents, (unsigned)MIN_EXTENTS);
+
+				Extent * const extents =
+					(Extent *)_alloc.alloc(max_extents*sizeof(Extent));
+
+				if (_extents) {
+					memcpy(extents, _extents, _num_extents*sizeof(Extent));
+					_alloc.free(_extents, _max_extents*sizeof(Extent));
+				}
+				_extents     = extents;
+				_max_extents = max_extents;
+			}
+
+			size_t const capacity = max(size, (size_t)MIN_EXTENT_CAPACITY);
+			char * const data     = (char *)_alloc.alloc(capacity);
+
+			memmove(&_extents[i + 1], &_extents[i],
+			        (_num_extents - i)*sizeof(Extent));
+			_num_extents++;
+
+			_extents[i] = Extent { .offset   = offset,
+			                       .size     = 0,
+			                       .capacity = capacity,
+			                       .data     = data };
+			return _extents[i];
+		}
+
+		/**
+		 * Move inline content into the first extent
+		 */
+		void _leave_inline_mode()
+		{
+			if (!_inline_mode())
+				return;
+
+			_extents = (Extent *)_alloc.alloc(MIN_EXTENTS*sizeof(Extent));
+			_max_extents = MIN_EXTENTS;
+
+			if (_inline_used == 0)
+				return;
+
+			try {
+				Extent &e = _insert(0, 0, _inline_used);
+				memcpy(e.data, _inline, _inline_used);
+				e.size = _inline_used;
+			}
+			catch (...) { _free_extents(); throw; }
+
+			_inline_used = 0;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  allocator used for the extent array and extent data
+		 *
+		 * The second argument is unused. It merely makes the signature of
+		 * the constructor compatible to the constructor of 'Chunk_index'.
+		 */
+		Extent_storage(Allocator &alloc, seek_off_t = 0) : _alloc(alloc) { }
+
+		~Extent_storage() { _free_extents(); }
+
+		/**
+		 * Return position after the highest offset that was written to
+		 */
+		file_size_t used_size() const
+		{
+			if (_inline_mode())
+				return _inline_used;
+
+			return _num_extents ? _extents[_num_extents - 1].end() : 0;
+		}
+
+		/**
+		 * Return number of extents, 0 if the content is stored inline
+		 */
+		unsigned num_extents() const { return _num_extents; }
+
+		/**
+		 * Write data
+		 *
+		 * \throw Out_of_ram
+		 */
+		void write(char const *src, size_t len, seek_off_t seek_offset)
+		{
+			if (_inline_mode() && seek_offset + len <= INLINE_SIZE) {
+
+				/* the buffer may hold stale content beyond '_inline_used' */
+				if (seek_offset > _inline_used)
+					memset(&_inline[_inline_used], 0, (size_t)seek_offset - _inline_used);
+
+				memcpy(&_inline[seek_offset], src, len);
+				_inline_used = max(_inline_used, (size_t)(seek_offset + len));
+				return;
+			}
+
+			_leave_inline_mode();
+
+			while (len > 0) {
+
+				unsigned const i = _index(seek_offset);
+
+				/* overwrite content of existing extent */
+				if (i < _num_extents && _extents[i].offset <= seek_offset) {
+					Extent &e = _extents[i];
+
+					size_t const local_offset = (size_t)(seek_offset - e.offset);
+					size_t const curr_len     = min(len, e.size - local_offset);
+
+					memcpy(e.data + local_offset, src, curr_len);
+
+					len -= curr_len; src += curr_len; seek_offset += curr_len;
+					continue;
+				}
+
+				/* fill gap in front of the next extent */
+				file_size_t const gap = (i < _num_extents)
+				                      ? _extents[i].offset - seek_offset
+				                      : SIZE - seek_offset;
+
+				size_t curr_len = (size_t)min((file_size_t)len, gap);
+
+				/* preferably append to the preceding extent */
+				if (i > 0 && _extents[i - 1].end() == seek_offset
+				 && _extents[i - 1].size < MAX_EXTENT_SIZE) {
+
+					Extent &e = _extents[i - 1];
+
+					curr_len = min(curr_len, MAX_EXTENT_SIZE - e.size);
+					_reserve(e, e.size + curr_len);
+					memcpy(e.data + e.size, src, curr_len);
+					e.size += curr_len;
+
+				} else {
+
+					curr_len = min(curr_len, (size_t)MAX_EXTENT_SIZE);
+
+					Extent &e = _insert(i, seek_offset, curr_len);
+					memcpy(e.data, src, curr_len);
+					e.size = curr_len;
+				}
+
+				len -= curr_len; src += curr_len; seek_offset += curr_len;
+			}
+		}
+
+		/**
+		 * Read data, gaps between extents are returned as zeros
+		 */
+		void read(char *dst, size_t len, seek_off_t seek_offset) const
+		{
+			if (_inline_mode()) {
+				size_t const avail = (seek_offset < _inline_used)
+				                   ? min(len, (size_t)(_inline_used - seek_offset)) : 0;
+
+				if (avail)
+					memcpy(dst, &_inline[seek_offset], avail);
+
+				memset(dst + avail, 0, len - avail);
+				return;
+			}
+
+			unsigned i = _index(seek_offset);
+
+			while (len > 0) {
+
+				if (i >= _num_extents) {
+					memset(dst, 0, len);
+					return;
+				}
+
+				Extent const &e = _extents[i];
+
+				size_t curr_len = 0;
+				if (e.offset > seek_offset) {
+					curr_len = (size_t)min((file_size_t)len, e.offset - seek_offset);
+					memset(dst, 0, curr_len);
+				} else {
+					size_t const local_offset = (size_t)(seek_offset - e.offset);
+					curr_len = min(len, e.size - local_offset);
+					memcpy(dst, e.data + local_offset, curr_len);
+					i++;
+				}
+
+				len -= curr_len; dst += curr_len; seek_offset += curr_len;
+			}
+		}
+
+		/**
+		 * Truncate content to specified size in bytes
+		 *
+		 * Like 'Chunk_index::truncate', this function can be used to shrink
+		 * the content only.
+		 */
+		void truncate(file_size_t size)
+		{
+			if (_inline_mode()) {
+				if (size < _inline_used) {
+					memset(&_inline[size], 0, _inline_used - (size_t)size);
+					_inline_used = (size_t)size;
+				}
+				return;
+			}
+
+			/* return to the inline representation if the file becomes empty */
+			if (size == 0) {
+				_free_extents();
+				return;
+			}
+
+			unsigned const i = _index(size);
+
+			for (unsigned j = i; j < _num_extents; j++) {
+				Extent &e = _extents[j];
+
+				if (e.offset < size) {
+					e.size = (size_t)(size - e.offset);
+					continue;
+				}
+				_alloc.free(e.data, e.capacity);
+			}
+
+			_num_extents = (i < _num_extents && _extents[i].offset < size)
+			             ? i + 1 : i;
+		}
+};
+
+#endif /* _INCLUDE__RAM_FS__EXTENT_H_ */
@@ -39,8 +39,15 @@ class Cell_array
 		unsigned           _num_cols;
 		unsigned           _num_lines;
 		Genode::Allocator &_alloc;
-		CELL             **_array      = nullptr;
-		bool              *_line_dirty = nullptr;
+		CELL             **_array       = nullptr;
+		bool              *_line_dirty  = nullptr;
+
+		/*
+		 * Position of each line when it was marked as clean the last time,
+		 * or -1 if the line changed otherwise than by scrolling. This way,
+		 * a scrolled line can be presented by moving its pixels.
+		 */
+		int               *_line_origin = nullptr;
 
 		typedef CELL *Char_cell_line;
 
@@ -52,8 +59,10 @@ class Cell_array
 
 		void _mark_lines_as_dirty(int start, int end)
 		{
-			for (int line = start; line <= end; line++)
-				_line_dirty[line] = true;
+			for (int line = start; line <= end; line++) {
+				_line_dirty[line]  = true;
+				_line_origin[line] = -1;
+			}
 		}
 
 		void _scroll_vertically(int start, int end, bool up)
@@ -62,18 +71,26 @@ class Cell_array
 			Char_cell_line yanked_line = _array[up ? start : end];
 
 			if (up) {
-				for (int line = start; line <= end - 1; line++)
-					_array[line] = _array[line + 1];
+				for (int line = start; line <= end - 1; line++) {
+					_array[line]       = _array[line + 1];
+					_line_origin[line] = _line_origin[line + 1];
+				}
 			} else {
-				for (int line = end; line >= start + 1; line--)
-					_array[line] = _array[line - 1];
+				for (int line = end; line >= start + 1; line--) {
+					_array[line]       = _array[line - 1];
+					_line_origin[line] = _line_origin[line - 1];
+				}
 			}
 
 			_clear_line(yanked_line);
 
 			_array[up ? end: start] = yanked_line;
 
-			_mark_lines_as_dirty(start, end);
+			/* the scrolled lines are dirty but keep their origin */
+			for (int line = start; line <= end; line++)
+				_line_dirty[line] = true;
+
+			_line_origin[up ? end : start] = -1;
 		}
 
 	public:
@@ -87,7 +104,8 @@ class Cell_array
 		{
 			_array = new (alloc) Char_cell_line[num_lines];
 
-			_line_dirty = new (alloc) bool[num_lines];
+			_line_dirty  = new (alloc) bool[num_lines];
+			_line_origin = new (alloc) int[num_lines];
 			mark_all_lines_as_dirty();
 
 			for (unsigned i = 0; i < num_lines; i++)
@@ -98,6 +116,7 @@ class Cell_array
 		{
 			return sizeof(Char_cell_line[num_lines])
 			     + sizeof(bool[num_lines])
+			     + sizeof(int[num_lines])
 			     + sizeof(CELL[num_cols])*num_lines;
 		}
 
@@ -106,20 +125,20 @@ class Cell_array
 			for (unsigned i = 0; i < _num_lines; i++)
 				Genode::destroy(_alloc, _array[i]);
 
+			Genode::destroy(_alloc, _line_origin);
 			Genode::destroy(_alloc, _line_dirty);
 			Genode::destroy(_alloc, _array);
 		}
 
 		void mark_all_lines_as_dirty()
 		{
-			for (unsigned i = 0; i < _num_lines; i++)
-				_line_dirty[i] = true;
+			_mark_lines_as_dirty(0, _num_lines - 1);
 		}
 
 		void set_cell(int column, int line, CELL cell)
 		{
 			_array[line][column] = cell;
-			_line_dirty[line] = true;
+			_mark_lines_as_dirty(line, line);
 		}
 
 		CELL get_cell(int column, int line) const
@@ -141,14 +160,22 @@ class Cell_array
 
 		bool line_dirty(int line) { return _line_dirty[line]; }
 
+		/**
+		 * Return position of the line when marked as clean the last time
+		 *
+		 * \return  -1 if the line changed otherwise than by scrolling
+		 */
+		int line_origin(int line) const { return _line_origin[line]; }
+
 		void mark_line_as_clean(int line)
 		{
-			_line_dirty[line] = false;
+			_line_dirty[line]  = false;
+			_line_origin[line] = line;
 		}
 
 		void mark_line_as_dirty(int line)
 		{
-			_line_dirty[line] = true;
+			_mark_lines_as_dirty(line, line);
 		}
 
 		void scroll_up(int region_start, int region_end)
@@ -182,6 +209,13 @@ class Cell_array
 			else
 				cell.clear_cursor();
 
+			/*
+			 * The cursor may be removed temporarily without marking the line
+			 * as dirty. Should the line be scrolled meanwhile, its presented
+			 * content would show a stale cursor.
+			 */
+			_line_origin[pos.y] = -1;
+
 			if (mark_dirty)
 				_line_dirty[pos.y] = true;
 		}
@@ -0,0 +1,63 @@
+/*
+ * \brief  Trace-buffer entry produced by the 'rpc_events' policy
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _TRACE__RPC_LATENCY_EVENT_H_
+#define _TRACE__RPC_LATENCY_EVENT_H_
+
+/* Genode includes */
+#include <trace/timestamp.h>
+
+namespace Genode { namespace Trace { struct Rpc_latency_event; } }
+
+
+/**
+ * Compact record of an RPC or signal event
+ *
+ * The record is written by the traced thread and evaluated by the
+ * 'rpc_latency' component, which pairs CALL/RETURNED and DISPATCH/REPLY
+ * records of the same thread, and by the 'cpu_balancer', which correlates
+ * the records of different threads to find communicating threads.
+ */
+struct Genode::Trace::Rpc_latency_event
+{
+	enum Type : uint8_t { CALL = 1, RETURNED = 2, DISPATCH = 3, REPLY = 4,
+	                      SIGNAL_SUBMIT = 5, SIGNAL_RECEIVE = 6 };
+
+	enum { MAX_NAME_LEN = 32 };
+
+	Timestamp timestamp;
+	uint32_t  opcode;   /* RPC opcode at the client side, signal count */
+	Type      type;
+	char      name[MAX_NAME_LEN];  /* null-terminated, possibly truncated */
+
+	/**
+	 * Fill record
+	 *
+	 * The function is used by the trace policy, which has no access to
+	 * the 'Genode::copy_cstring' implementation.
+	 */
+	void assign(Type t, char const *rpc_name, uint32_t op)
+	{
+		timestamp = Trace::timestamp();
+		opcode    = op;
+		type      = t;
+
+		unsigned i = 0;
+		for (; rpc_name[i] && i < MAX_NAME_LEN - 1; i++)
+			name[i] = rpc_name[i];
+		name[i] = 0;
+	}
+
+} __attribute__((packed));
+
+#endif /* _TRACE__RPC_LATENCY_EVENT_H_ */
@@ -1,6 +1,5 @@
 SRC_CC  = blit.cc
 REQUIRES = x86 64bit
-INC_DIR += $(REP_DIR)/src/lib/blit/spec/x86_64 \
-           $(REP_DIR)/src/lib/blit/spec/x86
+INC_DIR += $(REP_DIR)/src/lib/blit/spec/x86_64
 
 vpath blit.cc $(REP_DIR)/src/lib/blit
@@ -0,0 +1,2 @@
+SRC_DIR = src/app/rpc_latency
+include $(GENODE_DIR)/repos/base/recipes/src/content.inc
@@ -125,6 +125,7 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 		size_t   const _io_buffer;
 		uint64_t const _progress_interval;
 		bool     const _copy;
+		bool     const _pattern;
 		size_t   const _batch;
 
 		Constructible<Timer::Connection> _timer { };
@@ -142,6 +143,8 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 		{
 			unsigned const id;
 
+			bool unexpected_data { false };
+
 			Job(Block_connection &connection, Block::Operation operation, unsigned id)
 			:
 				Block_connection::Job(connection, operation), id(id)
@@ -195,6 +198,32 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 			Genode::memcpy(dst, src, length);
 		}
 
+		/*
+		 * Verification of the data read back
+		 *
+		 * Each 32-bit word of a block is derived from the block number and
+		 * the position of the word within the block.
+		 */
+		static uint32_t _pattern_word(block_number_t block, size_t word)
+		{
+			return (uint32_t)(block*2654435761u) ^ (uint32_t)word;
+		}
+
+		template <typename FN>
+		void _for_each_pattern_word(Job &job, Block::seek_off_t offset,
+		                            size_t length, FN const &fn)
+		{
+			size_t const block_size = _info.block_size;
+			size_t const num_words  = block_size/sizeof(uint32_t);
+
+			block_number_t const first = job.operation().block_number
+			                           + (block_number_t)offset/block_size;
+
+			for (size_t i = 0; i < length/block_size; i++)
+				for (size_t w = 0; w < num_words; w++)
+					fn(i*num_words + w, _pattern_word(first + i, w));
+		}
+
 	public:
 
 		/**
@@ -208,7 +237,12 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 			if (_verbose)
 				log("job ", job.id, ": writing ", length, " bytes at ", offset);
 
-			if (_copy)
+			if (_pattern) {
+				uint32_t * const words = (uint32_t *)dst;
+				_for_each_pattern_word(job, offset, length,
+					[&] (size_t i, uint32_t value) { words[i] = value; });
+			}
+			else if (_copy)
 				_memcpy(dst, _scratch_buffer.base, length);
 		}
 
@@ -224,7 +258,19 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 			if (_verbose)
 				log("job ", job.id, ": got ", length, " bytes at ", offset);
 
-			if (_copy)
+			if (_pattern) {
+				uint32_t const * const words = (uint32_t const *)src;
+				bool mismatch = false;
+				_for_each_pattern_word(job, offset, length,
+					[&] (size_t i, uint32_t value) { mismatch |= (words[i] != value); });
+
+				if (mismatch)
+					error("job ", job.id, ": unexpected data at block ",
+					      job.operation().block_number + offset/_info.block_size);
+
+				job.unexpected_data |= mismatch;
+			}
+			else if (_copy)
 				_memcpy(_scratch_buffer.base, src, length);
 		}
 
@@ -238,6 +284,9 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 			if (_verbose)
 				log("job ", job.id, ": ", job.operation(), ", completed");
 
+			/* a read job with unexpected data counts as failed */
+			success &= !job.unexpected_data;
+
 			if (!success)
 				error("processing ", job.operation(), " failed");
 
@@ -287,6 +336,7 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 			                                 Number_of_bytes(4*1024*1024))),
 			_progress_interval(_node.attribute_value("progress", (uint64_t)0)),
 			_copy(_node.attribute_value("copy", true)),
+			_pattern(_node.attribute_value("pattern", false)),
 			_batch(_node.attribute_value("batch", 1u)),
 			_finished_sig(finished_sig),
 			_scratch_buffer(scratch_buffer)
@@ -0,0 +1,118 @@
+/*
+ * \brief  Latency histogram with fixed memory footprint
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The histogram follows the HDR scheme: values are grouped into power-of-two
+ * magnitudes, each of which is linearly subdivided into 'SUB_BUCKETS'
+ * buckets. The relative error of a reported percentile is thereby bounded by
+ * 1/SUB_BUCKETS for the whole 64-bit value range.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _HISTOGRAM_H_
+#define _HISTOGRAM_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+#include <util/misc_math.h>
+
+namespace Rpc_latency {
+
+	using namespace Genode;
+
+	class Histogram;
+}
+
+
+class Rpc_latency::Histogram
+{
+	public:
+
+		enum {
+			SUB_BUCKET_BITS = 3,
+			SUB_BUCKETS     = 1 << SUB_BUCKET_BITS,
+			NUM_BUCKETS     = (64 - SUB_BUCKET_BITS + 1)*SUB_BUCKETS,
+		};
+
+	private:
+
+		uint32_t _buckets[NUM_BUCKETS] { };
+
+		uint64_t _count = 0;
+		uint64_t _sum   = 0;
+		uint64_t _min   = ~0ULL;
+		uint64_t _max   = 0;
+
+		static unsigned _index(uint64_t value)
+		{
+			if (value < SUB_BUCKETS)
+				return (unsigned)value;
+
+			unsigned const shift = (unsigned)log2(value) - SUB_BUCKET_BITS;
+			unsigned const sub   = (unsigned)(value >> shift) & (SUB_BUCKETS - 1);
+
+			return (shift + 1)*SUB_BUCKETS + sub;
+		}
+
+		/**
+		 * Return highest value covered by bucket
+		 */
+		static uint64_t _upper_bound(unsigned index)
+		{
+			if (index < SUB_BUCKETS)
+				return index;
+
+			unsigned const shift = index/SUB_BUCKETS - 1;
+			uint64_t const sub   = index % SUB_BUCKETS;
+
+			return ((SUB_BUCKETS + sub) << shift) + (1ULL << shift) - 1;
+		}
+
+	public:
+
+		void record(uint64_t value)
+		{
+			unsigned const i = _index(value);
+
+			if (_buckets[i] != ~0U)
+				_buckets[i]++;
+
+			_count++;
+			_sum += value;
+			_min  = Genode::min(_min, value);
+			_max  = Genode::max(_max, value);
+		}
+
+		uint64_t count() const { return _count; }
+		uint64_t min()   const { return _count ? _min : 0; }
+		uint64_t max()   const { return _max; }
+		uint64_t avg()   const { return _count ? _sum/_count : 0; }
+
+		/**
+		 * Return value below which 'permille' of all recorded values lie
+		 */
+		uint64_t percentile(unsigned permille) const
+		{
+			if (!_count)
+				return 0;
+
+			uint64_t const threshold = (_count*permille + 999)/1000;
+
+			uint64_t seen = 0;
+			for (unsigned i = 0; i < NUM_BUCKETS; i++) {
+				seen += _buckets[i];
+				if (seen >= threshold)
+					return Genode::min(_upper_bound(i), _max);
+			}
+			return _max;
+		}
+};
+
+#endif /* _HISTOGRAM_H_ */
@@ -0,0 +1,481 @@
+/*
+ * \brief  Aggregation of RPC latencies from trace events
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The component traces the threads selected by its configuration with the
+ * 'rpc_events' policy. Each period, it drains the trace buffers of all
+ * traced threads, pairs the RPC events of each thread, and records the
+ * latency in a histogram per thread, RPC function, and side. At the client
+ * side, the latency covers the whole round trip from the call until the
+ * reply arrived. At the server side, it covers the dispatching of the RPC
+ * function. The histograms are published as report.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/registry.h>
+#include <os/reporter.h>
+#include <os/session_policy.h>
+#include <rom_session/connection.h>
+#include <timer_session/connection.h>
+#include <trace_session/connection.h>
+#include <trace/rpc_latency_event.h>
+#include <trace/trace_buffer.h>
+#include <util/construct_at.h>
+
+/* local includes */
+#include <histogram.h>
+
+namespace Rpc_latency {
+
+	using Event       = Trace::Rpc_latency_event;
+	using Rpc_name    = String<Event::MAX_NAME_LEN>;
+	using Thread_name = Trace::Thread_name;
+
+	struct Policy;
+	struct Statistics;
+	struct Monitor;
+	struct Main;
+}
+
+
+/**
+ * Trace policy installed at the Trace session
+ */
+struct Rpc_latency::Policy : Noncopyable
+{
+	Rom_connection             _rom;
+	Rom_dataspace_capability   _ds   { _rom.dataspace() };
+	size_t               const _size { Dataspace_client(_ds).size() };
+
+	Trace::Policy_id const id;
+
+	Policy(Env &env, Trace::Connection &trace, char const *name)
+	:
+		_rom(env, name), id(trace.alloc_policy(_size))
+	{
+		void *dst = env.rm().attach(trace.policy(id));
+		void *src = env.rm().attach(_ds);
+		memcpy(dst, src, _size);
+		env.rm().detach(dst);
+		env.rm().detach(src);
+	}
+};
+
+
+/**
+ * Fixed-size table of latency histograms
+ *
+ * The table is dimensioned at startup. Once all entries are in use,
+ * measurements for new combinations of thread and RPC function are counted
+ * as dropped.
+ */
+struct Rpc_latency::Statistics : Noncopyable
+{
+	enum Side { CLIENT, SERVER };
+
+	struct Key
+	{
+		Trace::Subject_id subject;
+		Side              side;
+		Rpc_name          name;
+
+		bool operator == (Key const &other) const
+		{
+			return subject.id == other.subject.id && side == other.side
+			    && name == other.name;
+		}
+
+		unsigned hash() const
+		{
+			unsigned h = subject.id*31 + side;
+			for (char const *s = name.string(); *s; s++)
+				h = h*31 + (unsigned char)*s;
+			return h;
+		}
+	};
+
+	struct Entry
+	{
+		bool          used = false;
+		Key           key { };
+		Session_label label { };
+		Thread_name   thread { };
+		unsigned      opcode = 0;
+		bool          outlier = false;
+		Histogram     histogram { };
+	};
+
+	Allocator &_alloc;
+
+	unsigned const _num_entries;
+
+	Entry * const _entries;
+
+	unsigned long dropped = 0;
+
+	/*
+	 * Noncopyable
+	 */
+	Statistics(Statistics const &);
+	Statistics &operator = (Statistics const &);
+
+	Statistics(Allocator &alloc, unsigned num_entries)
+	:
+		_alloc(alloc), _num_entries(max(num_entries, 1u)),
+		_entries((Entry *)alloc.alloc(sizeof(Entry)*_num_entries))
+	{
+		for (unsigned i = 0; i < _num_entries; i++)
+			construct_at<Entry>(&_entries[i]);
+	}
+
+	~Statistics()
+	{
+		for (unsigned i = 0; i < _num_entries; i++)
+			_entries[i].~Entry();
+
+		_alloc.free(_entries, sizeof(Entry)*_num_entries);
+	}
+
+	/**
+	 * Look up entry via open addressing, allocate it if not present
+	 */
+	Entry *entry(Key const &key, Session_label const &label, Thread_name const &thread)
+	{
+		unsigned const start = key.hash() % _num_entries;
+
+		for (unsigned n = 0; n < _num_entries; n++) {
+
+			Entry &e = _entries[(start + n) % _num_entries];
+
+			if (e.used && e.key == key)
+				return &e;
+
+			if (!e.used) {
+				e.used   = true;
+				e.key    = key;
+				e.label  = label;
+				e.thread = thread;
+				return &e;
+			}
+		}
+		dropped++;
+		return nullptr;
+	}
+
+	template <typename FN>
+	void for_each_entry(FN const &fn)
+	{
+		for (unsigned i = 0; i < _num_entries; i++)
+			if (_entries[i].used)
+				fn(_entries[i]);
+	}
+};
+
+
+/**
+ * State of one traced thread
+ */
+struct Rpc_latency::Monitor : Noncopyable, Interface
+{
+	Trace::Connection       &_trace;
+	Region_map              &_rm;
+	Trace::Subject_id  const subject_id;
+	Session_label      const label;
+	Thread_name        const thread;
+	Trace::Buffer           &_buffer_raw;
+	Trace_buffer             _buffer { _buffer_raw };
+
+	bool alive = true;
+
+	struct Pending
+	{
+		bool              valid = false;
+		Trace::Timestamp  timestamp = 0;
+		Rpc_name          name { };
+		unsigned          opcode = 0;
+	};
+
+	/*
+	 * RPCs of one thread are synchronous. Hence, there is at most one
+	 * outstanding call. A server thread may issue a call while dispatching
+	 * a request, which is why calls and dispatches are tracked separately.
+	 */
+	Pending _call { }, _dispatch { };
+
+	Monitor(Trace::Connection &trace, Region_map &rm, Trace::Subject_id id,
+	        Trace::Subject_info const &info)
+	:
+		_trace(trace), _rm(rm), subject_id(id),
+		label(info.session_label()), thread(info.thread_name()),
+		_buffer_raw(*(Trace::Buffer *)rm.attach(trace.buffer(id)))
+	{ }
+
+	~Monitor()
+	{
+		_rm.detach(&_buffer_raw);
+		try { _trace.free(subject_id); }
+		catch (Trace::Nonexistent_subject) { }
+	}
+
+	/**
+	 * Process new buffer entries
+	 *
+	 * \param fn  functor called with 'Statistics::Side', 'Pending const &',
+	 *            and the latency in timestamp ticks
+	 */
+	template <typename FN>
+	void drain(FN const &fn)
+	{
+		_buffer.for_each_new_entry([&] (Trace::Buffer::Entry entry) {
+
+			if (entry.length() < sizeof(Event))
+				return true;
+
+			Event event { };
+			memcpy(&event, entry.data(), sizeof(Event));
+			event.name[Event::MAX_NAME_LEN - 1] = 0;
+
+			Rpc_name const name(Cstring(event.name));
+
+			auto start = [&] (Pending &pending) {
+				pending = Pending { .valid     = true,
+				                    .timestamp = event.timestamp,
+				                    .name      = name,
+				                    .opcode    = event.opcode }; };
+
+			auto finish = [&] (Pending &pending, Statistics::Side side) {
+				if (pending.valid && pending.name == name
+				 && event.timestamp >= pending.timestamp)
+					fn(side, pending, event.timestamp - pending.timestamp);
+				pending.valid = false; };
+
+			switch (event.type) {
+			case Event::CALL:     start(_call);                         break;
+			case Event::RETURNED: finish(_call, Statistics::CLIENT);    break;
+			case Event::DISPATCH: start(_dispatch);                     break;
+			case Event::REPLY:    finish(_dispatch, Statistics::SERVER); break;
+
+			case Event::SIGNAL_SUBMIT:
+			case Event::SIGNAL_RECEIVE: break;
+			}
+			return true;
+		});
+	}
+};
+
+
+struct Rpc_latency::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Xml_node const _config_xml = _config.xml();
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Trace::Connection _trace {
+		_env,
+		_config_xml.attribute_value("session_ram", Number_of_bytes(1024*1024)),
+		_config_xml.attribute_value("session_arg_buffer", Number_of_bytes(64*1024)),
+		_config_xml.attribute_value("session_parent_levels", 0u) };
+
+	Policy _policy { _env, _trace, "rpc_events" };
+
+	Number_of_bytes const _buffer_size =
+		_config_xml.attribute_value("buffer", Number_of_bytes(64*1024));
+
+	/* p99 latencies above this multiple of the median are flagged */
+	unsigned const _outlier_factor =
+		_config_xml.attribute_value("outlier_factor", 10u);
+
+	/* p99 latencies above this absolute limit are flagged, 0 disables */
+	uint64_t const _outlier_threshold_us =
+		_config_xml.attribute_value("outlier_threshold_us", (uint64_t)0);
+
+	uint64_t const _ticks_per_us = _calibrate();
+
+	Statistics _statistics { _heap, _config_xml.attribute_value("max_entries", 256u) };
+
+	Registry<Registered<Monitor>> _monitors { };
+
+	Expanding_reporter _reporter { _env, "rpc_latency", "rpc_latency" };
+
+	Signal_handler<Main> _period_handler { _env.ep(), *this, &Main::_handle_period };
+
+	/**
+	 * Determine frequency of the trace timestamps
+	 */
+	uint64_t _calibrate()
+	{
+		uint64_t const configured = _config_xml.attribute_value("ticks_per_us", (uint64_t)0);
+		if (configured)
+			return configured;
+
+		uint64_t         const us_0    = _timer.curr_time().trunc_to_plain_us().value;
+		Trace::Timestamp const ticks_0 = Trace::timestamp();
+
+		_timer.msleep(100);
+
+		uint64_t         const us_1    = _timer.curr_time().trunc_to_plain_us().value;
+		Trace::Timestamp const ticks_1 = Trace::timestamp();
+
+		return max((ticks_1 - ticks_0)/max(us_1 - us_0, (uint64_t)1), (uint64_t)1);
+	}
+
+	uint64_t _ns(uint64_t ticks) const { return (ticks*1000)/_ticks_per_us; }
+
+	Monitor *_lookup(Trace::Subject_id id)
+	{
+		Monitor *result = nullptr;
+		_monitors.for_each([&] (Monitor &m) {
+			if (m.subject_id.id == id.id)
+				result = &m; });
+		return result;
+	}
+
+	void _update_monitors()
+	{
+		_monitors.for_each([&] (Monitor &m) { m.alive = false; });
+
+		_trace.for_each_subject_info([&] (Trace::Subject_id   const  id,
+		                                  Trace::Subject_info const &info) {
+
+			if (info.state() == Trace::Subject_info::DEAD)
+				return;
+
+			with_matching_policy(info.session_label(), _config_xml,
+
+				[&] (Xml_node const &policy) {
+
+					if (policy.has_attribute("thread")
+					 && policy.attribute_value("thread", Thread_name()) != info.thread_name())
+						return;
+
+					if (Monitor *m = _lookup(id)) {
+						m->alive = true;
+						return;
+					}
+
+					try {
+						_trace.trace(id, _policy.id, _buffer_size);
+						new (_heap) Registered<Monitor>(_monitors, _trace,
+						                                _env.rm(), id, info);
+					}
+					catch (Trace::Already_traced)          { }
+					catch (Trace::Source_is_dead)          { }
+					catch (Trace::Traced_by_other_session) { }
+					catch (Trace::Nonexistent_subject)     { }
+				},
+				[&] () { /* no policy matches */ });
+		});
+	}
+
+	void _drain()
+	{
+		_monitors.for_each([&] (Monitor &m) {
+			m.drain([&] (Statistics::Side side, Monitor::Pending const &pending,
+			             uint64_t ticks) {
+
+				Statistics::Key const key { .subject = m.subject_id,
+				                            .side    = side,
+				                            .name    = pending.name };
+
+				if (Statistics::Entry *e = _statistics.entry(key, m.label, m.thread)) {
+					e->opcode = pending.opcode;
+					e->histogram.record(_ns(ticks));
+				}
+			});
+		});
+	}
+
+	bool _outlier(Histogram const &h) const
+	{
+		uint64_t const p50 = h.percentile(500), p99 = h.percentile(990);
+
+		if (_outlier_threshold_us && p99 > _outlier_threshold_us*1000)
+			return true;
+
+		return _outlier_factor && p50 && p99 > p50*_outlier_factor;
+	}
+
+	void _report()
+	{
+		_reporter.generate([&] (Xml_generator &xml) {
+
+			xml.attribute("ticks_per_us", _ticks_per_us);
+			if (_statistics.dropped)
+				xml.attribute("dropped", _statistics.dropped);
+
+			_statistics.for_each_entry([&] (Statistics::Entry &e) {
+
+				Histogram const &h = e.histogram;
+
+				bool const outlier = _outlier(h);
+				if (outlier && !e.outlier)
+					warning("slow RPC '", e.key.name, "' at ",
+					        e.key.side == Statistics::CLIENT ? "client" : "server",
+					        " \"", e.label, "\" thread \"", e.thread, "\": "
+					        "p99 ", h.percentile(990), " ns, "
+					        "p50 ", h.percentile(500), " ns");
+				e.outlier = outlier;
+
+				xml.node("rpc", [&] () {
+					xml.attribute("label",  e.label);
+					xml.attribute("thread", e.thread);
+					xml.attribute("side",   e.key.side == Statistics::CLIENT
+					                        ? "client" : "server");
+					xml.attribute("name",   e.key.name);
+					if (e.key.side == Statistics::CLIENT)
+						xml.attribute("opcode", e.opcode);
+					xml.attribute("count",  h.count());
+					xml.attribute("min_ns", h.min());
+					xml.attribute("avg_ns", h.avg());
+					xml.attribute("p50_ns", h.percentile(500));
+					xml.attribute("p90_ns", h.percentile(900));
+					xml.attribute("p99_ns", h.percentile(990));
+					xml.attribute("max_ns", h.max());
+					if (outlier)
+						xml.attribute("outlier", "yes");
+				});
+			});
+		});
+	}
+
+	void _handle_period()
+	{
+		_update_monitors();
+		_drain();
+
+		/* release monitors of vanished subjects after draining their buffers */
+		_monitors.for_each([&] (Registered<Monitor> &m) {
+			if (!m.alive)
+				destroy(_heap, &m); });
+
+		_report();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_timer.sigh(_period_handler);
+		_timer.trigger_periodic(1000*_config_xml.attribute_value("period_ms", 5000u));
+
+		_update_monitors();
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Rpc_latency::Main main(env); }
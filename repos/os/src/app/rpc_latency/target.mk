@@ -0,0 +1,4 @@
+TARGET  = rpc_latency
+SRC_CC  = main.cc
+INC_DIR += $(PRG_DIR)
+LIBS    = base
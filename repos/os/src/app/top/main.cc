@@ -20,7 +20,7 @@
 #include <base/heap.h>
 #include <os/reporter.h>
 
-enum SORT_TIME { EC_TIME = 0, SC_TIME = 1};
+enum SORT_TIME { EC_TIME = 0, SC_TIME = 1, CYCLES = 2 };
 
 struct Trace_subject_registry
 {
@@ -30,30 +30,68 @@ struct Trace_subject_registry
 		{
 			Genode::Trace::Subject_id const id;
 
-			Genode::Trace::Subject_info info { };
+			/* obtained once the subject is reported as added */
+			Genode::Session_label       session_label { };
+			Genode::Trace::Thread_name  thread_name   { };
+			bool                        name_known    { false };
+
+			/* reported by a delta query during the current period */
+			bool reported { false };
+
+			Genode::Trace::Subject_info::State state { Genode::Trace::Subject_info::INVALID };
+			Genode::Trace::Execution_time      execution_time { };
+			Genode::Affinity::Location         affinity { };
+
+			Genode::Trace::Performance_counters counters { };
 
 			/**
-			 * Execution time during the last period
+			 * Execution time and cycles during the last period
 			 */
-			Genode::uint64_t recent_time[2] = { 0, 0 };
+			Genode::uint64_t recent_time[3] = { 0, 0, 0 };
+
+			/**
+			 * Performance-counter events during the last period
+			 */
+			Genode::uint64_t recent_instructions = 0;
+			Genode::uint64_t recent_llc_misses   = 0;
 
 			Entry(Genode::Trace::Subject_id id) : id(id) { }
 
-			void update(Genode::Trace::Subject_info const &new_info)
+			/**
+			 * Account delta reported during the current period
+			 *
+			 * A subject may be reported more than once per period if the
+			 * changes exceed the argument buffer. Hence, the execution time
+			 * is accumulated relative to the previously reported value.
+			 */
+			void update(Genode::Trace::Subject_delta const &delta)
+			{
+				Genode::Trace::Execution_time const &time = delta.execution_time;
+
+				auto recent = [] (Genode::uint64_t curr, Genode::uint64_t prev) {
+					return curr < prev ? 0 : curr - prev; };
+
+				recent_time[EC_TIME] += recent(time.thread_context,
+				                               execution_time.thread_context);
+				recent_time[SC_TIME] += recent(time.scheduling_context,
+				                               execution_time.scheduling_context);
+
+				state          = delta.state;
+				execution_time = time;
+				affinity       = delta.affinity;
+			}
+
+			void update(Genode::Trace::Performance_counters const &c)
 			{
-				if (new_info.execution_time().thread_context < info.execution_time().thread_context)
-					recent_time[EC_TIME] = 0;
-				else
-					recent_time[EC_TIME] = new_info.execution_time().thread_context -
-				                           info.execution_time().thread_context;
-
-				if (new_info.execution_time().scheduling_context < info.execution_time().scheduling_context)
-					recent_time[SC_TIME] = 0;
-				else
-					recent_time[SC_TIME] = new_info.execution_time().scheduling_context -
-				                           info.execution_time().scheduling_context;
-
-				info = new_info;
+				auto recent = [] (Genode::uint64_t curr, Genode::uint64_t prev) {
+					return curr < prev ? 0 : curr - prev; };
+
+				if (c.valid && counters.valid) {
+					recent_time[CYCLES] = recent(c.cycles,       counters.cycles);
+					recent_instructions = recent(c.instructions, counters.instructions);
+					recent_llc_misses   = recent(c.llc_misses,   counters.llc_misses);
+				}
+				counters = c;
 			}
 		};
 
@@ -68,6 +106,73 @@ struct Trace_subject_registry
 			return nullptr;
 		}
 
+		void _update_names(Genode::Trace::Connection &trace)
+		{
+			enum { BATCH = 64 };
+			Genode::Trace::Subject_id ids[BATCH];
+			Entry                    *batch[BATCH];
+
+			for (;;) {
+				unsigned n = 0;
+				for (Entry *e = _entries.first(); e && n < BATCH; e = e->next())
+					if (!e->name_known) {
+						batch[n] = e;
+						ids[n++] = e->id;
+					}
+
+				if (!n)
+					return;
+
+				/* infos are reported in the order of 'ids' */
+				unsigned i = 0, resolved = 0;
+				trace.for_each_subject_info(ids, n,
+					[&] (Genode::Trace::Subject_id const &id,
+					     Genode::Trace::Subject_info const &info) {
+
+						Entry * const e = (i < n) ? batch[i++] : nullptr;
+						if (!e || !(e->id == id))
+							return;
+
+						e->session_label = info.session_label();
+						e->thread_name   = info.thread_name();
+						e->name_known    = true;
+						resolved++;
+					});
+
+				/* no progress, e.g., if the argument buffer holds no info */
+				if (!resolved)
+					return;
+			}
+		}
+
+		void _update_counters(Genode::Trace::Connection &trace)
+		{
+			enum { BATCH = 64 };
+			Genode::Trace::Subject_id ids[BATCH];
+			Entry                    *batch[BATCH];
+
+			Entry *e = _entries.first();
+			while (e) {
+				unsigned n = 0;
+				for (; e && n < BATCH; e = e->next())
+					if (e->state != Genode::Trace::Subject_info::DEAD) {
+						batch[n] = e;
+						ids[n++] = e->id;
+					}
+
+				/* counters are reported in the order of 'ids' */
+				unsigned i = 0;
+				trace.for_each_performance_counters(ids, n,
+					[&] (Genode::Trace::Subject_id const &id,
+					     Genode::Trace::Performance_counters const &counters) {
+
+						Entry * const entry = (i < n) ? batch[i++] : nullptr;
+						if (entry && entry->id == id)
+							entry->update(counters);
+					});
+			}
+		}
+
 		enum { MAX_CPUS_X = 16, MAX_CPUS_Y = 4, MAX_ELEMENTS_PER_CPU = 6};
 
 		/* accumulated execution time on all CPUs */
@@ -79,31 +184,69 @@ struct Trace_subject_registry
 
 	public:
 
-		bool update(Genode::Trace::Connection &trace,
-		            Genode::Allocator &alloc)
+		void update(Genode::Trace::Connection &trace,
+		            Genode::Allocator &alloc, bool const counters)
 		{
-			auto res = trace.for_each_subject_info([&](Genode::Trace::Subject_id const &id,
-			                                           Genode::Trace::Subject_info const &info)
-			{
-				Entry *e = _lookup(id);
-				if (!e) {
-					e = new (alloc) Entry(id);
-					_entries.insert(e);
-				}
+			/* subjects not reported as changed did not execute */
+			for (Entry *e = _entries.first(); e; e = e->next()) {
+				e->recent_time[EC_TIME] = e->recent_time[SC_TIME] = 0;
+				e->recent_time[CYCLES]  = 0;
+				e->recent_instructions  = e->recent_llc_misses = 0;
+				e->reported             = false;
+			}
+
+			/*
+			 * Core reports only the subjects changed since the previous
+			 * query. Changes exceeding the argument buffer are reported by
+			 * subsequent queries, which resume where the previous one
+			 * stopped. Once a subject is reported twice, core went through
+			 * all subjects. Further changes are picked up by the next
+			 * period. Otherwise, more frequently changing subjects than fit
+			 * into the argument buffer would keep this loop going forever.
+			 */
+			for (bool wrapped = false; !wrapped; ) {
+				auto res = trace.for_each_subject_delta([&] (Genode::Trace::Subject_delta const &delta)
+				{
+					Entry *e = _lookup(delta.id);
+					if (!e) {
+						e = new (alloc) Entry(delta.id);
+						_entries.insert(e);
+					}
 
-				e->update(info);
+					/* subject reported anew, e.g., after re-constructing the session */
+					if (delta.added)
+						e->name_known = false;
 
-				/* remove dead threads which did not run in the last period */
-				if (e->info.state() == Genode::Trace::Subject_info::DEAD &&
-				    !e->recent_time[EC_TIME] && !e->recent_time[SC_TIME]) {
+					if (e->reported)
+						wrapped = true;
+
+					e->reported = true;
+					e->update(delta);
+				});
+
+				if (res.count < res.limit)
+					break;
+			}
+
+			_update_names(trace);
+
+			/* performance counters are not covered by the delta query */
+			if (counters)
+				_update_counters(trace);
+
+			/* remove dead threads which did not run in the last period */
+			for (Entry *e = _entries.first(), *next = nullptr; e; e = next) {
+				next = e->next();
+
+				if (e->state == Genode::Trace::Subject_info::DEAD &&
+				    !e->recent_time[EC_TIME] && !e->recent_time[SC_TIME] &&
+				    !e->recent_time[CYCLES]) {
 
 					trace.free(e->id);
 					_entries.remove(e);
 					Genode::destroy(alloc, e);
 				}
-			});
-
-			return res.count < res.limit;
+			}
 		}
 
 		void flush(Genode::Trace::Connection &trace, Genode::Allocator &alloc)
@@ -115,24 +258,24 @@ struct Trace_subject_registry
 			}
 		}
 
-		void top(enum SORT_TIME sorting)
+		void top(enum SORT_TIME sorting, bool const counters)
 		{
 			/* clear old calculations */
 			Genode::memset(total_first, 0, sizeof(total_first));
 			Genode::memset(total_second, 0, sizeof(total_second));
 			Genode::memset(load, 0, sizeof(load));
 
-			unsigned const first  = sorting == EC_TIME ? EC_TIME : SC_TIME;
-			unsigned const second = sorting == EC_TIME ? SC_TIME : EC_TIME;
+			unsigned const first  = sorting;
+			unsigned const second = sorting == SC_TIME ? EC_TIME : SC_TIME;
 
 			for (Entry const *e = _entries.first(); e; e = e->next()) {
 
 				/* collect highest execution time per CPU */
-				unsigned const x = e->info.affinity().xpos();
-				unsigned const y = e->info.affinity().ypos();
+				unsigned const x = e->affinity.xpos();
+				unsigned const y = e->affinity.ypos();
 				if (x >= MAX_CPUS_X || y >= MAX_CPUS_Y) {
-					Genode::error("cpu ", e->info.affinity().xpos(), ".",
-					              e->info.affinity().ypos(), " is outside "
+					Genode::error("cpu ", e->affinity.xpos(), ".",
+					              e->affinity.ypos(), " is outside "
 					              "supported range ",
 					              (int)MAX_CPUS_X, ".", (int)MAX_CPUS_Y);
 					continue;
@@ -227,7 +370,7 @@ struct Trace_subject_registry
 						static char space[NAME_SPACE];
 						Genode::memset(space, ' ', NAME_SPACE - 1);
 
-						Genode::size_t const thread_name_len = entry.info.thread_name().length();
+						Genode::size_t const thread_name_len = entry.thread_name.length();
 						if (!thread_name_len)
 							space[NAME_SPACE - 1] = 0;
 						else
@@ -238,17 +381,32 @@ struct Trace_subject_registry
 
 						Genode::String<NAME_SPACE> space_string(space);
 
+						/* instructions per cycle in hundredths */
+						Genode::uint64_t const ipc = entry.recent_time[CYCLES]
+						                           ? entry.recent_instructions*100
+						                             / entry.recent_time[CYCLES]
+						                           : 0;
+
+						typedef Genode::String<80> Counter_columns;
+						Counter_columns const counter_columns = !counters
+							? Counter_columns()
+							: Counter_columns(_align_right<13>(entry.recent_time[CYCLES]), " cyc ",
+							                  _align_right<4>(ipc / 100), ".",
+							                  _align_right<3>(ipc % 100, true), " ipc ",
+							                  _align_right<11>(entry.recent_llc_misses), " llc ");
+
 						using Genode::log;
-						log("cpu=", entry.info.affinity().xpos(),
-						    ".", entry.info.affinity().ypos(),
-						    " ", _align_right<4>(entry.info.execution_time().priority),
-						    " ", _align_right<6>(entry.info.execution_time().quantum),
+						log("cpu=", entry.affinity.xpos(),
+						    ".", entry.affinity.ypos(),
+						    " ", _align_right<4>(entry.execution_time.priority),
+						    " ", _align_right<6>(entry.execution_time.quantum),
 						    " ", _align_right<4>(ec_percent),
 						    ".", _align_right<3>(ec_rest, true), "%"
 						    " ", _align_right<4>(sc_percent),
-						    ".", _align_right<3>(sc_rest, true), "% "
-						    "thread='", entry.info.thread_name(), "' ", space_string,
-						    "label='", entry.info.session_label(), "'");
+						    ".", _align_right<3>(sc_rest, true), "% ",
+						    counter_columns,
+						    "thread='", entry.thread_name, "' ", space_string,
+						    "label='", entry.session_label, "'");
 					}
 				}
 			}
@@ -300,6 +458,8 @@ struct App::Main
 
 	SORT_TIME _sort { EC_TIME };
 
+	bool _counters { false };
+
 	Attached_rom_dataspace _config { _env, "config" };
 
 	Timer::Connection _timer { _env };
@@ -337,12 +497,26 @@ void App::Main::_handle_config()
 	String<8> ec_sc(_config.xml().attribute_value("sort_time", String<8>("ec")));
 	if (ec_sc == "ec")
 		_sort = EC_TIME;
+	else
+	if (ec_sc == "cycles")
+		_sort = CYCLES;
 	else
 		_sort = SC_TIME;
 
-	log("sorting based on ",
-	    _sort == EC_TIME ? "execution context (ec) [other option is scheduling context (sc)]"
-	                     : "scheduling context (sc) [other option is execution context (ec)]");
+	/* sorting by cycles implies the performance-counter columns */
+	_counters = _config.xml().attribute_value("counters", false) || _sort == CYCLES;
+
+	switch (_sort) {
+	case EC_TIME:
+		log("sorting based on execution context (ec) [other options are scheduling context (sc) and cycles]");
+		break;
+	case SC_TIME:
+		log("sorting based on scheduling context (sc) [other options are execution context (ec) and cycles]");
+		break;
+	case CYCLES:
+		log("sorting based on cycles [other options are execution context (ec) and scheduling context (sc)]");
+		break;
+	}
 
 	_timer.trigger_periodic(1000*_period_ms);
 }
@@ -350,18 +524,19 @@ void App::Main::_handle_config()
 
 void App::Main::_handle_period()
 {
-	/* update subject information */
-	bool const arg_buffer_sufficient = _trace_subject_registry.update(*_trace,
-	                                                                  _heap);
-	if (arg_buffer_sufficient) {
+	try {
+		/* update subject information */
+		_trace_subject_registry.update(*_trace, _heap, _counters);
+
 		/* show most significant consumers */
-		_trace_subject_registry.top(_sort);
+		_trace_subject_registry.top(_sort, _counters);
 		return;
 	}
+	catch (Out_of_ram)  { }
+	catch (Out_of_caps) { }
 
-	enum { ARG_RAM_UPGRADE = 4 * 4096 };
-	trace_ram_quota += ARG_RAM_UPGRADE;
-	arg_buffer_ram  += ARG_RAM_UPGRADE;
+	enum { TRACE_RAM_UPGRADE = 4 * 4096 };
+	trace_ram_quota += TRACE_RAM_UPGRADE;
 
 	/* by destructing the session we free up the allocated memory in core */
 	Genode::warning("re-construct trace session");
@@ -11,6 +11,7 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
+#include <base/stdint.h>
 #include <blit/blit.h>
 #include <blit_helper.h>
 
@@ -54,3 +55,69 @@ extern "C" void blit(void const *s, unsigned src_w,
 	/* handle trailing row */
 	if (w >> 1) copy_16bit_column(src, src_w, dst, dst_w, h);
 }
+
+
+extern "C" void blit_rotated(void const *s, unsigned src_w,
+                             void *d, unsigned dst_w,
+                             int w, int h,
+                             Blit_rotation rotation, bool flip)
+{
+	using Genode::uint32_t;
+
+	if (w <= 0 || h <= 0) return;
+
+	if (rotation == BLIT_ROTATE_0 && !flip) {
+		blit(s, src_w, d, dst_w, w*4, h);
+		return;
+	}
+
+	long const pitch = dst_w/4;
+
+	/*
+	 * Destination offset of the first source pixel and destination steps
+	 * for advancing one pixel within a source line ('step_x') and for
+	 * advancing one source line ('step_y')
+	 */
+	long origin = 0, step_x = 1, step_y = pitch;
+
+	switch (rotation) {
+	case BLIT_ROTATE_0:   break;
+	case BLIT_ROTATE_90:  origin = h - 1;                 step_x =  pitch; step_y = -1;     break;
+	case BLIT_ROTATE_180: origin = (h - 1)*pitch + w - 1; step_x = -1;     step_y = -pitch; break;
+	case BLIT_ROTATE_270: origin = (w - 1)*pitch;         step_x = -pitch; step_y =  1;     break;
+	}
+
+	if (flip) {
+		origin += (w - 1)*step_x;
+		step_x  = -step_x;
+	}
+
+	/*
+	 * Process the pixels in square tiles that fit into the L1 cache such
+	 * that the lines of the destination tile remain cached while writing
+	 * the columns
+	 */
+	enum { TILE = 32 };
+
+	char     const *src = (char const *)s;
+	uint32_t       *dst = (uint32_t *)d + origin;
+
+	for (int ty = 0; ty < h; ty += TILE) {
+
+		int const th = (h - ty < TILE) ? h - ty : TILE;
+
+		for (int tx = 0; tx < w; tx += TILE) {
+
+			int const tw = (w - tx < TILE) ? w - tx : TILE;
+
+			for (int y = ty; y < ty + th; y++) {
+
+				uint32_t const *sp = (uint32_t const *)(src + (long)y*src_w) + tx;
+				uint32_t       *dp = dst + y*step_y + tx*step_x;
+
+				for (int x = tw; x--; sp++, dp += step_x)
+					*dp = *sp;
+			}
+		}
+	}
+}
@@ -52,31 +52,50 @@ static inline void copy_block_32bit(char const *src, int src_w,
 
 
 /**
- * Copy pixel block 64bit-wise
- *
- * \param src    source address
- * \param dst    64bit-aligned destination address
- * \param w      number of 32bit words to copy per line
- * \param h      number of lines to copy
- * \param src_w  width of source buffer in bytes
- * \param dst_w  width of destination buffer in bytes
+ * Copy 32byte chunks via NEON
  */
-static inline void copy_block_64bit(char const *src, int src_w,
-                                    char *dst, int dst_w,
-                                    int w, int h)
+static inline void copy_32byte_chunks(char const *src, char *dst, int size)
 {
-	src_w -= w*8;
-	dst_w -= w*8;
-	for (; h--; src += src_w, dst += dst_w) {
-		for (int i = w; i--; src += 8, dst += 8)
-			*((Genode::uint64_t *)dst) = *((Genode::uint64_t const *)src);
-	}
+	asm volatile (
+		"0:                          \n\t"
+		"ldp   q0, q1, [%1], #32     \n\t"
+		"stp   q0, q1, [%2], #32     \n\t"
+		"subs  %w0, %w0, #1          \n\t"
+		"b.ne  0b                    \n\t"
+		: "+r" (size), "+r" (src), "+r" (dst)
+		:
+		: "v0", "v1", "cc", "memory"
+	);
+}
+
+
+/**
+ * Copy 32byte chunks via NEON with non-temporal stores
+ */
+static inline void stream_32byte_chunks(char const *src, char *dst, int size)
+{
+	asm volatile (
+		"0:                          \n\t"
+		"ldnp  q0, q1, [%1]          \n\t"
+		"stnp  q0, q1, [%2]          \n\t"
+		"add   %1, %1, #32           \n\t"
+		"add   %2, %2, #32           \n\t"
+		"subs  %w0, %w0, #1          \n\t"
+		"b.ne  0b                    \n\t"
+		: "+r" (size), "+r" (src), "+r" (dst)
+		:
+		: "v0", "v1", "cc", "memory"
+	);
 }
 
 
 /**
  * Copy block with a size of multiple of 32 bytes
  *
+ * Advanced SIMD is an architectural feature of ARMv8-A, so no runtime
+ * detection is needed. Blocks larger than a typical L2 cache half are
+ * written with non-temporal stores.
+ *
  * \param w  width in 32 byte chunks to copy per line
  * \param h  number of lines of copy
  */
@@ -84,11 +103,22 @@ static inline void copy_block_32byte(char const *src, int src_w,
                                      char *dst, int dst_w,
                                      int w, int h)
 {
-	for (; h > 0; h--) {
-			copy_block_64bit(src, src_w, dst, dst_w, w*4, 1);
-			src += src_w;
-			dst += dst_w;
+	enum { STREAM_THRESHOLD = 256*1024 };
+
+	if (w <= 0 || h <= 0)
+		return;
+
+	bool const stream = 32UL*w*h >= STREAM_THRESHOLD;
+
+	for (; h > 0; h--, src += src_w, dst += dst_w) {
+		if (stream)
+			stream_32byte_chunks(src, dst, w);
+		else
+			copy_32byte_chunks(src, dst, w);
 	}
+
+	if (stream)
+		asm volatile ("dmb ishst" : : : "memory");
 }
 
 #endif /* _LIB__BLIT__SPEC__ARM_64__BLIT_HELPER_H_ */
@@ -0,0 +1,274 @@
+/*
+ * \brief  Blitting utilities for x86_64
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * Blocks are copied via SSE2, which is always present on x86_64, or via
+ * AVX2 if supported by the CPU and enabled by the kernel. The kernel is
+ * selected once at runtime via CPUID. Blocks exceeding half of the L2 cache
+ * are written with non-temporal stores to avoid evicting the working set
+ * of the caller, e.g., when copying to a framebuffer.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__BLIT__SPEC__X86_64__BLIT_HELPER_H_
+#define _LIB__BLIT__SPEC__X86_64__BLIT_HELPER_H_
+
+/**
+ * Copy single 16bit column
+ */
+static inline void copy_16bit_column(char const *src, int src_w,
+                                     char *dst, int dst_w, int h)
+{
+	for (; h-- > 0; src += src_w, dst += dst_w)
+		*(short *)dst = *(short const *)src;
+}
+
+
+/**
+ * Copy pixel block 32bit-wise
+ *
+ * \param src    source address
+ * \param dst    32bit-aligned destination address
+ * \param w      number of 32bit words to copy per line
+ * \param h      number of lines to copy
+ * \param src_w  width of source buffer in bytes
+ * \param dst_w  width of destination buffer in bytes
+ */
+static inline void copy_block_32bit(char const *src, int src_w,
+                                    char *dst, int dst_w,
+                                    int w, int h)
+{
+	long d0, d1, d2;
+
+	for (; h--; src += src_w, dst += dst_w )
+		asm volatile ("cld; rep movsl"
+		 : "=S" (d0), "=D" (d1), "=c" (d2)
+		 : "S" (src), "D" (dst), "c" (w)
+		 : "memory");
+}
+
+
+/**
+ * Copy 32byte chunks via SSE2
+ */
+static inline void copy_32byte_chunks_sse2(void const *src, void *dst, int size)
+{
+	asm volatile (
+		"xor     %%rcx,%%rcx             \n\t"
+		".align 16                       \n\t"
+		"0:                              \n\t"
+		"movdqu  (%%rsi,%%rcx),%%xmm0    \n\t"
+		"movdqu  16(%%rsi,%%rcx),%%xmm1  \n\t"
+		"movdqu  %%xmm0,(%%rdi,%%rcx)    \n\t"
+		"movdqu  %%xmm1,16(%%rdi,%%rcx)  \n\t"
+		"add     $0x20,%%rcx             \n\t"
+		"dec     %0                      \n\t"
+		"jnz     0b                      \n\t"
+		: "=r"(size)
+		: "S" (src), "D" (dst), "0" (size)
+		: "rcx", "xmm0", "xmm1", "memory"
+	);
+}
+
+
+/**
+ * Copy 32byte chunks via SSE2 with non-temporal stores
+ *
+ * The destination must be 16-byte aligned.
+ */
+static inline void stream_32byte_chunks_sse2(void const *src, void *dst, int size)
+{
+	asm volatile (
+		"xor     %%rcx,%%rcx             \n\t"
+		".align 16                       \n\t"
+		"0:                              \n\t"
+		"movdqu  (%%rsi,%%rcx),%%xmm0    \n\t"
+		"movdqu  16(%%rsi,%%rcx),%%xmm1  \n\t"
+		"movntdq %%xmm0,(%%rdi,%%rcx)    \n\t"
+		"movntdq %%xmm1,16(%%rdi,%%rcx)  \n\t"
+		"add     $0x20,%%rcx             \n\t"
+		"dec     %0                      \n\t"
+		"jnz     0b                      \n\t"
+		: "=r"(size)
+		: "S" (src), "D" (dst), "0" (size)
+		: "rcx", "xmm0", "xmm1", "memory"
+	);
+}
+
+
+/**
+ * Copy 32byte chunks via AVX2
+ */
+static inline void copy_32byte_chunks_avx2(void const *src, void *dst, int size)
+{
+	asm volatile (
+		"xor      %%rcx,%%rcx            \n\t"
+		".align 16                       \n\t"
+		"0:                              \n\t"
+		"vmovdqu  (%%rsi,%%rcx),%%ymm0   \n\t"
+		"vmovdqu  %%ymm0,(%%rdi,%%rcx)   \n\t"
+		"add      $0x20,%%rcx            \n\t"
+		"dec      %0                     \n\t"
+		"jnz      0b                     \n\t"
+		"vzeroupper                      \n\t"
+		: "=r"(size)
+		: "S" (src), "D" (dst), "0" (size)
+		: "rcx", "xmm0", "memory"
+	);
+}
+
+
+/**
+ * Copy 32byte chunks via AVX2 with non-temporal stores
+ *
+ * The destination must be 32-byte aligned.
+ */
+static inline void stream_32byte_chunks_avx2(void const *src, void *dst, int size)
+{
+	asm volatile (
+		"xor      %%rcx,%%rcx            \n\t"
+		".align 16                       \n\t"
+		"0:                              \n\t"
+		"vmovdqu  (%%rsi,%%rcx),%%ymm0   \n\t"
+		"vmovntdq %%ymm0,(%%rdi,%%rcx)   \n\t"
+		"add      $0x20,%%rcx            \n\t"
+		"dec      %0                     \n\t"
+		"jnz      0b                     \n\t"
+		"vzeroupper                      \n\t"
+		: "=r"(size)
+		: "S" (src), "D" (dst), "0" (size)
+		: "rcx", "xmm0", "memory"
+	);
+}
+
+
+/**
+ * Copy functions selected according to the CPU features
+ */
+struct Blit_kernel
+{
+	typedef void (*Copy)(void const *src, void *dst, int size);
+
+	Copy          copy;              /* temporal, arbitrary alignment      */
+	Copy          stream;            /* non-temporal, aligned destination  */
+	unsigned      stream_align;      /* destination alignment of 'stream'  */
+	unsigned long stream_threshold;  /* block size in bytes to use 'stream' */
+
+	static void _cpuid(unsigned leaf, unsigned &a, unsigned &b,
+	                   unsigned &c, unsigned &d)
+	{
+		asm volatile ("cpuid"
+		              : "=a" (a), "=b" (b), "=c" (c), "=d" (d)
+		              : "a" (leaf), "c" (0));
+	}
+
+	static bool _avx2_usable()
+	{
+		unsigned a = 0, b = 0, c = 0, d = 0;
+
+		_cpuid(0, a, b, c, d);
+		if (a < 7)
+			return false;
+
+		/* AVX supported and register state managed via XSAVE */
+		_cpuid(1, a, b, c, d);
+		if (!(c & (1U << 27)) || !(c & (1U << 28)))
+			return false;
+
+		/* SSE and AVX register state enabled by the kernel */
+		unsigned xcr0_lo = 0, xcr0_hi = 0;
+		asm volatile ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+		if ((xcr0_lo & 6) != 6)
+			return false;
+
+		_cpuid(7, a, b, c, d);
+		return b & (1U << 5);
+	}
+
+	static unsigned long _l2_size()
+	{
+		unsigned a = 0, b = 0, c = 0, d = 0;
+
+		_cpuid(0x80000000, a, b, c, d);
+		if (a < 0x80000006)
+			return 256*1024;
+
+		_cpuid(0x80000006, a, b, c, d);
+		unsigned long const size = (unsigned long)(c >> 16)*1024;
+		return size ? size : 256*1024;
+	}
+
+	static Blit_kernel _detect()
+	{
+		unsigned long const threshold = _l2_size()/2;
+
+		if (_avx2_usable())
+			return Blit_kernel { copy_32byte_chunks_avx2,
+			                     stream_32byte_chunks_avx2, 32, threshold };
+
+		return Blit_kernel { copy_32byte_chunks_sse2,
+		                     stream_32byte_chunks_sse2, 16, threshold };
+	}
+
+	static Blit_kernel const &get()
+	{
+		static Blit_kernel const kernel = _detect();
+		return kernel;
+	}
+};
+
+
+/**
+ * Copy block with a size of multiple of 32 bytes
+ *
+ * \param w  width in 32 byte chunks to copy per line
+ * \param h  number of lines of copy
+ */
+static inline void copy_block_32byte(char const *src, int src_w,
+                                     char *dst, int dst_w,
+                                     int w, int h)
+{
+	if (w <= 0 || h <= 0)
+		return;
+
+	Blit_kernel const &kernel = Blit_kernel::get();
+
+	unsigned long const line = 32UL*w;
+
+	if (line*h < kernel.stream_threshold || w < 2) {
+		for (int i = h; i--; src += src_w, dst += dst_w)
+			kernel.copy(src, dst, w);
+		return;
+	}
+
+	/*
+	 * The non-temporal stores require an aligned destination. The unaligned
+	 * head and tail of each line are covered by overlapping temporal copies
+	 * of the first and last chunk.
+	 */
+	for (int i = h; i--; src += src_w, dst += dst_w) {
+
+		unsigned long const misalign = (unsigned long)dst & (kernel.stream_align - 1);
+		unsigned long const skip     = misalign ? kernel.stream_align - misalign : 0;
+		unsigned long const rest     = line - skip;
+
+		if (skip)
+			kernel.copy(src, dst, 1);
+
+		kernel.stream(src + skip, dst + skip, (int)(rest/32));
+
+		if (rest % 32)
+			kernel.copy(src + line - 32, dst + line - 32, 1);
+	}
+
+	asm volatile ("sfence" : : : "memory");
+}
+
+#endif /* _LIB__BLIT__SPEC__X86_64__BLIT_HELPER_H_ */
@@ -15,10 +15,12 @@
 #define _INCLUDE__VFS__RAM_FILE_SYSTEM_H_
 
 #include <ram_fs/chunk.h>
+#include <ram_fs/extent.h>
 #include <ram_fs/param.h>
 #include <vfs/file_system.h>
 #include <dataspace/client.h>
 #include <util/avl_tree.h>
+#include <util/reconstructible.h>
 
 namespace Vfs { class Ram_file_system; }
 
@@ -29,14 +31,33 @@ namespace Vfs_ram {
 	using namespace Ram_fs;
 	using ::File_system::Chunk;
 	using ::File_system::Chunk_index;
+	using ::File_system::Extent_storage;
+
+	typedef Chunk      <num_level_3_entries()>                Chunk_level_3;
+	typedef Chunk_index<num_level_2_entries(), Chunk_level_3> Chunk_level_2;
+	typedef Chunk_index<num_level_1_entries(), Chunk_level_2> Chunk_level_1;
+	typedef Chunk_index<num_level_0_entries(), Chunk_level_1> Chunk_level_0;
 
 	struct Io_handle;
 	struct Watch_handle;
 
 	class Node;
 	class File;
+	template <typename> class Storage_file;
 	class Symlink;
 	class Directory;
+	struct Hash_link;
+	template <typename> class Hashed;
+
+	/**
+	 * File backed by the hierarchic chunk structure
+	 */
+	typedef Storage_file<Chunk_level_0> Chunked_file;
+
+	/**
+	 * File with inline data for tiny files and extents for larger ones
+	 */
+	typedef Storage_file<Extent_storage> Compact_file;
 
 	enum { MAX_NAME_LEN = 128 };
 
@@ -106,10 +127,23 @@ class Vfs_ram::Node : private Genode::Avl_node<Node>, private Genode::Mutex
 		friend class Watch_handle;
 		friend class Directory;
 
+		/*
+		 * Noncopyable
+		 */
+		Node(Node const &);
+		Node &operator = (Node const &);
+
 		char _name[MAX_NAME_LEN];
 		Genode::List<Io_handle>       _io_handles { };
 		Genode::List<Watch_handle> _watch_handles { };
 
+		/**
+		 * Return link within the hash index of the parent directory
+		 *
+		 * Only nodes created for hashed directories carry a link.
+		 */
+		virtual Hash_link *_hash_link() { return nullptr; }
+
 		/**
 		 * Generate unique inode number
 		 */
@@ -252,49 +286,92 @@ class Vfs_ram::Node : private Genode::Avl_node<Node>, private Genode::Mutex
 };
 
 
-class Vfs_ram::File : public Vfs_ram::Node
+/**
+ * Link of a node within a hash bucket of the parent directory
+ */
+struct Vfs_ram::Hash_link
+{
+	Node     *next      { nullptr };
+	unsigned  name_hash { 0 };
+};
+
+
+/**
+ * Node equipped with a hash link to become an entry of a hashed directory
+ */
+template <typename NODE>
+class Vfs_ram::Hashed : public NODE
 {
 	private:
 
-		typedef Chunk      <num_level_3_entries()>                Chunk_level_3;
-		typedef Chunk_index<num_level_2_entries(), Chunk_level_3> Chunk_level_2;
-		typedef Chunk_index<num_level_1_entries(), Chunk_level_2> Chunk_level_1;
-		typedef Chunk_index<num_level_0_entries(), Chunk_level_1> Chunk_level_0;
+		Hash_link _link { };
+
+		Hash_link *_hash_link() override { return &_link; }
+
+	public:
+
+		template <typename... ARGS>
+		Hashed(ARGS &&... args) : NODE(args...) { }
+};
+
+
+class Vfs_ram::File : public Vfs_ram::Node
+{
+	protected:
+
+		/*
+		 * Keep track of file length. We cannot use the 'used_size()' of the
+		 * storage as file length because trailing zeros may by represented
+		 * by zero chunks or gaps, which do not contribute to 'used_size()'.
+		 */
+		file_size _length = 0;
+
+	public:
+
+		File(char const *name) : Node(name) { }
+
+		file_size length() override { return _length; }
+};
+
 
-		Chunk_level_0 _chunk;
-		file_size     _length = 0;
+template <typename STORAGE>
+class Vfs_ram::Storage_file : public Vfs_ram::File
+{
+	private:
+
+		STORAGE _storage;
 
 	public:
 
-		File(char const *name, Allocator &alloc)
-		: Node(name), _chunk(alloc, 0) { }
+		Storage_file(char const *name, Allocator &alloc)
+		: File(name), _storage(alloc, 0) { }
 
 		size_t read(char *dst, size_t len, file_size seek_offset) override
 		{
-			file_size const chunk_used_size = _chunk.used_size();
+			file_size const storage_used_size = _storage.used_size();
 
 			if (seek_offset >= _length)
 				return 0;
 
 			/*
-			 * Constrain read transaction to available chunk data
+			 * Constrain read transaction to available storage data
 			 *
-			 * Note that 'chunk_used_size' may be lower than '_length'
-			 * because 'Chunk' may have truncated tailing zeros.
+			 * Note that 'storage_used_size' may be lower than '_length'
+			 * because the storage may have truncated tailing zeros.
 			 */
 			if (seek_offset + len >= _length)
 				len = (size_t)(_length - seek_offset);
 
 			file_size read_len = len;
 
-			if (seek_offset + read_len > chunk_used_size) {
-				if (chunk_used_size >= seek_offset)
-					read_len = chunk_used_size - seek_offset;
+			if (seek_offset + read_len > storage_used_size) {
+				if (storage_used_size >= seek_offset)
+					read_len = storage_used_size - seek_offset;
 				else
 					read_len = 0;
 			}
 
-			_chunk.read(dst, (size_t)read_len, (size_t)seek_offset);
+			_storage.read(dst, (size_t)read_len, (size_t)seek_offset);
 
 			/* add zero padding if needed */
 			if (read_len < len)
@@ -315,30 +392,23 @@ class Vfs_ram::File : public Vfs_ram::Node
 		size_t write(char const *src, size_t len, file_size seek_offset) override
 		{
 			if (seek_offset == (file_size)(~0))
-				seek_offset = _chunk.used_size();
+				seek_offset = _storage.used_size();
 
-			if (seek_offset + len >= Chunk_level_0::SIZE)
-				len = Chunk_level_0::SIZE - (size_t)(seek_offset + len);
+			if (seek_offset + len >= STORAGE::SIZE)
+				len = (size_t)(STORAGE::SIZE - (seek_offset + len));
 
-			try { _chunk.write(src, len, (size_t)seek_offset); }
+			try { _storage.write(src, len, (size_t)seek_offset); }
 			catch (Out_of_memory) { return 0; }
 
-			/*
-			 * Keep track of file length. We cannot use 'chunk.used_size()'
-			 * as file length because trailing zeros may by represented
-			 * by zero chunks, which do not contribute to 'used_size()'.
-			 */
 			_length = max(_length, seek_offset + len);
 
 			return len;
 		}
 
-		file_size length() override { return _length; }
-
 		void truncate(file_size size) override
 		{
-			if (size < _chunk.used_size())
-				_chunk.truncate(size);
+			if (size < _storage.used_size())
+				_storage.truncate(size);
 
 			_length = size;
 		}
@@ -403,18 +473,218 @@ class Vfs_ram::Directory : public Vfs_ram::Node
 {
 	private:
 
-		Avl_tree<Node>  _entries { };
-		file_size       _count = 0;
+		/*
+		 * Hash index of directory entries
+		 *
+		 * Used instead of the AVL tree when the file system is configured
+		 * for compact storage. Entries are chained via their 'Hash_link',
+		 * which is present in nodes created as 'Hashed' only.
+		 */
+		class Hash_index : Genode::Noncopyable
+		{
+			private:
+
+				/*
+				 * Noncopyable
+				 */
+				Hash_index(Hash_index const &);
+				Hash_index &operator = (Hash_index const &);
+
+				enum { MIN_BUCKETS = 8 };
+
+				Allocator &_alloc;
+
+				Node     **_buckets;
+				unsigned   _num_buckets = MIN_BUCKETS;
+				unsigned   _count       = 0;
+
+				/* position of the most recent 'index' lookup */
+				struct Cursor
+				{
+					file_offset index;
+					unsigned    bucket;
+					Node       *node;
+				} _cursor { 0, 0, nullptr };
+
+				Node **_alloc_buckets(unsigned num)
+				{
+					Node **buckets = (Node **)_alloc.alloc(num*sizeof(Node *));
+					for (unsigned i = 0; i < num; i++)
+						buckets[i] = nullptr;
+					return buckets;
+				}
+
+				void _grow()
+				{
+					unsigned const num = 2*_num_buckets;
+
+					Node **buckets = nullptr;
+					try { buckets = _alloc_buckets(num); }
+
+					/* keep using the current buckets with longer chains */
+					catch (Out_of_memory) { return; }
+
+					for (unsigned i = 0; i < _num_buckets; i++) {
+						while (Node *node = _buckets[i]) {
+							Hash_link &link = _link(*node);
+							_buckets[i] = link.next;
+							Node *&head = buckets[link.name_hash & (num - 1)];
+							link.next = head;
+							head = node;
+						}
+					}
+
+					_alloc.free(_buckets, _num_buckets*sizeof(Node *));
+					_buckets     = buckets;
+					_num_buckets = num;
+				}
+
+				Node *&_bucket(unsigned hash) { return _buckets[hash & (_num_buckets - 1)]; }
+
+				static Hash_link &_link(Node &node) { return *node._hash_link(); }
+
+			public:
+
+				/**
+				 * FNV-1a hash of node name
+				 */
+				static unsigned hash(char const *name)
+				{
+					unsigned h = 2166136261u;
+					for (; *name; name++)
+						h = (h ^ (unsigned char)*name)*16777619u;
+					return h;
+				}
+
+				/**
+				 * Constructor
+				 *
+				 * \throw Out_of_memory
+				 */
+				Hash_index(Allocator &alloc)
+				: _alloc(alloc), _buckets(_alloc_buckets(_num_buckets)) { }
+
+				~Hash_index() { _alloc.free(_buckets, _num_buckets*sizeof(Node *)); }
+
+				void insert(Node &node)
+				{
+					if (_count >= 2*_num_buckets)
+						_grow();
+
+					Hash_link &link = _link(node);
+					link.name_hash = hash(node.name());
+
+					Node *&head = _bucket(link.name_hash);
+					link.next = head;
+					head = &node;
+
+					_count++;
+					_cursor.node = nullptr;
+				}
+
+				void remove(Node &node)
+				{
+					Hash_link &link = _link(node);
+
+					for (Node **n = &_bucket(link.name_hash); *n; n = &_link(**n).next) {
+						if (*n != &node)
+							continue;
+
+						*n = link.next;
+						link.next = nullptr;
+						_count--;
+						_cursor.node = nullptr;
+						return;
+					}
+				}
+
+				Node *lookup(char const *name)
+				{
+					unsigned const h = hash(name);
+
+					for (Node *n = _bucket(h); n; n = _link(*n).next)
+						if (_link(*n).name_hash == h && strcmp(n->_name, name) == 0)
+							return n;
+
+					return nullptr;
+				}
+
+				Node *first()
+				{
+					for (unsigned i = 0; i < _num_buckets; i++)
+						if (_buckets[i])
+							return _buckets[i];
+
+					return nullptr;
+				}
+
+				/**
+				 * Return entry at position 'index' of the iteration order
+				 *
+				 * Sequential directory reads continue at the cursor of the
+				 * previous lookup instead of walking from the first entry.
+				 */
+				Node *index(file_offset index)
+				{
+					Cursor c { 0, 0, nullptr };
+
+					if (_cursor.node && _cursor.index <= index)
+						c = _cursor;
+					else
+						c.node = _buckets[0];
+
+					for (;;) {
+						while (!c.node) {
+							if (++c.bucket >= _num_buckets)
+								return nullptr;
+							c.node = _buckets[c.bucket];
+						}
+
+						if (c.index == index)
+							break;
+
+						c.node = _link(*c.node).next;
+						c.index++;
+					}
+
+					_cursor = c;
+					return c.node;
+				}
+		};
+
+		Avl_tree<Node>            _entries    { };
+		Constructible<Hash_index> _hash_index { };
+		file_size                 _count = 0;
 
 	public:
 
-		Directory(char const *name)
-		: Node(name) { }
+		/**
+		 * Constructor
+		 *
+		 * \param hashed  use hash index instead of AVL tree for entries
+		 *
+		 * \throw Out_of_memory
+		 */
+		Directory(char const *name, Allocator &alloc, bool hashed)
+		: Node(name)
+		{
+			if (hashed)
+				_hash_index.construct(alloc);
+		}
 
 		void empty(Allocator &alloc)
 		{
-			while (Node *node = _entries.first()) {
-				_entries.remove(node);
+			for (;;) {
+				Node *node = _hash_index.constructed() ? _hash_index->first()
+				                                       : _entries.first();
+				if (!node)
+					break;
+
+				if (_hash_index.constructed())
+					_hash_index->remove(*node);
+				else
+					_entries.remove(node);
+
 				if (File *file = dynamic_cast<File*>(node)) {
 					if (file->opened())
 						continue;
@@ -427,19 +697,28 @@ class Vfs_ram::Directory : public Vfs_ram::Node
 
 		void adopt(Node *node)
 		{
-			_entries.insert(node);
+			if (_hash_index.constructed())
+				_hash_index->insert(*node);
+			else
+				_entries.insert(node);
 			++_count;
 		}
 
 		Node *child(char const *name)
 		{
+			if (_hash_index.constructed())
+				return _hash_index->lookup(name);
+
 			Node *node = _entries.first();
 			return node ? node->sibling(name) : nullptr;
 		}
 
 		void release(Node *node)
 		{
-			_entries.remove(node);
+			if (_hash_index.constructed())
+				_hash_index->remove(*node);
+			else
+				_entries.remove(node);
 			--_count;
 		}
 
@@ -463,8 +742,13 @@ class Vfs_ram::Directory : public Vfs_ram::Node
 
 			out_count = sizeof(Dirent);
 
-			Node *node_ptr = _entries.first();
-			if (node_ptr) node_ptr = node_ptr->index(index);
+			Node *node_ptr = nullptr;
+			if (_hash_index.constructed()) {
+				node_ptr = _hash_index->index(index);
+			} else {
+				node_ptr = _entries.first();
+				if (node_ptr) node_ptr = node_ptr->index(index);
+			}
 			if (!node_ptr) {
 				dirent.type = Dirent_type::END;
 				return Vfs::File_io_service::READ_OK;
@@ -504,8 +788,45 @@ class Vfs::Ram_file_system : public Vfs::File_system
 
 		friend class Genode::List<Vfs_ram::Watch_handle>;
 
-		Vfs::Env           &_env;
-		Vfs_ram::Directory  _root = { "" };
+		Vfs::Env &_env;
+
+		/*
+		 * In compact mode, files are stored inline or as extents instead
+		 * of chunk trees and directory entries are indexed by a hash table.
+		 */
+		bool const _compact;
+
+		Vfs_ram::Directory _root { "", _env.alloc(), _compact };
+
+		static bool _compact_from_config(Genode::Xml_node config)
+		{
+			typedef Genode::String<16> Storage;
+			return config.attribute_value("storage", Storage("chunked")) == "compact";
+		}
+
+		/**
+		 * Create node, which is hashed if the file system is compact
+		 *
+		 * \throw Out_of_memory
+		 */
+		template <typename NODE, typename... ARGS>
+		NODE *_new_node(ARGS &&... args)
+		{
+			if (_compact)
+				return new (_env.alloc()) Vfs_ram::Hashed<NODE>(args...);
+
+			return new (_env.alloc()) NODE(args...);
+		}
+
+		Vfs_ram::File *_new_file(char const *name)
+		{
+			using namespace Vfs_ram;
+
+			if (_compact)
+				return _new_node<Compact_file>(name, _env.alloc());
+
+			return _new_node<Chunked_file>(name, _env.alloc());
+		}
 
 		Vfs_ram::Node *lookup(char const *path, bool return_parent = false)
 		{
@@ -569,7 +890,8 @@ class Vfs::Ram_file_system : public Vfs::File_system
 
 	public:
 
-		Ram_file_system(Vfs::Env &env, Genode::Xml_node) : _env(env) { }
+		Ram_file_system(Vfs::Env &env, Genode::Xml_node config)
+		: _env(env), _compact(_compact_from_config(config)) { }
 
 		~Ram_file_system() { _root.empty(_env.alloc()); }
 
@@ -624,7 +946,7 @@ class Vfs::Ram_file_system : public Vfs::File_system
 				if (strlen(name) >= MAX_NAME_LEN)
 					return OPEN_ERR_NAME_TOO_LONG;
 
-				try { file = new (_env.alloc()) File(name, _env.alloc()); }
+				try { file = _new_file(name); }
 				catch (Out_of_memory) { return OPEN_ERR_NO_SPACE; }
 				parent->adopt(file);
 				parent->notify();
@@ -678,7 +1000,7 @@ class Vfs::Ram_file_system : public Vfs::File_system
 				if (parent->child(name))
 					return OPENDIR_ERR_NODE_ALREADY_EXISTS;
 
-				try { dir = new (_env.alloc()) Directory(name); }
+				try { dir = _new_node<Directory>(name, _env.alloc(), _compact); }
 				catch (Out_of_memory) { return OPENDIR_ERR_NO_SPACE; }
 
 				parent->adopt(dir);
@@ -734,7 +1056,7 @@ class Vfs::Ram_file_system : public Vfs::File_system
 				if (strlen(name) >= MAX_NAME_LEN)
 					return OPENLINK_ERR_NAME_TOO_LONG;
 
-				try { link = new (_env.alloc()) Symlink(name); }
+				try { link = _new_node<Symlink>(name); }
 				catch (Out_of_memory) { return OPENLINK_ERR_NO_SPACE; }
 
 				link->acquire();
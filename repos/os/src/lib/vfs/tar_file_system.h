@@ -15,9 +15,13 @@
 #define _INCLUDE__VFS__TAR_FILE_SYSTEM_H_
 
 #include <rom_session/connection.h>
+#include <rm_session/connection.h>
+#include <region_map/client.h>
 #include <vfs/file_system.h>
 #include <vfs/vfs_handle.h>
 #include <base/attached_rom_dataspace.h>
+#include <base/registry.h>
+#include <util/reconstructible.h>
 
 namespace Vfs { class Tar_file_system; }
 
@@ -296,8 +300,31 @@ class Vfs::Tar_file_system : public File_system
 		char const *name;
 		Record const *record;
 
+		Node *parent = nullptr;
+
+		/* link within hash bucket of the path index */
+		Node     *hash_next = nullptr;
+		unsigned  name_hash = 0;
+
+		/* directory entries in list order, populated after mounting */
+		unsigned      num_children = 0;
+		Node const  **children     = nullptr;
+
 		Node(char const *name, Record const *record) : name(name), record(record) { }
 
+		/*
+		 * Noncopyable
+		 */
+		Node(Node const &);
+		Node &operator = (Node const &);
+
+		void insert_child(Node &child)
+		{
+			child.parent = this;
+			insert(&child);
+			num_children++;
+		}
+
 		Node *lookup(char const *name)
 		{
 			Absolute_path lookup_path(name);
@@ -335,8 +362,11 @@ class Vfs::Tar_file_system : public File_system
 		}
 
 
-		Node const *lookup_child(int index) const
+		Node const *lookup_child(unsigned index) const
 		{
+			if (children)
+				return index < num_children ? children[index] : nullptr;
+
 			for (Node const *child_node = first(); child_node; child_node = child_node->next(), index--) {
 				if (index == 0)
 					return child_node;
@@ -346,16 +376,151 @@ class Vfs::Tar_file_system : public File_system
 		}
 
 
-		file_size num_dirent()
-		{
-			file_size count = 0;
-			for (Node *child_node = first(); child_node; child_node = child_node->next(), count++) ;
-			return count;
-		}
+		file_size num_dirent() const { return num_children; }
 
 	} _root_node;
 
 
+	/*
+	 * Hash index of all nodes keyed by parent node and name
+	 *
+	 * The index is populated while scanning the archive at mount time and
+	 * allows the resolution of a path with one hash lookup per path element.
+	 */
+	class Path_index
+	{
+		private:
+
+			enum { MIN_BUCKETS = 64 };
+
+			Genode::Allocator &_alloc;
+
+			Node     **_buckets;
+			unsigned   _num_buckets = MIN_BUCKETS;
+			unsigned   _count       = 0;
+
+			Node **_alloc_buckets(unsigned num)
+			{
+				Node **buckets = (Node **)_alloc.alloc(num*sizeof(Node *));
+				for (unsigned i = 0; i < num; i++)
+					buckets[i] = nullptr;
+				return buckets;
+			}
+
+			static unsigned _hash(Node const *parent, char const *name, size_t len)
+			{
+				unsigned h = 2166136261u;
+				for (size_t i = 0; i < len; i++)
+					h = (h ^ (unsigned char)name[i])*16777619u;
+
+				return h ^ (unsigned)(((Genode::addr_t)parent >> 4)*2654435761u);
+			}
+
+			void _grow()
+			{
+				unsigned const num = 2*_num_buckets;
+				Node **buckets = _alloc_buckets(num);
+
+				for_each([&] (Node &node) {
+					Node *&head = buckets[node.name_hash & (num - 1)];
+					node.hash_next = head;
+					head = &node; }, true);
+
+				_alloc.free(_buckets, _num_buckets*sizeof(Node *));
+				_buckets     = buckets;
+				_num_buckets = num;
+			}
+
+			/*
+			 * Noncopyable
+			 */
+			Path_index(Path_index const &);
+			Path_index &operator = (Path_index const &);
+
+		public:
+
+			Path_index(Genode::Allocator &alloc)
+			: _alloc(alloc), _buckets(_alloc_buckets(_num_buckets)) { }
+
+			~Path_index() { _alloc.free(_buckets, _num_buckets*sizeof(Node *)); }
+
+			/**
+			 * Call 'fn' for each indexed node
+			 *
+			 * \param detach  unlink nodes from their buckets while iterating
+			 */
+			template <typename FN>
+			void for_each(FN const &fn, bool detach = false)
+			{
+				for (unsigned i = 0; i < _num_buckets; i++) {
+					Node *next = nullptr;
+					for (Node *node = _buckets[i]; node; node = next) {
+						next = node->hash_next;
+						fn(*node);
+					}
+					if (detach)
+						_buckets[i] = nullptr;
+				}
+			}
+
+			void insert(Node &node)
+			{
+				if (_count >= _num_buckets)
+					_grow();
+
+				node.name_hash = _hash(node.parent, node.name, strlen(node.name));
+
+				Node *&head = _buckets[node.name_hash & (_num_buckets - 1)];
+				node.hash_next = head;
+				head = &node;
+				_count++;
+			}
+
+			Node *child(Node const &parent, char const *name, size_t len) const
+			{
+				unsigned const h = _hash(&parent, name, len);
+
+				for (Node *n = _buckets[h & (_num_buckets - 1)]; n; n = n->hash_next)
+					if (n->name_hash == h && n->parent == &parent
+					 && strcmp(n->name, name, len) == 0 && n->name[len] == 0)
+						return n;
+
+				return nullptr;
+			}
+
+			/**
+			 * Resolve canonical path relative to 'root'
+			 *
+			 * Paths that contain '.' or '..' elements are resolved via
+			 * 'Node::lookup'.
+			 */
+			Node *lookup(Node &root, char const * const path) const
+			{
+				Node *node = &root;
+
+				for (char const *p = path; *p; ) {
+
+					if (*p == '/') { p++; continue; }
+
+					size_t len = 0;
+					for (; p[len] && p[len] != '/'; len++);
+
+					if (p[0] == '.' && (len == 1 || (len == 2 && p[1] == '.')))
+						return root.lookup(path);
+
+					node = child(*node, p, len);
+					if (!node)
+						return nullptr;
+
+					p += len;
+				}
+				return node;
+			}
+	} _path_index { _alloc };
+
+	Node *_lookup(char const *path) { return _path_index.lookup(_root_node, path); }
+
+
 	/*
 	 *  Create a Node for a tar record and insert it into the node list
 	 */
@@ -367,11 +532,14 @@ class Vfs::Tar_file_system : public File_system
 
 			Node &_root_node;
 
+			Path_index &_path_index;
+
 		public:
 
 			Add_node_action(Genode::Allocator &alloc,
-			                Node              &root_node)
-			: _alloc(alloc), _root_node(root_node) { }
+			                Node              &root_node,
+			                Path_index        &path_index)
+			: _alloc(alloc), _root_node(root_node), _path_index(path_index) { }
 
 			void operator()(Record const *record)
 			{
@@ -406,10 +574,8 @@ class Vfs::Tar_file_system : public File_system
 
 					t.string(path_element, sizeof(path_element));
 
-					for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-						if (strcmp(child_node->name, path_element) == 0)
-							break;
-					}
+					child_node = _path_index.child(*parent_node, path_element,
+					                               strlen(path_element));
 
 					if (child_node) {
 
@@ -439,7 +605,8 @@ class Vfs::Tar_file_system : public File_system
 							copy_cstring(name, path_element, name_size);
 							child_node = new (_alloc) Node(name, 0);
 						}
-						parent_node->insert(child_node);
+						parent_node->insert_child(*child_node);
+						_path_index.insert(*child_node);
 					}
 
 					parent_node = child_node;
@@ -482,40 +649,12 @@ class Vfs::Tar_file_system : public File_system
 	}
 
 
-	struct Num_dirent_cache
-	{
-		Mutex            mutex { };
-		Node            &root_node;
-		bool             valid;              /* true after first lookup */
-		char             key[256];           /* key used for lookup */
-		file_size        cached_num_dirent;  /* cached value */
-
-		Num_dirent_cache(Node &root_node)
-		: root_node(root_node), valid(false), cached_num_dirent(0) { }
-
-		file_size num_dirent(char const *path)
-		{
-			Mutex::Guard guard(mutex);
-
-			/* check for cache miss */
-			if (!valid || strcmp(path, key) != 0) {
-				Node *node = root_node.lookup(path);
-				if (!node)
-					return 0;
-				copy_cstring(key, path, sizeof(key));
-				cached_num_dirent = node->num_dirent();
-				valid = true;
-			}
-			return cached_num_dirent;
-		}
-	} _cached_num_dirent;
-
 	/**
 	 * Walk hardlinks until we reach a file
 	 */
 	Node const *dereference(char const *path)
 	{
-		Node const *node = _root_node.lookup(path);
+		Node const *node = _lookup(path);
 		Node const *slow_node = node;
 		int i = 0;
 		while (node) {
@@ -529,9 +668,9 @@ class Vfs::Tar_file_system : public File_system
 			 * loop then eventually we catch it as the faster
 			 * laps the slower.
 			 */
-			node = _root_node.lookup(record->linked_name());
+			node = _lookup(record->linked_name());
 			if (i++ & 1) {
-				slow_node = _root_node.lookup(slow_node->record->linked_name());
+				slow_node = _lookup(slow_node->record->linked_name());
 				if (node == slow_node) {
 					Genode::error(_rom_name, " contains a hard-link loop at '", path, "'");
 					node = nullptr;
@@ -541,6 +680,148 @@ class Vfs::Tar_file_system : public File_system
 		return node;
 	}
 
+	/**
+	 * Populate directory-entry arrays for constant-time 'lookup_child'
+	 */
+	void _index_directory_entries()
+	{
+		auto populate = [&] (Node &node) {
+
+			if (!node.num_children)
+				return;
+
+			node.children = (Node const **)
+				_alloc.alloc(node.num_children*sizeof(Node const *));
+
+			unsigned i = 0;
+			for (Node const *child = node.first(); child; child = child->next())
+				node.children[i++] = child;
+		};
+
+		populate(_root_node);
+		_path_index.for_each(populate);
+	}
+
+
+	/*
+	 * Support for exporting file content without copying
+	 *
+	 * If enabled via the 'zero_copy' config attribute, the 'dataspace'
+	 * method hands out a managed dataspace that refers to the file content
+	 * within the archive ROM. This is possible only if the content starts
+	 * at a page boundary within the archive and spans at least one page.
+	 * Because the managed dataspace has page granularity, a partially used
+	 * last page is backed by a copy. Otherwise, it would expose the content
+	 * of the subsequent archive entries.
+	 */
+
+	enum { PAGE_SHIFT = 12, PAGE_SIZE = 1 << PAGE_SHIFT, PAGE_MASK = PAGE_SIZE - 1 };
+
+	bool const _zero_copy;
+
+	Genode::Constructible<Genode::Rm_connection> _rm { };
+
+	/* set if the RM session could not be created, disables zero copy */
+	bool _rm_unavailable = false;
+
+	struct Exported_dataspace
+	{
+		Genode::Capability<Genode::Region_map> const map;
+		Dataspace_capability                   const ds;
+		Genode::Ram_dataspace_capability       const tail;
+
+		Exported_dataspace(Genode::Capability<Genode::Region_map> map,
+		                   Dataspace_capability ds,
+		                   Genode::Ram_dataspace_capability tail)
+		: map(map), ds(ds), tail(tail) { }
+
+		virtual ~Exported_dataspace() { }
+	};
+
+	Genode::Registry<Genode::Registered<Exported_dataspace> > _exported { };
+
+	void _destroy(Genode::Registered<Exported_dataspace> &exported)
+	{
+		_rm->destroy(exported.map);
+
+		if (exported.tail.valid())
+			_env.ram().free(exported.tail);
+
+		destroy(_alloc, &exported);
+	}
+
+	/**
+	 * Return dataspace with a copy of the partially used last page
+	 */
+	Genode::Ram_dataspace_capability _tail_copy(char const *src, size_t size)
+	{
+		Genode::Ram_dataspace_capability const ds = _env.ram().alloc(PAGE_SIZE);
+		try {
+			void * const local_addr = _env.rm().attach(ds);
+			memcpy(local_addr, src, size);
+			_env.rm().detach(local_addr);
+		}
+		catch (...) { _env.ram().free(ds); throw; }
+
+		return ds;
+	}
+
+	Dataspace_capability _export_dataspace(Record const &record)
+	{
+		using namespace Genode;
+
+		addr_t const offset = (addr_t)record.data() - (addr_t)_tar_base;
+
+		if (!_zero_copy || _rm_unavailable || (offset & PAGE_MASK)
+		 || record.size() < PAGE_SIZE)
+			return Dataspace_capability();
+
+		if (!_rm.constructed()) {
+			try { _rm.construct(_env); }
+			catch (...) {
+				warning(_rom_name, ": RM session unavailable, zero-copy export disabled");
+				_rm_unavailable = true;
+				return Dataspace_capability();
+			}
+		}
+
+		size_t const size      = align_addr((size_t)record.size(), PAGE_SHIFT);
+		size_t const full      = (size_t)record.size() & ~(size_t)PAGE_MASK;
+		size_t const tail_size = (size_t)record.size() & PAGE_MASK;
+
+		Capability<Region_map> map_cap  { };
+		Ram_dataspace_capability tail   { };
+		try {
+			map_cap = _rm->create(size);
+
+			Region_map_client map(map_cap);
+			map.attach(_tar_ds.cap(), full, (off_t)offset, true, (addr_t)0,
+			           true /* executable */, false /* writeable */);
+
+			if (tail_size) {
+				tail = _tail_copy((char const *)record.data() + full, tail_size);
+				map.attach(tail, PAGE_SIZE, 0, true, (addr_t)full,
+				           true /* executable */, false /* writeable */);
+			}
+
+			Dataspace_capability const ds = map.dataspace();
+
+			new (_alloc) Registered<Exported_dataspace>(_exported, map_cap, ds, tail);
+
+			return ds;
+		}
+		catch (...) {
+			warning(_rom_name, ": zero-copy export failed, falling back to copy");
+
+			if (map_cap.valid())
+				_rm->destroy(map_cap);
+
+			if (tail.valid())
+				_env.ram().free(tail);
+		}
+		return Dataspace_capability();
+	}
+
 	public:
 
 		Tar_file_system(Vfs::Env &env, Genode::Xml_node config)
@@ -548,9 +829,16 @@ class Vfs::Tar_file_system : public File_system
 			_env(env.env()), _alloc(env.alloc()),
 			_rom_name(config.attribute_value("name", Rom_name())),
 			_root_node("", 0),
-			_cached_num_dirent(_root_node)
+			_zero_copy(config.attribute_value("zero_copy", false))
+		{
+			_for_each_tar_record_do(Add_node_action(_alloc, _root_node, _path_index));
+			_index_directory_entries();
+		}
+
+		~Tar_file_system()
 		{
-			_for_each_tar_record_do(Add_node_action(_alloc, _root_node));
+			_exported.for_each([&] (Genode::Registered<Exported_dataspace> &e) {
+				_destroy(e); });
 		}
 
 		/*********************************
@@ -570,6 +858,10 @@ class Vfs::Tar_file_system : public File_system
 				return Dataspace_capability();
 			}
 
+			Dataspace_capability const exported_ds_cap = _export_dataspace(*record);
+			if (exported_ds_cap.valid())
+				return exported_ds_cap;
+
 			try {
 				Ram_dataspace_capability ds_cap =
 					_env.ram().alloc((size_t)record->size());
@@ -587,7 +879,18 @@ class Vfs::Tar_file_system : public File_system
 
 		void release(char const *, Dataspace_capability ds_cap) override
 		{
-			_env.ram().free(static_cap_cast<Genode::Ram_dataspace>(ds_cap));
+			bool exported = false;
+
+			_exported.for_each([&] (Genode::Registered<Exported_dataspace> &e) {
+				if (exported || !(e.ds == ds_cap))
+					return;
+
+				_destroy(e);
+				exported = true;
+			});
+
+			if (!exported)
+				_env.ram().free(static_cap_cast<Genode::Ram_dataspace>(ds_cap));
 		}
 
 		Stat_result stat(char const *path, Stat &out) override
@@ -647,14 +950,15 @@ class Vfs::Tar_file_system : public File_system
 
 		Rename_result rename(char const *from, char const *to) override
 		{
-			if (_root_node.lookup(from) || _root_node.lookup(to))
+			if (_lookup(from) || _lookup(to))
 				return RENAME_ERR_NO_PERM;
 			return RENAME_ERR_NO_ENTRY;
 		}
 
 		file_size num_dirent(char const *path) override
 		{
-			return _cached_num_dirent.num_dirent(path);
+			Node const *node = _lookup(path);
+			return node ? node->num_dirent() : 0;
 		}
 
 		bool directory(char const *path) override
@@ -676,7 +980,7 @@ class Vfs::Tar_file_system : public File_system
 			 * case, return the whole path, which is relative to the root
 			 * of this file system.
 			 */
-			Node *node = _root_node.lookup(path);
+			Node *node = _lookup(path);
 			return node ? path : 0;
 		}
 
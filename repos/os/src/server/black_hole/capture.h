@@ -89,6 +89,13 @@ class Capture::Session_component : public Session_object<Capture::Session>
 		{
 			return Affected_rects();
 		}
+
+		void tiling(Tiling) override { }
+
+		Dataspace_capability tile_stream() override
+		{
+			return Dataspace_capability();
+		}
 };
 
 
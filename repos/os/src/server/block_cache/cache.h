@@ -0,0 +1,325 @@
+/*
+ * \brief  Cache of block-device lines
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The cache holds a fixed number of lines, each covering a fixed number of
+ * consecutive blocks of the back-end device. Lines are found via a hash table
+ * keyed by line number and replaced in least-recently-used order.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _BLOCK_CACHE__CACHE_H_
+#define _BLOCK_CACHE__CACHE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <block_session/block_session.h>
+#include <util/noncopyable.h>
+
+namespace Block_cache {
+
+	using namespace Genode;
+
+	using Line_number = Block::block_number_t;
+
+	struct Line;
+	class  Cache;
+}
+
+
+struct Block_cache::Line
+{
+	static constexpr unsigned INVALID = ~0u;
+
+	Line_number number = 0;
+
+	/*
+	 * A line is in use as long as it is hashed. Its data is 'present' once
+	 * read from the device or completely written by the client.
+	 */
+	bool hashed    = false;
+	bool present   = false;
+	bool filling   = false;  /* read from device in flight */
+	bool failed    = false;  /* last read from device failed */
+	bool dirty     = false;  /* modified, not yet written back */
+	bool writing   = false;  /* write-back in flight */
+	bool redirtied = false;  /* modified while write-back was in flight */
+	bool prefetched = false; /* filled by read-ahead, not yet accessed */
+
+	/* number of client requests currently referring to the line */
+	unsigned pins = 0;
+
+	unsigned hash_next = INVALID;
+	unsigned lru_prev  = INVALID;
+	unsigned lru_next  = INVALID;
+
+	bool evictable() const
+	{
+		return !pins && !filling && !dirty && !writing;
+	}
+};
+
+
+class Block_cache::Cache : Noncopyable
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Cache(Cache const &);
+		Cache &operator = (Cache const &);
+
+		Allocator &_alloc;
+
+		unsigned const _num_lines;
+		size_t   const _line_size;
+		char   * const _data;
+
+		Line     * const _lines;
+		unsigned * const _buckets;
+		unsigned   const _num_buckets;
+
+		/* least recently used line at head, most recently used at tail */
+		unsigned _lru_head = Line::INVALID;
+		unsigned _lru_tail = Line::INVALID;
+
+		unsigned _num_dirty = 0;
+
+		static unsigned _buckets_for(unsigned num_lines)
+		{
+			unsigned n = 1;
+			while (n < num_lines) n <<= 1;
+			return n;
+		}
+
+		unsigned _bucket(Line_number number) const
+		{
+			return (unsigned)((number * 0x9e3779b97f4a7c15ULL) >> 32)
+			       & (_num_buckets - 1);
+		}
+
+		unsigned _index(Line const &line) const
+		{
+			return (unsigned)(&line - _lines);
+		}
+
+		void _lru_remove(unsigned i)
+		{
+			Line &line = _lines[i];
+
+			if (line.lru_prev != Line::INVALID)
+				_lines[line.lru_prev].lru_next = line.lru_next;
+			else
+				_lru_head = line.lru_next;
+
+			if (line.lru_next != Line::INVALID)
+				_lines[line.lru_next].lru_prev = line.lru_prev;
+			else
+				_lru_tail = line.lru_prev;
+
+			line.lru_prev = line.lru_next = Line::INVALID;
+		}
+
+		void _lru_append(unsigned i)
+		{
+			Line &line = _lines[i];
+
+			line.lru_prev = _lru_tail;
+			line.lru_next = Line::INVALID;
+
+			if (_lru_tail != Line::INVALID)
+				_lines[_lru_tail].lru_next = i;
+			else
+				_lru_head = i;
+
+			_lru_tail = i;
+		}
+
+		void _unhash(unsigned i)
+		{
+			Line &line = _lines[i];
+			if (!line.hashed)
+				return;
+
+			unsigned *link = &_buckets[_bucket(line.number)];
+			while (*link != Line::INVALID && *link != i)
+				link = &_lines[*link].hash_next;
+
+			if (*link == i)
+				*link = line.hash_next;
+
+			line.hash_next = Line::INVALID;
+			line.hashed    = false;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param data  backing store of 'num_lines * line_size' bytes
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Cache(Allocator &alloc, char *data, unsigned num_lines, size_t line_size)
+		:
+			_alloc(alloc), _num_lines(num_lines), _line_size(line_size),
+			_data(data),
+			_lines((Line *)_alloc.alloc(sizeof(Line)*num_lines)),
+			_buckets((unsigned *)_alloc.alloc(sizeof(unsigned)*_buckets_for(num_lines))),
+			_num_buckets(_buckets_for(num_lines))
+		{
+			for (unsigned i = 0; i < _num_buckets; i++)
+				_buckets[i] = Line::INVALID;
+
+			for (unsigned i = 0; i < _num_lines; i++) {
+				construct_at<Line>(&_lines[i]);
+				_lru_append(i);
+			}
+		}
+
+		~Cache()
+		{
+			_alloc.free(_buckets, sizeof(unsigned)*_num_buckets);
+			_alloc.free(_lines, sizeof(Line)*_num_lines);
+		}
+
+		size_t   line_size() const { return _line_size; }
+		unsigned num_lines() const { return _num_lines; }
+		unsigned num_dirty() const { return _num_dirty; }
+
+		char *data(Line const &line) const
+		{
+			return _data + _index(line)*_line_size;
+		}
+
+		/**
+		 * Return line with specified number, or nullptr if not cached
+		 */
+		Line *lookup(Line_number number)
+		{
+			for (unsigned i = _buckets[_bucket(number)]; i != Line::INVALID;
+			     i = _lines[i].hash_next)
+				if (_lines[i].number == number)
+					return &_lines[i];
+
+			return nullptr;
+		}
+
+		/**
+		 * Assign the least recently used evictable line to 'number'
+		 *
+		 * \return  nullptr if no line can be evicted
+		 */
+		Line *alloc(Line_number number)
+		{
+			for (unsigned i = _lru_head; i != Line::INVALID; i = _lines[i].lru_next) {
+
+				if (!_lines[i].evictable())
+					continue;
+
+				_unhash(i);
+
+				Line &line = _lines[i];
+				line = Line();
+				line.number = number;
+				line.hashed = true;
+
+				unsigned &bucket = _buckets[_bucket(number)];
+				line.hash_next = bucket;
+				bucket = i;
+
+				touch(line);
+				return &line;
+			}
+			return nullptr;
+		}
+
+		/**
+		 * Mark line as most recently used
+		 */
+		void touch(Line &line)
+		{
+			unsigned const i = _index(line);
+			_lru_remove(i);
+			_lru_append(i);
+		}
+
+		/**
+		 * Return line to the pool of unused lines
+		 *
+		 * Used for lines that were allocated but never became present.
+		 */
+		void discard(Line &line)
+		{
+			if (line.dirty) _num_dirty--;
+
+			unsigned const i = _index(line);
+			_unhash(i);
+			line = Line();
+
+			/* reuse discarded lines first */
+			_lru_remove(i);
+			_lines[i].lru_next = _lru_head;
+			if (_lru_head != Line::INVALID)
+				_lines[_lru_head].lru_prev = i;
+			else
+				_lru_tail = i;
+			_lru_head = i;
+		}
+
+		void mark_dirty(Line &line)
+		{
+			if (line.writing)
+				line.redirtied = true;
+
+			if (!line.dirty)
+				_num_dirty++;
+
+			line.dirty = true;
+		}
+
+		void mark_written(Line &line)
+		{
+			line.writing = false;
+
+			if (line.redirtied) {
+				line.redirtied = false;
+				return;
+			}
+
+			if (line.dirty)
+				_num_dirty--;
+
+			line.dirty = false;
+		}
+
+		/**
+		 * Call 'fn' for each dirty line that is not being written back,
+		 * starting with the least recently used
+		 *
+		 * The iteration stops as soon as 'fn' returns false.
+		 */
+		template <typename FN>
+		void for_each_idle_dirty(FN const &fn)
+		{
+			for (unsigned i = _lru_head; i != Line::INVALID; ) {
+				unsigned const next = _lines[i].lru_next;
+				Line &line = _lines[i];
+				if (line.dirty && !line.writing && !fn(line))
+					return;
+				i = next;
+			}
+		}
+};
+
+#endif /* _BLOCK_CACHE__CACHE_H_ */
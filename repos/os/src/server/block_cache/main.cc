@@ -0,0 +1,884 @@
+/*
+ * \brief  Block-session proxy with a write-back cache
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_ram_dataspace.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/registry.h>
+#include <block/request_stream.h>
+#include <block_session/connection.h>
+#include <os/reporter.h>
+#include <root/root.h>
+#include <timer_session/connection.h>
+
+/* local includes */
+#include "cache.h"
+
+namespace Block_cache {
+
+	struct Job;
+	struct Pending;
+	struct Statistics;
+	struct Block_session_component;
+	struct Main;
+
+	using Block_connection = Block::Connection<Job>;
+}
+
+
+struct Block_cache::Job : Block_connection::Job
+{
+	enum class Kind { FILL, WRITE_BACK, SYNC };
+
+	Registry<Job>::Element registry_element;
+
+	Kind        const kind;
+	Line_number const first;  /* first cache line covered by the job */
+	unsigned    const count;  /* number of cache lines */
+
+	bool done = false;
+
+	Job(Block_connection &connection, Block::Operation operation,
+	    Registry<Job> &registry, Kind kind, Line_number first, unsigned count)
+	:
+		Block_connection::Job(connection, operation),
+		registry_element(registry, *this),
+		kind(kind), first(first), count(count)
+	{ }
+};
+
+
+/**
+ * Client request that was accepted but not yet acknowledged
+ */
+struct Block_cache::Pending
+{
+	Block::Request request  { };
+	char          *payload  = nullptr;
+	uint64_t       start_us = 0;
+
+	bool claimed        = false;  /* cache lines are pinned */
+	bool sync_submitted = false;
+	bool done           = false;
+};
+
+
+struct Block_cache::Statistics
+{
+	struct Latency
+	{
+		uint64_t count    = 0;
+		uint64_t total_us = 0;
+		uint64_t max_us   = 0;
+
+		void record(uint64_t us)
+		{
+			count++;
+			total_us += us;
+			max_us = max(max_us, us);
+		}
+
+		void generate(Xml_generator &xml, char const *type) const
+		{
+			xml.node("latency", [&] () {
+				xml.attribute("type",    type);
+				xml.attribute("count",   count);
+				xml.attribute("avg_us",  count ? total_us / count : 0);
+				xml.attribute("max_us",  max_us);
+			});
+		}
+	};
+
+	uint64_t requests          = 0;
+	uint64_t hits              = 0;
+	uint64_t misses            = 0;
+	uint64_t read_ahead        = 0;
+	uint64_t read_ahead_hits   = 0;
+	uint64_t fills             = 0;
+	uint64_t fill_blocks       = 0;
+	uint64_t write_backs       = 0;
+	uint64_t write_back_blocks = 0;
+	uint64_t merged_lines      = 0;
+
+	Latency read  { };
+	Latency write { };
+	Latency sync  { };
+
+	void generate(Xml_generator &xml, unsigned dirty_lines) const
+	{
+		uint64_t const lookups = hits + misses;
+
+		xml.attribute("requests",          requests);
+		xml.attribute("hits",              hits);
+		xml.attribute("misses",            misses);
+		xml.attribute("hit_ratio_percent", lookups ? (hits*100)/lookups : 0);
+		xml.attribute("read_ahead",        read_ahead);
+		xml.attribute("read_ahead_hits",   read_ahead_hits);
+		xml.attribute("fills",             fills);
+		xml.attribute("fill_blocks",       fill_blocks);
+		xml.attribute("write_backs",       write_backs);
+		xml.attribute("write_back_blocks", write_back_blocks);
+		xml.attribute("merged_lines",      merged_lines);
+		xml.attribute("dirty_lines",       dirty_lines);
+
+		read .generate(xml, "read");
+		write.generate(xml, "write");
+		sync .generate(xml, "sync");
+	}
+};
+
+
+struct Block_cache::Block_session_component : Rpc_object<Block::Session>,
+                                              private Block::Request_stream
+{
+	Entrypoint &_ep;
+
+	using Block::Request_stream::with_requests;
+	using Block::Request_stream::with_content;
+	using Block::Request_stream::try_acknowledge;
+	using Block::Request_stream::wakeup_client_if_needed;
+
+	Block_session_component(Region_map                &rm,
+	                        Entrypoint                &ep,
+	                        Dataspace_capability       ds,
+	                        Signal_context_capability  sigh,
+	                        Info                       info)
+	:
+		Request_stream { rm, ds, ep, sigh, info },
+		_ep            { ep }
+	{
+		_ep.manage(*this);
+	}
+
+	~Block_session_component() { _ep.dissolve(*this); }
+
+	Info info() const override { return Request_stream::info(); }
+
+	Capability<Tx> tx_cap() override { return Request_stream::tx_cap(); }
+};
+
+
+struct Block_cache::Main : Rpc_object<Typed_root<Block::Session>>
+{
+	using Operation = Block::Operation;
+	using Type      = Block::Operation::Type;
+	using Response  = Block::Request_stream::Response;
+
+	enum { MAX_PENDING = 64, MAX_JOBS = 32 };
+
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Number_of_bytes const _io_buffer_size =
+		_config.xml().attribute_value("io_buffer",
+		                              Number_of_bytes(2*1024*1024));
+
+	Allocator_avl    _block_alloc { &_heap };
+	Block_connection _block       { _env, &_block_alloc, _io_buffer_size };
+
+	Block::Session::Info const _info = _block.info();
+
+	size_t const _line_size = _init_line_size();
+
+	Block::block_number_t const _blocks_per_line = _line_size / _info.block_size;
+
+	unsigned const _num_lines =
+		(unsigned)max((size_t)1, _config.xml().attribute_value("size",
+		              Number_of_bytes(8*1024*1024)) / _line_size);
+
+	static unsigned _lines_from_config(Xml_node config, char const *attr,
+	                                   size_t dflt, size_t line_size)
+	{
+		return (unsigned)(config.attribute_value(attr, Number_of_bytes(dflt))
+		                  / line_size);
+	}
+
+	unsigned const _max_merge_lines =
+		max(1u, _lines_from_config(_config.xml(), "max_merge", 128*1024, _line_size));
+
+	unsigned const _read_ahead_lines =
+		_lines_from_config(_config.xml(), "read_ahead", 64*1024, _line_size);
+
+	Attached_ram_dataspace _cache_ds { _env.ram(), _env.rm(), _num_lines*_line_size };
+
+	Cache _cache { _heap, _cache_ds.local_addr<char>(), _num_lines, _line_size };
+
+	Registry<Job> _jobs     { };
+	unsigned      _num_jobs { 0 };
+
+	Pending  _pending[MAX_PENDING] { };
+	unsigned _num_pending { 0 };
+
+	/* block number following the most recent read, used to detect streaming */
+	Block::block_number_t _next_read { 0 };
+
+	enum class Sync_state { IDLE, IN_FLIGHT, DONE } _sync_state { Sync_state::IDLE };
+
+	bool _sync_success = false;
+	bool _write_error  = false;
+
+	Statistics _stats { };
+	uint64_t   _reported_requests = ~0ULL;
+
+	Constructible<Expanding_reporter> _reporter { };
+
+	Constructible<Attached_ram_dataspace>  _session_ds { };
+	Constructible<Block_session_component> _session    { };
+
+	Signal_handler<Main> _request_handler { _env.ep(), *this, &Main::_handle };
+	Signal_handler<Main> _io_handler      { _env.ep(), *this, &Main::_handle };
+	Signal_handler<Main> _report_handler  { _env.ep(), *this, &Main::_handle_report };
+
+	size_t _init_line_size() const
+	{
+		size_t const block_size = _info.block_size;
+		size_t const line_size  = _config.xml().attribute_value("line_size",
+		                                                        Number_of_bytes(4096));
+
+		return max(block_size, (line_size / block_size) * block_size);
+	}
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	Line &_line(Line_number number) { return *_cache.lookup(number); }
+
+	Line_number _first_line(Operation const &op) const {
+		return op.block_number / _blocks_per_line; }
+
+	Line_number _last_line(Operation const &op) const {
+		return (op.block_number + op.count - 1) / _blocks_per_line; }
+
+	Line_number _num_device_lines() const {
+		return (_info.block_count + _blocks_per_line - 1) / _blocks_per_line; }
+
+	bool _covers_line(Operation const &op, Line_number number) const
+	{
+		Block::block_number_t const start = number*_blocks_per_line;
+		Block::block_number_t const end   = min(start + _blocks_per_line,
+		                                        _info.block_count);
+
+		return op.block_number <= start && op.block_number + op.count >= end;
+	}
+
+	/**
+	 * Create back-end job covering 'count' lines starting at 'first'
+	 */
+	void _submit_job(Job::Kind kind, Line_number first, unsigned count)
+	{
+		Block::block_number_t const block_number = first*_blocks_per_line;
+
+		Operation const op {
+			.type         = (kind == Job::Kind::FILL) ? Type::READ : Type::WRITE,
+			.block_number = block_number,
+			.count        = min(count*_blocks_per_line,
+			                    _info.block_count - block_number) };
+
+		new (_heap) Job(_block, op, _jobs, kind, first, count);
+		_num_jobs++;
+
+		if (kind == Job::Kind::FILL) {
+			_stats.fills++;
+			_stats.fill_blocks += op.count;
+		} else {
+			_stats.write_backs++;
+			_stats.write_back_blocks += op.count;
+		}
+		_stats.merged_lines += count - 1;
+	}
+
+	/**
+	 * Read lines within [first, last] that satisfy 'needs_fill' from device
+	 *
+	 * Consecutive lines are merged into one back-end request.
+	 */
+	template <typename FN>
+	bool _fill(Line_number first, Line_number last, FN const &needs_fill)
+	{
+		bool progress = false;
+
+		for (Line_number n = first; n <= last && _num_jobs < MAX_JOBS; ) {
+
+			Line *line = _cache.lookup(n);
+			if (!line || !needs_fill(*line)) { n++; continue; }
+
+			unsigned count = 0;
+			for (; n + count <= last && count < _max_merge_lines; count++) {
+				Line *l = _cache.lookup(n + count);
+				if (!l || !needs_fill(*l))
+					break;
+				l->filling = true;
+			}
+
+			_submit_job(Job::Kind::FILL, n, count);
+			progress = true;
+			n += count;
+		}
+		return progress;
+	}
+
+	/**
+	 * Write back dirty line together with adjacent dirty lines
+	 */
+	void _write_back(Line &line)
+	{
+		auto idle_dirty = [&] (Line_number n) {
+			Line const *l = _cache.lookup(n);
+			return l && l->dirty && !l->writing; };
+
+		Line_number first = line.number;
+		while (first > 0 && line.number - first + 1 < _max_merge_lines
+		    && idle_dirty(first - 1))
+			first--;
+
+		unsigned count = 0;
+		for (; count < _max_merge_lines && idle_dirty(first + count); count++) {
+			Line &l = _line(first + count);
+			l.writing   = true;
+			l.redirtied = false;
+		}
+
+		_submit_job(Job::Kind::WRITE_BACK, first, count);
+	}
+
+	/**
+	 * Start write-back of dirty lines, least recently used first
+	 */
+	bool _write_back_dirty(unsigned max_jobs)
+	{
+		bool progress = false;
+		_cache.for_each_idle_dirty([&] (Line &line) {
+			if (_num_jobs >= MAX_JOBS || max_jobs == 0)
+				return false;
+			_write_back(line);
+			max_jobs--;
+			progress = true;
+			return true;
+		});
+		return progress;
+	}
+
+	/**
+	 * Pin all lines in [first, last], allocating lines as needed
+	 *
+	 * \return false if not enough lines could be evicted
+	 */
+	bool _claim(Line_number first, Line_number last)
+	{
+		for (Line_number n = first; n <= last; n++) {
+
+			Line *line = _cache.lookup(n);
+			if (!line)
+				line = _cache.alloc(n);
+
+			if (!line) {
+				if (n > first)
+					_unpin(first, n - 1);
+				return false;
+			}
+			line->pins++;
+		}
+		return true;
+	}
+
+	void _unpin(Line_number first, Line_number last)
+	{
+		for (Line_number n = first; n <= last; n++) {
+			Line &line = _line(n);
+			line.pins--;
+
+			if (!line.pins && line.failed)
+				_cache.discard(line);
+		}
+	}
+
+	void _read_ahead(Line_number first)
+	{
+		Line_number const end = min(first + _read_ahead_lines, _num_device_lines());
+
+		for (Line_number n = first; n < end; n++) {
+
+			if (_cache.lookup(n))
+				continue;
+
+			Line *line = _cache.alloc(n);
+			if (!line)
+				break;
+
+			line->prefetched = true;
+			_stats.read_ahead++;
+		}
+
+		_fill(first, end - 1, [&] (Line const &line) {
+			return line.prefetched && !line.present && !line.filling; });
+	}
+
+	void _account_lookups(Operation const &op)
+	{
+		if (op.type != Type::READ)
+			return;
+
+		for (Line_number n = _first_line(op); n <= _last_line(op); n++) {
+			Line &line = _line(n);
+			if (line.present || line.filling) {
+				_stats.hits++;
+				if (line.prefetched)
+					_stats.read_ahead_hits++;
+			} else {
+				_stats.misses++;
+			}
+			line.prefetched = false;
+		}
+	}
+
+	void _copy(Pending &p)
+	{
+		Operation const &op = p.request.operation;
+		size_t const block_size = _info.block_size;
+
+		for (Line_number n = _first_line(op); n <= _last_line(op); n++) {
+
+			Line &line = _line(n);
+
+			Block::block_number_t const line_start = n*_blocks_per_line;
+			Block::block_number_t const start = max(op.block_number, line_start);
+			Block::block_number_t const end   = min(op.block_number + op.count,
+			                                        line_start + _blocks_per_line);
+
+			char  * const client = p.payload + (start - op.block_number)*block_size;
+			char  * const cached = _cache.data(line) + (start - line_start)*block_size;
+			size_t  const length = (size_t)(end - start)*block_size;
+
+			if (op.type == Type::READ) {
+				memcpy(client, cached, length);
+			} else {
+				memcpy(cached, client, length);
+				line.present = true;
+				_cache.mark_dirty(line);
+			}
+			_cache.touch(line);
+		}
+	}
+
+	bool _process_read_write(Pending &p)
+	{
+		Operation const &op = p.request.operation;
+
+		Line_number const first = _first_line(op);
+		Line_number const last  = _last_line(op);
+
+		bool progress = false;
+
+		if (!p.claimed) {
+
+			if (!_claim(first, last))
+				return _write_back_dirty(4);
+
+			p.claimed = true;
+			progress  = true;
+
+			_account_lookups(op);
+
+			if (op.type == Type::READ && _read_ahead_lines) {
+				if (op.block_number == _next_read)
+					_read_ahead(last + 1);
+				_next_read = op.block_number + op.count;
+			}
+		}
+
+		auto needs_fill = [&] (Line const &line) {
+			return !line.present && !line.filling && !line.failed
+			    && (op.type == Type::READ || !_covers_line(op, line.number)); };
+
+		progress |= _fill(first, last, needs_fill);
+
+		bool ready  = true;
+		bool failed = false;
+		for (Line_number n = first; n <= last; n++) {
+			Line const &line = _line(n);
+			if (line.failed)                        failed = true;
+			else if (line.filling || needs_fill(line)) ready  = false;
+		}
+
+		if (!failed && !ready)
+			return progress;
+
+		if (!failed)
+			_copy(p);
+
+		_unpin(first, last);
+
+		p.request.success = !failed;
+		p.done = true;
+
+		uint64_t const us = _now_us() - p.start_us;
+		if (op.type == Type::READ) _stats.read .record(us);
+		else                       _stats.write.record(us);
+
+		return true;
+	}
+
+	bool _process_sync(Pending &p)
+	{
+		if (!p.sync_submitted) {
+
+			/* flush all dirty lines before syncing the device */
+			if (_cache.num_dirty())
+				return _write_back_dirty(MAX_JOBS);
+
+			if (_sync_state != Sync_state::IDLE || _num_jobs >= MAX_JOBS)
+				return false;
+
+			Operation const op { .type = Type::SYNC, .block_number = 0, .count = 0 };
+			new (_heap) Job(_block, op, _jobs, Job::Kind::SYNC, 0, 0);
+			_num_jobs++;
+
+			p.sync_submitted = true;
+			_sync_state = Sync_state::IN_FLIGHT;
+			return true;
+		}
+
+		if (_sync_state != Sync_state::DONE)
+			return false;
+
+		p.request.success = _sync_success && !_write_error;
+		p.done = true;
+
+		_sync_state  = Sync_state::IDLE;
+		_write_error = false;
+
+		_stats.sync.record(_now_us() - p.start_us);
+		return true;
+	}
+
+	bool _process(Pending &p)
+	{
+		if (p.done)
+			return false;
+
+		switch (p.request.operation.type) {
+		case Type::READ:
+		case Type::WRITE: return _process_read_write(p);
+		case Type::SYNC:  return _process_sync(p);
+		default:
+			p.request.success = true;
+			p.done = true;
+			return true;
+		}
+	}
+
+	bool _valid(Block::Request const &request) const
+	{
+		Operation const &op = request.operation;
+
+		switch (op.type) {
+		case Type::WRITE:
+			if (!_info.writeable)
+				return false;
+			[[fallthrough]];
+		case Type::READ:
+			/* written such that a huge block number cannot overflow */
+			return op.count && op.block_number < _info.block_count
+			                && op.count <= _info.block_count - op.block_number;
+
+		case Type::TRIM: [[fallthrough]];
+		case Type::SYNC: return true;
+		default:         return false;
+		}
+	}
+
+	bool _accept_requests()
+	{
+		bool progress = false;
+
+		_session->with_requests([&] (Block::Request request) {
+
+			if (_num_pending == MAX_PENDING)
+				return Response::RETRY;
+
+			if (!_valid(request))
+				return Response::REJECTED;
+
+			/* the payload must lie within the communication buffer */
+			char *payload = nullptr;
+			if (Operation::has_payload(request.operation.type)) {
+				_session->with_content(request, [&] (void *ptr, size_t) {
+					payload = (char *)ptr; });
+
+				if (!payload)
+					return Response::REJECTED;
+			}
+
+			Pending &p = _pending[_num_pending];
+			p = Pending();
+			p.request  = request;
+			p.payload  = payload;
+			p.start_us = _now_us();
+
+			_num_pending++;
+			_stats.requests++;
+			progress = true;
+			return Response::ACCEPTED;
+		});
+
+		return progress;
+	}
+
+	bool _acknowledge_completed()
+	{
+		bool progress = false;
+
+		_session->try_acknowledge([&] (Block::Request_stream::Ack &ack) {
+			for (unsigned i = 0; i < _num_pending; i++) {
+				if (!_pending[i].done)
+					continue;
+
+				ack.submit(_pending[i].request);
+
+				/* keep remaining requests in arrival order */
+				for (unsigned j = i + 1; j < _num_pending; j++)
+					_pending[j - 1] = _pending[j];
+				_num_pending--;
+
+				progress = true;
+				return;
+			}
+		});
+
+		return progress;
+	}
+
+	bool _update_jobs()
+	{
+		bool const progress = _block.update_jobs(*this);
+
+		_jobs.for_each([&] (Job &job) {
+			if (!job.done)
+				return;
+
+			destroy(_heap, &job);
+			_num_jobs--;
+		});
+
+		return progress;
+	}
+
+	void _handle()
+	{
+		for (;;) {
+
+			bool progress = _update_jobs();
+
+			if (_session.constructed()) {
+
+				progress |= _accept_requests();
+
+				for (unsigned i = 0; i < _num_pending; i++)
+					progress |= _process(_pending[i]);
+
+				progress |= _acknowledge_completed();
+			} else {
+
+				/* write back modifications of a closed session */
+				progress |= _write_back_dirty(MAX_JOBS);
+			}
+
+			progress |= _update_jobs();
+
+			if (!progress)
+				break;
+		}
+
+		if (_session.constructed())
+			_session->wakeup_client_if_needed();
+	}
+
+	void _handle_report()
+	{
+		if (!_reporter.constructed() || _stats.requests == _reported_requests)
+			return;
+
+		_reported_requests = _stats.requests;
+
+		_reporter->generate([&] (Xml_generator &xml) {
+			_stats.generate(xml, _cache.num_dirty()); });
+	}
+
+
+	/************************
+	 ** Update_jobs_policy **
+	 ************************/
+
+	template <typename FN>
+	void _with_line_ranges(Job &job, off_t offset, size_t length, FN const &fn)
+	{
+		while (length > 0) {
+			Line_number const n          = job.first + offset / _line_size;
+			size_t      const line_off   = offset % _line_size;
+			size_t      const curr_len   = min(length, _line_size - line_off);
+
+			Line *line = _cache.lookup(n);
+			if (line)
+				fn(_cache.data(*line) + line_off, curr_len);
+
+			offset += curr_len;
+			length -= curr_len;
+		}
+	}
+
+	void produce_write_content(Job &job, off_t offset, char *dst, size_t length)
+	{
+		_with_line_ranges(job, offset, length, [&] (char const *src, size_t len) {
+			memcpy(dst, src, len);
+			dst += len;
+		});
+	}
+
+	void consume_read_result(Job &job, off_t offset, char const *src, size_t length)
+	{
+		_with_line_ranges(job, offset, length, [&] (char *dst, size_t len) {
+			memcpy(dst, src, len);
+			src += len;
+		});
+	}
+
+	void completed(Job &job, bool success)
+	{
+		job.done = true;
+
+		switch (job.kind) {
+
+		case Job::Kind::FILL:
+			for (Line_number n = job.first; n < job.first + job.count; n++) {
+				Line &line = _line(n);
+				line.filling = false;
+				line.present = success;
+				line.failed  = !success;
+
+				if (!success && !line.pins)
+					_cache.discard(line);
+			}
+			break;
+
+		case Job::Kind::WRITE_BACK:
+			if (!success) {
+				error("write-back of blocks ", job.operation().block_number,
+				      "+", job.operation().count, " failed");
+				_write_error = true;
+			}
+			for (Line_number n = job.first; n < job.first + job.count; n++)
+				_cache.mark_written(_line(n));
+			break;
+
+		case Job::Kind::SYNC:
+			_sync_success = success;
+			_sync_state   = Sync_state::DONE;
+			break;
+		}
+	}
+
+
+	/********************
+	 ** Root interface **
+	 ********************/
+
+	Capability<Session> session(Root::Session_args const &args,
+	                            Affinity const &) override
+	{
+		if (_session.constructed())
+			throw Service_denied();
+
+		size_t const tx_buf_size =
+			Arg_string::find_arg(args.string(), "tx_buf_size").aligned_size();
+
+		Ram_quota const ram_quota = ram_quota_from_args(args.string());
+
+		if (tx_buf_size > ram_quota.value) {
+			warning("communication buffer size exceeds session quota");
+			throw Insufficient_ram_quota();
+		}
+
+		/*
+		 * All lines referred to by in-flight requests are pinned. Make sure
+		 * that they fit into the cache.
+		 */
+		if (tx_buf_size / _line_size + 2*MAX_PENDING > _num_lines) {
+			error("cache too small for communication buffer of ",
+			      Number_of_bytes(tx_buf_size));
+			throw Service_denied();
+		}
+
+		Block::Session::Info const info {
+			.block_size  = _info.block_size,
+			.block_count = _info.block_count,
+			.align_log2  = 0,
+			.writeable   = _info.writeable };
+
+		_session_ds.construct(_env.ram(), _env.rm(), tx_buf_size);
+		_session.construct(_env.rm(), _env.ep(), _session_ds->cap(),
+		                   _request_handler, info);
+
+		return _session->cap();
+	}
+
+	void upgrade(Capability<Session>, Root::Upgrade_args const &) override { }
+
+	void close(Capability<Session> cap) override
+	{
+		if (!_session.constructed() || !(cap == _session->cap()))
+			return;
+
+		/* requests that are still in flight are dropped */
+		for (unsigned i = 0; i < _num_pending; i++) {
+			Pending &p = _pending[i];
+			if (p.claimed && !p.done)
+				_unpin(_first_line(p.request.operation),
+				       _last_line(p.request.operation));
+		}
+		_num_pending = 0;
+
+		_session.destruct();
+		_session_ds.destruct();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_block.sigh(_io_handler);
+
+		Xml_node const config = _config.xml();
+
+		if (config.has_sub_node("report")) {
+			Xml_node const report = config.sub_node("report");
+
+			if (report.attribute_value("statistics", false)) {
+				_reporter.construct(_env, "block_cache", "statistics");
+				_timer.sigh(_report_handler);
+				_timer.trigger_periodic(1000*report.attribute_value("interval_ms", 1000u));
+			}
+		}
+
+		log("cache of ", Number_of_bytes(_num_lines*_line_size), " in ",
+		    _num_lines, " lines of ", Number_of_bytes(_line_size));
+
+		_env.parent().announce(_env.ep().manage(*this));
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Block_cache::Main main(env); }
@@ -0,0 +1,392 @@
+/*
+ * \brief  Communication graph of threads and co-locating placement
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include "comm_graph.h"
+
+void Cpu::Comm_graph::begin_period()
+{
+	_period++;
+	_num_records   = 0;
+	_num_decisions = 0;
+	_nodes_changed = false;
+
+	for (unsigned a = 0; a < MAX_NODES; a++)
+		for (unsigned b = 0; b < MAX_NODES; b++)
+			_weight[a][b] >>= 1;
+
+	for (Node &node : _nodes) {
+		node.seen         = false;
+		node.target_valid = false;
+		node.call_pending = false;
+
+		if (node.hold)
+			node.hold--;
+	}
+
+	for (Submit &submit : _submits)
+		submit.valid = false;
+}
+
+
+void Cpu::Comm_graph::node(Subject_id const id, Location const &area,
+                           Location const &current, uint64_t const load,
+                           Session_label const &label, Thread_name const &name)
+{
+	int i = _lookup(id);
+
+	if (i < 0) {
+		for (unsigned j = 0; j < MAX_NODES && i < 0; j++)
+			if (!_nodes[j].used)
+				i = j;
+
+		if (i < 0) {
+			Genode::warning("too many threads for co-locate policy");
+			return;
+		}
+
+		for (unsigned j = 0; j < MAX_NODES; j++)
+			_weight[i][j] = _weight[j][i] = 0;
+
+		_nodes[i] = Node { };
+		_nodes[i].used  = true;
+		_nodes[i].id    = id;
+		_nodes[i].label = label;
+		_nodes[i].name  = name;
+
+		_nodes_changed = true;
+	}
+
+	Node &node = _nodes[i];
+	node.seen    = true;
+	node.area    = area;
+	node.current = current;
+	node.load    = load;
+}
+
+
+void Cpu::Comm_graph::event(Subject_id const id, Event const &event)
+{
+	int const node = _lookup(id);
+	if (node < 0)
+		return;
+
+	if (_num_records == MAX_RECORDS) {
+		_dropped++;
+		return;
+	}
+
+	_records[_num_records++] = Record { .time = event.timestamp,
+	                                    .hash = _hash(event.name),
+	                                    .node = (uint16_t)node,
+	                                    .type = event.type };
+}
+
+
+void Cpu::Comm_graph::_sort_records()
+{
+	/* shell sort, the records of each thread are already in order */
+	static unsigned const gaps[] = { 701, 301, 132, 57, 23, 10, 4, 1 };
+
+	for (unsigned gap : gaps)
+		for (unsigned i = gap; i < _num_records; i++) {
+			Record const r = _records[i];
+			unsigned j = i;
+			for (; j >= gap && _records[j - gap].time > r.time; j -= gap)
+				_records[j] = _records[j - gap];
+			_records[j] = r;
+		}
+}
+
+
+void Cpu::Comm_graph::_correlate()
+{
+	for (unsigned i = 0; i < _num_records; i++) {
+
+		Record const &r    = _records[i];
+		Node         &node = _nodes[r.node];
+
+		switch (r.type) {
+
+		case Event::CALL:
+			node.call_pending = true;
+			node.call_served  = false;
+			node.call_hash    = r.hash;
+			node.call_time    = r.time;
+			break;
+
+		case Event::RETURNED:
+			node.call_pending = false;
+			break;
+
+		case Event::DISPATCH:
+			{
+				/* the caller is the thread with the latest matching call */
+				int caller = -1;
+				for (unsigned j = 0; j < MAX_NODES; j++) {
+					Node const &c = _nodes[j];
+					if (j == r.node || !c.used || !c.call_pending || c.call_served
+					 || c.call_hash != r.hash || c.call_time > r.time)
+						continue;
+
+					if (caller < 0 || c.call_time > _nodes[caller].call_time)
+						caller = j;
+				}
+
+				if (caller >= 0) {
+					_nodes[caller].call_served = true;
+					_add_weight(caller, r.node);
+				}
+			}
+			break;
+
+		case Event::SIGNAL_SUBMIT:
+			_submits[_next_submit] = Submit { .valid = true, .node = r.node,
+			                                  .time  = r.time };
+			_next_submit = (_next_submit + 1) % MAX_SUBMITS;
+			break;
+
+		case Event::SIGNAL_RECEIVE:
+			{
+				int sender = -1;
+				for (unsigned j = 0; j < MAX_SUBMITS; j++) {
+					Submit const &s = _submits[j];
+					if (!s.valid || s.node == r.node || s.time > r.time)
+						continue;
+
+					if (sender < 0 || s.time > _submits[sender].time)
+						sender = j;
+				}
+
+				if (sender >= 0) {
+					_submits[sender].valid = false;
+					_add_weight(_submits[sender].node, r.node);
+				}
+			}
+			break;
+
+		case Event::REPLY:
+			break;
+		}
+	}
+}
+
+
+void Cpu::Comm_graph::_remove_unseen()
+{
+	for (Node &node : _nodes) {
+		if (!node.used || node.seen)
+			continue;
+
+		node = Node { };
+		_nodes_changed = true;
+	}
+}
+
+
+void Cpu::Comm_graph::_decide(unsigned const i, Location const &to,
+                              Decision::Reason const reason,
+                              unsigned const gain)
+{
+	Node &node = _nodes[i];
+
+	if (_num_decisions < MAX_DECISIONS)
+		_decisions[_num_decisions++] = Decision { .label  = node.label,
+		                                          .name   = node.name,
+		                                          .from   = node.current,
+		                                          .to     = to,
+		                                          .reason = reason,
+		                                          .gain   = gain };
+	node.current      = to;
+	node.target       = to;
+	node.target_valid = true;
+	node.hold         = _config.hold;
+
+	_migrations++;
+}
+
+
+void Cpu::Comm_graph::place(Affinity::Space const &space, uint64_t const capacity)
+{
+	_remove_unseen();
+	_sort_records();
+	_correlate();
+
+	unsigned const width  = space.width();
+	unsigned const cpus   = Genode::min(space.total(), (unsigned)MAX_CPUS);
+
+	auto cpu_of = [&] (Location const &loc) -> int {
+		if (loc.xpos() < 0 || loc.ypos() < 0
+		 || (unsigned)loc.xpos() >= width || (unsigned)loc.ypos() >= space.height())
+			return -1;
+
+		unsigned const index = loc.ypos()*width + loc.xpos();
+		return index < cpus ? (int)index : -1;
+	};
+
+	/* CPUs the thread may be placed on */
+	auto for_each_cpu = [&] (Node const &node, auto const &fn) {
+		for (unsigned x = 0; x < node.area.width(); x++)
+			for (unsigned y = 0; y < node.area.height(); y++) {
+				Location const loc(node.area.xpos() + x, node.area.ypos() + y, 1, 1);
+				int const cpu = cpu_of(loc);
+				if (cpu >= 0)
+					fn(loc, (unsigned)cpu);
+			}
+	};
+
+	/* load of the observed threads per CPU */
+	uint64_t load[MAX_CPUS] { };
+	for (Node const &node : _nodes) {
+		int const cpu = node.used ? cpu_of(node.current) : -1;
+		if (cpu >= 0)
+			load[cpu] += node.load;
+	}
+
+	uint64_t const limit = capacity*_config.max_load_percent/100;
+
+	for (unsigned m = 0; m < _config.max_migrations; m++) {
+
+		int              best_node = -1;
+		Location         best_to   { };
+		unsigned         best_gain = 0;
+		Decision::Reason reason    = Decision::CO_LOCATE;
+
+		/*
+		 * Move the thread with the highest gain, i.e., the weight of the
+		 * edges to threads at the target CPU minus the weight of the edges
+		 * to threads at its current CPU.
+		 */
+		for (unsigned i = 0; i < MAX_NODES; i++) {
+
+			Node const &node = _nodes[i];
+			int  const  cur  = node.used ? cpu_of(node.current) : -1;
+			if (cur < 0 || node.hold)
+				continue;
+
+			uint32_t affinity[MAX_CPUS] { };
+			for (unsigned j = 0; j < MAX_NODES; j++) {
+				int const cpu = _nodes[j].used ? cpu_of(_nodes[j].current) : -1;
+				if (cpu >= 0 && j != i)
+					affinity[cpu] += _weight[i][j];
+			}
+
+			for_each_cpu(node, [&] (Location const &loc, unsigned cpu) {
+				if ((int)cpu == cur || load[cpu] + node.load > limit)
+					return;
+
+				if (affinity[cpu] < affinity[cur] + _config.threshold)
+					return;
+
+				unsigned const gain = affinity[cpu] - affinity[cur];
+				if (gain > best_gain) {
+					best_node = i;
+					best_to   = loc;
+					best_gain = gain;
+				}
+			});
+		}
+
+		/*
+		 * Without any gain by co-location, relieve overloaded CPUs by moving
+		 * the least busy thread to the least loaded CPU.
+		 */
+		if (best_node < 0) {
+			reason = Decision::BALANCE;
+
+			uint64_t best_load = ~0ULL;
+
+			for (unsigned i = 0; i < MAX_NODES; i++) {
+
+				Node const &node = _nodes[i];
+				int  const  cur  = node.used ? cpu_of(node.current) : -1;
+				if (cur < 0 || node.hold || load[cur] <= limit || !node.load)
+					continue;
+
+				for_each_cpu(node, [&] (Location const &loc, unsigned cpu) {
+					if ((int)cpu == cur || load[cpu] + node.load > limit)
+						return;
+
+					/* prefer the lightest thread and the least loaded CPU */
+					bool const better = best_node < 0
+					                 || node.load < _nodes[best_node].load
+					                 || ((int)i == best_node && load[cpu] < best_load);
+					if (!better)
+						return;
+
+					best_node = i;
+					best_to   = loc;
+					best_load = load[cpu];
+				});
+			}
+		}
+
+		if (best_node < 0)
+			break;
+
+		Node const &node = _nodes[best_node];
+		load[cpu_of(node.current)] -= node.load;
+		load[cpu_of(best_to)]      += node.load;
+
+		_decide(best_node, best_to, reason, best_gain);
+	}
+}
+
+
+void Cpu::Comm_graph::report(Xml_generator &xml) const
+{
+	xml.attribute("period",     _period);
+	xml.attribute("migrations", _migrations);
+	xml.attribute("events",     _num_records);
+	if (_dropped)
+		xml.attribute("dropped", _dropped);
+
+	for (unsigned i = 0; i < MAX_NODES; i++) {
+
+		Node const &node = _nodes[i];
+		if (!node.used)
+			continue;
+
+		xml.node("thread", [&] () {
+			xml.attribute("label", node.label);
+			xml.attribute("name",  node.name);
+			xml.attribute("xpos",  node.current.xpos());
+			xml.attribute("ypos",  node.current.ypos());
+			xml.attribute("load",  node.load);
+			if (node.hold)
+				xml.attribute("hold", node.hold);
+
+			for (unsigned j = 0; j < MAX_NODES; j++) {
+				if (!_nodes[j].used || !_weight[i][j])
+					continue;
+
+				xml.node("peer", [&] () {
+					xml.attribute("label",  _nodes[j].label);
+					xml.attribute("name",   _nodes[j].name);
+					xml.attribute("weight", _weight[i][j]);
+				});
+			}
+		});
+	}
+
+	for_each_decision([&] (Decision const &d) {
+		xml.node("migration", [&] () {
+			xml.attribute("label",  d.label);
+			xml.attribute("name",   d.name);
+			xml.attribute("from",   Genode::String<12>(d.from.xpos(), "x", d.from.ypos()));
+			xml.attribute("to",     Genode::String<12>(d.to.xpos(),   "x", d.to.ypos()));
+			xml.attribute("reason", d.reason_string());
+			if (d.gain)
+				xml.attribute("gain", d.gain);
+		});
+	});
+}
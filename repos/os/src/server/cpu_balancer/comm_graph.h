@@ -0,0 +1,255 @@
+/*
+ * \brief  Communication graph of threads and co-locating placement
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The nodes of the graph are threads with the 'co-locate' policy. Edges are
+ * weighted by the number of RPCs and signals exchanged between two threads.
+ * The edges are derived from the 'rpc_events' trace records of the threads:
+ * a dispatch is attributed to the thread with the latest pending call of the
+ * same RPC function, a received signal to the latest preceding submission of
+ * another thread. Each period, the weights decay by half such that the graph
+ * reflects the recent behaviour.
+ *
+ * Based on the graph, threads are moved to the CPU of their most chatty
+ * peers as long as the CPU does not become overloaded. Migration storms are
+ * prevented by requiring a minimal gain, by holding migrated threads at their
+ * CPU for a number of periods, and by limiting the migrations per period.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _COMM_GRAPH_H_
+#define _COMM_GRAPH_H_
+
+#include <base/affinity.h>
+#include <base/session_label.h>
+#include <util/xml_generator.h>
+#include <util/xml_node.h>
+
+#include "trace.h"
+
+namespace Cpu {
+	class Comm_graph;
+
+	using Genode::uint16_t;
+	using Genode::uint32_t;
+	using Genode::uint64_t;
+	using Genode::Xml_generator;
+	using Genode::Xml_node;
+}
+
+
+class Cpu::Comm_graph : Genode::Noncopyable
+{
+	public:
+
+		typedef Affinity::Location Location;
+
+		struct Config
+		{
+			unsigned threshold;         /* minimal gain in weighted events */
+			unsigned hold;              /* periods a migrated thread stays */
+			unsigned max_migrations;    /* per period */
+			unsigned max_load_percent;  /* of the CPU capacity */
+
+			static Config from_xml(Xml_node const &node)
+			{
+				return Config {
+					.threshold        = node.attribute_value("threshold",        32u),
+					.hold             = node.attribute_value("hold",             3u),
+					.max_migrations   = node.attribute_value("max_migrations",   2u),
+					.max_load_percent = node.attribute_value("max_load_percent", 90u) };
+			}
+		};
+
+		struct Decision
+		{
+			enum Reason { CO_LOCATE, BALANCE };
+
+			Session_label label;
+			Thread_name   name;
+			Location      from, to;
+			Reason        reason;
+			unsigned      gain;
+
+			char const *reason_string() const {
+				return reason == CO_LOCATE ? "co-locate" : "balance"; }
+		};
+
+	private:
+
+		enum {
+			MAX_NODES     = 64,
+			MAX_CPUS      = 128,
+			MAX_RECORDS   = 4096,
+			MAX_SUBMITS   = 8,
+			MAX_DECISIONS = 8,
+			MAX_WEIGHT    = 0xffff,
+		};
+
+		typedef Trace::Event Event;
+
+		struct Node
+		{
+			bool          used;
+			bool          seen;          /* registered in current period */
+			Subject_id    id;
+			Session_label label;
+			Thread_name   name;
+			Location      area;          /* affinity area of CPU session */
+			Location      current;
+			Location      target;
+			bool          target_valid;
+			uint64_t      load;          /* execution time of last period */
+			unsigned      hold;          /* periods until next migration */
+
+			/* pending RPC call of the thread */
+			bool                      call_pending;
+			bool                      call_served;
+			uint32_t                  call_hash;
+			Genode::Trace::Timestamp  call_time;
+		};
+
+		struct Record
+		{
+			Genode::Trace::Timestamp time;
+			uint32_t                 hash;
+			uint16_t                 node;
+			Event::Type              type;
+		};
+
+		struct Submit
+		{
+			bool                     valid;
+			uint16_t                 node;
+			Genode::Trace::Timestamp time;
+		};
+
+		Config _config;
+
+		Node     _nodes[MAX_NODES] { };
+		uint16_t _weight[MAX_NODES][MAX_NODES] { };
+
+		Record   _records[MAX_RECORDS] { };
+		unsigned _num_records = 0;
+
+		Submit   _submits[MAX_SUBMITS] { };
+		unsigned _next_submit = 0;
+
+		Decision _decisions[MAX_DECISIONS] { };
+		unsigned _num_decisions = 0;
+
+		unsigned long _period        = 0;
+		unsigned long _migrations    = 0;
+		unsigned long _dropped       = 0;
+		unsigned      _last_node     = 0;
+		bool          _nodes_changed = false;
+
+		static uint32_t _hash(char const *name)
+		{
+			/* FNV-1a */
+			uint32_t h = 2166136261u;
+			for (unsigned i = 0; i < Event::MAX_NAME_LEN && name[i]; i++) {
+				h ^= (unsigned char)name[i];
+				h *= 16777619u;
+			}
+			return h;
+		}
+
+		int _lookup(Subject_id const id)
+		{
+			/* events arrive grouped by thread */
+			if (_nodes[_last_node].used && _nodes[_last_node].id == id)
+				return _last_node;
+
+			for (unsigned i = 0; i < MAX_NODES; i++)
+				if (_nodes[i].used && _nodes[i].id == id) {
+					_last_node = i;
+					return i;
+				}
+
+			return -1;
+		}
+
+		void _add_weight(unsigned a, unsigned b)
+		{
+			if (a == b || _weight[a][b] == MAX_WEIGHT)
+				return;
+
+			_weight[a][b]++;
+			_weight[b][a]++;
+		}
+
+		void _sort_records();
+		void _correlate();
+		void _remove_unseen();
+
+		void _decide(unsigned node, Location const &to, Decision::Reason,
+		             unsigned gain);
+
+	public:
+
+		Comm_graph(Config const &config) : _config(config) { }
+
+		void config(Config const &config) { _config = config; }
+
+		/**
+		 * Start new period, decaying the weights of the previous ones
+		 */
+		void begin_period();
+
+		/**
+		 * Register thread for the current period
+		 *
+		 * \param area     affinity area of the thread's CPU session
+		 * \param current  CPU the thread is executing on
+		 * \param load     execution time consumed during last period
+		 */
+		void node(Subject_id, Location const &area, Location const &current,
+		          uint64_t load, Session_label const &, Thread_name const &);
+
+		/**
+		 * Account recorded RPC or signal event of a registered thread
+		 */
+		void event(Subject_id, Event const &);
+
+		/**
+		 * Derive communication edges and determine new placement
+		 *
+		 * \param capacity  execution time available per CPU and period
+		 */
+		void place(Affinity::Space const &, uint64_t capacity);
+
+		/**
+		 * Call 'fn' with the CPU the thread should migrate to
+		 */
+		template <typename FN>
+		void with_target(Subject_id const id, FN const &fn) const
+		{
+			for (Node const &node : _nodes)
+				if (node.used && node.id == id && node.target_valid)
+					fn(node.target);
+		}
+
+		template <typename FN>
+		void for_each_decision(FN const &fn) const
+		{
+			for (unsigned i = 0; i < _num_decisions; i++)
+				fn(_decisions[i]);
+		}
+
+		/**
+		 * Return true if the placement changed since the last report
+		 */
+		bool report_update() const { return _num_decisions || _nodes_changed; }
+
+		void report(Xml_generator &) const;
+};
+
+#endif /* _COMM_GRAPH_H_ */
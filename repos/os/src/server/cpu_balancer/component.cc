@@ -21,6 +21,7 @@
 #include <timer_session/connection.h>
 #include <pd_session/connection.h>
 
+#include "comm_graph.h"
 #include "session.h"
 #include "config.h"
 #include "trace.h"
@@ -211,6 +212,12 @@ struct Cpu::Balancer : Rpc_object<Typed_root<Cpu_session>>
 	bool                    update_report { false };
 	bool                    use_sleeper   { true  };
 
+	/* placement of communicating threads by the co-locate policy */
+	Comm_graph              graph         { Comm_graph::Config::from_xml(Xml_node("<co-locate/>")) };
+	Constructible<Reporter> placement_reporter { };
+	unsigned                placement_report_size { 4096 * 1 };
+	Number_of_bytes         event_buffer  { 16 * 1024 };
+
 	Cpu::Pd_root            pd            { env };
 
 	Signal_handler<Balancer> signal_config {
@@ -218,6 +225,7 @@ struct Cpu::Balancer : Rpc_object<Typed_root<Cpu_session>>
 
 	void handle_config();
 	void handle_timeout();
+	void co_locate();
 
 	/*
 	 * Need extra EP to avoid dead-lock/live-lock (depending on kernel)
@@ -344,6 +352,13 @@ void Cpu::Balancer::handle_config()
 
 		/* read in components configuration */
 		Cpu::Config::apply(config.xml(), list);
+
+		Xml_node co_locate("<co-locate/>");
+		config.xml().with_optional_sub_node("co-locate", [&] (Xml_node const &node) {
+			co_locate = node; });
+
+		graph.config(Comm_graph::Config::from_xml(co_locate));
+		event_buffer = co_locate.attribute_value("buffer", event_buffer);
 	}
 
 	if (verbose)
@@ -359,8 +374,63 @@ void Cpu::Balancer::handle_config()
 	if (use_report)
 		reporter->enabled(true);
 
-	if (timer_us != time_us)
+	placement_reporter.conditional(use_report, env, "placement", "placement",
+	                               placement_report_size);
+	if (use_report)
+		placement_reporter->enabled(true);
+
+	if (timer_us != time_us) {
+		timer_us = time_us;
 		timer.trigger_periodic(time_us);
+	}
+}
+
+void Cpu::Balancer::co_locate()
+{
+	graph.begin_period();
+
+	list.for_each([&](auto &session) {
+		session.observe_communication(*trace, graph, event_buffer); });
+
+	trace->sweep_events();
+
+	trace->for_each_event([&] (Subject_id const id, Trace::Event const &event) {
+		graph.event(id, event); });
+
+	/*
+	 * The execution times are reported in microseconds, on kernels that
+	 * report idle times the largest idle time is a better estimate.
+	 */
+	Affinity::Space const space = env.cpu().affinity_space();
+	uint64_t capacity = timer_us;
+	for (unsigned i = 0; i < space.total(); i++) {
+		Execution_time const idle = trace->read_max_idle(space.location_of_index(i));
+		capacity = max(capacity, max(idle.thread_context, idle.scheduling_context));
+	}
+
+	graph.place(space, capacity);
+
+	list.for_each([&](auto &session) {
+		session.apply_placement(graph); });
+
+	if (verbose)
+		graph.for_each_decision([&] (Comm_graph::Decision const &d) {
+			log("[", d.label, "] name='", d.name, "' ", d.reason_string(),
+			    " from ", d.from.xpos(), "x", d.from.ypos(),
+			    " to ", d.to.xpos(), "x", d.to.ypos(), " gain=", d.gain); });
+
+	if (!placement_reporter.constructed() || !graph.report_update())
+		return;
+
+	retry<Genode::Xml_generator::Buffer_exceeded>(env, [&] () {
+		Reporter::Xml_generator xml(*placement_reporter, [&] () {
+			graph.report(xml); });
+	}, [&] () {
+		placement_report_size += 4096;
+		placement_reporter.construct(env, "placement", "placement",
+		                             placement_report_size);
+		placement_reporter->enabled(true);
+	});
 }
 
 void Cpu::Balancer::handle_timeout()
@@ -380,6 +450,10 @@ void Cpu::Balancer::handle_timeout()
 		trace->read_idle_times();
 	}
 
+	/* place threads of the co-locate policy before applying all policies */
+	if (trace.constructed() && !trace->subject_id_reread())
+		co_locate();
+
 	/* update all sessions */
 	list.for_each([&](auto &session) {
 		if (trace.constructed()) {
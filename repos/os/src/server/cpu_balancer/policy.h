@@ -30,6 +30,7 @@ namespace Cpu
 	class Policy_pin;
 	class Policy_round_robin;
 	class Policy_max_utilize;
+	class Policy_co_locate;
 };
 
 class Cpu::Policy {
@@ -175,7 +176,7 @@ class Cpu::Policy_round_robin : public Cpu::Policy
 
 class Cpu::Policy_max_utilize : public Cpu::Policy
 {
-	private:
+	protected:
 
 		Execution_time _last { };
 		Execution_time _time { };
@@ -312,4 +313,61 @@ class Cpu::Policy_max_utilize : public Cpu::Policy
 			return "max-utilize"; }
 };
 
+/*
+ * The CPU of a thread is chosen by the 'Comm_graph' based on the
+ * communication with other threads, the policy merely applies the decision.
+ */
+class Cpu::Policy_co_locate : public Cpu::Policy_max_utilize
+{
+	private:
+
+		Location _target       { };
+		bool     _target_valid { false };
+
+	public:
+
+		/**
+		 * Execution time consumed during the last period
+		 */
+		Genode::uint64_t load() const
+		{
+			if (!_last_valid || !_time_valid)
+				return 0;
+
+			Execution_time const util = _last_utilization();
+
+			return (util.scheduling_context && !util.thread_context)
+			       ? util.scheduling_context : util.thread_context;
+		}
+
+		void target(Location const &to)
+		{
+			_target       = to;
+			_target_valid = true;
+		}
+
+		bool migrate(Location const &, Location &current, Trace *) override
+		{
+			if (!_target_valid)
+				return false;
+
+			_target_valid = false;
+
+			if ((_target.xpos() == current.xpos()) && (_target.ypos() == current.ypos()))
+				return false;
+
+			current = _target;
+			return true;
+		}
+
+		void print(Genode::Output &output) const override {
+			Genode::print(output, "co-locate"); }
+
+		bool same_type(Name const &name) const override {
+			return name == "co-locate"; }
+
+		char const * string() const override {
+			return "co-locate"; }
+};
+
 #endif
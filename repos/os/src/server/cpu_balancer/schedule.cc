@@ -13,6 +13,7 @@
 
 #include <cpu_thread/client.h>
 
+#include "comm_graph.h"
 #include "session.h"
 #include "trace.h"
 
@@ -106,3 +107,38 @@ void Cpu::Session::update_threads()
 		return false;
 	});
 }
+
+void Cpu::Session::observe_communication(Trace &trace, Comm_graph &graph,
+                                         size_t const buffer_size)
+{
+	Affinity::Location const &base = _affinity.location();
+
+	_for_each_thread([&](Thread_client &thread) {
+		if (!thread._cap.valid() || !thread._id.id ||
+		    thread._type != Thread_client::Policy_type::CO_LOCATE)
+			return false;
+
+		Policy_co_locate const &policy = thread._policy_co;
+
+		Affinity::Location const current { base.xpos() + policy.location.xpos(),
+		                                   base.ypos() + policy.location.ypos(), 1, 1 };
+
+		trace.trace_events(thread._id, buffer_size);
+		graph.node(thread._id, base, current, policy.load(), _label,
+		           thread._name);
+		return false;
+	});
+}
+
+void Cpu::Session::apply_placement(Comm_graph const &graph)
+{
+	_for_each_thread([&](Thread_client &thread) {
+		if (thread._type != Thread_client::Policy_type::CO_LOCATE)
+			return false;
+
+		graph.with_target(thread._id, [&] (Affinity::Location const &to) {
+			thread._policy_co.target(to); });
+
+		return false;
+	});
+}
@@ -34,6 +34,7 @@ namespace Cpu {
 	class Session;
 	class Trace;
 	class Policy;
+	class Comm_graph;
 	struct Thread_client;
 	typedef Id_space<Parent::Client>::Element    Client_id;
 	typedef Registry<Registered<Session> >       Child_list;
@@ -47,13 +48,14 @@ struct Cpu::Thread_client : Interface
 		Genode::Thread::Name   _name   { };
 		Subject_id             _id     { };
 
-		enum Policy_type { NONE, PIN, ROUND_ROBIN, MAX_UTIL };
+		enum Policy_type { NONE, PIN, ROUND_ROBIN, MAX_UTIL, CO_LOCATE };
 
 		Policy_type            _type { Policy_type::NONE };
 
 		Policy_pin             _policy_pin  { };
 		Policy_round_robin     _policy_rr   { };
 		Policy_max_utilize     _policy_max  { };
+		Policy_co_locate       _policy_co   { };
 		Policy_none            _policy_none { };
 
 		bool                   _fix    { false };
@@ -66,6 +68,8 @@ struct Cpu::Thread_client : Interface
 				return _policy_rr;
 			case Policy_type::MAX_UTIL:
 				return _policy_max;
+			case Policy_type::CO_LOCATE:
+				return _policy_co;
 			case Policy_type::NONE:
 				return _policy_none;
 			}
@@ -113,6 +117,8 @@ class Cpu::Session : public Rpc_object<Cpu_session>
 				thread._type = Thread_client::Policy_type::ROUND_ROBIN;
 			else if (name == "max-utilize")
 				thread._type = Thread_client::Policy_type::MAX_UTIL;
+			else if (name == "co-locate")
+				thread._type = Thread_client::Policy_type::CO_LOCATE;
 			else
 				thread._type = Thread_client::Policy_type::NONE;
 
@@ -353,6 +359,17 @@ class Cpu::Session : public Rpc_object<Cpu_session>
 
 		void update_threads();
 		void update_threads(Trace &, Session_label const &);
+
+		/**
+		 * Register threads with the co-locate policy at the graph and
+		 * record their RPC and signal events
+		 */
+		void observe_communication(Trace &, Comm_graph &, size_t buffer_size);
+
+		/**
+		 * Hand over the CPUs chosen by the graph to the co-locate policies
+		 */
+		void apply_placement(Comm_graph const &);
 		bool report_state(Xml_generator &);
 		void reset_report_state() { _report = false; }
 		bool report_update() const { return _report; }
@@ -1,5 +1,5 @@
 TARGET = cpu_balancer
-SRC_CC = component.cc session.cc config.cc trace.cc schedule.cc
+SRC_CC = component.cc session.cc config.cc trace.cc schedule.cc comm_graph.cc
 LIBS   = base
 
 CONFIG_XSD = config.xsd
@@ -12,6 +12,9 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
+#include <dataspace/client.h>
+#include <rom_session/connection.h>
+
 #include "trace.h"
 
 void Cpu::Trace::_read_idle_times(bool skip_max_idle)
@@ -132,3 +135,113 @@ Genode::Session_label Cpu::Trace::lookup_my_label()
 
 	return label;
 }
+
+
+bool Cpu::Trace::_install_event_policy()
+{
+	if (_event_policy_valid || _event_policy_failed)
+		return _event_policy_valid;
+
+	try {
+		Genode::Rom_connection rom(_env, "rpc_events");
+
+		Genode::Dataspace_capability const ds = rom.dataspace();
+		Genode::size_t const size = Genode::Dataspace_client(ds).size();
+
+		_event_policy      = _trace->alloc_policy(size);
+		_event_policy_size = size;
+
+		void *dst = _env.rm().attach(_trace->policy(_event_policy));
+		void *src = _env.rm().attach(ds);
+		Genode::memcpy(dst, src, size);
+		_env.rm().detach(dst);
+		_env.rm().detach(src);
+
+		_event_policy_valid = true;
+	} catch (Genode::Rom_connection::Rom_connection_failed) {
+		Genode::error("trace policy 'rpc_events' unavailable");
+		_event_policy_failed = true;
+	}
+	return _event_policy_valid;
+}
+
+
+void Cpu::Trace::_release(Event_source &source, bool free_subject)
+{
+	if (!source.used)
+		return;
+
+	if (source.buffer)
+		_env.rm().detach(source.buffer);
+
+	if (free_subject && _trace.constructed()) {
+		try { _trace->free(source.id); }
+		catch (Genode::Trace::Nonexistent_subject) { }
+	}
+
+	source = Event_source();
+}
+
+
+void Cpu::Trace::trace_events(Subject_id const id, Genode::size_t buffer_size)
+{
+	if (!_trace.constructed() || !id.id)
+		return;
+
+	Event_source *unused = nullptr;
+
+	for (Event_source &source : _sources) {
+		if (source.used && source.id == id) {
+			source.marked = true;
+			return;
+		}
+		if (!source.used && !unused)
+			unused = &source;
+	}
+
+	if (!unused) {
+		Genode::warning("too many threads for recording events");
+		return;
+	}
+
+	if (!_install_event_policy())
+		return;
+
+	/* remember failed attempts as source without buffer to not retry */
+	*unused = Event_source { .id = id, .buffer = nullptr,
+	                         .curr = Event_source::Buffer::Entry::invalid(),
+	                         .used = true, .marked = true, .quota = 0 };
+	try {
+		Genode::size_t const quota = buffer_size + _event_policy_size;
+
+		Genode::size_t used = 0;
+		for (Event_source const &source : _sources)
+			used += source.quota;
+
+		if (used + quota > _event_quota) {
+			_trace->upgrade_ram(used + quota - _event_quota);
+			_event_quota = used + quota;
+		}
+
+		_trace->trace(id, _event_policy, buffer_size);
+		unused->quota = quota;
+
+		unused->buffer = _env.rm().attach(_trace->buffer(id));
+	}
+	catch (Genode::Trace::Already_traced)          { }
+	catch (Genode::Trace::Source_is_dead)          { }
+	catch (Genode::Trace::Traced_by_other_session) {
+		Genode::warning("subject ", id.id, " is traced by other session"); }
+	catch (Genode::Trace::Nonexistent_subject)     { }
+}
+
+
+void Cpu::Trace::sweep_events()
+{
+	for (Event_source &source : _sources) {
+		if (source.used && !source.marked)
+			_release(source, true);
+
+		source.marked = false;
+	}
+}
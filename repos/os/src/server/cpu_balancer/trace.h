@@ -16,7 +16,9 @@
 #define _TRACE_H_
 
 #include <util/reconstructible.h>
+#include <base/trace/buffer.h>
 #include <trace_session/connection.h>
+#include <trace/rpc_latency_event.h>
 
 namespace Cpu {
 	class Trace;
@@ -34,6 +36,10 @@ namespace Cpu {
 
 class Cpu::Trace
 {
+	public:
+
+		typedef Genode::Trace::Rpc_latency_event Event;
+
 	private:
 
 		Genode::Env              &_env;
@@ -51,13 +57,58 @@ class Cpu::Trace
 
 		unsigned        _subject_id_reread { 0 };
 
+		/*
+		 * Trace buffers of threads, whose RPC and signal events are recorded
+		 * by the 'rpc_events' policy
+		 */
+		enum { MAX_EVENT_SOURCES = 64 };
+
+		struct Event_source
+		{
+			typedef Genode::Trace::Buffer Buffer;
+
+			Subject_id     id     { };
+			Buffer        *buffer { nullptr }; /* nullptr if tracing failed */
+			Buffer::Entry  curr   { Buffer::Entry::invalid() };
+			bool           used   { false };
+			bool           marked { false };
+
+			/* RAM accounted by core for the buffer and the policy */
+			Genode::size_t quota  { 0 };
+		};
+
+		Event_source              _sources[MAX_EVENT_SOURCES] { };
+		Genode::Trace::Policy_id  _event_policy { };
+		Genode::size_t            _event_policy_size   { 0 };
+		bool                      _event_policy_valid  { false };
+		bool                      _event_policy_failed { false };
+
+		/*
+		 * RAM donated to the current session for tracing event sources
+		 *
+		 * Core returns the RAM of a freed subject to the session. So the
+		 * quota is donated only if the sources in use need more than
+		 * donated so far. It is not part of '_ram_quota' because the
+		 * sources are traced anew after re-constructing the session.
+		 */
+		Genode::size_t _event_quota { 0 };
+
+		bool _install_event_policy();
+		void _release(Event_source &, bool free_subject);
+
 		void _reconstruct(Genode::size_t const upgrade = 4 * 4096)
 		{
 			_ram_quota += upgrade;
 			_arg_quota += upgrade;
 
+			/* buffers and policy vanish with the session */
+			for (Event_source &source : _sources)
+				_release(source, false);
+			_event_policy_valid = false;
+
 			_trace.destruct();
 			_trace.construct(_env, _ram_quota, _arg_quota, 0 /* parent levels */);
+			_event_quota = 0;
 
 			/*
 			 * Explicitly re-trigger import of subjects. Otherwise
@@ -138,6 +189,55 @@ class Cpu::Trace
 			}
 		}
 
+		/**
+		 * Record RPC and signal events of the given subject
+		 *
+		 * The events are recorded as long as the subject is marked by
+		 * calling this method before each 'sweep_events'.
+		 */
+		void trace_events(Subject_id, Genode::size_t buffer_size);
+
+		/**
+		 * Stop recording events of subjects not marked since last sweep
+		 */
+		void sweep_events();
+
+		/**
+		 * Call 'fn' with subject ID and event for each new recorded event
+		 */
+		template <typename FN>
+		void for_each_event(FN const &fn)
+		{
+			for (Event_source &source : _sources) {
+
+				if (!source.used || !source.buffer || !source.buffer->initialized())
+					continue;
+
+				Event_source::Buffer &buffer = *source.buffer;
+				Event_source::Buffer::Entry entry = source.curr;
+
+				/*
+				 * Entries overwritten by the traced thread since the last
+				 * call are skipped silently, the events serve as samples.
+				 */
+				for (; !entry.head(); entry = buffer.next(entry)) {
+
+					if (entry.last())
+						entry = buffer.first();
+
+					if (entry.empty() || entry.length() < sizeof(Event))
+						continue;
+
+					Event event { };
+					Genode::memcpy(&event, entry.data(), sizeof(Event));
+					event.name[Event::MAX_NAME_LEN - 1] = 0;
+
+					fn(source.id, event);
+				}
+				source.curr = entry;
+			}
+		}
+
 		Execution_time abs_idle_times(Affinity::Location const &location)
 		{
 			if (location.xpos() >= MAX_CORES || location.ypos() >= MAX_THREADS)
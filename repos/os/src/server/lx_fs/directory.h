@@ -48,6 +48,90 @@ class Lx_fs::Directory : public Node
 		Path       _path;
 		Allocator &_alloc;
 
+		/*
+		 * Snapshot of the directory entries
+		 *
+		 * Reading a single entry by index requires rewinding the directory
+		 * stream and a stat call per entry. To avoid the quadratic cost of
+		 * listing a directory this way, all entries are read and stat'ed in
+		 * one pass when the first entry is requested. Subsequent reads are
+		 * served from the snapshot.
+		 */
+		Directory_entry *_snapshot          = nullptr;
+		unsigned         _snapshot_count    = 0;
+		unsigned         _snapshot_capacity = 0;
+		bool             _snapshot_valid    = false;
+
+		static void _fill_entry(Directory_entry &e, int dir_fd, struct dirent const &dent)
+		{
+			struct stat st { };
+			fstatat(dir_fd, dent.d_name, &st, AT_SYMLINK_NOFOLLOW);
+
+			auto type = [] (unsigned char type)
+			{
+				switch (type) {
+				case DT_REG: return Node_type::CONTINUOUS_FILE;
+				case DT_DIR: return Node_type::DIRECTORY;
+				case DT_LNK: return Node_type::SYMLINK;
+				default:     return Node_type::CONTINUOUS_FILE;
+				}
+			};
+
+			e = {
+				.inode = (unsigned long)dent.d_ino,
+				.type  = type(dent.d_type),
+				.rwx   = { .readable   = (st.st_mode & S_IRUSR) != 0,
+				           .writeable  = (st.st_mode & S_IWUSR) != 0,
+				           .executable = (st.st_mode & S_IXUSR) != 0},
+				.name  = { dent.d_name }
+			};
+		}
+
+		void _free_snapshot()
+		{
+			if (_snapshot)
+				_alloc.free(_snapshot, _snapshot_capacity*sizeof(Directory_entry));
+
+			_snapshot          = nullptr;
+			_snapshot_count    = 0;
+			_snapshot_capacity = 0;
+			_snapshot_valid    = false;
+		}
+
+		void _take_snapshot()
+		{
+			_snapshot_count = 0;
+			_snapshot_valid = false;
+
+			int const dir_fd = dirfd(_fd);
+
+			rewinddir(_fd);
+			while (struct dirent const *dent = readdir(_fd)) {
+
+				if (_snapshot_count == _snapshot_capacity) {
+
+					unsigned const capacity = max(16u, 2*_snapshot_capacity);
+
+					Directory_entry *snapshot = nullptr;
+					try {
+						snapshot = (Directory_entry *)
+							_alloc.alloc(capacity*sizeof(Directory_entry));
+					}
+					catch (...) { return; }
+
+					if (_snapshot) {
+						Genode::memcpy(snapshot, _snapshot, _snapshot_count*sizeof(Directory_entry));
+						_alloc.free(_snapshot, _snapshot_capacity*sizeof(Directory_entry));
+					}
+					_snapshot          = snapshot;
+					_snapshot_capacity = capacity;
+				}
+
+				_fill_entry(_snapshot[_snapshot_count++], dir_fd, *dent);
+			}
+			_snapshot_valid = true;
+		}
+
 		uint64_t _inode(char const *path, bool create)
 		{
 			int ret;
@@ -109,6 +193,7 @@ class Lx_fs::Directory : public Node
 
 		virtual ~Directory()
 		{
+			_free_snapshot();
 			closedir(_fd);
 		}
 
@@ -193,8 +278,22 @@ class Lx_fs::Directory : public Node
 
 			seek_off_t index = seek_offset / sizeof(Directory_entry);
 
-			/* seek to index and read entry */
-			struct dirent *dent;
+			Directory_entry &e = *(Directory_entry *)(dst);
+
+			/* a listing starts with the first entry */
+			if (index == 0 || !_snapshot_valid)
+				_take_snapshot();
+
+			if (_snapshot_valid) {
+				if (index >= _snapshot_count)
+					return 0;
+
+				e = _snapshot[index];
+				return sizeof(Directory_entry);
+			}
+
+			/* fall back to seek to index and read entry */
+			struct dirent *dent = nullptr;
 			rewinddir(_fd);
 			for (unsigned i = 0; i <= index; ++i) {
 				dent = readdir(_fd);
@@ -203,30 +302,7 @@ class Lx_fs::Directory : public Node
 			if (!dent)
 				return 0;
 
-			Path dent_path(dent->d_name, _path.base());
-
-			struct stat st { };
-			lstat(dent_path.base(), &st);
-
-			auto type = [] (unsigned char type)
-			{
-				switch (type) {
-				case DT_REG: return Node_type::CONTINUOUS_FILE;
-				case DT_DIR: return Node_type::DIRECTORY;
-				case DT_LNK: return Node_type::SYMLINK;
-				default:     return Node_type::CONTINUOUS_FILE;
-				}
-			};
-
-			Directory_entry &e = *(Directory_entry *)(dst);
-			e = {
-				.inode = (unsigned long)dent->d_ino,
-				.type  = type(dent->d_type),
-				.rwx   = { .readable   = (st.st_mode & S_IRUSR) != 0,
-				           .writeable  = (st.st_mode & S_IWUSR) != 0,
-				           .executable = (st.st_mode & S_IXUSR) != 0},
-				.name  = { dent->d_name }
-			};
+			_fill_entry(e, dirfd(_fd), *dent);
 
 			return sizeof(Directory_entry);
 		}
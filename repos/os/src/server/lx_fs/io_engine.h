@@ -0,0 +1,292 @@
+/*
+ * \brief  Asynchronous execution of file I/O
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * Read, write, and sync operations on files are executed by a pool of worker
+ * threads so that a slow host operation does not stall the processing of
+ * other packets and sessions. All jobs that refer to the same open node of a
+ * session are executed by the same worker, which preserves their order. Jobs
+ * of different nodes may complete out of order.
+ *
+ * Jobs are never waited for by the entrypoint. A node closed with jobs
+ * pending is destroyed along with its last job, and a session closed with
+ * jobs in flight is destroyed once the jobs are completed.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _IO_ENGINE_H_
+#define _IO_ENGINE_H_
+
+/* Genode includes */
+#include <base/mutex.h>
+#include <base/semaphore.h>
+#include <base/signal.h>
+#include <base/thread.h>
+#include <file_system_session/file_system_session.h>
+#include <util/fifo.h>
+
+/* local includes */
+#include "node.h"
+
+
+namespace Lx_fs {
+
+	using namespace Genode;
+
+	class Io_job;
+	class Io_engine;
+}
+
+
+class Lx_fs::Io_job : public Fifo<Io_job>::Element
+{
+	public:
+
+		/**
+		 * Session-local bookkeeping of jobs
+		 *
+		 * Completed jobs are handed back to the entrypoint via the owner's
+		 * signal handler.
+		 */
+		class Owner : Noncopyable
+		{
+			private:
+
+				friend class Io_job;
+
+				Signal_context_capability const _sigh;
+
+				Mutex        _mutex     { };
+				Fifo<Io_job> _completed { };
+				unsigned     _in_flight = 0;
+
+				void _complete(Io_job &job)
+				{
+					Signal_context_capability sigh { };
+					{
+						Mutex::Guard guard(_mutex);
+
+						sigh = _sigh;
+						_completed.enqueue(job);
+						_in_flight--;
+					}
+
+					/*
+					 * Once '_in_flight' dropped to zero, the owner may vanish
+					 * at any time. Hence, it must not be accessed anymore.
+					 */
+					Signal_transmitter(sigh).submit();
+				}
+
+			public:
+
+				Owner(Signal_context_capability sigh) : _sigh(sigh) { }
+
+				void submitted()
+				{
+					Mutex::Guard guard(_mutex);
+					_in_flight++;
+				}
+
+				/**
+				 * Return true if submitted jobs are not completed yet
+				 */
+				bool in_flight()
+				{
+					Mutex::Guard guard(_mutex);
+					return _in_flight > 0;
+				}
+
+				/**
+				 * Call 'fn' with the oldest completed job
+				 *
+				 * \return  false if no job was completed
+				 */
+				template <typename FN>
+				bool with_completed(FN const &fn)
+				{
+					Io_job *job = nullptr;
+					{
+						Mutex::Guard guard(_mutex);
+						_completed.dequeue([&] (Io_job &j) { job = &j; });
+					}
+					if (!job)
+						return false;
+
+					fn(*job);
+					return true;
+				}
+		};
+
+		Owner                            &owner;
+		File_system::Packet_descriptor    packet;
+
+	private:
+
+		Node &_node;
+		char *_content;
+
+		size_t _result    = 0;
+		bool   _succeeded = false;
+
+	public:
+
+		Io_job(Owner &owner, File_system::Packet_descriptor packet,
+		       Node &node, char *content)
+		:
+			owner(owner), packet(packet), _node(node), _content(content)
+		{ }
+
+		Node  &node()            { return _node; }
+		size_t result()    const { return _result; }
+		bool   succeeded() const { return _succeeded; }
+
+		/**
+		 * Execute job, called by a worker thread
+		 */
+		void execute()
+		{
+			using Packet_descriptor = File_system::Packet_descriptor;
+
+			size_t const length = packet.length();
+
+			switch (packet.operation()) {
+
+			case Packet_descriptor::READ:
+				_result = _node.read(_content, length, packet.position());
+
+				/* read data or EOF is a success */
+				_succeeded = _result || (packet.position() >= _node.status().size);
+				break;
+
+			case Packet_descriptor::WRITE:
+				_result    = _node.write(_content, length, packet.position());
+				_succeeded = (_result == length);
+				break;
+
+			case Packet_descriptor::SYNC:
+				_succeeded = _node.sync();
+				break;
+
+			case Packet_descriptor::WRITE_TIMESTAMP:
+				packet.with_timestamp([&] (File_system::Timestamp const time) {
+					_node.update_modification_time(time);
+					_succeeded = true;
+				});
+				break;
+
+			/*
+			 * A content-changed job merely marks the point after all prior
+			 * jobs of the node. The notification is handled by the entrypoint.
+			 */
+			case Packet_descriptor::CONTENT_CHANGED:
+				_succeeded = true;
+				break;
+
+			default:
+				break;
+			}
+
+			owner._complete(*this);
+		}
+};
+
+
+class Lx_fs::Io_engine : Noncopyable
+{
+	private:
+
+		enum { STACK_SIZE = 16*1024 };
+
+		/*
+		 * Noncopyable
+		 */
+		Io_engine(Io_engine const &);
+		Io_engine &operator = (Io_engine const &);
+
+		class Worker : public Thread
+		{
+			private:
+
+				Mutex        _mutex { };
+				Fifo<Io_job> _queue { };
+				Semaphore    _avail { };
+
+				void entry() override
+				{
+					for (;;) {
+						_avail.down();
+
+						Io_job *job = nullptr;
+						{
+							Mutex::Guard guard(_mutex);
+							_queue.dequeue([&] (Io_job &j) { job = &j; });
+						}
+						if (job)
+							job->execute();
+					}
+				}
+
+			public:
+
+				Worker(Env &env, unsigned index)
+				:
+					Thread(env, Thread::Name("io_worker_", index), STACK_SIZE)
+				{ }
+
+				void submit(Io_job &job)
+				{
+					{
+						Mutex::Guard guard(_mutex);
+						_queue.enqueue(job);
+					}
+					_avail.up();
+				}
+		};
+
+		Allocator &_alloc;
+
+		unsigned const _num_workers;
+
+		Worker **_workers;
+
+	public:
+
+		Io_engine(Env &env, Allocator &alloc, unsigned num_workers)
+		:
+			_alloc(alloc), _num_workers(num_workers),
+			_workers(num_workers ? new (alloc) Worker*[num_workers] : nullptr)
+		{
+			for (unsigned i = 0; i < _num_workers; i++) {
+				_workers[i] = new (_alloc) Worker(env, i);
+				_workers[i]->start();
+			}
+		}
+
+		/*
+		 * The worker threads live as long as the component.
+		 */
+
+		bool enabled() const { return _num_workers > 0; }
+
+		/**
+		 * Hand job to the worker responsible for the job's open node
+		 */
+		void submit(Io_job &job)
+		{
+			addr_t const key = ((addr_t)&job.owner >> 4)
+			                 + (addr_t)job.packet.handle().value;
+
+			job.owner.submitted();
+			_workers[key % _num_workers]->submit(job);
+		}
+};
+
+#endif /* _IO_ENGINE_H_ */
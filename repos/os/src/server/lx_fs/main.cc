@@ -28,6 +28,7 @@
 
 /* local includes */
 #include "directory.h"
+#include "io_engine.h"
 #include "notifier.h"
 #include "open_node.h"
 #include "watch.h"
@@ -101,6 +102,146 @@ class Lx_fs::Session_component : private Session_resources,
 		Absolute_path const          _root_dir;
 		Signal_handler               _process_packet_dispatcher;
 		Notifier                    &_notifier;
+		Io_engine                   &_io_engine;
+		Signal_handler               _io_completion_handler;
+		Io_job::Owner                _io_jobs { _io_completion_handler };
+
+		Genode::List_element<Session_component> _closed_elem { this };
+
+		/* handler informed once the closed session has no I/O in flight */
+		Genode::Signal_context_capability _idle_sigh { };
+
+		bool _closed() const { return _idle_sigh.valid(); }
+
+		/**
+		 * Hand file operation over to the I/O engine
+		 *
+		 * \return true if the packet is processed asynchronously
+		 */
+		bool _submit_io_job(Packet_descriptor &packet, Open_node &open_node)
+		{
+			if (!_io_engine.enabled() || open_node.node().type_directory())
+				return false;
+
+			/* content-changed packets carry no payload */
+			bool const payload = (packet.operation() != Packet_descriptor::CONTENT_CHANGED);
+
+			if (payload && (!tx_sink()->packet_valid(packet) || (packet.length() > packet.size())))
+				return false;
+
+			try {
+				Io_job &job = *new (_alloc)
+					Io_job(_io_jobs, packet, open_node.node(),
+					       payload ? (char *)tx_sink()->packet_content(packet) : nullptr);
+
+				open_node.node().io_job_submitted();
+				_io_engine.submit(job);
+				return true;
+			}
+			catch (Out_of_ram)  { }
+			catch (Out_of_caps) { }
+
+			/* fall back to synchronous processing */
+			return false;
+		}
+
+		/**
+		 * Destroy completed I/O job along with its node if released meanwhile
+		 */
+		void _destroy_io_job(Io_job &job)
+		{
+			Node &node = job.node();
+
+			destroy(_alloc, &job);
+
+			if (node.io_job_completed())
+				destroy(_alloc, &node);
+		}
+
+		/**
+		 * Register client for notifications about changes of the node
+		 */
+		void _content_changed(Open_node &open_node)
+		{
+			open_node.register_notify(*tx_sink());
+			/* notify_listeners may bounce the packet back*/
+			open_node.node().notify_listeners();
+			/* otherwise defer acknowledgement of this packet */
+		}
+
+		/**
+		 * Handle content-changed packet queued behind the I/O jobs of the node
+		 */
+		void _content_changed(Io_job &job)
+		{
+			Packet_descriptor packet = job.packet;
+
+			bool registered = false;
+			try {
+				_open_node_registry.apply<Open_node>(packet.handle(),
+				                                     [&] (Open_node &open_node) {
+					/* the handle may have been reused for another node */
+					if (&open_node.node() != &job.node())
+						return;
+
+					_content_changed(open_node);
+					registered = true;
+				});
+			} catch (Id_space<File_system::Node>::Unknown_id const &) { }
+
+			/* node was closed meanwhile */
+			if (!registered)
+				tx_sink()->acknowledge_packet(packet);
+		}
+
+		/**
+		 * Acknowledge packets of completed I/O jobs
+		 */
+		void _acknowledge_io_jobs()
+		{
+			while (tx_sink()->ready_to_ack()) {
+
+				bool const completed = _io_jobs.with_completed([&] (Io_job &job) {
+
+					Packet_descriptor packet = job.packet;
+
+					if (packet.operation() == Packet_descriptor::CONTENT_CHANGED) {
+						_content_changed(job);
+						_destroy_io_job(job);
+						return;
+					}
+
+					bool const ack = (packet.operation() != Packet_descriptor::WRITE)
+					              || job.succeeded();
+
+					packet.length(job.result());
+					packet.succeeded(job.succeeded());
+					_destroy_io_job(job);
+
+					/* File system session can't handle partial writes */
+					if (ack)
+						tx_sink()->acknowledge_packet(packet);
+				});
+
+				if (!completed)
+					break;
+			}
+		}
+
+		void _handle_io_completion()
+		{
+			if (_closed()) {
+				while (_io_jobs.with_completed([&] (Io_job &job) {
+					_destroy_io_job(job); }));
+
+				if (!_io_jobs.in_flight())
+					Genode::Signal_transmitter(_idle_sigh).submit();
+				return;
+			}
+
+			_acknowledge_io_jobs();
+			_process_packets();
+		}
 
 		/******************************
 		 ** Packet-stream processing **
@@ -122,6 +263,9 @@ class Lx_fs::Session_component : private Session_resources,
 			switch (packet.operation()) {
 
 			case Packet_descriptor::READ:
+				if (_submit_io_job(packet, open_node))
+					return;
+
 				if (tx_sink()->packet_valid(packet) && (packet.length() <= packet.size())) {
 					res_length = open_node.node().read((char *)tx_sink()->packet_content(packet), length,
 					                                   packet.position());
@@ -132,6 +276,9 @@ class Lx_fs::Session_component : private Session_resources,
 				break;
 
 			case Packet_descriptor::WRITE:
+				if (_submit_io_job(packet, open_node))
+					return;
+
 				if (tx_sink()->packet_valid(packet) && (packet.length() <= packet.size())) {
 					res_length = open_node.node().write((char const *)tx_sink()->packet_content(packet),
 					                                    length,
@@ -147,6 +294,11 @@ class Lx_fs::Session_component : private Session_resources,
 				break;
 
 			case Packet_descriptor::WRITE_TIMESTAMP:
+
+				/* apply timestamp after pending writes of the node */
+				if (open_node.node().io_jobs_pending() && _submit_io_job(packet, open_node))
+					return;
+
 				if (tx_sink()->packet_valid(packet) && (packet.length() <= packet.size())) {
 
 					packet.with_timestamp([&] (File_system::Timestamp const time) {
@@ -157,10 +309,12 @@ class Lx_fs::Session_component : private Session_resources,
 				break;
 
 			case Packet_descriptor::CONTENT_CHANGED:
-				open_node.register_notify(*tx_sink());
-				/* notify_listeners may bounce the packet back*/
-				open_node.node().notify_listeners();
-				/* otherwise defer acknowledgement of this packet */
+
+				/* notify listeners after pending writes of the node */
+				if (open_node.node().io_jobs_pending() && _submit_io_job(packet, open_node))
+					return;
+
+				_content_changed(open_node);
 				return;
 
 			case Packet_descriptor::READ_READY:
@@ -170,6 +324,9 @@ class Lx_fs::Session_component : private Session_resources,
 
 			case Packet_descriptor::SYNC:
 
+				if (_submit_io_job(packet, open_node))
+					return;
+
 				if (tx_sink()->packet_valid(packet)) {
 					succeeded = open_node.node().sync();
 				}
@@ -207,6 +364,11 @@ class Lx_fs::Session_component : private Session_resources,
 		 */
 		void _process_packets()
 		{
+			if (_closed())
+				return;
+
+			_acknowledge_io_jobs();
+
 			while (tx_sink()->packet_avail()) {
 
 				/*
@@ -297,7 +459,8 @@ class Lx_fs::Session_component : private Session_resources,
 		                  size_t               tx_buf_size,
 		                  char const          *root_dir,
 		                  bool                 writeable,
-		                  Notifier            &notifier)
+		                  Notifier            &notifier,
+		                  Io_engine           &io_engine)
 		:
 			Session_resources { env.pd(), env.rm(), ram_quota, cap_quota, tx_buf_size },
 			Session_rpc_object {_packet_ds.cap(), env.rm(), env.ep().rpc_ep() },
@@ -306,7 +469,9 @@ class Lx_fs::Session_component : private Session_resources,
 			_writeable { writeable },
 			_root_dir { root_dir },
 			_process_packet_dispatcher { env.ep(), *this, &Session_component::_process_packets },
-			_notifier { notifier }
+			_notifier { notifier },
+			_io_engine { io_engine },
+			_io_completion_handler { env.ep(), *this, &Session_component::_handle_io_completion }
 		{
 			/*
 			 * Register '_process_packets' dispatch function as signal
@@ -321,6 +486,13 @@ class Lx_fs::Session_component : private Session_resources,
 		 */
 		~Session_component()
 		{
+			/*
+			 * The root destroys the session not before all I/O jobs are
+			 * completed. Destroying the jobs releases the closed nodes.
+			 */
+			while (_io_jobs.with_completed([&] (Io_job &job) {
+				_destroy_io_job(job); }));
+
 			List<List_element<Open_node>> node_list;
 
 			auto collect_fn = [&node_list, this] (Open_node &open_node) {
@@ -353,6 +525,21 @@ class Lx_fs::Session_component : private Session_resources,
 		void upgrade(Genode::Ram_quota ram)  { _ram_guard.upgrade(ram); }
 		void upgrade(Genode::Cap_quota caps) { _cap_guard.upgrade(caps); }
 
+		bool io_jobs_in_flight() { return _io_jobs.in_flight(); }
+
+		/**
+		 * Stop serving the session and defer its destruction
+		 *
+		 * \param idle_sigh  handler informed once no I/O job of the session
+		 *                   is in flight anymore
+		 */
+		void close_when_idle(Genode::Signal_context_capability idle_sigh)
+		{
+			_idle_sigh = idle_sigh;
+		}
+
+		Genode::List_element<Session_component> &closed_elem() { return _closed_elem; }
+
 
 		/***************************
 		 ** File_system interface **
@@ -449,7 +636,12 @@ class Lx_fs::Session_component : private Session_resources,
 			_with_open_node(handle, [&] (Open_node &open_node) {
 				Node &node = open_node.node();
 				destroy(_alloc, &open_node);
-				destroy(_alloc, &node);
+
+				/* I/O jobs may still operate on the node */
+				if (node.io_jobs_pending())
+					node.release();
+				else
+					destroy(_alloc, &node);
 			});
 		}
 
@@ -546,6 +738,29 @@ class Lx_fs::Root : public Root_component<Session_component>
 		Genode::Env                    &_env;
 		Genode::Attached_rom_dataspace  _config   { _env, "config" };
 		Notifier                        _notifier { _env };
+		Genode::Heap                    _heap     { _env.ram(), _env.rm() };
+		Io_engine                       _io_engine {
+			_env, _heap, _config.xml().attribute_value("io_workers", 4u) };
+
+		/* sessions closed while I/O jobs were in flight */
+		Genode::List<Genode::List_element<Session_component>> _closed_sessions { };
+
+		Genode::Signal_handler<Root> _idle_session_handler {
+			_env.ep(), *this, &Root::_destroy_idle_sessions };
+
+		void _destroy_idle_sessions()
+		{
+			for (auto *e = _closed_sessions.first(); e; ) {
+
+				auto * const next = e->next();
+
+				if (!e->object()->io_jobs_in_flight()) {
+					_closed_sessions.remove(e);
+					Genode::destroy(md_alloc(), e->object());
+				}
+				e = next;
+			}
+		}
 
 		static inline bool writeable_from_args(char const *args)
 		{
@@ -628,7 +843,7 @@ class Lx_fs::Root : public Root_component<Session_component>
 				                           Genode::Cap_quota { cap_quota },
 				                           tx_buf_size,
 				                           absolute_root_dir(root_dir).string(),
-				                           writeable, _notifier };
+				                           writeable, _notifier, _io_engine };
 
 				auto ram_used { _env.pd().used_ram().value - initial_ram_usage };
 				auto cap_used { _env.pd().used_caps().value - initial_cap_usage };
@@ -655,6 +870,13 @@ class Lx_fs::Root : public Root_component<Session_component>
 
 		void _destroy_session(Session_component *session) override
 		{
+			/* workers may still operate on the session's nodes and buffer */
+			if (session->io_jobs_in_flight()) {
+				session->close_when_idle(_idle_session_handler);
+				_closed_sessions.insert(&session->closed_elem());
+				return;
+			}
+
 			Genode::destroy(md_alloc(), session);
 		}
 
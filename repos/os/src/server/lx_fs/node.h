@@ -50,6 +50,12 @@ class Lx_fs::Node : public File_system::Node_base
 
 		uint64_t const _inode;
 
+		/*
+		 * I/O jobs referring to the node, accounted by the entrypoint
+		 */
+		unsigned _io_jobs  = 0;
+		bool     _released = false;
+
 	public:
 
 		Node(uint64_t inode) : _inode { inode }
@@ -62,6 +68,26 @@ class Lx_fs::Node : public File_system::Node_base
 
 		virtual bool type_directory() const { return false; }
 
+		void io_job_submitted()       { _io_jobs++; }
+		bool io_jobs_pending()  const { return _io_jobs > 0; }
+
+		/**
+		 * Account completion of an I/O job
+		 *
+		 * \return  true if the node was released while the job was pending
+		 *          and can be destroyed now
+		 */
+		bool io_job_completed()
+		{
+			_io_jobs--;
+			return _released && !_io_jobs;
+		}
+
+		/**
+		 * Mark node as released, to be destroyed with its last I/O job
+		 */
+		void release() { _released = true; }
+
 		/**
 		 * Assign name
 		 */
@@ -18,6 +18,7 @@
 #include <net/arp.h>
 #include <net/internet_checksum.h>
 #include <base/quota_guard.h>
+#include <trace/probe.h>
 
 /* local includes */
 #include <interface.h>
@@ -1574,6 +1575,8 @@ void Interface::_handle_arp(Ethernet_frame &eth,
 
 void Interface::_handle_pkt()
 {
+	GENODE_TRACE_COUNTER("nic_router_rx_packets", 1);
+
 	Packet_descriptor const pkt = _sink.get_packet();
 	Size_guard size_guard(pkt.size());
 	try {
@@ -1587,6 +1590,8 @@ void Interface::_handle_pkt()
 
 void Interface::_handle_pkt_stream_signal()
 {
+	GENODE_TRACE_DURATION_NAMED(0, "nic_router_pkt_stream_signal");
+
 	_timer.update_cached_time();
 
 	/*
@@ -1829,6 +1834,8 @@ void Interface::_handle_eth(void              *const  eth_base,
 				}
 			}
 			catch (Drop_packet exception) {
+				GENODE_TRACE_COUNTER("nic_router_dropped_packets", 1);
+
 				if (local_domain.verbose_packet_drop()) {
 					log("[", local_domain, "] drop packet (",
 					    exception.reason, ")");
@@ -33,6 +33,8 @@ class Net::Main
 {
 	private:
 
+		enum { SIGNAL_BATCH_LIMIT = 32 };
+
 		Genode::Env                    &_env;
 		Quota                           _shared_quota        { };
 		Interface_list                  _interfaces          { };
@@ -78,6 +80,9 @@ void Main::_handle_report()
 
 Net::Main::Main(Env &env) : _env(env)
 {
+	/* handle the packet-stream signals of all interfaces per wakeup */
+	env.ep().signal_batch_limit(SIGNAL_BATCH_LIMIT);
+
 	_config_rom.sigh(_config_handler);
 	_handle_config();
 	env.parent().announce(env.ep().manage(_nic_session_root));
@@ -18,6 +18,9 @@
 #include <base/session_object.h>
 #include <capture_session/capture_session.h>
 
+/* local includes */
+#include "compositor.h"
+
 namespace Nitpicker { class Capture_session; }
 
 
@@ -44,6 +47,8 @@ class Nitpicker::Capture_session : public Session_object<Capture::Session>
 
 		View_stack const &_view_stack;
 
+		Compositor &_compositor;
+
 		Area _buffer_size { };
 
 		Constructible<Attached_ram_dataspace> _buffer { };
@@ -54,6 +59,149 @@ class Nitpicker::Capture_session : public Session_object<Capture::Session>
 
 		Dirty_rect _dirty_rect { };
 
+		/*
+		 * Change detection per tile
+		 */
+		Tiling _tiling { };
+
+		enum { MIN_TILE_SIZE = 8 };
+
+		struct Tile_state
+		{
+			uint64_t hash;
+			uint64_t frame;   /* frame of the last check, 0 if never checked */
+		};
+
+		Constructible<Attached_ram_dataspace> _tile_states { };
+		Constructible<Attached_ram_dataspace> _tile_stream { };
+
+		uint64_t _frame = 0;
+
+		void _disable_tiling()
+		{
+			_tiling = Tiling { };
+			_tile_states.destruct();
+			_tile_stream.destruct();
+		}
+
+		/**
+		 * Call 'fn' for each tile intersecting 'rect' with the tile index
+		 * and the tile rectangle clipped to the buffer
+		 */
+		template <typename FN>
+		void _for_each_tile(Rect const rect, FN const &fn) const
+		{
+			unsigned const size    = _tiling.tile_size;
+			unsigned const columns = _tiling.columns(_buffer_size);
+
+			Rect const buffer_rect(Point(0, 0), _buffer_size);
+
+			for (int y = rect.y1()/(int)size; y <= rect.y2()/(int)size; y++)
+				for (int x = rect.x1()/(int)size; x <= rect.x2()/(int)size; x++)
+					fn(y*columns + x,
+					   Rect::intersect(buffer_rect,
+					                   Rect(Point(x*size, y*size), Area(size, size))));
+		}
+
+		uint64_t _hash(Rect const tile)
+		{
+			Pixel_rgb888 const *base = _buffer->local_addr<Pixel_rgb888>();
+
+			/* FNV-1a over the pixel values */
+			uint64_t h = 0xcbf29ce484222325ULL;
+			for (int y = tile.y1(); y <= tile.y2(); y++) {
+				Pixel_rgb888 const *src = base + (long)y*_buffer_size.w() + tile.x1();
+				for (unsigned i = 0; i < tile.w(); i++)
+					h = (h ^ src[i].pixel)*0x100000001b3ULL;
+			}
+			return h;
+		}
+
+		/**
+		 * Report tiles of the drawn area with changed content
+		 *
+		 * \return  rectangles covering the changed tiles
+		 */
+		Affected_rects _detect_changed_tiles(Affected_rects const &drawn)
+		{
+			using Stream = Capture::Tile_stream;
+
+			_frame++;
+
+			Tile_state * const states   = _tile_states->local_addr<Tile_state>();
+			char       * const stream   = _tile_stream->local_addr<char>();
+			size_t       const capacity = tile_stream_bytes(_buffer_size, _tiling);
+
+			unsigned const num_tiles = _tiling.columns(_buffer_size)
+			                         * _tiling.rows(_buffer_size);
+
+			Stream::Header &header = *(Stream::Header *)stream;
+			header = Stream::Header { .num_tiles = 0,
+			                          .bytes     = sizeof(Stream::Header) };
+
+			Dirty_rect changed { };
+
+			auto append = [&] (Rect const tile)
+			{
+				size_t   const offset = header.bytes;
+				unsigned const index  = header.num_tiles;
+
+				/* space kept for the records of the remaining tiles */
+				size_t const reserved = (num_tiles - index - 1)*sizeof(Stream::Tile);
+
+				char * const content = stream + offset + sizeof(Stream::Tile);
+
+				size_t const encoded_bytes = !_tiling.encode ? 0 :
+					Stream::encode_rle(_buffer->local_addr<Pixel_rgb888>()
+					                   + (long)tile.y1()*_buffer_size.w() + tile.x1(),
+					                   _buffer_size.w(), tile.area(), content,
+					                   capacity - offset - sizeof(Stream::Tile) - reserved);
+
+				*(Stream::Tile *)(stream + offset) = Stream::Tile {
+					.x        = (uint32_t)tile.x1(),
+					.y        = (uint32_t)tile.y1(),
+					.w        = tile.w(),
+					.h        = tile.h(),
+					.encoding = encoded_bytes ? Stream::RLE : Stream::RAW,
+					.bytes    = (uint32_t)encoded_bytes };
+
+				header.num_tiles++;
+				header.bytes += (uint32_t)(sizeof(Stream::Tile) + encoded_bytes);
+			};
+
+			drawn.for_each_rect([&] (Rect const rect) {
+				_for_each_tile(rect, [&] (unsigned index, Rect const tile) {
+
+					Tile_state &state = states[index];
+
+					/* tile intersects multiple drawn rectangles */
+					if (state.frame == _frame)
+						return;
+
+					bool     const known = (state.frame != 0);
+					uint64_t const hash  = _hash(tile);
+
+					state.frame = _frame;
+
+					if (known && state.hash == hash)
+						return;
+
+					state.hash = hash;
+
+					changed.mark_as_dirty(tile);
+					append(tile);
+				});
+			});
+
+			Affected_rects affected { };
+			unsigned i = 0;
+			changed.flush([&] (Rect const &rect) {
+				if (i < Affected_rects::NUM_RECTS)
+					affected.rects[i++] = rect; });
+
+			return affected;
+		}
+
 	public:
 
 		Capture_session(Env              &env,
@@ -61,13 +209,15 @@ class Nitpicker::Capture_session : public Session_object<Capture::Session>
 		                Label      const &label,
 		                Diag       const &diag,
 		                Handler          &handler,
-		                View_stack const &view_stack)
+		                View_stack const &view_stack,
+		                Compositor       &compositor)
 		:
 			Session_object(env.ep(), resources, label, diag),
 			_env(env),
 			_ram(env.ram(), _ram_quota_guard(), _cap_quota_guard()),
 			_handler(handler),
-			_view_stack(view_stack)
+			_view_stack(view_stack),
+			_compositor(compositor)
 		{
 			_dirty_rect.mark_as_dirty(Rect(Point(0, 0), view_stack.size()));
 		}
@@ -107,6 +257,8 @@ class Nitpicker::Capture_session : public Session_object<Capture::Session>
 
 		void buffer(Area size) override
 		{
+			_disable_tiling();
+
 			_buffer_size = Area { };
 
 			if (size.count() == 0) {
@@ -139,7 +291,8 @@ class Nitpicker::Capture_session : public Session_object<Capture::Session>
 
 			using Pixel = Pixel_rgb888;
 
-			Canvas<Pixel> canvas = { _buffer->local_addr<Pixel>(), pos, _buffer_size };
+			Draw_job<Pixel> const job { _view_stack, _buffer->local_addr<Pixel>(),
+			                            pos, _buffer_size };
 
 			Rect const buffer_rect(Point(0, 0), _buffer_size);
 
@@ -147,7 +300,7 @@ class Nitpicker::Capture_session : public Session_object<Capture::Session>
 			unsigned i = 0;
 			_dirty_rect.flush([&] (Rect const &rect) {
 
-				_view_stack.draw(canvas, rect);
+				_compositor.add(rect);
 
 				if (i < Affected_rects::NUM_RECTS) {
 					Rect const translated(rect.p1() - pos, rect.area());
@@ -156,8 +309,49 @@ class Nitpicker::Capture_session : public Session_object<Capture::Session>
 				}
 			});
 
+			/* the affected rectangles are valid once all tiles are drawn */
+			_compositor.draw(_view_stack.font(), job);
+
+			if (_tiling.enabled())
+				return _detect_changed_tiles(affected);
+
 			return affected;
 		}
+
+		void tiling(Tiling tiling) override
+		{
+			_disable_tiling();
+
+			if (!tiling.enabled() || !_buffer.constructed())
+				return;
+
+			/*
+			 * Limit the tile size provided by the client. Tiles larger than
+			 * the buffer do not reduce the number of tiles any further.
+			 */
+			tiling.tile_size = min(max(tiling.tile_size, (unsigned)MIN_TILE_SIZE),
+			                       max(_buffer_size.w(), _buffer_size.h()));
+
+			size_t const num_tiles = (size_t)tiling.columns(_buffer_size)
+			                       * tiling.rows(_buffer_size);
+
+			if (num_tiles == 0)
+				return;
+
+			_tile_states.construct(_ram, _env.rm(), num_tiles*sizeof(Tile_state));
+			_tile_stream.construct(_ram, _env.rm(), tile_stream_bytes(_buffer_size, tiling));
+
+			/* zero-initialized tile states mark all tiles as unknown */
+			_tiling = tiling;
+		}
+
+		Dataspace_capability tile_stream() override
+		{
+			if (_tile_stream.constructed())
+				return _tile_stream->cap();
+
+			return Dataspace_capability();
+		}
 };
 
 #endif /* _CAPTURE_SESSION_H_ */
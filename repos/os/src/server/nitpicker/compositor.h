@@ -0,0 +1,459 @@
+/*
+ * \brief  Tile-parallel drawing of dirty screen areas
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The dirty rectangles of a frame are split into tiles, which are drawn
+ * by the entrypoint and a pool of worker threads. The view stack is not
+ * modified while drawing because the entrypoint waits for the completion
+ * of all tiles before handling the next request. Since the glyph buffer of
+ * a font is mutable, each worker uses a font instance of its own.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _COMPOSITOR_H_
+#define _COMPOSITOR_H_
+
+/* Genode includes */
+#include <base/blockade.h>
+#include <base/mutex.h>
+#include <base/thread.h>
+#include <nitpicker_gfx/tff_font.h>
+#include <timer_session/connection.h>
+
+/* local includes */
+#include "view_stack.h"
+
+namespace Nitpicker {
+	class Compositor;
+	template <typename> struct Draw_job;
+}
+
+
+class Nitpicker::Compositor
+{
+	public:
+
+		enum { MAX_WORKERS = 16, MAX_RECTS = 8 };
+
+		struct Config
+		{
+			unsigned workers;      /* number of threads besides the entrypoint */
+			unsigned tile_width;
+			unsigned tile_height;
+			unsigned log_frames;   /* interval of frame-time messages */
+
+			Affinity::Location locations[MAX_WORKERS];
+			unsigned           num_locations;
+
+			static Config from_xml(Xml_node const &config)
+			{
+				Xml_node const node = config.has_sub_node("composite")
+				                    ? config.sub_node("composite")
+				                    : Xml_node("<composite/>");
+				Config result {
+					.workers       = min(node.attribute_value("workers", 0u),
+					                     (unsigned)MAX_WORKERS),
+					.tile_width    = max(node.attribute_value("tile_width",  4096u), 16u),
+					.tile_height   = max(node.attribute_value("tile_height",   64u),  1u),
+					.log_frames    = node.attribute_value("log_frames", 0u),
+					.locations     = { },
+					.num_locations = 0 };
+
+				node.for_each_sub_node("worker", [&] (Xml_node const &worker) {
+					if (result.num_locations < MAX_WORKERS)
+						result.locations[result.num_locations++] =
+							Affinity::Location(worker.attribute_value("xpos", 0),
+							                   worker.attribute_value("ypos", 0), 1, 1);
+				});
+				return result;
+			}
+
+			bool operator != (Config const &other) const
+			{
+				if (workers       != other.workers
+				 || tile_width    != other.tile_width
+				 || tile_height   != other.tile_height
+				 || num_locations != other.num_locations)
+					return true;
+
+				for (unsigned i = 0; i < num_locations; i++)
+					if (locations[i].xpos() != other.locations[i].xpos()
+					 || locations[i].ypos() != other.locations[i].ypos())
+						return true;
+
+				return false;
+			}
+		};
+
+		/**
+		 * Drawing operation applied to each tile, called concurrently
+		 */
+		struct Job : Interface
+		{
+			virtual void draw(Font const &, Rect) const = 0;
+		};
+
+	private:
+
+		struct Worker : Thread
+		{
+			enum { STACK_SIZE = 8*1024*sizeof(long) };
+
+			Compositor &_compositor;
+
+			Tff_font::Static_glyph_buffer<4096> _glyph_buffer { };
+
+			Tff_font const _font;
+
+			Blockade _start { };
+
+			bool _exit = false;
+
+			void entry() override
+			{
+				for (;;) {
+					_start.block();
+
+					if (_exit)
+						return;
+
+					_compositor._draw_tiles(_font);
+					_compositor._worker_done();
+				}
+			}
+
+			Worker(Env &env, Compositor &compositor, void const *tff,
+			       unsigned id, Location location)
+			:
+				Thread(env, Name("compositor_", id), STACK_SIZE, location,
+				       Weight(), env.cpu()),
+				_compositor(compositor), _font(tff, _glyph_buffer)
+			{ }
+
+			~Worker()
+			{
+				_exit = true;
+				_start.wakeup();
+				join();
+			}
+		};
+
+		Config const _config;
+
+		Allocator &_alloc;
+
+		Timer::Connection &_timer;
+
+		/*
+		 * Statistics of the frame times, logged every 'log_frames' frames
+		 */
+		struct Frame_stats
+		{
+			unsigned frames;
+			uint64_t total_us, max_us, pixels;
+
+			void record(uint64_t us, uint64_t frame_pixels)
+			{
+				frames++;
+				total_us += us;
+				pixels   += frame_pixels;
+				max_us    = max(max_us, us);
+			}
+		};
+
+		Frame_stats _stats { };
+
+		uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+		void _log_stats()
+		{
+			log("composite: ", _stats.frames, " frames, "
+			    "avg ", _stats.total_us/_stats.frames, " us, "
+			    "max ", _stats.max_us, " us, ",
+			    _stats.pixels/_stats.frames, " pixels/frame, ",
+			    _config.workers, " workers");
+
+			_stats = Frame_stats { };
+		}
+
+		Worker *_workers[MAX_WORKERS] { };
+
+		Mutex    _mutex   { };
+		Blockade _done    { };
+		unsigned _pending = 0;   /* workers still drawing */
+
+		Rect     _rects[MAX_RECTS] { };
+		unsigned _num_rects = 0;
+
+		/* index of first tile of each rectangle, tiles are numbered across rectangles */
+		unsigned _first_tile[MAX_RECTS + 1] { };
+
+		unsigned _next_tile = 0;
+
+		Job const *_job = nullptr;
+
+		unsigned _columns(Rect const &rect) const
+		{
+			return (rect.w() + _config.tile_width - 1)/_config.tile_width;
+		}
+
+		unsigned _rows(Rect const &rect) const
+		{
+			return (rect.h() + _config.tile_height - 1)/_config.tile_height;
+		}
+
+		bool _fetch_tile(Rect &tile)
+		{
+			Mutex::Guard guard(_mutex);
+
+			unsigned const index = _next_tile;
+			if (index >= _first_tile[_num_rects])
+				return false;
+
+			_next_tile++;
+
+			unsigned i = 0;
+			while (index >= _first_tile[i + 1])
+				i++;
+
+			Rect     const &rect    = _rects[i];
+			unsigned const  columns = _columns(rect);
+			unsigned const  offset  = index - _first_tile[i];
+			unsigned const  x       = (offset % columns)*_config.tile_width;
+			unsigned const  y       = (offset / columns)*_config.tile_height;
+
+			tile = Rect(Point(rect.x1() + x, rect.y1() + y),
+			            Area(min(_config.tile_width,  rect.w() - x),
+			                 min(_config.tile_height, rect.h() - y)));
+			return true;
+		}
+
+		void _draw_tiles(Font const &font)
+		{
+			Rect tile { };
+			while (_fetch_tile(tile))
+				_job->draw(font, tile);
+		}
+
+		void _worker_done()
+		{
+			Mutex::Guard guard(_mutex);
+
+			if (--_pending == 0)
+				_done.wakeup();
+		}
+
+		void _draw_parallel(Font const &font, Job const &job)
+		{
+			for (unsigned i = 0; i < _num_rects; i++)
+				_first_tile[i + 1] = _first_tile[i]
+				                   + _columns(_rects[i])*_rows(_rects[i]);
+
+			unsigned const num_tiles = _first_tile[_num_rects];
+
+			_job       = &job;
+			_next_tile = 0;
+
+			/* the entrypoint draws tiles too, wake up only the workers needed */
+			unsigned const num_workers = min(_config.workers, num_tiles - 1);
+
+			_pending = num_workers;
+			for (unsigned i = 0; i < num_workers; i++)
+				_workers[i]->_start.wakeup();
+
+			_draw_tiles(font);
+
+			if (num_workers)
+				_done.block();
+
+			_job = nullptr;
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Compositor(Compositor const &);
+		Compositor &operator = (Compositor const &);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param tff  font data used for the labels drawn by the workers
+		 */
+		Compositor(Env &env, Allocator &alloc, Timer::Connection &timer,
+		           Config const &config, void const *tff)
+		:
+			_config(config), _alloc(alloc), _timer(timer)
+		{
+			Affinity::Space const space = env.cpu().affinity_space();
+
+			/* by default, place workers next to the entrypoint at the first CPU */
+			for (unsigned i = 0; i < _config.workers; i++) {
+				Affinity::Location const location = (i < _config.num_locations)
+				                                  ? _config.locations[i]
+				                                  : space.location_of_index(i + 1);
+
+				_workers[i] = new (_alloc) Worker(env, *this, tff, i, location);
+				_workers[i]->start();
+			}
+		}
+
+		~Compositor()
+		{
+			for (unsigned i = 0; i < _config.workers; i++)
+				destroy(_alloc, _workers[i]);
+		}
+
+		Config const &config() const { return _config; }
+
+		/**
+		 * Add dirty rectangle to be drawn by the next call of 'draw'
+		 *
+		 * The drawing of a pixel blends translucent views onto the
+		 * background. Hence, the same pixel must not be drawn by two workers
+		 * at the same time. Therefore, only the parts of 'rect' not covered
+		 * by the already added rectangles are added, which keeps the
+		 * rectangles disjoint. If the parts exceed 'MAX_RECTS', all
+		 * rectangles are merged into a single one.
+		 */
+		void add(Rect const rect)
+		{
+			if (!rect.valid())
+				return;
+
+			Rect     parts[MAX_RECTS] { };
+			unsigned num_parts = 0;
+			bool     exceeded  = (_num_rects == MAX_RECTS);
+
+			parts[num_parts++] = rect;
+
+			for (unsigned i = 0; i < _num_rects && num_parts && !exceeded; i++) {
+
+				Rect     remaining[MAX_RECTS] { };
+				unsigned num_remaining = 0;
+
+				auto append = [&] (Rect const &r) {
+					if (!r.valid())
+						return;
+
+					if (num_remaining == MAX_RECTS) {
+						exceeded = true;
+						return;
+					}
+					remaining[num_remaining++] = r;
+				};
+
+				for (unsigned j = 0; j < num_parts; j++) {
+
+					if (!Rect::intersect(parts[j], _rects[i]).valid()) {
+						append(parts[j]);
+						continue;
+					}
+
+					Rect top, left, right, bottom;
+					parts[j].cut(_rects[i], &top, &left, &right, &bottom);
+
+					append(top); append(left); append(right); append(bottom);
+				}
+
+				for (unsigned j = 0; j < num_remaining; j++)
+					parts[j] = remaining[j];
+
+				num_parts = num_remaining;
+			}
+
+			if (exceeded || _num_rects + num_parts > MAX_RECTS) {
+				Rect all = rect;
+				for (unsigned i = 0; i < _num_rects; i++)
+					all = Rect::compound(all, _rects[i]);
+
+				_rects[0]  = all;
+				_num_rects = 1;
+				return;
+			}
+
+			for (unsigned j = 0; j < num_parts; j++)
+				_rects[_num_rects++] = parts[j];
+		}
+
+		/**
+		 * Draw the added rectangles and wait for the completion
+		 *
+		 * Without workers, each rectangle is drawn as a whole on the
+		 * entrypoint.
+		 */
+		void draw(Font const &font, Job const &job)
+		{
+			if (_num_rects == 0)
+				return;
+
+			uint64_t const start_us = _config.log_frames ? _now_us() : 0;
+
+			uint64_t pixels = 0;
+			for (unsigned i = 0; i < _num_rects; i++)
+				pixels += _rects[i].area().count();
+
+			if (_config.workers == 0) {
+				for (unsigned i = 0; i < _num_rects; i++)
+					job.draw(font, _rects[i]);
+			} else {
+				_draw_parallel(font, job);
+			}
+
+			_num_rects = 0;
+
+			if (!_config.log_frames)
+				return;
+
+			_stats.record(_now_us() - start_us, pixels);
+
+			if (_stats.frames >= _config.log_frames)
+				_log_stats();
+		}
+};
+
+
+
+/**
+ * Job for drawing the view stack into a pixel buffer
+ */
+template <typename PT>
+struct Nitpicker::Draw_job : Compositor::Job
+{
+	View_stack const &view_stack;
+
+	PT   * const base;
+	Point  const offset;
+	Area   const size;
+
+	Draw_job(View_stack const &view_stack, PT *base, Point offset, Area size)
+	:
+		view_stack(view_stack), base(base), offset(offset), size(size)
+	{ }
+
+	void draw(Font const &font, Rect rect) const override
+	{
+		/* each tile is drawn with a canvas of its own holding the clip state */
+		Canvas<PT> canvas { base, offset, size };
+		view_stack.draw(canvas, font, rect);
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Draw_job(Draw_job const &);
+		Draw_job &operator = (Draw_job const &);
+};
+
+#endif /* _COMPOSITOR_H_ */
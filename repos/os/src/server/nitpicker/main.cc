@@ -24,6 +24,7 @@
 #include <os/session_policy.h>
 #include <nitpicker_gfx/tff_font.h>
 #include <util/dirty_rect.h>
+#include <trace/probe.h>
 
 /* local includes */
 #include "types.h"
@@ -33,6 +34,7 @@
 #include "pointer_origin.h"
 #include "domain_registry.h"
 #include "capture_session.h"
+#include "compositor.h"
 #include "event_session.h"
 
 namespace Nitpicker {
@@ -210,6 +212,7 @@ class Nitpicker::Capture_root : public Root_component<Capture_session>
 		Env                      &_env;
 		Sessions                  _sessions { };
 		View_stack         const &_view_stack;
+		Compositor               &_compositor;
 		Capture_session::Handler &_handler;
 
 	protected:
@@ -221,7 +224,7 @@ class Nitpicker::Capture_root : public Root_component<Capture_session>
 				                            session_resources_from_args(args),
 				                            session_label_from_args(args),
 				                            session_diag_from_args(args),
-				                            _handler, _view_stack);
+				                            _handler, _view_stack, _compositor);
 		}
 
 		void _upgrade_session(Capture_session *s, const char *args) override
@@ -246,10 +249,12 @@ class Nitpicker::Capture_root : public Root_component<Capture_session>
 		Capture_root(Env                      &env,
 		             Allocator                &md_alloc,
 		             View_stack         const &view_stack,
+		             Compositor               &compositor,
 		             Capture_session::Handler &handler)
 		:
 			Root_component<Capture_session>(&env.ep().rpc_ep(), &md_alloc),
-			_env(env), _view_stack(view_stack), _handler(handler)
+			_env(env), _view_stack(view_stack), _compositor(compositor),
+			_handler(handler)
 		{ }
 
 		/**
@@ -467,7 +472,14 @@ struct Nitpicker::Main : Focus_updater, Hover_updater,
 	                     _builtin_background, _sliced_heap,
 	                     _focus_reporter, *this, *this };
 
-	Capture_root _capture_root { _env, _sliced_heap, _view_stack, *this };
+	/*
+	 * Drawing of dirty areas, reconstructed on configuration changes
+	 */
+	Reconstructible<Compositor> _compositor {
+		_env, _sliced_heap, _timer, Compositor::Config::from_xml(Xml_node("<config/>")),
+		_binary_default_tff_start };
+
+	Capture_root _capture_root { _env, _sliced_heap, _view_stack, *_compositor, *this };
 
 	Event_root _event_root { _env, _sliced_heap, *this };
 
@@ -654,6 +666,8 @@ struct Nitpicker::Main : Focus_updater, Hover_updater,
 
 void Nitpicker::Main::handle_input_events(User_state::Input_batch batch)
 {
+	GENODE_TRACE_GAUGE("nitpicker_input_batch", batch.count);
+
 	bool const old_button_activity = _button_activity;
 	bool const old_motion_activity = _motion_activity;
 
@@ -741,10 +755,18 @@ void Nitpicker::Main::_handle_period()
 
 	/* perform redraw */
 	if (_framebuffer.constructed() && _fb_screen.constructed()) {
+
+		GENODE_TRACE_DURATION_NAMED(0, "nitpicker_redraw");
+
 		/* call 'Dirty_rect::flush' on a copy to preserve the state */
 		Dirty_rect dirty_rect = _fb_screen->dirty_rect;
 		dirty_rect.flush([&] (Rect const &rect) {
-			_view_stack.draw(_fb_screen->screen, rect); });
+			GENODE_TRACE_COUNTER("nitpicker_redrawn_pixels", rect.area().count());
+			_compositor->add(rect); });
+
+		Draw_job<PT> const job { _view_stack, _fb_screen->fb_ds.local_addr<PT>(),
+		                         Point(0, 0), _fb_screen->size };
+		_compositor->draw(_view_stack.font(), job);
 
 		/* flush pixels to the framebuffer, reset dirty_rect */
 		_fb_screen->dirty_rect.flush([&] (Rect const &rect) {
@@ -819,6 +841,12 @@ void Nitpicker::Main::_handle_config()
 	configure_reporter(config, _clicked_reporter);
 	configure_reporter(config, _displays_reporter);
 
+	/* restart the compositor threads if their configuration changed */
+	Compositor::Config const compositor_config = Compositor::Config::from_xml(config);
+	if (compositor_config != _compositor->config())
+		_compositor.construct(_env, _sliced_heap, _timer, compositor_config,
+		                      _binary_default_tff_start);
+
 	/* update domain registry and session policies */
 	for (Gui_session *s = _session_list.first(); s; s = s->next())
 		s->reset_domain();
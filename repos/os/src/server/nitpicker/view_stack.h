@@ -123,6 +123,22 @@ class Nitpicker::View_stack
 			draw_rec(canvas, _font, _first_view(), rect);
 		}
 
+		/**
+		 * Draw specified area using the given font for the labels
+		 *
+		 * This variant is used for drawing from multiple threads, each
+		 * with a font instance of its own.
+		 */
+		void draw(Canvas_base &canvas, Font const &font, Rect rect) const
+		{
+			draw_rec(canvas, font, _first_view(), rect);
+		}
+
+		/**
+		 * Return font used for the labels
+		 */
+		Font const &font() const { return _font; }
+
 		/**
 		 * Trigger redraw of the whole view stack
 		 */
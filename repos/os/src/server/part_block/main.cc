@@ -20,6 +20,9 @@
 #include <block_session/rpc_object.h>
 #include <block/request_stream.h>
 #include <os/session_policy.h>
+#include <region_map/client.h>
+#include <rm_session/connection.h>
+#include <util/list.h>
 #include <util/bit_allocator.h>
 
 #include "gpt.h"
@@ -28,6 +31,7 @@
 namespace Block {
 	class  Session_component;
 	struct Session_handler;
+	class  Buffer_slice;
 	struct Dispatch;
 	class  Main;
 
@@ -68,24 +72,133 @@ struct Block::Job_queue
 
 struct Block::Dispatch : Interface
 {
-	virtual Response submit(long number, Request const &request, addr_t addr) = 0;
+	virtual Response submit(long number, unsigned long session,
+	                        Request const &request, addr_t addr) = 0;
+	virtual Response submit(long number, unsigned long session,
+	                        Request const &request,
+	                        Packet_descriptor::Payload payload) = 0;
 	virtual void     update() = 0;
 	virtual void     acknowledge_completed(bool all = true, long number = -1) = 0;
-	virtual Response sync(long number, Request const &request) = 0;
+	virtual Response sync(long number, unsigned long session,
+	                      Request const &request) = 0;
+};
+
+
+/**
+ * Part of the back-end communication buffer used as client buffer
+ *
+ * In zero-copy mode, the communication buffer of a client session is a
+ * managed dataspace that refers to a page-aligned range of the back-end
+ * buffer. The range is taken from the back-end packet allocator. Hence,
+ * payload written by the client can be passed to the back end without
+ * copying and vice versa.
+ */
+class Block::Buffer_slice : Noncopyable, public List<Buffer_slice>::Element
+{
+	private:
+
+		Rm_connection   &_rm;
+		Range_allocator &_alloc;
+
+		size_t const _size;
+		addr_t const _offset;
+
+		struct Alloc_failed : Exception { };
+
+		addr_t _alloc_range()
+		{
+			return _alloc.alloc_aligned(_size, 12).convert<addr_t>(
+				[&] (void *ptr) { return (addr_t)ptr; },
+				[&] (Allocator::Alloc_error) -> addr_t { throw Alloc_failed(); });
+		}
+
+		/*
+		 * The destructor is not executed if the construction fails. Hence,
+		 * the range allocated beforehand must be freed here.
+		 */
+		Capability<Region_map> _create_map()
+		{
+			try { return _rm.create(_size); }
+			catch (...) {
+				_alloc.free((void *)_offset, _size);
+				throw;
+			}
+		}
+
+		Region_map_client _map { _create_map() };
+
+	public:
+
+		unsigned long const session;
+
+		/**
+		 * Constructor
+		 *
+		 * \param session     ID of the session using the slice
+		 * \param alloc       back-end packet allocator
+		 * \param backend_ds  back-end communication buffer
+		 *
+		 * \throw Alloc_failed
+		 */
+		Buffer_slice(unsigned long session, Rm_connection &rm, Range_allocator &alloc,
+		             Dataspace_capability backend_ds, size_t size)
+		:
+			_rm(rm), _alloc(alloc), _size(align_addr(size, 12)),
+			_offset(_alloc_range()), session(session)
+		{
+			try { _map.attach(backend_ds, _size, (off_t)_offset, true, (addr_t)0); }
+			catch (...) {
+				_rm.destroy(_map.rpc_cap());
+				_alloc.free((void *)_offset, _size);
+				throw;
+			}
+		}
+
+		~Buffer_slice()
+		{
+			_rm.destroy(_map.rpc_cap());
+			_alloc.free((void *)_offset, _size);
+		}
+
+		Dataspace_capability ds() { return _map.dataspace(); }
+
+		/**
+		 * Translate payload location from client to back-end buffer
+		 *
+		 * The request must have passed the range and alignment check of
+		 * the request stream, which is backed by the slice.
+		 */
+		Packet_descriptor::Payload payload(Request const &request, size_t block_size) const
+		{
+			return { .offset = (off_t)_offset + request.offset,
+			         .bytes  = request.operation.count * block_size };
+		}
 };
 
 
 struct Block::Session_handler : Interface
 {
-	Env                   &env;
-	Attached_ram_dataspace ds;
+	Env &env;
+
+	/* communication buffer, unless provided by a 'Buffer_slice' */
+	Constructible<Attached_ram_dataspace> ram_ds { };
+
+	Dataspace_capability ds_cap { };
 
 	Signal_handler<Session_handler> request_handler
 	  { env.ep(), *this, &Session_handler::handle };
 
-	Session_handler(Env &env, size_t buffer_size)
-	: env(env), ds(env.ram(), env.rm(), buffer_size)
-	{ }
+	Session_handler(Env &env, size_t buffer_size, Buffer_slice *slice)
+	: env(env)
+	{
+		if (slice) {
+			ds_cap = slice->ds();
+			return;
+		}
+
+		ram_ds.construct(env.ram(), env.rm(), buffer_size);
+		ds_cap = ram_ds->cap();
+	}
 
 	virtual void handle_requests()= 0;
 
@@ -105,15 +218,26 @@ class Block::Session_component : public Rpc_object<Block::Session>,
 		long      _number;
 		Dispatch &_dispatcher;
 
+		unsigned long const _id;
+
+		Buffer_slice *_slice;
+
+		/*
+		 * Noncopyable
+		 */
+		Session_component(Session_component const &);
+		Session_component &operator = (Session_component const &);
+
 	public:
 
 		bool syncing { false };
 
-		Session_component(Env &env, long number, size_t buffer_size,
-		                  Session::Info info, Dispatch &dispatcher)
-		: Session_handler(env, buffer_size),
-		  Request_stream(env.rm(), ds.cap(), env.ep(), request_handler, info),
-		  _number(number), _dispatcher(dispatcher)
+		Session_component(Env &env, long number, unsigned long id,
+		                  size_t buffer_size, Session::Info info,
+		                  Dispatch &dispatcher, Buffer_slice *slice)
+		: Session_handler(env, buffer_size, slice),
+		  Request_stream(env.rm(), ds_cap, env.ep(), request_handler, info),
+		  _number(number), _dispatcher(dispatcher), _id(id), _slice(slice)
 		{
 			env.ep().manage(*this);
 		}
@@ -123,12 +247,16 @@ class Block::Session_component : public Rpc_object<Block::Session>,
 			env.ep().dissolve(*this);
 		}
 
+		Buffer_slice *slice() { return _slice; }
+
 		Info info() const override { return Request_stream::info(); }
 
 		Capability<Tx> tx_cap() override { return Request_stream::tx_cap(); }
 
 		long number() const { return _number; }
 
+		unsigned long id() const { return _id; }
+
 		bool acknowledge(Request &request)
 		{
 			bool progress = false;
@@ -173,14 +301,20 @@ class Block::Session_component : public Rpc_object<Block::Session>,
 					}
 
 					if (request.operation.type == Operation::Type::SYNC) {
-						response = _dispatcher.sync(_number, request);
+						response = _dispatcher.sync(_number, _id, request);
 						if (response == Response::ACCEPTED) syncing = true;
 						return response;
 					}
 
+					/* requests exceeding the communication buffer are rejected */
+					response = Response::REJECTED;
+
 					with_payload([&] (Request_stream::Payload const &payload) {
 						payload.with_content(request, [&] (void *addr, size_t) {
-							response = _dispatcher.submit(_number, request, addr_t(addr));
+							response = _slice
+							         ? _dispatcher.submit(_number, _id, request,
+							                              _slice->payload(request, info().block_size))
+							         : _dispatcher.submit(_number, _id, request, addr_t(addr));
 						});
 					});
 
@@ -219,6 +353,13 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 			_config.xml().attribute_value("io_buffer",
 			                              Number_of_bytes(4*1024*1024));
 
+		bool const _zero_copy = _config.xml().attribute_value("zero_copy", false);
+
+		Constructible<Rm_connection> _rm { };
+
+		/* set if the RM session could not be created, e.g., lacking a route */
+		bool _rm_unavailable { false };
+
 		Allocator_avl           _block_alloc { &_heap };
 		Block_connection        _block    { _env, &_block_alloc, _io_buffer_size };
 		Io_signal_handler<Main> _io_sigh  { _env.ep(), *this, &Main::_handle_io };
@@ -226,13 +367,120 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 		Gpt                     _gpt      { _env, _block, _heap, _reporter };
 		Partition_table        &_partition_table { _table() };
 
-		enum { MAX_SESSIONS = 128 };
+		enum { MAX_SESSIONS = 128, MAX_JOBS = 128 };
 		Session_component   *_sessions[MAX_SESSIONS] { };
-		Job_queue<128>       _job_queue { };
+		Job_queue<MAX_JOBS>  _job_queue { };
 		Registry<Block::Job> _job_registry { };
 
 		unsigned _wake_up_index { 0 };
 
+		/* number of allocated jobs per partition, i.e., per session */
+		unsigned _jobs[MAX_SESSIONS] { };
+
+		/*
+		 * Sessions are identified by a unique ID because a partition
+		 * number is reused by a new session while jobs of the previous
+		 * session may still be in flight.
+		 */
+		unsigned long _session_id { 0 };
+
+		/**
+		 * Return session that issued 'job', or nullptr if it was closed
+		 */
+		Session_component *_session(Job const &job)
+		{
+			Session_component * const session = _sessions[job.number];
+
+			return (session && session->id() == job.session) ? session : nullptr;
+		}
+
+		/* buffer slices of closed sessions with jobs still in flight */
+		List<Buffer_slice> _orphaned_slices { };
+
+		void _release_idle_slices()
+		{
+			for (Buffer_slice *slice = _orphaned_slices.first(); slice; ) {
+				Buffer_slice * const next = slice->next();
+
+				bool in_flight = false;
+				_job_registry.for_each([&] (Job const &job) {
+					in_flight |= (job.session == slice->session); });
+
+				if (!in_flight) {
+					_orphaned_slices.remove(slice);
+					destroy(_heap, slice);
+				}
+				slice = next;
+			}
+		}
+
+		/**
+		 * Return true if the session may allocate another job
+		 *
+		 * The job queue is shared by all sessions. To prevent a single busy
+		 * partition from occupying all jobs and thereby starving the others,
+		 * the jobs of each partition are limited to an equal share of the
+		 * queue. Because a partition is handed out to one session at a time,
+		 * the share is accounted by partition number.
+		 */
+		bool _within_fair_share(long number) const
+		{
+			unsigned active = 0;
+			for (long i = 0; i < MAX_SESSIONS; i++)
+				if (_sessions[i]) active++;
+
+			unsigned const share = max(1u, MAX_JOBS / max(1u, active));
+
+			return _jobs[number] < share;
+		}
+
+		/**
+		 * Allocate job for session and construct it via 'fn'
+		 */
+		template <typename FN>
+		Response _alloc_job(long number, FN const &fn)
+		{
+			if (!_within_fair_share(number))
+				return Response::RETRY;
+
+			addr_t index = 0;
+			try {
+				index = _job_queue.alloc();
+			} catch (...) { return Response::RETRY; }
+
+			_job_queue.with_job(index, [&](Job_object &job) { fn(job, index); });
+
+			_jobs[number]++;
+
+			return Response::ACCEPTED;
+		}
+
+		Buffer_slice *_alloc_buffer_slice(unsigned long session, size_t tx_buf_size)
+		{
+			if (!_zero_copy || _rm_unavailable)
+				return nullptr;
+
+			if (!_rm.constructed()) {
+				try { _rm.construct(_env); }
+				catch (...) {
+					warning("RM session unavailable, falling back to copying");
+					_rm_unavailable = true;
+					return nullptr;
+				}
+			}
+
+			try {
+				return new (_heap)
+					Buffer_slice(session, *_rm, _block_alloc,
+					             _block.tx()->dataspace(), tx_buf_size);
+			}
+			catch (...) {
+				warning("unable to provide zero-copy buffer of ", tx_buf_size,
+				        " bytes, falling back to copying");
+			}
+			return nullptr;
+		}
+
 		void _wakeup_clients()
 		{
 			bool     first      = true;
@@ -365,8 +613,18 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 				.writeable   = writeable,
 			};
 
-			_sessions[num] = new (_heap) Session_component(_env, num, tx_buf_size,
-			                                               info, *this);
+			unsigned long const id = ++_session_id;
+
+			Buffer_slice * const slice = _alloc_buffer_slice(id, tx_buf_size);
+
+			try {
+				_sessions[num] = new (_heap) Session_component(_env, num, id, tx_buf_size,
+				                                               info, *this, slice);
+			}
+			catch (...) {
+				if (slice) destroy(_heap, slice);
+				throw;
+			}
 			return _sessions[num]->cap();
 		}
 
@@ -376,9 +634,21 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 				if (!_sessions[number] || !(cap == _sessions[number]->cap()))
 					continue;
 
+				/*
+				 * Jobs of the session that are still in flight refer to the
+				 * buffer slice. Once completed, they are freed as orphans.
+				 * Until then, the slice must stay reserved at the back end.
+				 */
+				Buffer_slice * const slice = _sessions[number]->slice();
+
 				destroy(_heap, _sessions[number]);
 				_sessions[number] = nullptr;
 
+				if (slice) {
+					_orphaned_slices.insert(slice);
+					_release_idle_slices();
+				}
+
 				break;
 			}
 		}
@@ -392,7 +662,7 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 
 		void consume_read_result(Job &job, off_t offset, char const *src, size_t length)
 		{
-			if (!_sessions[job.number]) return;
+			if (!_session(job)) return;
 
 			memcpy((void *)(job.addr + offset), src, length);
 		}
@@ -415,7 +685,8 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 
 		void update() override { _block.update_jobs(*this); }
 
-		Response submit(long number, Request const &request, addr_t addr) override
+		Response submit(long number, unsigned long session,
+		                Request const &request, addr_t addr) override
 		{
 			Partition &partition = _partition_table.partition(number);
 			block_number_t last  = request.operation.block_number + request.operation.count;
@@ -423,35 +694,43 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 			if (last > partition.sectors)
 				return Response::REJECTED;
 
-			addr_t index = 0;
-			try {
-				index  = _job_queue.alloc();
-			} catch (...) { return Response::RETRY; }
-
-			_job_queue.with_job(index, [&](Job_object &job) {
+			return _alloc_job(number, [&] (Job_object &job, addr_t index) {
 
 				Operation op     = request.operation;
 				op.block_number += partition.lba;
 
-				job.construct(_block, op, _job_registry, index, number, request, addr);
+				job.construct(_block, op, _job_registry, index, number, session,
+				              request, addr);
 			});
-
-			return Response::ACCEPTED;
 		}
 
-		Response sync(long number, Request const &request) override
+		Response submit(long number, unsigned long session,
+		                Request const &request,
+		                Packet_descriptor::Payload payload) override
 		{
-			addr_t index = 0;
-			try {
-				index = _job_queue.alloc();
-			} catch (...) { return Response::RETRY; }
+			Partition &partition = _partition_table.partition(number);
+			block_number_t last  = request.operation.block_number + request.operation.count;
 
-			_job_queue.with_job(index, [&](Job_object &job) {
-				job.construct(_block, request.operation, _job_registry,
-				              index, number, request, 0);
+			if (last > partition.sectors)
+				return Response::REJECTED;
+
+			return _alloc_job(number, [&] (Job_object &job, addr_t index) {
+
+				Operation op     = request.operation;
+				op.block_number += partition.lba;
+
+				job.construct(_block, op, _job_registry, index, number, session,
+				              request, payload);
 			});
+		}
 
-			return Response::ACCEPTED;
+		Response sync(long number, unsigned long session,
+		              Request const &request) override
+		{
+			return _alloc_job(number, [&] (Job_object &job, addr_t index) {
+				job.construct(_block, request.operation, _job_registry,
+				              index, number, session, request, 0);
+			});
 		}
 
 		void acknowledge_completed(bool all = true, long number = -1) override
@@ -461,8 +740,11 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 
 				addr_t index = job.index;
 
+				Session_component * const session = _session(job);
+
 				/* free orphans */
-				if (!_sessions[job.number]) {
+				if (!session) {
+					_jobs[job.number]--;
 					_job_queue.free(index);
 					return;
 				}
@@ -470,9 +752,13 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 				if (!all && job.number != number)
 					return;
 
-				if (_sessions[job.number]->acknowledge(job.request))
+				if (session->acknowledge(job.request)) {
+					_jobs[job.number]--;
 					_job_queue.free(index);
+				}
 			});
+
+			_release_idle_slices();
 		}
 };
 
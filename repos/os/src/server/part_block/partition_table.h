@@ -46,6 +46,7 @@ struct Block::Job : public Block_connection::Job
 
 	addr_t  const index;                /* job index */
 	long    const number;               /* parition number */
+	unsigned long const session;        /* ID of the issuing session */
 	Request       request;
 	addr_t  const addr;                 /* target payload address */
 	bool          completed { false };
@@ -55,11 +56,29 @@ struct Block::Job : public Block_connection::Job
 	    Registry<Job>    &registry,
 	    addr_t const      index,
 	    addr_t const      number,
+	    unsigned long     session,
 	    Request           request,
 	    addr_t            addr)
 	: Block_connection::Job(connection, operation),
 	  registry_element(registry, *this),
-	  index(index), number(number), request(request), addr(addr) { }
+	  index(index), number(number), session(session), request(request),
+	  addr(addr) { }
+
+	/**
+	 * Constructor for a job that operates directly on the back-end buffer
+	 */
+	Job(Block_connection          &connection,
+	    Operation                  operation,
+	    Registry<Job>             &registry,
+	    addr_t const               index,
+	    addr_t const               number,
+	    unsigned long              session,
+	    Request                    request,
+	    Packet_descriptor::Payload payload)
+	: Block_connection::Job(connection, operation, payload),
+	  registry_element(registry, *this),
+	  index(index), number(number), session(session), request(request),
+	  addr(0) { }
 };
 
 
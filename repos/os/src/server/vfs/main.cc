@@ -23,6 +23,7 @@
 #include <root/component.h>
 #include <os/session_policy.h>
 #include <vfs/simple_env.h>
+#include <trace/probe.h>
 
 /* local includes */
 #include "node.h"
@@ -216,6 +217,7 @@ class Vfs_server::Session_component : private Session_resources,
 						switch (node.submit_job(packet, payload_ptr)) {
 
 						case Node::Submit_result::ACCEPTED:
+							GENODE_TRACE_COUNTER("vfs_jobs_submitted", 1);
 							_stalled = false;
 							if (!node.enqueued())
 								_active_nodes.enqueue(node);
@@ -228,6 +230,7 @@ class Vfs_server::Session_component : private Session_resources,
 							break;
 
 						case Node::Submit_result::STALLED:
+							GENODE_TRACE_COUNTER("vfs_jobs_stalled", 1);
 							_stalled = true;
 							/* keep request packet in submit queue */
 							break;
@@ -275,6 +278,8 @@ class Vfs_server::Session_component : private Session_resources,
 				if (node.acknowledgement_pending()) {
 					_stream.acknowledge_packet(node.dequeue_acknowledgement());
 					progress = true;
+
+					GENODE_TRACE_COUNTER("vfs_jobs_acknowledged", 1);
 				}
 
 				/*
@@ -305,6 +310,8 @@ class Vfs_server::Session_component : private Session_resources,
 		 */
 		Process_packets_result process_packets()
 		{
+			GENODE_TRACE_DURATION_NAMED(0, "vfs_process_packets");
+
 			bool overall_progress = false;
 
 			/*
@@ -754,6 +761,8 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 {
 	private:
 
+		enum { SIGNAL_BATCH_LIMIT = 32 };
+
 		Genode::Env &_env;
 
 		Genode::Attached_rom_dataspace _config_rom { _env, "config" };
@@ -802,6 +811,8 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 		 */
 		void handle_io_progress() override
 		{
+			GENODE_TRACE_DURATION_NAMED(0, "vfs_io_progress");
+
 			bool yield = false;
 
 			unsigned iterations = 200;
@@ -981,6 +992,10 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 			_env(env)
 		{
 			_env.ep().register_io_progress_handler(*this);
+
+			/* handle the packet-stream signals of all sessions per wakeup */
+			_env.ep().signal_batch_limit(SIGNAL_BATCH_LIMIT);
+
 			_config_rom.sigh(_config_handler);
 			env.parent().announce(env.ep().manage(*this));
 		}
@@ -153,13 +153,46 @@ struct Test::Main
 
 		Gui::Point _at { };
 
+		Capture::Session::Tiling const _tiling;
+
+		bool _tiling_init = ( _capture.tiling(_tiling), true );
+
+		Constructible<Attached_dataspace> _tile_stream_ds { };
+
 		Capture_input(Env &env, Gui::Area area, Xml_node const &config)
 		:
-			_env(env), _area(area), _at(_point_from_xml(config))
-		{ }
+			_env(env), _area(area), _at(_point_from_xml(config)),
+			_tiling({ .tile_size = config.attribute_value("tile_size", 0U),
+			          .encode    = config.attribute_value("encode", false) })
+		{
+			Dataspace_capability const ds = _capture.tile_stream();
+			if (ds.valid())
+				_tile_stream_ds.construct(_env.rm(), ds);
+		}
 
 		Affected_rects capture() { return _capture.capture_at(_at); }
 
+		bool tiled() const { return _tile_stream_ds.constructed(); }
+
+		/**
+		 * Call 'fn' with each changed tile and its encoded content
+		 */
+		template <typename FN>
+		void for_each_tile(FN const &fn) const
+		{
+			if (tiled())
+				Capture::Tile_stream::for_each_tile(_tile_stream_ds->local_addr<char const>(),
+				                                    _tile_stream_ds->size(), fn);
+		}
+
+		size_t tile_stream_bytes() const
+		{
+			if (!tiled())
+				return 0;
+
+			return _tile_stream_ds->local_addr<Capture::Tile_stream::Header const>()->bytes;
+		}
+
 		template <typename FN>
 		void with_texture(FN const &fn) const
 		{
@@ -177,11 +210,76 @@ struct Test::Main
 
 	Signal_handler<Main> _timer_handler { _env.ep(), *this, &Main::_handle_timer };
 
+	/*
+	 * Statistics of the captured frames, logged every 'log_frames' frames
+	 */
+	struct Stats
+	{
+		unsigned frames;
+		uint64_t total_us, pixels, tiles, bytes;
+	};
+
+	Stats _stats { };
+
+	unsigned _log_frames = 0;
+
+	void _log_stats()
+	{
+		if (!_log_frames || _stats.frames < _log_frames)
+			return;
+
+		log("capture: ", _stats.frames, " frames, "
+		    "avg ", _stats.total_us/_stats.frames, " us, ",
+		    _stats.pixels/_stats.frames, " pixels/frame, ",
+		    _stats.tiles/_stats.frames,  " tiles/frame, ",
+		    _stats.bytes/_stats.frames,  " bytes/frame");
+
+		_stats = Stats { };
+	}
+
+	/**
+	 * Apply changed tiles to the output surface
+	 *
+	 * \return  number of bytes obtained from the capture dataspaces
+	 */
+	size_t _apply_tiles(Surface<Pixel> &surface, Texture<Pixel> const &texture)
+	{
+		using Tile_stream = Capture::Tile_stream;
+
+		size_t bytes = _capture_input->tile_stream_bytes();
+
+		Gui::Rect const surface_rect(Gui::Point(0, 0), surface.size());
+
+		_capture_input->for_each_tile([&] (Tile_stream::Tile const &tile,
+		                                   char const *content) {
+			_stats.tiles++;
+
+			Gui::Rect const rect = tile.rect();
+
+			bool const decoded = (tile.encoding == Tile_stream::RLE)
+			                  && surface_rect.contains(rect.p1())
+			                  && surface_rect.contains(rect.p2())
+			                  && Tile_stream::decode_rle(content, tile.bytes,
+			                                             surface.addr() + rect.y1()*surface.size().w()
+			                                                            + rect.x1(),
+			                                             surface.size().w(), rect.area());
+			if (decoded)
+				return;
+
+			surface.clip(rect);
+			Blit_painter::paint(surface, texture, Gui::Point(0, 0));
+			bytes += rect.area().count()*sizeof(Pixel);
+		});
+		return bytes;
+	}
+
 	void _handle_timer()
 	{
 		if (!_capture_input.constructed() || !_output.constructed())
 			return;
 
+		uint64_t const start_us = _log_frames ? _timer.elapsed_us() : 0;
+
 		_capture_input->with_texture([&] (Texture<Pixel> const &texture) {
 
 			_output->with_surface([&] (Surface<Pixel> &surface) {
@@ -189,11 +287,20 @@ struct Test::Main
 				Affected_rects const affected = _capture_input->capture();
 
 				affected.for_each_rect([&] (Gui::Rect const rect) {
+					_stats.pixels += rect.area().count(); });
 
-					surface.clip(rect);
+				if (_capture_input->tiled()) {
+					_stats.bytes += _apply_tiles(surface, texture);
+				} else {
+					affected.for_each_rect([&] (Gui::Rect const rect) {
 
-					Blit_painter::paint(surface, texture, Gui::Point(0, 0));
-				});
+						surface.clip(rect);
+
+						Blit_painter::paint(surface, texture, Gui::Point(0, 0));
+
+						_stats.bytes += rect.area().count()*sizeof(Pixel);
+					});
+				}
 
 				affected.for_each_rect([&] (Gui::Rect const rect) {
 					_output->_gui.framebuffer()->refresh(rect.x1(), rect.y1(),
@@ -202,6 +309,11 @@ struct Test::Main
 			});
 		});
 
+		if (_log_frames) {
+			_stats.frames++;
+			_stats.total_us += _timer.elapsed_us() - start_us;
+			_log_stats();
+		}
 	}
 
 	void _handle_config()
@@ -213,6 +325,9 @@ struct Test::Main
 		_output.construct(_env, _heap, config);
 		_capture_input.construct(_env, _output->_mode.area, config);
 
+		_log_frames = config.attribute_value("log_frames", 0U);
+		_stats      = Stats { };
+
 		unsigned long const period_ms = config.attribute_value("period_ms", 0U);
 
 		if (period_ms == 0)
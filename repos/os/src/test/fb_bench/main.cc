@@ -135,12 +135,57 @@ struct Unaligned_blit_test : Test
 	}
 };
 
+struct Blit_ram_test : Test
+{
+	static constexpr char const *brief = "copy via blit library from RAM to RAM";
+
+	Blit_ram_test(Env &env, int id) : Test(env, id, brief)
+	{
+		unsigned       kib      = 0;
+		uint64_t const start_ms = timer.elapsed_ms();
+		unsigned const w        = (unsigned)(fb_mode.area.w() * fb_mode.bytes_per_pixel());
+		unsigned const h        = fb_mode.area.h();
+		for (; timer.elapsed_ms() - start_ms < DURATION_MS;) {
+			blit(buf[1], w, buf[0], w, w, h);
+			kib += (w * h) / 1024;
+		}
+		conclusion(kib, start_ms, timer.elapsed_ms());
+	}
+};
+
+struct Rotated_blit_test : Test
+{
+	Rotated_blit_test(Env &env, int id, char const *brief, Blit_rotation rotation)
+	:
+		Test(env, id, brief)
+	{
+		/* the source is rotated to the size of the framebuffer */
+		bool const portrait = (rotation == BLIT_ROTATE_90)
+		                   || (rotation == BLIT_ROTATE_270);
+
+		int const fb_w = fb_mode.area.w();
+		int const w    = portrait ? fb_mode.area.h() : fb_mode.area.w();
+		int const h    = portrait ? fb_mode.area.w() : fb_mode.area.h();
+
+		unsigned       kib      = 0;
+		uint64_t const start_ms = timer.elapsed_ms();
+		for (unsigned i = 0; timer.elapsed_ms() - start_ms < DURATION_MS; i++) {
+			blit_rotated(buf[i % 2], w*4, fb_ds.local_addr<char>(), fb_w*4,
+			             w, h, rotation, false);
+			kib += (w * h * 4) / 1024;
+		}
+		conclusion(kib, start_ms, timer.elapsed_ms());
+	}
+};
+
 struct Main
 {
 	Constructible<Bytewise_ram_test>   test_1 { };
 	Constructible<Bytewise_fb_test>    test_2 { };
 	Constructible<Blit_test>           test_3 { };
 	Constructible<Unaligned_blit_test> test_4 { };
+	Constructible<Blit_ram_test>       test_5 { };
+	Constructible<Rotated_blit_test>   test_6 { };
 
 	Main(Env &env)
 	{
@@ -149,6 +194,10 @@ struct Main
 		test_2.construct(env, 2); test_2.destruct();
 		test_3.construct(env, 3); test_3.destruct();
 		test_4.construct(env, 4); test_4.destruct();
+		test_5.construct(env, 5); test_5.destruct();
+		test_6.construct(env, 6, "blit rotated by 90 degrees from RAM to FB",  BLIT_ROTATE_90);  test_6.destruct();
+		test_6.construct(env, 7, "blit rotated by 180 degrees from RAM to FB", BLIT_ROTATE_180); test_6.destruct();
+		test_6.construct(env, 8, "blit rotated by 270 degrees from RAM to FB", BLIT_ROTATE_270); test_6.destruct();
 		log("--- Framebuffer benchmark finished ---");
 	}
 };
@@ -95,6 +95,10 @@ struct Test::Capture_session : Rpc_object<Capture::Session>
 
 		return affected;
 	}
+
+	void tiling(Tiling) override { }
+
+	Dataspace_capability tile_stream() override { return Dataspace_capability(); }
 };
 
 
@@ -13,7 +13,9 @@
 
 #include <base/env.h>
 #include <util/list.h>
+#include <base/attached_rom_dataspace.h>
 #include <base/component.h>
+#include <base/heap.h>
 #include <base/log.h>
 #include <gui_session/connection.h>
 #include <timer_session/connection.h>
@@ -142,6 +144,87 @@ class Test_view_stack : public List<Test_view>
 };
 
 
+/**
+ * Animate translucent views covering most of the screen
+ *
+ * The benchmark produces a steady redraw load for measuring the frame times
+ * of nitpicker, e.g., as reported via its 'log_frames' option.
+ */
+static void benchmark(Env &env, Gui::Connection &gui, Timer::Connection &timer,
+                      Xml_node const &config)
+{
+	enum { MAX_VIEWS = 16 };
+
+	unsigned const num_views = min(config.attribute_value("views", 4u),
+	                               (unsigned)MAX_VIEWS);
+	unsigned const steps     = config.attribute_value("steps", 500u);
+	unsigned const period_ms = config.attribute_value("period_ms", 10u);
+	unsigned char const alpha_value =
+		(unsigned char)config.attribute_value("alpha", 160u);
+
+	Framebuffer::Mode const mode { .area = gui.mode().area };
+	gui.buffer(mode, true);
+
+	int const scr_w = mode.area.w(), scr_h = mode.area.h();
+
+	log("benchmark with ", num_views, " views on ", mode);
+
+	Attached_dataspace fb_ds(env.rm(), gui.framebuffer()->dataspace());
+
+	typedef Pixel_rgb888 PT;
+	PT *pixels = fb_ds.local_addr<PT>();
+	unsigned char *alpha = (unsigned char *)&pixels[scr_w*scr_h];
+	unsigned char *input_mask = alpha + scr_w*scr_h;
+
+	for (int i = 0; i < scr_h; i++)
+		for (int j = 0; j < scr_w; j++) {
+			pixels[i*scr_w + j]     = PT(j & 0xff, i & 0xff, (i + j) & 0xff);
+			alpha[i*scr_w + j]      = alpha_value;
+			input_mask[i*scr_w + j] = 0;
+		}
+
+	/* each view covers two thirds of the screen and bounces around */
+	int const w = 2*scr_w/3, h = 2*scr_h/3;
+
+	struct Motion { int x, y, dx, dy; } motion[MAX_VIEWS];
+
+	Heap heap { env.ram(), env.rm() };
+
+	Test_view *views[MAX_VIEWS] { };
+
+	for (unsigned i = 0; i < num_views; i++) {
+		motion[i] = { .x  = (int)(i*37) % (scr_w - w + 1),
+		              .y  = (int)(i*23) % (scr_h - h + 1),
+		              .dx = 3 + (int)i, .dy = 2 + (int)i };
+
+		views[i] = new (heap) Test_view(&gui, motion[i].x, motion[i].y,
+		                                       w, h, "benchmark");
+	}
+
+	auto bounce = [] (int &pos, int &d, int limit) {
+		pos += d;
+		if (pos < 0)     { pos = 0;     d = -d; }
+		if (pos > limit) { pos = limit; d = -d; }
+	};
+
+	for (unsigned step = 0; step < steps; step++) {
+
+		for (unsigned i = 0; i < num_views; i++) {
+			bounce(motion[i].x, motion[i].dx, scr_w - w);
+			bounce(motion[i].y, motion[i].dy, scr_h - h);
+			views[i]->move(motion[i].x, motion[i].y);
+		}
+
+		timer.msleep(period_ms);
+	}
+
+	for (unsigned i = 0; i < num_views; i++)
+		destroy(heap, views[i]);
+
+	log("--- nitpicker benchmark finished ---");
+}
+
+
 void Component::construct(Genode::Env &env)
 {
 	/*
@@ -151,6 +234,16 @@ void Component::construct(Genode::Env &env)
 	static Gui::Connection   gui   { env, "testnit" };
 	static Timer::Connection timer { env };
 
+	/* the config is optional, the interactive test needs none */
+	static Constructible<Attached_rom_dataspace> config { };
+	try { config.construct(env, "config"); } catch (...) { }
+
+	if (config.constructed() && config->xml().has_sub_node("benchmark")) {
+		benchmark(env, gui, timer, config->xml().sub_node("benchmark"));
+		env.parent().exit(0);
+		return;
+	}
+
 	Framebuffer::Mode const mode { .area = { 256, 256 } };
 	gui.buffer(mode, false);
 
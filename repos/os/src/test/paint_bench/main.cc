@@ -0,0 +1,181 @@
+/*
+ * \brief  Throughput of the span operations used by the painters
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * Each operation is measured for the pixel-wise generic implementation and
+ * for the implementation selected for the RGB888 format, which processes
+ * multiple pixels at a time if supported by the CPU. Before measuring, the
+ * results of both implementations are checked for equality.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <os/pixel_span.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+namespace Test { struct Main; }
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	unsigned const _w = _config.xml().attribute_value("width",  1024u);
+	unsigned const _h = _config.xml().attribute_value("height", 768u);
+
+	uint64_t const _duration_ms = _config.xml().attribute_value("duration_ms", 1000ULL);
+
+	size_t const _num = (size_t)_w*_h;
+
+	Pixel_rgb888  * const _src   = new (_heap) Pixel_rgb888[_num];
+	Pixel_rgb888  * const _dst   = new (_heap) Pixel_rgb888[_num];
+	Pixel_rgb888  * const _ref   = new (_heap) Pixel_rgb888[_num];
+	unsigned char * const _alpha = new (_heap) unsigned char[_num];
+	Pixel_rgb565  * const _dst16 = new (_heap) Pixel_rgb565[_num];
+	Pixel_rgb565  * const _ref16 = new (_heap) Pixel_rgb565[_num];
+
+	bool _failed = false;
+
+	/*
+	 * Noncopyable
+	 */
+	Main(Main const &);
+	Main &operator = (Main const &);
+
+	/**
+	 * Fill buffers with pseudo-random content
+	 *
+	 * A third of the alpha values are zero and another third are 255 to
+	 * resemble the anti-aliased glyphs and icons painted via textures.
+	 */
+	void _init_buffers()
+	{
+		uint32_t v = 0x1234567;
+		auto random = [&] () { v = v*1103515245 + 12345; return v >> 8; };
+
+		for (size_t i = 0; i < _num; i++) {
+			_src[i].pixel = random();
+			_dst[i].pixel = _ref[i].pixel = random();
+
+			unsigned const r = random();
+			_alpha[i] = (r % 3 == 0) ? 0 : (r % 3 == 1) ? 255 : (unsigned char)(r >> 8);
+		}
+	}
+
+	/**
+	 * Apply 'fn' to each line of the buffers
+	 */
+	template <typename PT, typename FN>
+	void _for_each_line(PT *dst, FN const &fn)
+	{
+		for (unsigned y = 0; y < _h; y++)
+			fn(dst + y*_w, y);
+	}
+
+	template <typename PT>
+	void _check(char const *name, PT const *a, PT const *b)
+	{
+		for (size_t i = 0; i < _num; i++)
+			if (a[i].pixel != b[i].pixel) {
+				error(name, ": mismatch at pixel ", i);
+				_failed = true;
+				return;
+			}
+	}
+
+	/**
+	 * Measure throughput of 'fn' applied to the whole buffer
+	 */
+	template <typename FN>
+	void _measure(char const *name, char const *variant, FN const &fn)
+	{
+		uint64_t       pixels   = 0;
+		uint64_t const start_ms = _timer.elapsed_ms();
+		uint64_t       end_ms   = start_ms;
+
+		for (; end_ms - start_ms < _duration_ms; end_ms = _timer.elapsed_ms()) {
+			fn();
+			pixels += _num;
+		}
+
+		log(name, " (", variant, "): ",
+		    pixels/1000/max(end_ms - start_ms, (uint64_t)1), " Mpixel/s");
+	}
+
+	/**
+	 * Check and measure operation for the generic and the specific variant
+	 */
+	template <typename PT, typename GENERIC, typename SPECIFIC>
+	void _test(char const *name, PT *dst, PT *ref,
+	           GENERIC const &generic, SPECIFIC const &specific)
+	{
+		_init_buffers();
+		_for_each_line(ref, generic);
+		_for_each_line(dst, specific);
+		_check(name, dst, ref);
+
+		_measure(name, "generic",  [&] () { _for_each_line(ref, generic); });
+		_measure(name, "specific", [&] () { _for_each_line(dst, specific); });
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- paint benchmark started (", _w, "x", _h, ") ---");
+
+		Pixel_rgb888 const color(200, 100, 50);
+
+		_test("fill", _dst, _ref,
+			[&] (Pixel_rgb888 *d, unsigned) {
+				Pixel_span::fill<Pixel_rgb888>(d, _w, color); },
+			[&] (Pixel_rgb888 *d, unsigned) {
+				Pixel_span::fill(d, _w, color); });
+
+		_test("mix", _dst, _ref,
+			[&] (Pixel_rgb888 *d, unsigned) {
+				Pixel_span::mix<Pixel_rgb888>(d, _w, color, 100); },
+			[&] (Pixel_rgb888 *d, unsigned) {
+				Pixel_span::mix(d, _w, color, 100); });
+
+		_test("mix_alpha", _dst, _ref,
+			[&] (Pixel_rgb888 *d, unsigned y) {
+				Pixel_span::mix_alpha<Pixel_rgb888>(d, _src + y*_w, _alpha + y*_w, _w); },
+			[&] (Pixel_rgb888 *d, unsigned y) {
+				Pixel_span::mix_alpha(d, _src + y*_w, _alpha + y*_w, _w); });
+
+		_test("dither", _dst16, _ref16,
+			[&] (Pixel_rgb565 *d, unsigned y) {
+				Pixel_span::dither<Pixel_rgb565, Pixel_rgb888>(d, _src + y*_w, _w, 0, y); },
+			[&] (Pixel_rgb565 *d, unsigned y) {
+				Pixel_span::dither(d, _src + y*_w, _w, 0, y); });
+
+		if (_failed) {
+			error("results of generic and specific variants differ");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		log("--- paint benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-paint_bench
+SRC_CC = main.cc
+LIBS   = base blit
@@ -1,5 +1,5 @@
 /*
- * \brief  Unit test for RAM fs chunk data structure
+ * \brief  Unit test and benchmark for RAM fs storage data structures
  * \author Norman Feske
  * \author Martin Stein
  * \date   2012-04-19
@@ -16,6 +16,9 @@
 #include <base/heap.h>
 #include <base/component.h>
 #include <ram_fs/chunk.h>
+#include <ram_fs/extent.h>
+#include <ram_fs/param.h>
+#include <timer_session/connection.h>
 
 using namespace File_system;
 using namespace Genode;
@@ -96,11 +99,214 @@ struct Allocator_tracer : Allocator
 	bool   need_size_for_free()  const override { return wrapped.need_size_for_free(); }
 };
 
+/*
+ * Dimensioning of the chunk hierarchy as used by the VFS RAM file system
+ */
+using Ram_chunk_level_3 = Chunk      <Ram_fs::num_level_3_entries()>;
+using Ram_chunk_level_2 = Chunk_index<Ram_fs::num_level_2_entries(), Ram_chunk_level_3>;
+using Ram_chunk_level_1 = Chunk_index<Ram_fs::num_level_1_entries(), Ram_chunk_level_2>;
+using Ram_chunk_level_0 = Chunk_index<Ram_fs::num_level_0_entries(), Ram_chunk_level_1>;
+
+
+/**
+ * Compare content of the extent storage with a flat reference buffer
+ */
+struct Extent_test
+{
+	enum { MAX_EXTENT = Extent_storage::MAX_EXTENT_SIZE,
+	       MAX_SIZE   = 2*MAX_EXTENT + 4096,
+	       NUM_OPS    = 500 };
+
+	Extent_storage storage;
+
+	char ref[MAX_SIZE] { };
+	char buf[MAX_SIZE] { };
+
+	file_size_t length = 0;
+	uint32_t    seed   = 1;
+	bool        failed = false;
+
+	Extent_test(Allocator &alloc) : storage(alloc, 0) { }
+
+	size_t random(size_t limit)
+	{
+		seed = seed*1103515245u + 12345u;
+		return (seed >> 8) % limit;
+	}
+
+	void write(size_t len, seek_off_t offset)
+	{
+		for (size_t i = 0; i < len; i++)
+			buf[i] = (char)(1 + (offset + i) % 251);
+
+		storage.write(buf, len, offset);
+		memcpy(ref + offset, buf, len);
+		length = max(length, offset + len);
+	}
+
+	void truncate(file_size_t size)
+	{
+		if (size >= length)
+			return;
+
+		/* like the VFS, shrink the storage only if it holds data beyond */
+		if (size < storage.used_size())
+			storage.truncate(size);
+
+		memset(ref + size, 0, (size_t)(length - size));
+		length = size;
+	}
+
+	void check(char const *what, bool condition)
+	{
+		if (condition)
+			return;
+
+		error("extent storage: ", what, " (length=", length,
+		      " used=", storage.used_size(), ")");
+		failed = true;
+	}
+
+	void verify()
+	{
+		check("used size exceeds length", storage.used_size() <= length);
+
+		storage.read(buf, (size_t)length, 0);
+		check("content differs", memcmp(buf, ref, (size_t)length) == 0);
+
+		/* window that may extend beyond the used size */
+		size_t const offset = random((size_t)length + 1);
+		size_t const len    = random(MAX_SIZE - offset + 1);
+
+		storage.read(buf, len, offset);
+		check("window differs", memcmp(buf, ref + offset, len) == 0);
+	}
+
+	void run_inline()
+	{
+		write(40, 0);
+		check("tiny content not inline", storage.num_extents() == 0);
+		verify();
+
+		write(40, 30);
+		check("content not moved to extent", storage.num_extents() == 1);
+		verify();
+
+		truncate(0);
+		check("empty content not inline", storage.num_extents() == 0);
+		verify();
+
+		/* sequential writes fill extents up to the maximum extent size */
+		for (size_t offset = 0; offset <= 2*MAX_EXTENT; offset += 4096)
+			write(4096, offset);
+		check("sequential content fragmented", storage.num_extents() == 3);
+		verify();
+
+		truncate(0);
+
+		if (!failed)
+			log("extent storage: inline and extents ok");
+	}
+
+	void run_random()
+	{
+		for (unsigned op = 0; op < NUM_OPS && !failed; op++) {
+
+			size_t len = 0;
+			switch (random(4)) {
+			case 0:  len = 1 + random(16);                            break;
+			case 1:  len = 1 + random(2*Extent_storage::INLINE_SIZE); break;
+			case 2:  len = 1 + random(8192);                          break;
+			default: len = 1 + random(MAX_EXTENT + MAX_EXTENT/2);     break;
+			}
+
+			/* favor offsets near the start to cover the inline content */
+			size_t const offset = random(2) ? random(64)
+			                                : random(MAX_SIZE - len + 1);
+
+			switch (random(8)) {
+			case 0:  truncate(random((size_t)length + 1)); break;
+			case 1:  truncate(0);                          break;
+			default: write(len, offset);                   break;
+			}
+
+			verify();
+		}
+
+		truncate(0);
+
+		if (!failed)
+			log("extent storage: ", (unsigned)NUM_OPS, " random operations ok");
+	}
+};
+
+
+/**
+ * Compare memory footprint and throughput of storage data structures
+ */
+template <typename STORAGE>
+struct Storage_bench
+{
+	enum { NUM_SMALL_FILES = 1000,
+	       SMALL_FILE_SIZE = 40,
+	       LARGE_FILE_SIZE = 16*1024*1024,
+	       BLOCK_SIZE      = 4096 };
+
+	static void run(char const *name, Allocator_tracer &alloc, Timer::Connection &timer)
+	{
+		log(name, " storage");
+
+		static char block[BLOCK_SIZE];
+		memset(block, 0x55, sizeof(block));
+
+		/* many tiny files */
+		{
+			STORAGE *files[NUM_SMALL_FILES];
+
+			for (unsigned i = 0; i < NUM_SMALL_FILES; i++) {
+				files[i] = new (alloc) STORAGE(alloc, 0);
+				files[i]->write(block, SMALL_FILE_SIZE, 0);
+			}
+
+			log("  ", (unsigned)NUM_SMALL_FILES, " files of ", (unsigned)SMALL_FILE_SIZE,
+			    " bytes: allocated=", alloc.sum / 1024, " KiB",
+			    " per file=", alloc.sum / NUM_SMALL_FILES, " bytes");
+
+			for (unsigned i = 0; i < NUM_SMALL_FILES; i++)
+				destroy(alloc, files[i]);
+		}
+
+		/* one large sequentially written file */
+		{
+			STORAGE &file = *new (alloc) STORAGE(alloc, 0);
+
+			uint64_t const write_start_us = timer.elapsed_us();
+			for (size_t off = 0; off < LARGE_FILE_SIZE; off += BLOCK_SIZE)
+				file.write(block, BLOCK_SIZE, off);
+			uint64_t const write_us = max(timer.elapsed_us() - write_start_us, 1ULL);
+
+			uint64_t const read_start_us = timer.elapsed_us();
+			for (size_t off = 0; off < LARGE_FILE_SIZE; off += BLOCK_SIZE)
+				file.read(block, BLOCK_SIZE, off);
+			uint64_t const read_us = max(timer.elapsed_us() - read_start_us, 1ULL);
+
+			log("  ", LARGE_FILE_SIZE / (1024*1024), " MiB file:",
+			    " allocated=", alloc.sum / 1024, " KiB",
+			    " write=", (LARGE_FILE_SIZE / write_us), " MB/s",
+			    " read=",  (LARGE_FILE_SIZE / read_us),  " MB/s");
+
+			destroy(alloc, &file);
+		}
+	}
+};
+
+
 struct Main
 {
-	Env              &env;
-	Heap              heap  { env.ram(), env.rm() };
-	Allocator_tracer  alloc { heap };
+	Env               &env;
+	Heap               heap  { env.ram(), env.rm() };
+	Allocator_tracer   alloc { heap };
+	Timer::Connection  timer { env };
 
 	Main(Env &env) : env(env)
 	{
@@ -126,6 +332,21 @@ struct Main
 				truncate(chunk, i);
 		}
 		log("allocator: sum=", alloc.sum);
+
+		log("--- RAM filesystem extent test ---");
+		{
+			Extent_test &test = *new (alloc) Extent_test(alloc);
+			test.run_inline();
+			test.run_random();
+			destroy(alloc, &test);
+		}
+		log("allocator: sum=", alloc.sum);
+
+		log("--- RAM filesystem storage benchmark ---");
+		Storage_bench<Ram_chunk_level_0>::run("chunked", alloc, timer);
+		Storage_bench<Extent_storage>   ::run("compact", alloc, timer);
+		log("allocator: sum=", alloc.sum);
+
 		log("--- RAM filesystem chunk test finished ---");
 	}
 
@@ -0,0 +1,191 @@
+/*
+ * \brief  Benchmark for path lookup and file access of the VFS tar file system
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The benchmark walks the directory tree of the mounted archive repeatedly.
+ * In each walk, one kind of operation is applied to every file. The time of
+ * a plain walk is subtracted to obtain the cost per operation.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+#include <vfs/simple_env.h>
+#include <os/path.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	typedef Path<Vfs::MAX_PATH_LEN> Path;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	Vfs::Simple_env _vfs_env { _env, _heap, _config.xml().sub_node("vfs") };
+
+	Vfs::File_system &_vfs = _vfs_env.root_dir();
+
+	enum class Op { WALK, STAT, OPEN, DATASPACE };
+
+	static char const *_name(Op op)
+	{
+		switch (op) {
+		case Op::WALK:      return "walk";
+		case Op::STAT:      return "stat";
+		case Op::OPEN:      return "open/close";
+		case Op::DATASPACE: return "dataspace/release";
+		}
+		return "";
+	}
+
+	unsigned _num_files = 0;
+	unsigned _num_dirs  = 0;
+
+	void _apply(Op op, char const *path)
+	{
+		switch (op) {
+
+		case Op::WALK:
+			break;
+
+		case Op::STAT:
+			{
+				Vfs::Directory_service::Stat stat { };
+				if (_vfs.stat(path, stat) != Vfs::Directory_service::STAT_OK)
+					error("stat of ", path, " failed");
+			}
+			break;
+
+		case Op::OPEN:
+			{
+				Vfs::Vfs_handle *handle = nullptr;
+				if (_vfs.open(path, Vfs::Directory_service::OPEN_MODE_RDONLY,
+				              &handle, _heap) != Vfs::Directory_service::OPEN_OK) {
+					error("open of ", path, " failed");
+					break;
+				}
+				handle->close();
+			}
+			break;
+
+		case Op::DATASPACE:
+			{
+				Dataspace_capability ds = _vfs.dataspace(path);
+				if (ds.valid())
+					_vfs.release(path, ds);
+				else
+					error("dataspace of ", path, " failed");
+			}
+			break;
+		}
+	}
+
+	void _walk(Op op, Path const &dir_path)
+	{
+		Vfs::Vfs_handle *dir_handle = nullptr;
+		if (_vfs.opendir(dir_path.base(), false, &dir_handle, _heap)
+		    != Vfs::Directory_service::OPENDIR_OK) {
+			error("opendir of ", dir_path, " failed");
+			return;
+		}
+
+		Vfs::file_size const num_dirent = _vfs.num_dirent(dir_path.base());
+
+		for (Vfs::file_size i = 0; i < num_dirent; i++) {
+
+			Vfs::Directory_service::Dirent dirent { };
+			Vfs::file_size out_count = 0;
+
+			dir_handle->seek(i*sizeof(dirent));
+			dir_handle->fs().queue_read(dir_handle, sizeof(dirent));
+
+			while (dir_handle->fs().complete_read(dir_handle, (char *)&dirent,
+			                                      sizeof(dirent), out_count)
+			       == Vfs::File_io_service::READ_QUEUED)
+				_env.ep().wait_and_dispatch_one_io_signal();
+
+			Path path(dirent.name.buf, dir_path.base());
+
+			switch (dirent.type) {
+
+			case Vfs::Directory_service::Dirent_type::DIRECTORY:
+				if (op == Op::WALK) _num_dirs++;
+				_walk(op, path);
+				break;
+
+			case Vfs::Directory_service::Dirent_type::CONTINUOUS_FILE:
+				if (op == Op::WALK) _num_files++;
+				_apply(op, path.base());
+				break;
+
+			default:
+				break;
+			}
+		}
+
+		dir_handle->close();
+	}
+
+	uint64_t _measure_us(Op op)
+	{
+		uint64_t const start_us = _timer.elapsed_us();
+		_walk(op, Path("/"));
+		return _timer.elapsed_us() - start_us;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- tar file-system benchmark ---");
+
+		uint64_t const walk_us = _measure_us(Op::WALK);
+
+		log("archive contains ", _num_files, " files in ", _num_dirs, " directories");
+		log(_name(Op::WALK), ": ", walk_us, " us");
+
+		if (!_num_files) {
+			error("archive contains no files");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		Op const ops[] = { Op::STAT, Op::OPEN, Op::DATASPACE };
+
+		for (Op op : ops) {
+
+			uint64_t const us = _measure_us(op);
+			uint64_t const op_us = us > walk_us ? us - walk_us : 0;
+
+			log(_name(op), ": ", us, " us total, ",
+			    (op_us*1000)/_num_files, " ns per file");
+		}
+
+		log("--- tar file-system benchmark finished ---");
+
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -17,6 +17,7 @@
 #include <base/attached_ram_dataspace.h>
 #include <base/component.h>
 #include <timer_session/connection.h>
+#include <trace/timestamp.h>
 
 using namespace Genode;
 
@@ -348,10 +349,248 @@ class Test_tracing
 };
 
 
+/**
+ * Entry carrying a timestamp for merging the buffers of several producers
+ */
+struct Timestamped_entry
+{
+	Trace::Timestamp   timestamp;
+	unsigned long long seq;
+
+	Timestamped_entry(Trace::Timestamp ts, unsigned long long seq)
+	: timestamp(ts), seq(seq) { }
+};
+
+
+/**
+ * Producer that fills its own buffer as fast as possible
+ */
+struct Throughput_producer : Thread
+{
+	Trace::Buffer      &buffer;
+	unsigned long long  produced { 0 };
+	bool volatile       stop     { false };
+
+	void entry() override
+	{
+		while (!stop) {
+			char *dst = buffer.reserve(sizeof(Timestamped_entry));
+			construct_at<Timestamped_entry>(dst, Trace::timestamp(), produced);
+			buffer.commit(sizeof(Timestamped_entry));
+			produced++;
+		}
+	}
+
+	Throughput_producer(Env &env, Trace::Buffer &buffer, Affinity::Location location)
+	: Thread(env, "producer", 8*1024, location, Weight(), env.cpu()),
+	  buffer(buffer)
+	{ }
+
+	void finish()
+	{
+		stop = true;
+		this->join();
+	}
+
+	~Throughput_producer() { if (!stop) finish(); }
+};
+
+
+/**
+ * Multi-producer throughput test
+ *
+ * Each producer thread writes into a buffer of its own while the consumer
+ * drains all buffers in one pass and merges their entries in the order of
+ * their timestamps. The test reports the number of produced, consumed, and
+ * lost entries per second.
+ */
+class Test_throughput
+{
+	private:
+
+		enum { NUM_PRODUCERS = 4, BUFFER_SIZE = 64*1024, DURATION_MS = 1000 };
+
+		struct Failed : Genode::Exception { };
+
+		struct Producer
+		{
+			Attached_ram_dataspace ds;
+			Trace::Buffer         &raw_buffer { *ds.local_addr<Trace::Buffer>() };
+			Trace_buffer           buffer     { raw_buffer };
+			Throughput_producer    thread;
+
+			unsigned long long consumed { 0 };
+			unsigned long long next_seq { 0 };
+			Trace::Timestamp   last_ts  { 0 };
+
+			Producer(Env &env, Affinity::Location location)
+			:
+				ds(env.ram(), env.rm(), BUFFER_SIZE),
+				thread(env, raw_buffer, location)
+			{
+				raw_buffer.init(BUFFER_SIZE);
+				thread.start();
+			}
+
+			void _validate(Trace::Buffer::Entry const &entry)
+			{
+				if (entry.length() != sizeof(Timestamped_entry)) {
+					error("Got invalid entry from for_each_new_entry()");
+					throw Failed();
+				}
+
+				Timestamped_entry const &e =
+					*reinterpret_cast<Timestamped_entry const *>(entry.data());
+
+				/* sequence numbers may skip lost entries but never go back */
+				if (e.seq < next_seq || e.timestamp < last_ts) {
+					error("entries of one producer out of order");
+					throw Failed();
+				}
+
+				next_seq = e.seq + 1;
+				last_ts  = e.timestamp;
+			}
+
+			static Trace::Timestamp _timestamp(Trace::Buffer::Entry const &entry) {
+				return reinterpret_cast<Timestamped_entry const *>(entry.data())->timestamp; }
+
+			/**
+			 * Determine timestamp of the next pending entry
+			 */
+			bool next_timestamp(Trace::Timestamp &ts)
+			{
+				bool pending = false;
+				buffer.for_each_new_entry([&] (Trace::Buffer::Entry &entry) {
+					ts      = _timestamp(entry);
+					pending = true;
+					return false;
+				});
+				return pending;
+			}
+
+			/**
+			 * Consume next entry and determine timestamp of the following one
+			 */
+			bool consume_next(Trace::Timestamp &ts)
+			{
+				bool processed = false;
+				bool pending   = false;
+				buffer.for_each_new_entry([&] (Trace::Buffer::Entry &entry) {
+					if (processed) {
+						ts      = _timestamp(entry);
+						pending = true;
+						return false;
+					}
+					_validate(entry);
+					processed = true;
+					consumed++;
+					return true;
+				});
+				return pending;
+			}
+		};
+
+		struct Pending
+		{
+			Producer         *producer;
+			Trace::Timestamp  timestamp;
+		};
+
+		Timer::Connection       _timer;
+		Constructible<Producer> _producers[NUM_PRODUCERS];
+
+		unsigned long long _merged = 0, _out_of_order = 0;
+		Trace::Timestamp   _last_merged = 0;
+
+		/**
+		 * Drain all buffers in one pass using a k-way merge
+		 */
+		void _drain()
+		{
+			Trace::Timestamp const end = Trace::timestamp();
+
+			Pending  pending[NUM_PRODUCERS];
+			unsigned num = 0;
+
+			for (Constructible<Producer> &p : _producers) {
+				Trace::Timestamp ts = 0;
+				if (p->next_timestamp(ts) && ts <= end)
+					pending[num++] = Pending { &*p, ts };
+			}
+
+			while (num) {
+				unsigned min = 0;
+				for (unsigned i = 1; i < num; i++)
+					if (pending[i].timestamp < pending[min].timestamp)
+						min = i;
+
+				/*
+				 * An entry committed late by a preempted producer may carry
+				 * an older timestamp than one already merged.
+				 */
+				if (pending[min].timestamp < _last_merged)
+					_out_of_order++;
+				_last_merged = pending[min].timestamp;
+				_merged++;
+
+				Pending &p = pending[min];
+				if (!p.producer->consume_next(p.timestamp) || p.timestamp > end)
+					p = pending[--num];
+			}
+		}
+
+		uint64_t _now_ms() { return _timer.curr_time().trunc_to_plain_ms().value; }
+
+	public:
+
+		Test_throughput(Env &env) : _timer(env)
+		{
+			log("running multi-producer throughput test");
+
+			Affinity::Space const space = env.cpu().affinity_space();
+
+			for (unsigned i = 0; i < NUM_PRODUCERS; i++)
+				_producers[i].construct(env, space.location_of_index(i + 1));
+
+			uint64_t const start = _now_ms();
+			while (_now_ms() - start < DURATION_MS)
+				_drain();
+
+			uint64_t const duration_ms = max(_now_ms() - start, (uint64_t)1);
+
+			unsigned long long produced = 0, consumed = 0, lost = 0;
+			for (Constructible<Producer> &p : _producers) {
+				p->thread.finish();
+				produced += p->thread.produced;
+				lost     += p->raw_buffer.lost_entries();
+			}
+
+			/* read the remaining entries */
+			_drain();
+
+			for (Constructible<Producer> &p : _producers)
+				consumed += p->consumed;
+
+			if (consumed != _merged) {
+				error("merged ", _merged, " entries but consumed ", consumed);
+				throw Failed();
+			}
+
+			log("throughput test succeeded (producers: ", (unsigned)NUM_PRODUCERS,
+			    ", produced: ", (produced*1000)/duration_ms, " events/s"
+			    ", consumed: ", (consumed*1000)/duration_ms, " events/s"
+			    ", lost: ", lost,
+			    ", merged out of order: ", _out_of_order, ")\n");
+		}
+};
+
+
 struct Main
 {
 	Constructible<Test_tracing<Generator1>> test_1 { };
 	Constructible<Test_tracing<Generator2>> test_2 { };
+	Constructible<Test_throughput>          test_3 { };
 
 	Main(Env &env)
 	{
@@ -371,6 +610,10 @@ struct Main
 		test_2.construct(env, BUFFER_SIZE, 10000, 0);
 		test_2.destruct();
 
+		/* several producers with buffers of their own */
+		test_3.construct(env);
+		test_3.destruct();
+
 		env.parent().exit(0);
 	}
 };
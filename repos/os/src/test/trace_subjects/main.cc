@@ -0,0 +1,372 @@
+/*
+ * \brief  Benchmark and check of the enumeration of trace subjects
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The component creates a large number of idle threads and compares the
+ * duration of querying all subject infos from core with the duration of
+ * the delta query, which reports only the subjects changed since the
+ * previous query.
+ *
+ * Afterwards, the values reported by delta queries are checked with an
+ * argument buffer too small to hold all changes of a period.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/blockade.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/registry.h>
+#include <base/semaphore.h>
+#include <timer_session/connection.h>
+#include <trace_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Idle_thread;
+	struct Busy_thread;
+	struct Main;
+}
+
+
+struct Test::Idle_thread : Thread
+{
+	Blockade _blockade { };
+
+	void entry() override { _blockade.block(); }
+
+	Idle_thread(Env &env, unsigned index)
+	:
+		Thread(env, Name("idle_", index), 2*1024*sizeof(addr_t))
+	{
+		start();
+	}
+
+	~Idle_thread()
+	{
+		_blockade.wakeup();
+		join();
+	}
+};
+
+
+/**
+ * Thread that executes a bit of work per step requested by the main thread
+ */
+struct Test::Busy_thread : Thread
+{
+	Semaphore  _step { };
+	Semaphore &_done;
+
+	bool _stop = false;
+
+	unsigned long volatile _work = 0;
+
+	void entry() override
+	{
+		for (;;) {
+			_step.down();
+			if (_stop)
+				return;
+
+			for (unsigned i = 0; i < 100*1000; i++)
+				_work = _work + 1;
+
+			_done.up();
+		}
+	}
+
+	Busy_thread(Env &env, unsigned index, Semaphore &done)
+	:
+		Thread(env, Name("busy_", index), 4*1024*sizeof(addr_t)), _done(done)
+	{
+		start();
+	}
+
+	~Busy_thread()
+	{
+		_stop = true;
+		_step.up();
+		join();
+	}
+
+	void step() { _step.up(); }
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	unsigned const _num_threads = _config.xml().attribute_value("threads", 5000u);
+	unsigned const _rounds      = _config.xml().attribute_value("rounds",  20u);
+
+	Registry<Registered<Idle_thread>> _threads { };
+
+	/*
+	 * The argument buffer must hold the infos of all subjects at once,
+	 * including the busy threads created by '_check_deltas'
+	 */
+	size_t const _arg_buffer_size = (_num_threads + 256)
+	                              * (sizeof(Trace::Subject_info) + sizeof(Trace::Subject_id));
+
+	/* core allocates the subjects from the session quota */
+	size_t const _trace_ram = _arg_buffer_size + _num_threads*1024 + 64*1024;
+
+	Constructible<Trace::Connection> _trace { };
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	bool _failed = false;
+
+	template <typename... ARGS>
+	void _check(bool condition, ARGS &&... args)
+	{
+		if (condition)
+			return;
+
+		error(args...);
+		_failed = true;
+	}
+
+	/*
+	 * Check the delta query with an argument buffer of few records
+	 *
+	 * Each subject must be reported as added exactly once, subjects that
+	 * change with each query must not starve, and the last reported
+	 * execution time must match the one of the full subject info.
+	 */
+	void _check_deltas()
+	{
+		/* the buffer must hold at least a few subject infos */
+		size_t const arg_buffer_size = 4*(sizeof(Trace::Subject_info)
+		                                + sizeof(Trace::Subject_id));
+
+		size_t   const max_deltas   = arg_buffer_size / sizeof(Trace::Subject_delta);
+		unsigned const busy_threads = 3*(unsigned)max_deltas;
+
+		Semaphore done { };
+		Registry<Registered<Busy_thread>> busy { };
+
+		for (unsigned i = 0; i < busy_threads; i++)
+			new (_heap) Registered<Busy_thread>(busy, _env, i, done);
+
+		auto step_busy_threads = [&] ()
+		{
+			busy.for_each([&] (Busy_thread &thread) { thread.step(); });
+			for (unsigned i = 0; i < busy_threads; i++)
+				done.down();
+		};
+
+		struct Record
+		{
+			unsigned added;
+			bool     busy;
+			bool     reported;
+			bool     reported_while_busy;
+			uint64_t thread_context;
+		};
+
+		/* subject IDs are allocated sequentially per session */
+		size_t const max_id = _num_threads + busy_threads + 1024;
+
+		Record * const records = new (_heap) Record[max_id];
+		for (size_t i = 0; i < max_id; i++)
+			records[i] = Record { 0, false, false, false, 0 };
+
+		Trace::Connection trace(_env, arg_buffer_size + max_id*1024 + 64*1024,
+		                        arg_buffer_size, 0);
+
+		auto query = [&] ()
+		{
+			return trace.for_each_subject_delta([&] (Trace::Subject_delta const &delta) {
+
+				if (delta.id.id >= max_id) {
+					_check(false, "subject ID ", delta.id.id, " out of range");
+					return;
+				}
+
+				Record &record = records[delta.id.id];
+				if (delta.added)
+					record.added++;
+
+				record.reported       = true;
+				record.thread_context = delta.execution_time.thread_context;
+			});
+		};
+
+		auto sweep = [&] ()
+		{
+			for (;;)
+				if (query().count < max_deltas)
+					return;
+		};
+
+		/* initial sweep reports all subjects as added */
+		sweep();
+
+		size_t subjects = 0;
+		Trace::Subject_id * const ids = new (_heap) Trace::Subject_id[max_id];
+		for (unsigned id = 0; id < max_id; id++) {
+			if (records[id].reported)
+				ids[subjects++] = Trace::Subject_id(id);
+			_check(records[id].added <= 1, "subject ", id, " added ",
+			       records[id].added, " times");
+		}
+
+		size_t const expected = _trace->for_each_subject_info(
+			[&] (Trace::Subject_id, Trace::Subject_info const &) { }).count;
+
+		_check(subjects == expected, "delta queries reported ", subjects,
+		       " subjects, full query reported ", expected);
+
+		trace.for_each_subject_info(ids, subjects,
+			[&] (Trace::Subject_id const &id, Trace::Subject_info const &info) {
+				records[id.id].busy =
+					!strcmp(info.thread_name().string(), "busy_", 5); });
+
+		/*
+		 * Let all busy threads change in each period, which exceeds the
+		 * capacity of the argument buffer. Each busy thread must be
+		 * reported within a few periods nevertheless.
+		 */
+		for (size_t i = 0; i < max_id; i++)
+			records[i].reported = false;
+
+		unsigned const periods = 2*busy_threads/(unsigned)max_deltas + 2;
+		for (unsigned i = 0; i < periods; i++) {
+			step_busy_threads();
+			query();
+		}
+
+		for (size_t i = 0; i < max_id; i++)
+			records[i].reported_while_busy = records[i].reported;
+
+		/* report remaining changes */
+		sweep();
+
+		unsigned starved = 0, mismatches = 0, busy_subjects = 0;
+		bool     time_accounted = false;
+
+		trace.for_each_subject_info(ids, subjects,
+			[&] (Trace::Subject_id const &id, Trace::Subject_info const &info) {
+
+				Record const &record = records[id.id];
+				if (!record.busy)
+					return;
+
+				busy_subjects++;
+
+				uint64_t const time = info.execution_time().thread_context;
+				if (time)
+					time_accounted = true;
+
+				if (time && !record.reported_while_busy)
+					starved++;
+
+				if (time != record.thread_context)
+					mismatches++;
+			});
+
+		_check(busy_subjects == busy_threads, "found ", busy_subjects,
+		       " of ", busy_threads, " busy threads");
+
+		if (!time_accounted)
+			log("execution time not accounted by the kernel, "
+			    "skipping starvation check");
+
+		_check(!starved, starved, " busy threads never reported");
+		_check(!mismatches, mismatches, " busy threads with mismatching execution time");
+
+		log("delta check: ", subjects, " subjects, ", busy_threads,
+		    " busy threads, ", max_deltas, " records per query");
+
+		_heap.free(ids,     max_id*sizeof(Trace::Subject_id));
+		_heap.free(records, max_id*sizeof(Record));
+
+		busy.for_each([&] (Registered<Busy_thread> &thread) {
+			destroy(_heap, &thread); });
+	}
+
+	template <typename FN>
+	void _measure(char const *name, FN const &fn)
+	{
+		size_t   count = 0;
+		uint64_t const start = _now_us();
+
+		for (unsigned i = 0; i < _rounds; i++)
+			count = fn();
+
+		uint64_t const duration_us = _now_us() - start;
+
+		log(name, ": ", count, " records, ",
+		    duration_us / max(_rounds, 1u), " us per query");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- trace subject enumeration benchmark ---");
+
+		for (unsigned i = 0; i < _num_threads; i++)
+			new (_heap) Registered<Idle_thread>(_threads, _env, i);
+
+		log("created ", _num_threads, " threads");
+
+		_trace.construct(_env, _trace_ram, _arg_buffer_size, 0);
+
+		_measure("full query", [&] () {
+			return _trace->for_each_subject_info(
+				[&] (Trace::Subject_id, Trace::Subject_info const &) { }).count; });
+
+		/* initial delta query reports all subjects as added */
+		{
+			uint64_t const start = _now_us();
+
+			size_t added = 0;
+			for (;;) {
+				auto res = _trace->for_each_subject_delta(
+					[&] (Trace::Subject_delta const &delta) {
+						if (delta.added) added++; });
+
+				if (res.count < res.limit)
+					break;
+			}
+			log("initial delta query: ", added, " subjects added in ",
+			    _now_us() - start, " us");
+		}
+
+		_measure("delta query", [&] () {
+			return _trace->for_each_subject_delta(
+				[&] (Trace::Subject_delta const &) { }).count; });
+
+		_check_deltas();
+
+		_trace.destruct();
+
+		_threads.for_each([&] (Registered<Idle_thread> &thread) {
+			destroy(_heap, &thread); });
+
+		log("--- trace subject enumeration benchmark finished ---");
+
+		_env.parent().exit(_failed ? -1 : 0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,259 @@
+/*
+ * \brief  Functional test of hashed directories of the VFS RAM file system
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The test populates a directory of a RAM file system configured for compact
+ * storage with enough entries to grow the hash index several times. It then
+ * checks lookup, directory reading, renaming, and unlinking of the entries
+ * against the expected state.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/attached_rom_dataspace.h>
+#include <vfs/simple_env.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	typedef String<Vfs::MAX_PATH_LEN> Path;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Vfs::Simple_env _vfs_env { _env, _heap, _config.xml().sub_node("vfs") };
+
+	Vfs::File_system &_vfs = _vfs_env.root_dir();
+
+	typedef Vfs::Directory_service Ds;
+
+	enum { NUM_FILES = 1000 };
+
+	/* expected state of each file */
+	enum class State { NONE, FILE, RENAMED };
+
+	State _state[NUM_FILES] { };
+
+	bool _failed = false;
+
+	template <typename... ARGS>
+	void _check(bool condition, ARGS &&... args)
+	{
+		if (condition)
+			return;
+
+		error(args...);
+		_failed = true;
+	}
+
+	static Path _path(State state, unsigned i)
+	{
+		return Path("/dir/", state == State::RENAMED ? "renamed-" : "file-", i);
+	}
+
+	bool _exists(Path const &path)
+	{
+		Ds::Stat stat { };
+		return _vfs.stat(path.string(), stat) == Ds::STAT_OK;
+	}
+
+	/**
+	 * Call 'fn' with each entry of '/dir' until the end of the directory
+	 */
+	template <typename FN>
+	void _for_each_dirent(FN const &fn)
+	{
+		Vfs::Vfs_handle *handle = nullptr;
+		if (_vfs.opendir("/dir", false, &handle, _heap) != Ds::OPENDIR_OK) {
+			_check(false, "opendir of /dir failed");
+			return;
+		}
+
+		for (Vfs::file_size i = 0; i <= NUM_FILES + 2; i++) {
+
+			Ds::Dirent dirent { };
+			Vfs::file_size out_count = 0;
+
+			handle->seek(i*sizeof(dirent));
+			handle->fs().queue_read(handle, sizeof(dirent));
+
+			while (handle->fs().complete_read(handle, (char *)&dirent,
+			                                  sizeof(dirent), out_count)
+			       == Vfs::File_io_service::READ_QUEUED)
+				_env.ep().wait_and_dispatch_one_io_signal();
+
+			if (dirent.type == Ds::Dirent_type::END)
+				break;
+
+			fn(dirent);
+		}
+
+		handle->close();
+	}
+
+	/**
+	 * Check lookup and directory reading against the expected state
+	 */
+	void _verify(char const *phase)
+	{
+		unsigned expected = 2;  /* 'sub' and 'link' */
+		for (unsigned i = 0; i < NUM_FILES; i++) {
+
+			if (_state[i] != State::NONE)
+				expected++;
+
+			bool const file    = _exists(_path(State::FILE,    i));
+			bool const renamed = _exists(_path(State::RENAMED, i));
+
+			_check(file    == (_state[i] == State::FILE),    phase, ": lookup of file-", i);
+			_check(renamed == (_state[i] == State::RENAMED), phase, ": lookup of renamed-", i);
+		}
+
+		_check(!_exists(_path(State::FILE, NUM_FILES)), phase, ": lookup of nonexistent file");
+
+		Vfs::file_size const num_dirent = _vfs.num_dirent("/dir");
+		_check(num_dirent == expected, phase, ": num_dirent=", num_dirent,
+		       " expected=", expected);
+
+		/* each entry must be read exactly once */
+		State    seen[NUM_FILES] { };
+		unsigned count = 0;
+
+		_for_each_dirent([&] (Ds::Dirent const &dirent) {
+
+			count++;
+
+			char const *name = dirent.name.buf;
+
+			if (!strcmp(name, "sub") || !strcmp(name, "link"))
+				return;
+
+			State const state = strcmp(name, "file-", 5) ? State::RENAMED : State::FILE;
+
+			unsigned long i = NUM_FILES;
+			ascii_to(name + (state == State::FILE ? 5 : 8), i);
+
+			if (i >= NUM_FILES || seen[i] != State::NONE || _state[i] != state) {
+				_check(false, phase, ": unexpected entry ", Cstring(name));
+				return;
+			}
+			seen[i] = state;
+		});
+
+		_check(count == expected, phase, ": read ", count, " entries, "
+		       "expected ", expected);
+
+		if (!_failed)
+			log(phase, ": ", expected, " entries ok");
+	}
+
+	void _populate()
+	{
+		Vfs::Vfs_handle *handle = nullptr;
+
+		_check(_vfs.opendir("/dir", true, &handle, _heap) == Ds::OPENDIR_OK,
+		       "creation of /dir failed");
+		if (handle) handle->close();
+
+		for (unsigned i = 0; i < NUM_FILES; i++) {
+			handle = nullptr;
+			if (_vfs.open(_path(State::FILE, i).string(), Ds::OPEN_MODE_CREATE,
+			              &handle, _heap) != Ds::OPEN_OK) {
+				_check(false, "creation of file-", i, " failed");
+				continue;
+			}
+			handle->close();
+			_state[i] = State::FILE;
+		}
+
+		/* directories and symlinks are entries of the hash index too */
+		handle = nullptr;
+		_check(_vfs.opendir("/dir/sub", true, &handle, _heap) == Ds::OPENDIR_OK,
+		       "creation of /dir/sub failed");
+		if (handle) handle->close();
+
+		handle = nullptr;
+		_check(_vfs.openlink("/dir/link", true, &handle, _heap) == Ds::OPENLINK_OK,
+		       "creation of /dir/link failed");
+		if (handle) handle->close();
+
+		handle = nullptr;
+		_check(_vfs.open(_path(State::FILE, 0).string(), Ds::OPEN_MODE_CREATE,
+		                 &handle, _heap) == Ds::OPEN_ERR_EXISTS,
+		       "creation of existing file succeeded");
+	}
+
+	void _rename_and_unlink()
+	{
+		for (unsigned i = 0; i < NUM_FILES; i += 2) {
+			_check(_vfs.rename(_path(State::FILE,    i).string(),
+			                   _path(State::RENAMED, i).string()) == Ds::RENAME_OK,
+			       "rename of file-", i, " failed");
+			_state[i] = State::RENAMED;
+		}
+
+		for (unsigned i = 0; i < NUM_FILES; i += 3) {
+			_check(_vfs.unlink(_path(_state[i], i).string()) == Ds::UNLINK_OK,
+			       "unlink of entry ", i, " failed");
+			_state[i] = State::NONE;
+		}
+	}
+
+	void _empty()
+	{
+		for (unsigned i = 0; i < NUM_FILES; i++) {
+			if (_state[i] == State::NONE)
+				continue;
+
+			_check(_vfs.unlink(_path(_state[i], i).string()) == Ds::UNLINK_OK,
+			       "unlink of entry ", i, " failed");
+			_state[i] = State::NONE;
+		}
+
+		_check(_vfs.unlink("/dir/sub")  == Ds::UNLINK_OK, "unlink of /dir/sub failed");
+		_check(_vfs.unlink("/dir/link") == Ds::UNLINK_OK, "unlink of /dir/link failed");
+
+		_check(_vfs.num_dirent("/dir") == 0, "/dir not empty");
+		_check(_vfs.unlink("/dir") == Ds::UNLINK_OK, "unlink of /dir failed");
+		_check(!_exists(Path("/dir")), "/dir still exists");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- VFS RAM compact test ---");
+
+		_populate();
+		_verify("populated");
+
+		_rename_and_unlink();
+		_verify("renamed and unlinked");
+
+		_empty();
+
+		log("--- VFS RAM compact test finished ---");
+
+		_env.parent().exit(_failed ? -1 : 0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
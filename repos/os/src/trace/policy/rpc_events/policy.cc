@@ -0,0 +1,66 @@
+#include <base/ipc_msgbuf.h>
+#include <trace/policy.h>
+#include <trace/rpc_latency_event.h>
+
+using namespace Genode;
+
+using Event = Trace::Rpc_latency_event;
+
+size_t max_event_size()
+{
+	return sizeof(Event);
+}
+
+size_t trace_eth_packet(char *, char const *, bool, char *, size_t)
+{
+	return 0;
+}
+
+size_t checkpoint(char *, char const *, unsigned long, void *, unsigned char)
+{
+	return 0;
+}
+
+size_t log_output(char *, char const *, size_t)
+{
+	return 0;
+}
+
+size_t rpc_call(char *dst, char const *rpc_name, Msgbuf_base const &msg)
+{
+	/* the opcode is the first word of the call message */
+	uint32_t const opcode = (uint32_t)const_cast<Msgbuf_base &>(msg).word(0);
+
+	((Event *)dst)->assign(Event::CALL, rpc_name, opcode);
+	return sizeof(Event);
+}
+
+size_t rpc_returned(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	((Event *)dst)->assign(Event::RETURNED, rpc_name, 0);
+	return sizeof(Event);
+}
+
+size_t rpc_dispatch(char *dst, char const *rpc_name)
+{
+	((Event *)dst)->assign(Event::DISPATCH, rpc_name, 0);
+	return sizeof(Event);
+}
+
+size_t rpc_reply(char *dst, char const *rpc_name)
+{
+	((Event *)dst)->assign(Event::REPLY, rpc_name, 0);
+	return sizeof(Event);
+}
+
+size_t signal_submit(char *dst, unsigned const num)
+{
+	((Event *)dst)->assign(Event::SIGNAL_SUBMIT, "signal", num);
+	return sizeof(Event);
+}
+
+size_t signal_receive(char *dst, Signal_context const &, unsigned num)
+{
+	((Event *)dst)->assign(Event::SIGNAL_RECEIVE, "signal", num);
+	return sizeof(Event);
+}
@@ -0,0 +1,5 @@
+TARGET = rpc_events_policy
+
+TARGET_POLICY = rpc_events
+
+include $(PRG_DIR)/../policy.inc